@@ -33,13 +33,13 @@ struct contextMeshOptions {
   int meshOnlyVisible, meshOnlyEmpty;
   int minCircPoints, minCurvPoints, minElementsPerTwoPi;
   int hoOptimize, hoPeriodic, hoNLayers, hoPrimSurfMesh, hoIterMax, hoPassMax;
-  int hoDistCAD;
+  int hoDistCAD, hoPatchStrategy;
   double hoThresholdMin, hoThresholdMax, hoPoissonRatio;
   int NewtonConvergenceTestXYZ, maxIterDelaunay3D;
   int ignorePeriodicityMsh2, ignoreParametrizationMsh4, boundaryLayerFanPoints;
   int maxNumThreads1D, maxNumThreads2D, maxNumThreads3D;
   double angleToleranceFacetOverlap;
-  int renumber, compoundClassify, reparamMaxTriangles;
+  int renumber, reorder, compoundClassify, reparamMaxTriangles;
   double compoundLcFactor;
   unsigned int randomSeed;
   // mesh IO
@@ -58,7 +58,7 @@ struct contextMeshOptions {
   // partitioning
   int numPartitions, partitionCreateTopology, partitionCreateGhostCells;
   int partitionCreatePhysicals, partitionSplitMeshFiles,
-    partitionSaveTopologyFile;
+    partitionStreamMeshFiles, partitionSaveTopologyFile;
   int partitionTriWeight, partitionQuaWeight, partitionTetWeight,
     partitionHexWeight, partitionLinWeight;
   int partitionPriWeight, partitionPyrWeight, partitionTrihWeight;
@@ -86,7 +86,8 @@ struct contextGeometryOptions {
   int occAutoFix, occFixDegenerated, occFixSmallEdges, occFixSmallFaces;
   int occSewFaces, occMakeSolids, occParallel, occBooleanPreserveNumbering;
   int occBoundsUseSTL, occDisableSTL, occImportLabels, occUnionUnify;
-  int occThruSectionsDegree;
+  int occThruSectionsDegree, occFragmentsClustering, occSyncIncremental;
+  int occTessellationCache;
   double occScaling;
   std::string occTargetUnit;
   int copyMeshingMethod, exactExtrusion;
@@ -154,6 +155,9 @@ public:
   std::string editor;
   // pattern of files to watch out for
   std::string watchFilePattern;
+  // profiling report file name and format (0: JSON, 1: Chrome trace)
+  std::string profileFileName;
+  int profileFormat;
   // show tootips in the GUI?
   int tooltips;
   // enable input field scrolling (moving the mouse to change numbers)
@@ -295,6 +299,8 @@ public:
     int combineTime, combineRemoveOrig, combineCopyOptions;
     int fileFormat, plugins, forceNodeData, forceElementData;
     int saveMesh, saveInterpolationMatrices;
+    int streamChunkSize, streamCompression, streamIncremental;
+    int streamQuantization;
     double animDelay;
     std::string doubleClickedGraphPointCommand;
     double doubleClickedGraphPointX, doubleClickedGraphPointY;
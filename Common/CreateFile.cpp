@@ -278,6 +278,8 @@ void CreateOutputFile(const std::string &fileName, int format,
   std::string name = fileName;
   if(name.empty()) name = GetDefaultFileName(format);
 
+  MsgProfileSection prof("Write '%s'", name.c_str());
+
   int oldFormat = CTX::instance()->print.fileFormat;
   CTX::instance()->print.fileFormat = format;
   CTX::instance()->printing = 1;
@@ -303,8 +305,9 @@ void CreateOutputFile(const std::string &fileName, int format,
     break;
 
   case FORMAT_MSH:
-    if(GModel::current()->getNumPartitions() &&
-       CTX::instance()->mesh.partitionSplitMeshFiles){
+    if((GModel::current()->getNumPartitions() &&
+        CTX::instance()->mesh.partitionSplitMeshFiles) ||
+       GModel::current()->getNumStreamPartitions()){
       std::vector<std::string> splitName = SplitFileName(name);
       splitName[0] += splitName[1];
       GModel::current()->writePartitionedMSH
@@ -80,6 +80,11 @@ StringXString GeneralOptions_String[] = {
 #endif
     "Option file created with `Tools->Options->Save'; automatically read on startup" },
 
+  { F, "ProfileFileName" , opt_general_profile_filename , "" ,
+    "File where the profiling report (wall and CPU times, memory usage and "
+    "counters of the nested meshing, optimization, input/output and plugin "
+    "sections) is written when Gmsh exits; profiling is disabled if empty" },
+
   { F|S, "RecentFile0", opt_general_recent_file0 , "untitled.geo" ,
     "Most recent opened file"},
   { F|S, "RecentFile1", opt_general_recent_file1 , "untitled.geo" ,
@@ -733,6 +738,9 @@ StringXNumber GeneralOptions_Number[] = {
     "Polygon offset factor (offset = factor * DZ + r * units)" },
   { F|O, "PolygonOffsetUnits" , opt_general_polygon_offset_units , 1. ,
     "Polygon offset units (offset = factor * DZ + r * units)" },
+  { F|O, "ProfileFormat" , opt_general_profile_format , 0. ,
+    "Format of the profiling report (0: hierarchical JSON report, 1: Chrome "
+    "trace event format)" },
   { F|O, "ProgressMeterStep" , opt_general_progress_meter_step , 10. ,
     "Increment (in percent) of the progress meter bar" },
 
@@ -912,6 +920,9 @@ StringXNumber GeometryOptions_Number[] = {
   { F|O, "OCCFixSmallFaces" , opt_geometry_occ_fix_small_faces , 0. ,
     "Fix small faces when importing STEP, IGES and BRep models with the "
     "OpenCASCADE kernel" },
+  { F|O, "OCCFragmentsClustering" , opt_geometry_occ_fragments_clustering , 0. ,
+    "Perform OpenCASCADE boolean fragments independently (and in parallel if "
+    "OpenMP is enabled) on clusters of shapes with overlapping bounding boxes" },
   { F|O, "OCCImportLabels" , opt_geometry_occ_import_labels , 1. ,
     "Import labels and colors when importing STEP models with the OpenCASCADE kernel" },
   { F|O, "OCCMakeSolids" , opt_geometry_occ_make_solids , 0. ,
@@ -924,6 +935,14 @@ StringXNumber GeometryOptions_Number[] = {
     "OpenCASCADE kernel" },
   { F|O, "OCCSewFaces" , opt_geometry_occ_sew_faces , 0. ,
     "Sew faces when importing STEP, IGES and BRep models with the OpenCASCADE kernel" },
+  { F|O, "OCCSyncIncremental" , opt_geometry_occ_sync_incremental , 0. ,
+    "Only import the OpenCASCADE entities created since the last synchronization "
+    "into the model, if the model has not been modified otherwise in the meantime" },
+  { F|O, "OCCTessellationCache" , opt_geometry_occ_tessellation_cache , 0. ,
+    "Cache the tessellation of STEP and IGES models imported with the OpenCASCADE "
+    "kernel in a BRep file stored alongside the original file, and reuse it on "
+    "subsequent imports of the same (unmodified) file with the same import, "
+    "healing and tessellation options" },
   { F|O, "OCCThruSectionsDegree" , opt_geometry_occ_thrusections_degree , -1. ,
     "Maximum degree of surfaces generated by thrusections with the OpenCASCADE kernel, "
     "if not explicitely specified (default OCC value if negative)" },
@@ -1114,6 +1133,10 @@ StringXNumber MeshOptions_Number[] = {
     "3: elastic, 4: fast curving)" },
   { F|O, "HighOrderPassMax", opt_mesh_ho_pass_max, 25,
     "Maximum number of high-order optimization passes (moving barrier)"},
+  { F|O, "HighOrderPatchStrategy", opt_mesh_ho_patch_strategy, 0,
+    "Strategy for building and optimizing the patches around invalid elements in "
+    "the high-order optimizer (0: disjoint strong, 1: adaptive one-by-one, 2: "
+    "disjoint weak, 3: adaptive concurrent)"},
   { F|O, "HighOrderPeriodic" , opt_mesh_ho_periodic , 0.,
     "Force location of nodes for periodic meshes using periodicity transform (0: "
     "assume identical parametrisations, 1: invert parametrisations, 2: compute "
@@ -1221,6 +1244,11 @@ StringXNumber MeshOptions_Number[] = {
     "elements connected to neighboring partitions by at least one node." },
   { F|O, "PartitionSplitMeshFiles" , opt_mesh_partition_split_mesh_files , 0 ,
     "Write one file for each mesh partition" },
+  { F|O, "PartitionStreamMeshFiles" , opt_mesh_partition_stream_mesh_files , 0 ,
+    "Only assign a partition to each element when partitioning the mesh, "
+    "without creating partition entities in the model, and write one MSH4 "
+    "file per partition (with partition boundaries and ghost cells) directly "
+    "from the element partitions, in parallel, when saving the mesh" },
   { F|O, "PartitionTopologyFile" , opt_mesh_partition_save_topology_file , 0 ,
     "Write a .pro file with the partition topology" },
   { F|O, "PartitionOldStyleMsh2" , opt_mesh_partition_old_style_msh2 , 1 ,
@@ -1337,6 +1365,10 @@ StringXNumber MeshOptions_Number[] = {
     "Number of refinement steps in the MeshAdapt-based 2D algorithms" },
   { F|O, "Renumber" , opt_mesh_renumber , 1 ,
     "Renumber nodes and elements in a continuous sequence after mesh generation" },
+  { F|O, "Reorder" , opt_mesh_reorder , 0 ,
+    "Reorder nodes and elements of surfaces and volumes before renumbering them, "
+    "to improve memory locality (0: none, 1: Hilbert curve, 2: Morton curve, "
+    "3: reverse Cuthill-McKee)" },
 
   { F,   "SaveAll" , opt_mesh_save_all , 0. ,
     "Save all elements, even if they don't belong to physical groups (for some "
@@ -1513,6 +1545,18 @@ StringXNumber PostProcessingOptions_Number[] = {
     "Save the mesh when exporting model-based data" },
   { F|O, "Smoothing" , opt_post_smooth , 0. ,
     "Apply (non-reversible) smoothing to post-processing view when merged" },
+  { F|O, "StreamChunkSize" , opt_post_stream_chunk_size , 0. ,
+    "Maximum number of elements per vertex array message sent by a remote "
+    "Gmsh server, for progressive display (0: send each array at once)" },
+  { F|O, "StreamCompression" , opt_post_stream_compression , 0. ,
+    "Zlib compression level (0-9) of the vertex arrays sent by a remote Gmsh "
+    "server (0: no compression)" },
+  { F|O, "StreamIncremental" , opt_post_stream_incremental , 0. ,
+    "Only send the colors of vertex arrays whose geometry did not change "
+    "(e.g. between time steps) from a remote Gmsh server" },
+  { F|O, "StreamQuantization" , opt_post_stream_quantization , 0. ,
+    "Quantize the node coordinates of the vertex arrays sent by a remote Gmsh "
+    "server on 16 bits" },
 
   { 0, 0 , 0 , 0. }
 } ;
@@ -241,6 +241,13 @@ int GmshWriteFile(const std::string &fileName)
 
 int GmshFinalize()
 {
+  // write the profiling report, if any, and reset the profiling data so that
+  // subsequent runs (e.g. through the API) start from scratch
+  if(Msg::GetProfiling())
+    Msg::WriteProfile(CTX::instance()->profileFileName,
+                      CTX::instance()->profileFormat);
+  Msg::ResetProfile();
+
 #if defined(HAVE_POST)
   // Delete all PViewData stored in static list of PView class
   while(PView::list.size() > 0) delete PView::list[PView::list.size() - 1];
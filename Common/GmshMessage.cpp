@@ -20,7 +20,9 @@
 #include <string.h>
 #include <time.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include "GmshMessage.h"
+#include "GmshVersion.h"
 #include "GmshSocket.h"
 #include "GmshGlobal.h"
 #include "GModel.h"
@@ -851,6 +853,221 @@ void Msg::PrintTimers()
   }
 }
 
+// profiling data: each thread records its sections in the order in which they
+// are opened, with the index of their parent section; the data of all threads
+// is only accessed concurrently when a new thread registers itself
+struct profileSection {
+  std::string name;
+  int parent;
+  double wallStart, wall, cpuStart, cpu;
+  long mem;
+  std::map<std::string, double> counters;
+};
+
+struct profileThread {
+  int id;
+  std::vector<profileSection> sections;
+  std::vector<int> open;
+  std::map<std::string, double> counters; // counters outside of any section
+};
+
+static std::vector<profileThread *> profileThreads;
+static thread_local profileThread *profileCurrent = nullptr;
+
+static profileThread *getProfileThread()
+{
+  if(!profileCurrent) {
+    profileThread *t = new profileThread();
+#if defined(_OPENMP)
+#pragma omp critical(MsgProfile)
+#endif
+    {
+      t->id = profileThreads.size();
+      profileThreads.push_back(t);
+    }
+    profileCurrent = t;
+  }
+  return profileCurrent;
+}
+
+bool Msg::GetProfiling()
+{
+  return !CTX::instance()->profileFileName.empty();
+}
+
+void Msg::StartProfileSection(const std::string &name)
+{
+  profileThread *t = getProfileThread();
+  profileSection s;
+  s.name = name;
+  s.parent = t->open.empty() ? -1 : t->open.back();
+  s.wallStart = TimeOfDay();
+  s.cpuStart = Cpu();
+  s.wall = s.cpu = 0.;
+  s.mem = 0;
+  t->open.push_back(t->sections.size());
+  t->sections.push_back(s);
+}
+
+void Msg::StopProfileSection()
+{
+  profileThread *t = getProfileThread();
+  if(t->open.empty()) return;
+  profileSection &s = t->sections[t->open.back()];
+  t->open.pop_back();
+  s.wall = TimeOfDay() - s.wallStart;
+  s.cpu = Cpu() - s.cpuStart;
+  s.mem = GetMemoryUsage();
+}
+
+void Msg::ProfileCount(const char *counter, double value)
+{
+  if(!GetProfiling()) return;
+  profileThread *t = getProfileThread();
+  if(t->open.empty())
+    t->counters[counter] += value;
+  else
+    t->sections[t->open.back()].counters[counter] += value;
+}
+
+void Msg::ResetProfile()
+{
+  for(std::size_t i = 0; i < profileThreads.size(); i++) {
+    profileThreads[i]->sections.clear();
+    profileThreads[i]->open.clear();
+    profileThreads[i]->counters.clear();
+  }
+}
+
+static std::string profileString(const std::string &str)
+{
+  std::string out = "\"";
+  for(std::size_t i = 0; i < str.size(); i++) {
+    if(str[i] == '"' || str[i] == '\\') out += '\\';
+    if(str[i] == '\n') { out += "\\n"; continue; }
+    out += str[i];
+  }
+  return out + "\"";
+}
+
+static void writeProfileCounters(FILE *fp,
+                                 const std::map<std::string, double> &c)
+{
+  fprintf(fp, "{");
+  for(std::map<std::string, double>::const_iterator it = c.begin();
+      it != c.end(); it++)
+    fprintf(fp, "%s%s: %.16g", (it == c.begin()) ? "" : ", ",
+            profileString(it->first).c_str(), it->second);
+  fprintf(fp, "}");
+}
+
+// write the sections with the given indices as an aggregated tree: sibling
+// sections with the same name are merged, and their children are merged
+// recursively
+static void writeProfileTree(FILE *fp, const profileThread *t,
+                             const std::vector<std::vector<int> > &children,
+                             const std::vector<int> &sections,
+                             const std::string &indent)
+{
+  std::vector<std::string> names;
+  std::map<std::string, std::vector<int> > groups;
+  for(std::size_t i = 0; i < sections.size(); i++) {
+    const std::string &name = t->sections[sections[i]].name;
+    if(!groups.count(name)) names.push_back(name);
+    groups[name].push_back(sections[i]);
+  }
+  fprintf(fp, "[");
+  for(std::size_t i = 0; i < names.size(); i++) {
+    const std::vector<int> &group = groups[names[i]];
+    double wall = 0., cpu = 0.;
+    long mem = 0;
+    std::map<std::string, double> counters;
+    std::vector<int> sub;
+    for(std::size_t j = 0; j < group.size(); j++) {
+      const profileSection &s = t->sections[group[j]];
+      wall += s.wall;
+      cpu += s.cpu;
+      mem = std::max(mem, s.mem);
+      for(std::map<std::string, double>::const_iterator it =
+            s.counters.begin();
+          it != s.counters.end(); it++)
+        counters[it->first] += it->second;
+      sub.insert(sub.end(), children[group[j]].begin(),
+                 children[group[j]].end());
+    }
+    fprintf(fp, "%s\n%s  {\"name\": %s, \"calls\": %d, \"wall\": %g, "
+            "\"cpu\": %g, \"memory\": %ld,\n%s   \"counters\": ",
+            i ? "," : "", indent.c_str(), profileString(names[i]).c_str(),
+            (int)group.size(), wall, cpu, mem, indent.c_str());
+    writeProfileCounters(fp, counters);
+    fprintf(fp, ",\n%s   \"sections\": ", indent.c_str());
+    writeProfileTree(fp, t, children, sub, indent + "   ");
+    fprintf(fp, "}");
+  }
+  fprintf(fp, "%s]", names.empty() ? "" : ("\n" + indent).c_str());
+}
+
+bool Msg::WriteProfile(const std::string &fileName, int format)
+{
+  FILE *fp = Fopen(fileName.c_str(), "w");
+  if(!fp) {
+    Msg::Error("Unable to open file '%s'", fileName.c_str());
+    return false;
+  }
+
+  if(format == 1) {
+    // Chrome trace event format (complete events, with times in microseconds),
+    // which can be loaded e.g. in chrome://tracing or https://ui.perfetto.dev
+    fprintf(fp, "{\"traceEvents\": [");
+    bool first = true;
+    for(std::size_t i = 0; i < profileThreads.size(); i++) {
+      const profileThread *t = profileThreads[i];
+      for(std::size_t j = 0; j < t->sections.size(); j++) {
+        const profileSection &s = t->sections[j];
+        fprintf(fp, "%s\n {\"name\": %s, \"cat\": \"gmsh\", \"ph\": \"X\", "
+                "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %d, "
+                "\"args\": {\"cpu\": %g, \"memory\": %ld, \"counters\": ",
+                first ? "" : ",", profileString(s.name).c_str(),
+                1.e6 * (s.wallStart - _startTime), 1.e6 * s.wall,
+                GetCommRank(), t->id, s.cpu, s.mem);
+        writeProfileCounters(fp, s.counters);
+        fprintf(fp, "}}");
+        first = false;
+      }
+    }
+    fprintf(fp, "\n], \"displayTimeUnit\": \"ms\"}\n");
+  }
+  else {
+    // hierarchical JSON report, with one aggregated section tree per thread
+    fprintf(fp, "{\"version\": %s, \"wall\": %g, \"cpu\": %g, "
+            "\"memory\": %ld, \"threads\": [",
+            profileString(GMSH_VERSION).c_str(), TimeOfDay() - _startTime,
+            Cpu(), GetMemoryUsage());
+    for(std::size_t i = 0; i < profileThreads.size(); i++) {
+      const profileThread *t = profileThreads[i];
+      std::vector<std::vector<int> > children(t->sections.size());
+      std::vector<int> roots;
+      for(std::size_t j = 0; j < t->sections.size(); j++) {
+        if(t->sections[j].parent < 0)
+          roots.push_back(j);
+        else
+          children[t->sections[j].parent].push_back(j);
+      }
+      fprintf(fp, "%s\n {\"thread\": %d, \"counters\": ", i ? "," : "",
+              t->id);
+      writeProfileCounters(fp, t->counters);
+      fprintf(fp, ",\n  \"sections\": ");
+      writeProfileTree(fp, t, children, roots, "  ");
+      fprintf(fp, "}");
+    }
+    fprintf(fp, "\n]}\n");
+  }
+
+  fclose(fp);
+  Msg::Info("Wrote profiling report '%s'", fileName.c_str());
+  return true;
+}
+
 void Msg::ResetErrorCounter()
 {
   _warningCount = 0; _errorCount = 0;
@@ -1627,6 +1844,23 @@ int Msg::GetThreadNum(){ return 0; }
 
 #endif
 
+MsgProfileSection::MsgProfileSection(const char *fmt, ...) : _active(false)
+{
+  if(!Msg::GetProfiling()) return;
+  char str[1024];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(str, sizeof(str), fmt, args);
+  va_end(args);
+  Msg::StartProfileSection(str);
+  _active = true;
+}
+
+MsgProfileSection::~MsgProfileSection()
+{
+  if(_active) Msg::StopProfileSection();
+}
+
 MsgProgressStatus::MsgProgressStatus(int num)
   : _totalElementToTreat(num), _currentI(0), _nextIToCheck(0),
     _initialTime(Cpu()), _lastTime(_initialTime), _lastPercentage(0),
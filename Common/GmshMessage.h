@@ -111,6 +111,12 @@ public:
   static void SetInfoMem(bool val);
   static double &Timer(const std::string &str);
   static void PrintTimers();
+  static bool GetProfiling();
+  static void StartProfileSection(const std::string &name);
+  static void StopProfileSection();
+  static void ProfileCount(const char *counter, double value = 1.);
+  static void ResetProfile();
+  static bool WriteProfile(const std::string &fileName, int format);
   static void ResetErrorCounter();
   static void PrintErrorCounter(const char *title);
   static int GetWarningCount();
@@ -172,6 +178,18 @@ public:
   static void ImportPhysicalGroupsInOnelab();
 };
 
+// a scoped profiling section, recording wall time, CPU time, memory usage and
+// counters between its construction and destruction if profiling is enabled
+// (i.e. if General.ProfileFileName is set); sections can be nested
+class MsgProfileSection {
+private:
+  bool _active;
+
+public:
+  MsgProfileSection(const char *fmt, ...);
+  ~MsgProfileSection();
+};
+
 // a class to print the progression and estimated remaining time
 class MsgProgressStatus {
 private:
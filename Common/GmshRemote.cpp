@@ -17,6 +17,8 @@
 #endif
 
 #include <sstream>
+#include <map>
+#include <algorithm>
 #include "GmshMessage.h"
 
 #if defined(HAVE_ONELAB) && defined(HAVE_POST)
@@ -24,6 +26,7 @@
 #include "onelab.h"
 #include "OpenFile.h"
 #include "OS.h"
+#include "Context.h"
 #include "VertexArray.h"
 #include "GmshRemote.h"
 #include "PView.h"
@@ -31,30 +34,85 @@
 #include "PViewData.h"
 #include "PViewDataRemote.h"
 
+// FNV-1a hash of the node coordinates and normals of a vertex array, used to
+// detect arrays whose geometry did not change since they were last sent
+template <class Iterator>
+static unsigned long long hashRange(Iterator first, Iterator last,
+                                    unsigned long long h)
+{
+  for(Iterator it = first; it != last; ++it) {
+    const unsigned char *c = (const unsigned char *)&(*it);
+    for(std::size_t i = 0; i < sizeof(*it); i++) {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+    }
+  }
+  return h;
+}
+
+static unsigned long long geometryHash(VertexArray *va)
+{
+  unsigned long long h = 14695981039346656037ULL;
+  h = hashRange(va->firstVertex(), va->lastVertex(), h);
+  return hashRange(va->firstNormal(), va->lastNormal(), h);
+}
+
+static void sendVertexArray(GmshClient *client, PView *p, VertexArray *va,
+                            int type)
+{
+  PViewData *data = p->getData();
+  PViewOptions *opt = p->getOptions();
+  double min = data->getMin(), max = data->getMax();
+  if(opt->rangeType == PViewOptions::PerTimeStep) {
+    min = data->getMin(opt->timeStep);
+    max = data->getMax(opt->timeStep);
+  }
+
+  int encoding = 0;
+  if(CTX::instance()->post.streamQuantization)
+    encoding |= VertexArray::Quantized;
+  if(CTX::instance()->post.streamCompression)
+    encoding |= VertexArray::Compressed;
+  if(CTX::instance()->post.streamIncremental) {
+    // only send the colors if the geometry is the same as in the last array
+    // sent for this view (e.g. when changing the time step)
+    static std::map<std::pair<int, int>, unsigned long long> sent;
+    std::pair<int, int> key(p->getTag(), type);
+    unsigned long long h = geometryHash(va);
+    std::map<std::pair<int, int>, unsigned long long>::iterator it =
+      sent.find(key);
+    if(it != sent.end() && it->second == h)
+      encoding |= VertexArray::ColorsOnly;
+    sent[key] = h;
+  }
+
+  // send large arrays in chunks, so that the client can display them
+  // progressively
+  int numElements = va->getNumVertices() / va->getNumVerticesPerElement();
+  int chunk = CTX::instance()->post.streamChunkSize;
+  if(chunk <= 0 || chunk > numElements) chunk = std::max(numElements, 1);
+  for(int first = 0; first < numElements || !first; first += chunk) {
+    int len;
+    char *str = va->toChar(p->getTag(), data->getName(), type, min, max,
+                           data->getNumTimeSteps(),
+                           data->getTime(opt->timeStep),
+                           data->getBoundingBox(), len,
+                           first ? (encoding | VertexArray::Append) : encoding,
+                           first, chunk);
+    client->SendMessage(GmshSocket::GMSH_VERTEX_ARRAY, len, str);
+    delete[] str;
+  }
+}
+
 static void computeAndSendVertexArrays(GmshClient *client, bool compute = true)
 {
   for(std::size_t i = 0; i < PView::list.size(); i++) {
     PView *p = PView::list[i];
     if(compute) p->fillVertexArrays();
-    PViewData *data = p->getData();
-    PViewOptions *opt = p->getOptions();
-    double min = data->getMin(), max = data->getMax();
-    if(opt->rangeType == PViewOptions::PerTimeStep) {
-      min = data->getMin(opt->timeStep);
-      max = data->getMax(opt->timeStep);
-    }
     VertexArray *va[4] = {p->va_points, p->va_lines, p->va_triangles,
                           p->va_vectors};
     for(int type = 0; type < 4; type++) {
-      if(va[type]) {
-        int len;
-        char *str = va[type]->toChar(p->getTag(), data->getName(), type + 1,
-                                     min, max, data->getNumTimeSteps(),
-                                     data->getTime(opt->timeStep),
-                                     data->getBoundingBox(), len);
-        client->SendMessage(GmshSocket::GMSH_VERTEX_ARRAY, len, str);
-        delete[] str;
-      }
+      if(va[type]) sendVertexArray(client, p, va[type], type + 1);
     }
   }
 }
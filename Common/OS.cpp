@@ -332,7 +332,7 @@ static void GetResources(double *s, long *mem)
   GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info));
   *mem = (long)info.PeakWorkingSetSize;
 #else
-  static struct rusage r;
+  struct rusage r;
   getrusage(RUSAGE_SELF, &r);
   *s = (double)r.ru_utime.tv_sec + 1.e-6 * (double)r.ru_utime.tv_usec;
 #if defined(__APPLE__)
@@ -503,6 +503,20 @@ int StatFile(const std::string &fileName)
   return ret;
 }
 
+double GetFileModificationTime(const std::string &fileName)
+{
+#if defined(WIN32) && !defined(__CYGWIN__)
+  struct _stat buf;
+  setwbuf(0, fileName.c_str());
+  int ret = _wstat(wbuf[0], &buf);
+#else
+  struct stat buf;
+  int ret = stat(fileName.c_str(), &buf);
+#endif
+  if(ret) return -1.;
+  return (double)buf.st_mtime;
+}
+
 int CreateSingleDir(const std::string &dirName)
 {
 #if defined(WIN32) && !defined(__CYGWIN__)
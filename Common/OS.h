@@ -24,6 +24,7 @@ std::string GetAbsolutePath(const std::string &fileName);
 std::string GetHostName();
 int UnlinkFile(const std::string &fileName);
 int StatFile(const std::string &fileName);
+double GetFileModificationTime(const std::string &fileName);
 int KillProcess(int pid);
 int CreateSingleDir(const std::string &dirName);
 void CreatePath(const std::string &fullPath);
@@ -299,6 +299,8 @@ int MergeFile(const std::string &fileName, bool warnIfMissing,
               bool setBoundingBox, bool importPhysicalsInOnelab,
               int partitionToRead)
 {
+  MsgProfileSection prof("Read '%s'", fileName.c_str());
+
   // added 'b' for pure Windows programs, since some of these files
   // contain binary data
   FILE *fp = Fopen(fileName.c_str(), "rb");
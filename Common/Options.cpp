@@ -1306,6 +1306,12 @@ std::string opt_general_watch_file_pattern(OPT_ARGS_STR)
   return CTX::instance()->watchFilePattern;
 }
 
+std::string opt_general_profile_filename(OPT_ARGS_STR)
+{
+  if(action & GMSH_SET) CTX::instance()->profileFileName = val;
+  return CTX::instance()->profileFileName;
+}
+
 std::string opt_general_gui_theme(OPT_ARGS_STR)
 {
   if(action & GMSH_SET) CTX::instance()->guiTheme = val;
@@ -2227,6 +2233,12 @@ double opt_general_polygon_offset_units(OPT_ARGS_NUM)
   return CTX::instance()->polygonOffsetUnits;
 }
 
+double opt_general_profile_format(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->profileFormat = (int)val;
+  return CTX::instance()->profileFormat;
+}
+
 double opt_general_graphics_position0(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET) CTX::instance()->glPosition[0] = (int)val;
@@ -4660,6 +4672,27 @@ double opt_geometry_occ_parallel(OPT_ARGS_NUM)
   return CTX::instance()->geom.occParallel;
 }
 
+double opt_geometry_occ_fragments_clustering(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET)
+    CTX::instance()->geom.occFragmentsClustering = (int)val;
+  return CTX::instance()->geom.occFragmentsClustering;
+}
+
+double opt_geometry_occ_sync_incremental(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET)
+    CTX::instance()->geom.occSyncIncremental = (int)val;
+  return CTX::instance()->geom.occSyncIncremental;
+}
+
+double opt_geometry_occ_tessellation_cache(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET)
+    CTX::instance()->geom.occTessellationCache = (int)val;
+  return CTX::instance()->geom.occTessellationCache;
+}
+
 double opt_geometry_occ_boolean_preserve_numbering(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET)
@@ -4877,6 +4910,16 @@ double opt_mesh_renumber(OPT_ARGS_NUM)
   return CTX::instance()->mesh.renumber;
 }
 
+double opt_mesh_reorder(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) {
+    int method = (int)val;
+    if(method < 0 || method > 3) method = 0;
+    CTX::instance()->mesh.reorder = method;
+  }
+  return CTX::instance()->mesh.reorder;
+}
+
 double opt_mesh_normals(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET) { CTX::instance()->mesh.normals = val; }
@@ -5662,6 +5705,13 @@ double opt_mesh_partition_split_mesh_files(OPT_ARGS_NUM)
   return CTX::instance()->mesh.partitionSplitMeshFiles;
 }
 
+double opt_mesh_partition_stream_mesh_files(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET)
+    CTX::instance()->mesh.partitionStreamMeshFiles = (int)val;
+  return CTX::instance()->mesh.partitionStreamMeshFiles;
+}
+
 double opt_mesh_partition_save_topology_file(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET)
@@ -6137,6 +6187,12 @@ double opt_mesh_ho_pass_max(OPT_ARGS_NUM)
   return CTX::instance()->mesh.hoPassMax;
 }
 
+double opt_mesh_ho_patch_strategy(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->mesh.hoPatchStrategy = (int)val;
+  return CTX::instance()->mesh.hoPatchStrategy;
+}
+
 double opt_mesh_ho_poisson(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET) {
@@ -6744,6 +6800,36 @@ double opt_post_save_interpolation_matrices(OPT_ARGS_NUM)
   return CTX::instance()->post.saveInterpolationMatrices;
 }
 
+double opt_post_stream_chunk_size(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET)
+    CTX::instance()->post.streamChunkSize = (val > 0) ? (int)val : 0;
+  return CTX::instance()->post.streamChunkSize;
+}
+
+double opt_post_stream_compression(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) {
+    CTX::instance()->post.streamCompression = (int)val;
+    if(CTX::instance()->post.streamCompression < 0 ||
+       CTX::instance()->post.streamCompression > 9)
+      CTX::instance()->post.streamCompression = 0;
+  }
+  return CTX::instance()->post.streamCompression;
+}
+
+double opt_post_stream_incremental(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->post.streamIncremental = (int)val;
+  return CTX::instance()->post.streamIncremental;
+}
+
+double opt_post_stream_quantization(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->post.streamQuantization = (int)val;
+  return CTX::instance()->post.streamQuantization;
+}
+
 double opt_post_double_clicked_graph_point_x(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET) CTX::instance()->post.doubleClickedGraphPointX = val;
@@ -5,12 +5,17 @@
 
 #include <string.h>
 #include <algorithm>
+#include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "VertexArray.h"
 #include "Context.h"
 #include "Numeric.h"
 #include "OS.h"
 
+#if defined(HAVE_LIBZ)
+#include <zlib.h>
+#endif
+
 template<int N> float ElementDataLessThan<N>::tolerance = 0.0F;
 float BarycenterLessThan::tolerance = 0.0F;
 
@@ -231,26 +236,103 @@ void VertexArray::sort(double x, double y, double z)
   _colors = sortedColors;
 }
 
+static void appendBytes(std::vector<char> &bytes, const void *data,
+                        std::size_t size)
+{
+  if(!size) return;
+  const char *c = (const char *)data;
+  bytes.insert(bytes.end(), c, c + size);
+}
+
 char *VertexArray::toChar(int num, const std::string &name, int type,
                           double min, double max, int numsteps, double time,
-                          const SBoundingBox3d &bbox, int &len)
+                          const SBoundingBox3d &bbox, int &len, int encoding,
+                          int firstElement, int numElements)
 {
-  int vn = _vertices.size(), nn = _normals.size(), cn = _colors.size();
-  int vs = vn * sizeof(float),
-      ns = nn * sizeof(normal_type),
-      cs = cn * sizeof(unsigned char);
+  // range of vertices to serialize
+  int nv = getNumVertices();
+  int ne = nv / _numVerticesPerElement;
+  if(firstElement < 0) firstElement = 0;
+  if(firstElement > ne) firstElement = ne;
+  if(numElements < 0 || firstElement + numElements > ne)
+    numElements = ne - firstElement;
+  bool all = (firstElement == 0 && numElements == ne);
+  int v0 = firstElement * _numVerticesPerElement;
+  int v1 = v0 + numElements * _numVerticesPerElement;
+
+  // normals and colors can only be split if they are given for all vertices
+  int vn = 3 * (v1 - v0), nn = 0, cn = 0, n0 = 0, c0 = 0;
+  if((int)_normals.size() == 3 * nv) { nn = 3 * (v1 - v0); n0 = 3 * v0; }
+  else if(all) nn = _normals.size();
+  if((int)_colors.size() == 4 * nv) { cn = 4 * (v1 - v0); c0 = 4 * v0; }
+  else if(all) cn = _colors.size();
+  if(encoding & ColorsOnly) vn = nn = 0;
+
   int is = sizeof(int), ds = sizeof(double);
+  std::vector<char> data;
+  data.reserve(3 * is + vn * sizeof(float) + nn * sizeof(normal_type) +
+               cn * sizeof(unsigned char));
+  appendBytes(data, &vn, is);
+  if(vn && (encoding & Quantized)) {
+    // store the coordinates on 16 bits, relative to their bounding box
+    float b[6] = {_vertices[3 * v0], _vertices[3 * v0 + 1],
+                  _vertices[3 * v0 + 2], _vertices[3 * v0],
+                  _vertices[3 * v0 + 1], _vertices[3 * v0 + 2]};
+    for(int i = 0; i < vn; i++) {
+      float x = _vertices[3 * v0 + i];
+      b[i % 3] = std::min(b[i % 3], x);
+      b[i % 3 + 3] = std::max(b[i % 3 + 3], x);
+    }
+    std::vector<unsigned short> q(vn);
+    for(int i = 0; i < vn; i++) {
+      float l = b[i % 3 + 3] - b[i % 3];
+      float x = _vertices[3 * v0 + i];
+      q[i] = l ? (unsigned short)((x - b[i % 3]) / l * 65535.f + 0.5f) : 0;
+    }
+    appendBytes(data, b, 6 * sizeof(float));
+    appendBytes(data, &q[0], vn * sizeof(unsigned short));
+  }
+  else if(vn) {
+    appendBytes(data, &_vertices[3 * v0], vn * sizeof(float));
+  }
+  appendBytes(data, &nn, is);
+  if(nn) appendBytes(data, &_normals[n0], nn * sizeof(normal_type));
+  appendBytes(data, &cn, is);
+  if(cn) appendBytes(data, &_colors[c0], cn * sizeof(unsigned char));
+
+  std::vector<char> zdata;
+  if(encoding & Compressed) {
+#if defined(HAVE_LIBZ)
+    int ls = data.size();
+    uLongf zlen = compressBound(ls);
+    zdata.resize(is + zlen);
+    memcpy(&zdata[0], &ls, is);
+    int level = CTX::instance()->post.streamCompression;
+    if(compress2((Bytef *)&zdata[is], &zlen, (const Bytef *)&data[0], ls,
+                 level ? level : Z_DEFAULT_COMPRESSION) == Z_OK &&
+       is + (int)zlen < ls) {
+      zdata.resize(is + zlen);
+      data.swap(zdata);
+    }
+    else
+      encoding &= ~Compressed;
+#else
+    encoding &= ~Compressed;
+#endif
+  }
+
   int ss = name.size();
+  int t = type | (encoding << 8);
   double xmin = bbox.min().x(), ymin = bbox.min().y(), zmin = bbox.min().z();
   double xmax = bbox.max().x(), ymax = bbox.max().y(), zmax = bbox.max().z();
 
-  len = ss + 7 * is + 9 * ds + vs + ns + cs;
+  len = ss + 4 * is + 9 * ds + data.size();
   char *bytes = new char[len];
   int index = 0;
   memcpy(&bytes[index], &num, is); index += is;
   memcpy(&bytes[index], &ss, is); index += is;
   memcpy(&bytes[index], name.c_str(), ss); index += ss;
-  memcpy(&bytes[index], &type, is); index += is;
+  memcpy(&bytes[index], &t, is); index += is;
   memcpy(&bytes[index], &min, ds); index += ds;
   memcpy(&bytes[index], &max, ds); index += ds;
   memcpy(&bytes[index], &numsteps, is); index += is;
@@ -261,12 +343,7 @@ char *VertexArray::toChar(int num, const std::string &name, int type,
   memcpy(&bytes[index], &xmax, ds); index += ds;
   memcpy(&bytes[index], &ymax, ds); index += ds;
   memcpy(&bytes[index], &zmax, ds); index += ds;
-  memcpy(&bytes[index], &vn, is); index += is;
-  if(vs){ memcpy(&bytes[index], &_vertices[0], vs); index += vs; }
-  memcpy(&bytes[index], &nn, is); index += is;
-  if(ns){ memcpy(&bytes[index], &_normals[0], ns); index += ns; }
-  memcpy(&bytes[index], &cn, is); index += is;
-  if(cs){ memcpy(&bytes[index], &_colors[0], cs); /* index += cs; */ }
+  memcpy(&bytes[index], &data[0], data.size()); /* index += data.size(); */
   return bytes;
 }
 
@@ -274,7 +351,8 @@ int VertexArray::decodeHeader(int length, const char *bytes, int swap,
                               std::string &name, int &tag, int &type,
                               double &min, double &max, int &numSteps, double &time,
                               double &xmin, double &ymin, double &zmin,
-                              double &xmax, double &ymax, double &zmax)
+                              double &xmax, double &ymax, double &zmax,
+                              int *encoding)
 {
   int is = sizeof(int), ds = sizeof(double);
 
@@ -297,6 +375,8 @@ int VertexArray::decodeHeader(int length, const char *bytes, int swap,
     for(std::size_t i = 0; i < n.size(); i++) name += n[i];
   }
   memcpy(&type, &bytes[index], is); index += is;
+  if(encoding) *encoding = type >> 8;
+  type &= 0xff;
   memcpy(&min, &bytes[index], ds); index += ds;
   memcpy(&max, &bytes[index], ds); index += ds;
   memcpy(&numSteps, &bytes[index], is); index += is;
@@ -313,30 +393,73 @@ int VertexArray::decodeHeader(int length, const char *bytes, int swap,
 void VertexArray::fromChar(int length, const char *bytes, int swap)
 {
   std::string name;
-  int tag, type, numSteps;
+  int tag, type, numSteps, encoding = 0;
   double min, max, time, xmin, ymin, zmin, xmax, ymax, zmax;
   int index = decodeHeader(length, bytes, swap, name, tag, type, min, max,
-                           numSteps, time, xmin, ymin, zmin, xmax, ymax, zmax);
+                           numSteps, time, xmin, ymin, zmin, xmax, ymax, zmax,
+                           &encoding);
   if(!index) return;
 
   int is = sizeof(int);
+  std::vector<char> data;
+  if(encoding & Compressed){
+#if defined(HAVE_LIBZ)
+    int ls; memcpy(&ls, &bytes[index], is); index += is;
+    data.resize(ls);
+    uLongf dlen = ls;
+    if(uncompress((Bytef *)&data[0], &dlen, (const Bytef *)&bytes[index],
+                  length - index) != Z_OK || (int)dlen != ls){
+      Msg::Error("Could not uncompress vertex array");
+      return;
+    }
+    bytes = &data[0];
+    index = 0;
+#else
+    Msg::Error("Gmsh must be compiled with zlib to uncompress vertex arrays");
+    return;
+#endif
+  }
+
+  if(!(encoding & Append)){
+    if(!(encoding & ColorsOnly)){
+      _vertices.clear();
+      _normals.clear();
+    }
+    _colors.clear();
+  }
+
   int vn; memcpy(&vn, &bytes[index], is); index += is;
   if(vn){
-    _vertices.resize(vn); int vs = vn * sizeof(float);
-    memcpy(&_vertices[0], &bytes[index], vs); index += vs;
+    std::size_t v0 = _vertices.size();
+    _vertices.resize(v0 + vn);
+    if(encoding & Quantized){
+      float b[6]; memcpy(b, &bytes[index], 6 * sizeof(float));
+      index += 6 * sizeof(float);
+      std::vector<unsigned short> q(vn);
+      memcpy(&q[0], &bytes[index], vn * sizeof(unsigned short));
+      index += vn * sizeof(unsigned short);
+      for(int i = 0; i < vn; i++)
+        _vertices[v0 + i] = b[i % 3] + (b[i % 3 + 3] - b[i % 3]) * q[i] / 65535.f;
+    }
+    else{
+      int vs = vn * sizeof(float);
+      memcpy(&_vertices[v0], &bytes[index], vs); index += vs;
+    }
   }
 
   int nn; memcpy(&nn, &bytes[index], is); index += is;
   if(nn){
-    _normals.resize(nn);
+    std::size_t n0 = _normals.size();
+    _normals.resize(n0 + nn);
     int ns = nn * sizeof(normal_type);
-    memcpy(&_normals[0], &bytes[index], ns); index += ns;
+    memcpy(&_normals[n0], &bytes[index], ns); index += ns;
   }
 
   int cn; memcpy(&cn, &bytes[index], is); index += is;
   if(cn){
-    _colors.resize(cn); int cs = cn * sizeof(unsigned char);
-    memcpy(&_colors[0], &bytes[index], cs); /* index += cs; */
+    std::size_t c0 = _colors.size();
+    _colors.resize(c0 + cn); int cs = cn * sizeof(unsigned char);
+    memcpy(&_colors[c0], &bytes[index], cs); /* index += cs; */
   }
 }
 
@@ -218,17 +218,24 @@ public:
   void sort(double x, double y, double z);
   // estimate the size of the vertex array in megabytes
   double getMemoryInMb();
+  // encoding flags of serialized vertex arrays (stored in the upper bits of
+  // the type): 16-bit quantized coordinates, zlib-compressed payload, data
+  // appended to the existing array (for chunked transfers), colors only (the
+  // coordinates and normals of the existing array are kept)
+  enum { Quantized = 1, Compressed = 2, Append = 4, ColorsOnly = 8 };
   // serialize the vertex array into a string (for sending over the
-  // network)
+  // network), possibly only numElements elements starting at firstElement
   char *toChar(int num, const std::string &name, int type, double min,
                double max, int numsteps, double time,
-               const SBoundingBox3d &bbox, int &len);
+               const SBoundingBox3d &bbox, int &len, int encoding = 0,
+               int firstElement = 0, int numElements = -1);
   void fromChar(int length, const char *bytes, int swap);
   static int decodeHeader(int length, const char *bytes, int swap,
                           std::string &name, int &tag, int &type, double &min,
                           double &max, int &numSteps, double &time,
                           double &xmin, double &ymin, double &zmin,
-                          double &xmax, double &ymax, double &zmax);
+                          double &xmax, double &ymax, double &zmax,
+                          int *encoding = 0);
   // merge another vertex array into this one
   void merge(VertexArray *va);
 };
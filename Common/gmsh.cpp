@@ -1258,18 +1258,9 @@ static void _getAdditionalNodesOnBoundary(GEntity *entity,
   }
 }
 
-GMSH_API void gmsh::model::mesh::getNodes(std::vector<std::size_t> &nodeTags,
-                                          std::vector<double> &coord,
-                                          std::vector<double> &parametricCoord,
-                                          const int dim, const int tag,
-                                          const bool includeBoundary,
-                                          const bool returnParametricCoord)
+static void _getEntities(const int dim, const int tag,
+                         std::vector<GEntity *> &entities)
 {
-  _checkInit();
-  nodeTags.clear();
-  coord.clear();
-  parametricCoord.clear();
-  std::vector<GEntity *> entities;
   if(dim >= 0 && tag >= 0) {
     GEntity *ge = GModel::current()->getEntityByTag(dim, tag);
     if(!ge) {
@@ -1281,24 +1272,158 @@ GMSH_API void gmsh::model::mesh::getNodes(std::vector<std::size_t> &nodeTags,
   else {
     GModel::current()->getEntities(entities, dim);
   }
-  for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++) {
-      MVertex *v = ge->mesh_vertices[j];
-      nodeTags.push_back(v->getNum());
-      coord.push_back(v->x());
-      coord.push_back(v->y());
-      coord.push_back(v->z());
-      if(dim > 0 && returnParametricCoord) {
+}
+
+// Nodes returned by getNodes when no parametric coordinates are requested:
+// their number is known in advance, so that they can be stored directly (and
+// in parallel) in arrays allocated by the caller
+struct _entityNodes {
+  std::vector<GEntity *> entities;
+  std::vector<std::size_t> offset;
+  std::vector<std::vector<std::size_t> > boundaryTags;
+  std::vector<std::vector<double> > boundaryCoord;
+};
+
+static std::size_t _getEntityNodes(const int dim, const int tag,
+                                   const bool includeBoundary,
+                                   _entityNodes &n)
+{
+  _getEntities(dim, tag, n.entities);
+  // the (few) nodes on the boundary of each entity are collected first
+  std::vector<double> parametricCoord;
+  n.offset.assign(n.entities.size() + 1, 0);
+  n.boundaryTags.resize(n.entities.size());
+  n.boundaryCoord.resize(n.entities.size());
+  for(std::size_t i = 0; i < n.entities.size(); i++) {
+    GEntity *ge = n.entities[i];
+    if(includeBoundary)
+      _getAdditionalNodesOnBoundary(ge, n.boundaryTags[i], n.boundaryCoord[i],
+                                    parametricCoord, false);
+    n.offset[i + 1] =
+      n.offset[i] + ge->mesh_vertices.size() + n.boundaryTags[i].size();
+  }
+  return n.offset.back();
+}
+
+static void _copyEntityNodes(const _entityNodes &n, std::size_t *nodeTags,
+                             double *coord)
+{
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    for(std::size_t i = 0; i < n.entities.size(); i++) {
+      GEntity *ge = n.entities[i];
+      const std::size_t N = ge->mesh_vertices.size();
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+      for(std::size_t j = 0; j < N; j++) {
+        MVertex *v = ge->mesh_vertices[j];
+        std::size_t idx = n.offset[i] + j;
+        nodeTags[idx] = v->getNum();
+        coord[3 * idx] = v->x();
+        coord[3 * idx + 1] = v->y();
+        coord[3 * idx + 2] = v->z();
+      }
+    }
+  }
+  for(std::size_t i = 0; i < n.entities.size(); i++) {
+    std::size_t idx = n.offset[i] + n.entities[i]->mesh_vertices.size();
+    std::copy(n.boundaryTags[i].begin(), n.boundaryTags[i].end(),
+              nodeTags + idx);
+    std::copy(n.boundaryCoord[i].begin(), n.boundaryCoord[i].end(),
+              coord + 3 * idx);
+  }
+}
+
+GMSH_API void gmsh::model::mesh::getNodes(std::vector<std::size_t> &nodeTags,
+                                          std::vector<double> &coord,
+                                          std::vector<double> &parametricCoord,
+                                          const int dim, const int tag,
+                                          const bool includeBoundary,
+                                          const bool returnParametricCoord)
+{
+  _checkInit();
+  nodeTags.clear();
+  coord.clear();
+  parametricCoord.clear();
+  if(dim > 0 && returnParametricCoord) {
+    // the number of parametric coordinates of each node is not known in
+    // advance
+    std::vector<GEntity *> entities;
+    _getEntities(dim, tag, entities);
+    for(std::size_t i = 0; i < entities.size(); i++) {
+      GEntity *ge = entities[i];
+      for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++) {
+        MVertex *v = ge->mesh_vertices[j];
+        nodeTags.push_back(v->getNum());
+        coord.push_back(v->x());
+        coord.push_back(v->y());
+        coord.push_back(v->z());
         double par;
         for(int k = 0; k < dim; k++) {
           if(v->getParameter(k, par)) parametricCoord.push_back(par);
         }
       }
+      if(includeBoundary)
+        _getAdditionalNodesOnBoundary(ge, nodeTags, coord, parametricCoord,
+                                      true);
     }
-    if(includeBoundary)
-      _getAdditionalNodesOnBoundary(ge, nodeTags, coord, parametricCoord,
-                                    dim > 0 && returnParametricCoord);
+    return;
+  }
+  _entityNodes n;
+  std::size_t numNodes = _getEntityNodes(dim, tag, includeBoundary, n);
+  if(!numNodes) return;
+  nodeTags.resize(numNodes);
+  coord.resize(3 * numNodes);
+  _copyEntityNodes(n, &nodeTags[0], &coord[0]);
+}
+
+// for better performance (and memory usage), manual C implementation of
+// gmsh::model::mesh::getNodes, which directly fills the returned arrays
+GMSH_API void gmshModelMeshGetNodes(size_t **nodeTags, size_t *nodeTags_n,
+                                    double **coord, size_t *coord_n,
+                                    double **parametricCoord,
+                                    size_t *parametricCoord_n, const int dim,
+                                    const int tag, const int includeBoundary,
+                                    const int returnParametricCoord, int *ierr)
+{
+  if(ierr) *ierr = 0;
+  try {
+    _checkInit();
+    *nodeTags_n = *coord_n = *parametricCoord_n = 0;
+    if(dim > 0 && returnParametricCoord) {
+      std::vector<std::size_t> api_nodeTags_;
+      std::vector<double> api_coord_, api_parametricCoord_;
+      gmsh::model::mesh::getNodes(api_nodeTags_, api_coord_,
+                                  api_parametricCoord_, dim, tag,
+                                  includeBoundary, returnParametricCoord);
+      *nodeTags =
+        (size_t *)gmshMalloc(api_nodeTags_.size() * sizeof(size_t));
+      std::copy(api_nodeTags_.begin(), api_nodeTags_.end(), *nodeTags);
+      *nodeTags_n = api_nodeTags_.size();
+      *coord = (double *)gmshMalloc(api_coord_.size() * sizeof(double));
+      std::copy(api_coord_.begin(), api_coord_.end(), *coord);
+      *coord_n = api_coord_.size();
+      *parametricCoord =
+        (double *)gmshMalloc(api_parametricCoord_.size() * sizeof(double));
+      std::copy(api_parametricCoord_.begin(), api_parametricCoord_.end(),
+                *parametricCoord);
+      *parametricCoord_n = api_parametricCoord_.size();
+      return;
+    }
+    _entityNodes n;
+    std::size_t numNodes = _getEntityNodes(dim, tag, includeBoundary, n);
+    *nodeTags = (size_t *)gmshMalloc(numNodes * sizeof(size_t));
+    *coord = (double *)gmshMalloc(3 * numNodes * sizeof(double));
+    *parametricCoord = (double *)gmshMalloc(0);
+    _copyEntityNodes(n, *nodeTags, *coord);
+    *nodeTags_n = numNodes;
+    *coord_n = 3 * numNodes;
+  }
+  catch(const std::string &api_error_) {
+    if(ierr) *ierr = 1;
   }
 }
 
@@ -1477,7 +1602,7 @@ GMSH_API void gmsh::model::mesh::addNodes(
       vv = new MVertex(x, y, z, ge, tag);
     ge->mesh_vertices.push_back(vv);
   }
-  GModel::current()->destroyMeshCaches();
+  GModel::current()->updateMeshCaches(ge);
 }
 
 GMSH_API void gmsh::model::mesh::reclassifyNodes()
@@ -1560,6 +1685,30 @@ _getEntitiesForElementTypes(int dim, int tag,
   }
 }
 
+// Get the elements of the given family type in the entities, restricted to the
+// range [begin, end) of their global index. The bulk mesh data getters loop
+// over this array in parallel (with General.NumThreads threads) when they are
+// called with a single task, and directly write into the preallocated output
+// arrays.
+static void _getElementsByType(const std::vector<GEntity *> &entities,
+                               int familyType, std::size_t begin,
+                               std::size_t end,
+                               std::vector<MElement *> &elements)
+{
+  elements.clear();
+  if(end <= begin) return;
+  elements.reserve(end - begin);
+  std::size_t o = 0;
+  for(std::size_t i = 0; i < entities.size() && o < end; i++) {
+    GEntity *ge = entities[i];
+    std::size_t n = ge->getNumMeshElementsByType(familyType);
+    std::size_t j = (begin > o) ? std::min(n, begin - o) : 0;
+    for(; j < n && o + j < end; j++)
+      elements.push_back(ge->getMeshElementByType(familyType, j));
+    o += n;
+  }
+}
+
 GMSH_API void gmsh::model::mesh::getElements(
   std::vector<int> &elementTypes,
   std::vector<std::vector<std::size_t> > &elementTags,
@@ -1781,7 +1930,7 @@ GMSH_API void gmsh::model::mesh::addElements(
 
   for(std::size_t i = 0; i < elementTypes.size(); i++)
     _addElements(dim, tag, ge, elementTypes[i], elementTags[i], nodeTags[i]);
-  GModel::current()->destroyMeshCaches();
+  GModel::current()->updateMeshCaches(ge);
 }
 
 GMSH_API void gmsh::model::mesh::addElementsByType(
@@ -1797,7 +1946,7 @@ GMSH_API void gmsh::model::mesh::addElementsByType(
     throw Msg::GetLastError();
   }
   _addElements(dim, tag, ge, elementType, elementTags, nodeTags);
-  GModel::current()->destroyMeshCaches();
+  GModel::current()->updateMeshCaches(ge);
 }
 
 GMSH_API void gmsh::model::mesh::getElementTypes(std::vector<int> &elementTypes,
@@ -1863,27 +2012,64 @@ GMSH_API void gmsh::model::mesh::getElementProperties(
     ElementType::getNumVertices(ElementType::getPrimaryType(elementType));
 }
 
-GMSH_API void gmsh::model::mesh::getElementsByType(
-  const int elementType, std::vector<std::size_t> &elementTags,
-  std::vector<std::size_t> &nodeTags, const int tag, const std::size_t task,
-  const std::size_t numTasks)
+// Get the elements of type elementType handled by the task, their total number
+// and the index of the first one
+static void _getElementsByTypeForTask(const int elementType, const int tag,
+                                      const std::size_t task,
+                                      const std::size_t numTasks,
+                                      std::vector<MElement *> &elements,
+                                      std::size_t &numElements,
+                                      std::size_t &begin)
 {
-  _checkInit();
   int dim = ElementType::getDimension(elementType);
   std::map<int, std::vector<GEntity *> > typeEnt;
   _getEntitiesForElementTypes(dim, tag, typeEnt);
   const std::vector<GEntity *> &entities(typeEnt[elementType]);
   int familyType = ElementType::getParentType(elementType);
-  std::size_t numElements = 0;
+  numElements = 0;
   for(std::size_t i = 0; i < entities.size(); i++)
     numElements += entities[i]->getNumMeshElementsByType(familyType);
-  const int numNodes = ElementType::getNumVertices(elementType);
   if(!numTasks) {
     Msg::Error("Number of tasks should be > 0");
     throw Msg::GetLastError();
   }
-  const std::size_t begin = (task * numElements) / numTasks;
+  begin = (task * numElements) / numTasks;
   const std::size_t end = ((task + 1) * numElements) / numTasks;
+  _getElementsByType(entities, familyType, begin, end, elements);
+}
+
+static void _copyElementsByType(const std::vector<MElement *> &elements,
+                                const std::size_t begin, const int numNodes,
+                                std::size_t *elementTags,
+                                std::size_t *nodeTags, const bool parallel)
+{
+  const std::size_t N = elements.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(parallel)
+#endif
+  for(std::size_t i = 0; i < N; i++) {
+    MElement *e = elements[i];
+    if(elementTags) elementTags[begin + i] = e->getNum();
+    if(nodeTags) {
+      std::size_t idx = (begin + i) * numNodes;
+      for(std::size_t k = 0; k < e->getNumVertices(); k++) {
+        nodeTags[idx + k] = e->getVertex(k)->getNum();
+      }
+    }
+  }
+}
+
+GMSH_API void gmsh::model::mesh::getElementsByType(
+  const int elementType, std::vector<std::size_t> &elementTags,
+  std::vector<std::size_t> &nodeTags, const int tag, const std::size_t task,
+  const std::size_t numTasks)
+{
+  _checkInit();
+  std::vector<MElement *> elements;
+  std::size_t numElements, begin;
+  _getElementsByTypeForTask(elementType, tag, task, numTasks, elements,
+                            numElements, begin);
+  const int numNodes = ElementType::getNumVertices(elementType);
   // check arrays
   bool haveElementTags = elementTags.size();
   bool haveNodeTags = nodeTags.size();
@@ -1905,22 +2091,43 @@ GMSH_API void gmsh::model::mesh::getElementsByType(
                numElements * numNodes);
     throw Msg::GetLastError();
   }
-  size_t o = 0;
-  size_t idx = begin * numNodes;
-  for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType); j++) {
-      if(o >= begin && o < end) {
-        MElement *e = ge->getMeshElementByType(familyType, j);
-        if(haveElementTags) elementTags[o] = e->getNum();
-        if(haveNodeTags) {
-          for(std::size_t k = 0; k < e->getNumVertices(); k++) {
-            nodeTags[idx++] = e->getVertex(k)->getNum();
-          }
-        }
-      }
-      o++;
+  if(elements.empty()) return;
+  _copyElementsByType(elements, begin, numNodes,
+                      haveElementTags ? &elementTags[0] : 0,
+                      haveNodeTags ? &nodeTags[0] : 0, numTasks == 1);
+}
+
+// for better performance (and memory usage), manual C implementation of
+// gmsh::model::mesh::getElementsByType, which directly fills the returned
+// arrays
+GMSH_API void gmshModelMeshGetElementsByType(
+  const int elementType, size_t **elementTags, size_t *elementTags_n,
+  size_t **nodeTags, size_t *nodeTags_n, const int tag, const size_t task,
+  const size_t numTasks, int *ierr)
+{
+  if(ierr) *ierr = 0;
+  try {
+    _checkInit();
+    std::vector<MElement *> elements;
+    std::size_t numElements, begin;
+    _getElementsByTypeForTask(elementType, tag, task, numTasks, elements,
+                              numElements, begin);
+    const int numNodes = ElementType::getNumVertices(elementType);
+    *elementTags_n = numElements;
+    *elementTags = (size_t *)gmshMalloc(numElements * sizeof(size_t));
+    *nodeTags_n = numElements * numNodes;
+    *nodeTags = (size_t *)gmshMalloc(numElements * numNodes * sizeof(size_t));
+    if(numTasks > 1) {
+      Msg::Warning("ElementTags and nodeTags should be preallocated "
+                   "if numTasks > 1");
+      std::fill(*elementTags, *elementTags + *elementTags_n, 0);
+      std::fill(*nodeTags, *nodeTags + *nodeTags_n, 0);
     }
+    _copyElementsByType(elements, begin, numNodes, *elementTags, *nodeTags,
+                        numTasks == 1);
+  }
+  catch(const std::string &api_error_) {
+    if(ierr) *ierr = 1;
   }
 }
 
@@ -2058,183 +2265,7 @@ GMSH_API void gmsh::model::mesh::getJacobians(
                  3 * end * numPoints);
       throw Msg::GetLastError();
     }
-    if(haveDeterminants && haveJacobians && havePoints) {
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              e->pnt(localCoord[3 * k], localCoord[3 * k + 1],
-                     localCoord[3 * k + 2], &coord[idx * 3]);
-              determinants[idx] = e->getJacobian(gsf[k], &jacobians[idx * 9]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(haveDeterminants && haveJacobians && !havePoints) {
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              determinants[idx] = e->getJacobian(gsf[k], &jacobians[idx * 9]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(haveDeterminants && !haveJacobians && havePoints) {
-      std::vector<double> jac(9, 0.);
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              e->pnt(localCoord[3 * k], localCoord[3 * k + 1],
-                     localCoord[3 * k + 2], &coord[idx * 3]);
-              determinants[idx] = e->getJacobian(gsf[k], &jac[0]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(haveDeterminants && !haveJacobians && !havePoints) {
-      std::vector<double> jac(9, 0.);
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              determinants[idx] = e->getJacobian(gsf[k], &jac[0]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(!haveDeterminants && haveJacobians && !havePoints) {
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              e->getJacobian(gsf[k], &jacobians[idx * 9]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else {
+    if(!haveDeterminants && !(haveJacobians && !havePoints)) {
       Msg::Error("The case with 'haveDeterminants = %s', `haveJacobians = %s` "
                  "and 'havePoints = %s' is not yet implemented",
                  (haveDeterminants ? "true" : "false"),
@@ -2243,6 +2274,42 @@ GMSH_API void gmsh::model::mesh::getJacobians(
       throw Msg::GetLastError();
     }
     // Add other combinaisons if necessary
+    std::vector<MElement *> elements;
+    _getElementsByType(entities, familyType, begin, end, elements);
+    const std::size_t N = elements.size();
+    if(!N) return;
+    // the gradients of the shape functions are the same for all the elements
+    // (this also initializes the nodal basis before the parallel loop)
+    std::vector<std::vector<SVector3> > gsf(numPoints);
+    for(int k = 0; k < numPoints; k++) {
+      double value[1256][3];
+      elements[0]->getGradShapeFunctions(localCoord[3 * k],
+                                         localCoord[3 * k + 1],
+                                         localCoord[3 * k + 2], value);
+      gsf[k].resize(elements[0]->getNumShapeFunctions());
+      for(std::size_t l = 0; l < elements[0]->getNumShapeFunctions(); l++) {
+        gsf[k][l][0] = value[l][0];
+        gsf[k][l][1] = value[l][1];
+        gsf[k][l][2] = value[l][2];
+      }
+    }
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(numTasks == 1)
+#endif
+    for(std::size_t i = 0; i < N; i++) {
+      MElement *e = elements[i];
+      double jac[9];
+      std::size_t idx = (begin + i) * numPoints;
+      for(int k = 0; k < numPoints; k++) {
+        if(havePoints)
+          e->pnt(localCoord[3 * k], localCoord[3 * k + 1],
+                 localCoord[3 * k + 2], &coord[idx * 3]);
+        double det =
+          e->getJacobian(gsf[k], haveJacobians ? &jacobians[idx * 9] : jac);
+        if(haveDeterminants) determinants[idx] = det;
+        idx++;
+      }
+    }
   }
 }
 
@@ -2916,8 +2983,6 @@ GMSH_API void gmsh::model::mesh::getBasisFunctionsOrientationForElements(
   else { // Hierarchical type
     const unsigned int numVertices =
       ElementType::getNumVertices(ElementType::getType(familyType, 1, false));
-    std::vector<MVertex *> vertices(numVertices);
-    std::vector<unsigned int> verticesOrder(numVertices);
     const std::size_t factorial[8] = {1, 1, 2, 6, 24, 120, 720, 5040};
 
     std::size_t entityOffset = 0;
@@ -2929,8 +2994,13 @@ GMSH_API void gmsh::model::mesh::getBasisFunctionsOrientationForElements(
       const std::size_t begin = task * localNumElements / numTasks;
       const std::size_t end = (task + 1) * localNumElements / numTasks;
 
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(numTasks == 1)
+#endif
       for(std::size_t iElement = begin; iElement < end; ++iElement) {
         MElement *e = ge->getMeshElementByType(familyType, iElement);
+        MVertex *vertices[8];
+        std::size_t verticesOrder[8];
         for(std::size_t i = 0; i < numVertices; ++i) {
           vertices[i] = e->getVertex(i);
         }
@@ -3182,6 +3252,9 @@ GMSH_API void gmsh::model::mesh::getKeysForElements(
   _getEntitiesForElementTypes(dim, tag, typeEnt);
   const std::vector<GEntity *> &entities(typeEnt[elementType]);
   int familyType = ElementType::getParentType(elementType);
+  std::size_t numElements = 0;
+  for(std::size_t i = 0; i < entities.size(); i++)
+    numElements += entities[i]->getNumMeshElementsByType(familyType);
 
   HierarchicalBasis *basis(0);
   if(fsName == "H1Legendre" || fsName == "GradH1Legendre") {
@@ -3251,27 +3324,27 @@ GMSH_API void gmsh::model::mesh::getKeysForElements(
       nodalB = BasisFactory::getNodalBasis(newType);
     }
 
-    for(std::size_t i = 0; i < entities.size(); ++i) {
-      GEntity *ge = entities[i];
-      std::size_t numElementsInEntitie =
-        ge->getNumMeshElementsByType(familyType);
-      if(generateCoord) {
-        coord.reserve(coord.size() + numElementsInEntitie *
-                                       nodalB->getNumShapeFunctions() * 3);
-      }
-      keys.reserve(keys.size() +
-                   numElementsInEntitie * nodalB->getNumShapeFunctions());
-
-      for(std::size_t j = 0; j < numElementsInEntitie; ++j) {
-        MElement *e = ge->getMeshElementByType(familyType, j);
-        for(size_t k = 0; k < e->getNumVertices(); ++k) {
-          keys.push_back(
-            std::pair<int, std::size_t>(0, e->getVertex(k)->getNum()));
-          if(generateCoord) {
-            coord.push_back(e->getVertex(k)->x());
-            coord.push_back(e->getVertex(k)->y());
-            coord.push_back(e->getVertex(k)->z());
-          }
+    if(!nodalB) return;
+    std::vector<MElement *> elements;
+    _getElementsByType(entities, familyType, 0, numElements, elements);
+    const std::size_t N = elements.size();
+    if(!N) return;
+    const std::size_t numKeysPerElement = elements[0]->getNumVertices();
+    keys.resize(N * numKeysPerElement);
+    if(generateCoord) coord.resize(3 * N * numKeysPerElement);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for(std::size_t i = 0; i < N; i++) {
+      MElement *e = elements[i];
+      std::size_t idx = i * numKeysPerElement;
+      for(size_t k = 0; k < numKeysPerElement; ++k, ++idx) {
+        MVertex *v = e->getVertex(k);
+        keys[idx] = std::pair<int, std::size_t>(0, v->getNum());
+        if(generateCoord) {
+          coord[3 * idx] = v->x();
+          coord[3 * idx + 1] = v->y();
+          coord[3 * idx + 2] = v->z();
         }
       }
     }
@@ -3288,7 +3361,6 @@ GMSH_API void gmsh::model::mesh::getKeysForElements(
   int quadFSize = basis->getnQuadFaceFunction();
   int triFSize = basis->getnTriFaceFunction();
   int fSize = quadFSize + triFSize;
-  int numDofsPerElement = vSize + bSize + eSize + fSize;
   int numberQuadFaces = basis->getNumQuadFace();
   int numberTriFaces = basis->getNumTriFace();
   int numTriFaceFunction = 0;
@@ -3314,101 +3386,118 @@ GMSH_API void gmsh::model::mesh::getKeysForElements(
   int const4 = bSize + std::max(const3, const2);
   delete basis;
 
-  for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    std::size_t numElementsInEntitie = ge->getNumMeshElementsByType(familyType);
-    if(generateCoord) {
-      coord.reserve(coord.size() +
-                    numElementsInEntitie * numDofsPerElement * 3);
+  std::vector<MElement *> elements;
+  _getElementsByType(entities, familyType, 0, numElements, elements);
+  const std::size_t N = elements.size();
+  if(!N) return;
+
+  // the global numbering of the edges and faces depends on the order in which
+  // they are added to the model: do it sequentially first
+  const int numEdgesPerElement = (eSize > 0) ? elements[0]->getNumEdges() : 0;
+  const int numFacesPerElement =
+    (fSize > 0) ? numberQuadFaces + numberTriFaces : 0;
+  std::vector<int> edgeGlobalIndices(N * numEdgesPerElement);
+  std::vector<int> faceGlobalIndices(N * numFacesPerElement);
+  for(std::size_t i = 0; i < N; i++) {
+    MElement *e = elements[i];
+    for(int jj = 0; jj < numEdgesPerElement; jj++)
+      edgeGlobalIndices[i * numEdgesPerElement + jj] =
+        GModel::current()->addMEdge(e->getEdge(jj));
+    for(int jj = 0; jj < numFacesPerElement; jj++)
+      faceGlobalIndices[i * numFacesPerElement + jj] =
+        GModel::current()->addMFace(e->getFaceSolin(jj));
+  }
+
+  std::size_t numKeysPerElement = vSize + numEdgesPerElement * (const1 - 1);
+  if(numFacesPerElement)
+    numKeysPerElement += numberQuadFaces * (const2 - const1) +
+                         numberTriFaces * (const3 - const1);
+  if(bSize > 0) numKeysPerElement += const4 - std::max(const3, const2);
+  keys.resize(N * numKeysPerElement);
+  if(generateCoord) coord.resize(3 * N * numKeysPerElement);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t i = 0; i < N; i++) {
+    MElement *e = elements[i];
+    std::size_t idx = i * numKeysPerElement;
+    // vertices
+    for(int k = 0; k < vSize; k++, idx++) {
+      MVertex *v = e->getVertex(k);
+      keys[idx] = std::pair<int, std::size_t>(0, v->getNum());
+      if(generateCoord) {
+        coord[3 * idx] = v->x();
+        coord[3 * idx + 1] = v->y();
+        coord[3 * idx + 2] = v->z();
+      }
     }
-    keys.reserve(keys.size() + numElementsInEntitie * numDofsPerElement);
-
-    for(std::size_t j = 0; j < numElementsInEntitie; j++) {
-      MElement *e = ge->getMeshElementByType(familyType, j);
-      // vertices
-      for(int k = 0; k < vSize; k++) {
-        keys.push_back(
-          std::pair<int, std::size_t>(0, e->getVertex(k)->getNum()));
+    // edges
+    for(int jj = 0; jj < numEdgesPerElement; jj++) {
+      double coordEdge[3] = {0., 0., 0.};
+      if(generateCoord) {
+        MEdge edge = e->getEdge(jj);
+        MVertex *v1 = edge.getVertex(0);
+        MVertex *v2 = edge.getVertex(1);
+        coordEdge[0] = 0.5 * (v1->x() + v2->x());
+        coordEdge[1] = 0.5 * (v1->y() + v2->y());
+        coordEdge[2] = 0.5 * (v1->z() + v2->z());
+      }
+      int edgeGlobalIndice = edgeGlobalIndices[i * numEdgesPerElement + jj];
+      for(int k = 1; k < const1; k++, idx++) {
+        keys[idx] = std::pair<int, std::size_t>(k, edgeGlobalIndice);
         if(generateCoord) {
-          coord.push_back(e->getVertex(k)->x());
-          coord.push_back(e->getVertex(k)->y());
-          coord.push_back(e->getVertex(k)->z());
+          coord[3 * idx] = coordEdge[0];
+          coord[3 * idx + 1] = coordEdge[1];
+          coord[3 * idx + 2] = coordEdge[2];
         }
       }
-      // edges
-      if(eSize > 0) {
-        for(int jj = 0; jj < e->getNumEdges(); jj++) {
-          MEdge edge = e->getEdge(jj);
-          double coordEdge[3];
-          if(generateCoord) {
-            MVertex *v1 = edge.getVertex(0);
-            MVertex *v2 = edge.getVertex(1);
-
-            coordEdge[0] = 0.5 * (v1->x() + v2->x());
-            coordEdge[1] = 0.5 * (v1->y() + v2->y());
-            coordEdge[2] = 0.5 * (v1->z() + v2->z());
-          }
-          int edgeGlobalIndice = GModel::current()->addMEdge(edge);
-          for(int k = 1; k < const1; k++) {
-            keys.push_back(std::pair<int, std::size_t>(k, edgeGlobalIndice));
-            if(generateCoord) {
-              coord.push_back(coordEdge[0]);
-              coord.push_back(coordEdge[1]);
-              coord.push_back(coordEdge[2]);
-            }
-          }
+    }
+    // faces
+    for(int jj = 0; jj < numFacesPerElement; jj++) {
+      double coordFace[3] = {0., 0., 0.};
+      if(generateCoord) {
+        MFace face = e->getFaceSolin(jj);
+        for(std::size_t indexV = 0; indexV < face.getNumVertices(); ++indexV) {
+          coordFace[0] += face.getVertex(indexV)->x();
+          coordFace[1] += face.getVertex(indexV)->y();
+          coordFace[2] += face.getVertex(indexV)->z();
         }
+        coordFace[0] /= face.getNumVertices();
+        coordFace[1] /= face.getNumVertices();
+        coordFace[2] /= face.getNumVertices();
       }
-      // faces
-      if(fSize > 0) {
-        for(int jj = 0; jj < numberQuadFaces + numberTriFaces; jj++) {
-          // Number the faces
-          MFace face = e->getFaceSolin(jj);
-          double coordFace[3] = {0., 0., 0.};
-          if(generateCoord) {
-            for(std::size_t indexV = 0; indexV < face.getNumVertices();
-                ++indexV) {
-              coordFace[0] += face.getVertex(indexV)->x();
-              coordFace[1] += face.getVertex(indexV)->y();
-              coordFace[2] += face.getVertex(indexV)->z();
-            }
-            coordFace[0] /= face.getNumVertices();
-            coordFace[1] /= face.getNumVertices();
-            coordFace[2] /= face.getNumVertices();
-          }
-          int faceGlobalIndice = GModel::current()->addMFace(face);
-          int it2 = const2;
-          if(jj >= numberQuadFaces) { it2 = const3; }
-          for(int k = const1; k < it2; k++) {
-            keys.push_back(std::pair<int, std::size_t>(k, faceGlobalIndice));
-            if(generateCoord) {
-              coord.push_back(coordFace[0]);
-              coord.push_back(coordFace[1]);
-              coord.push_back(coordFace[2]);
-            }
-          }
+      int faceGlobalIndice = faceGlobalIndices[i * numFacesPerElement + jj];
+      int it2 = const2;
+      if(jj >= numberQuadFaces) { it2 = const3; }
+      for(int k = const1; k < it2; k++, idx++) {
+        keys[idx] = std::pair<int, std::size_t>(k, faceGlobalIndice);
+        if(generateCoord) {
+          coord[3 * idx] = coordFace[0];
+          coord[3 * idx + 1] = coordFace[1];
+          coord[3 * idx + 2] = coordFace[2];
         }
       }
-      // volumes
-      if(bSize > 0) {
-        double bubbleCenterCoord[3] = {0., 0., 0.};
-        if(generateCoord) {
-          for(unsigned int indexV = 0; indexV < e->getNumVertices(); ++indexV) {
-            bubbleCenterCoord[0] += e->getVertex(indexV)->x();
-            bubbleCenterCoord[1] += e->getVertex(indexV)->y();
-            bubbleCenterCoord[2] += e->getVertex(indexV)->z();
-          }
-          bubbleCenterCoord[0] /= e->getNumVertices();
-          bubbleCenterCoord[1] /= e->getNumVertices();
-          bubbleCenterCoord[2] /= e->getNumVertices();
+    }
+    // volumes
+    if(bSize > 0) {
+      double bubbleCenterCoord[3] = {0., 0., 0.};
+      if(generateCoord) {
+        for(std::size_t indexV = 0; indexV < e->getNumVertices(); ++indexV) {
+          bubbleCenterCoord[0] += e->getVertex(indexV)->x();
+          bubbleCenterCoord[1] += e->getVertex(indexV)->y();
+          bubbleCenterCoord[2] += e->getVertex(indexV)->z();
         }
-        for(int k = std::max(const3, const2); k < const4; k++) {
-          keys.push_back(std::pair<int, std::size_t>(k, e->getNum()));
-          if(generateCoord) {
-            coord.push_back(bubbleCenterCoord[0]);
-            coord.push_back(bubbleCenterCoord[1]);
-            coord.push_back(bubbleCenterCoord[2]);
-          }
+        bubbleCenterCoord[0] /= e->getNumVertices();
+        bubbleCenterCoord[1] /= e->getNumVertices();
+        bubbleCenterCoord[2] /= e->getNumVertices();
+      }
+      for(int k = std::max(const3, const2); k < const4; k++, idx++) {
+        keys[idx] = std::pair<int, std::size_t>(k, e->getNum());
+        if(generateCoord) {
+          coord[3 * idx] = bubbleCenterCoord[0];
+          coord[3 * idx + 1] = bubbleCenterCoord[1];
+          coord[3 * idx + 2] = bubbleCenterCoord[2];
         }
       }
     }
@@ -3889,39 +3978,19 @@ GMSH_API void gmsh::model::mesh::getBarycenters(
       Msg::Warning("Barycenters should be preallocated if numTasks > 1");
     barycenters.resize(3 * numElements);
   }
-  size_t o = 0;
-  size_t idx = 3 * begin;
-  if(fast) {
-    for(std::size_t i = 0; i < entities.size(); i++) {
-      GEntity *ge = entities[i];
-      for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-          j++) {
-        if(o >= begin && o < end) {
-          MElement *e = ge->getMeshElementByType(familyType, j);
-          SPoint3 p = e->fastBarycenter(primary);
-          barycenters[idx++] = p[0];
-          barycenters[idx++] = p[1];
-          barycenters[idx++] = p[2];
-        }
-        o++;
-      }
-    }
-  }
-  else {
-    for(std::size_t i = 0; i < entities.size(); i++) {
-      GEntity *ge = entities[i];
-      for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-          j++) {
-        if(o >= begin && o < end) {
-          MElement *e = ge->getMeshElementByType(familyType, j);
-          SPoint3 p = e->barycenter(primary);
-          barycenters[idx++] = p[0];
-          barycenters[idx++] = p[1];
-          barycenters[idx++] = p[2];
-        }
-        o++;
-      }
-    }
+  std::vector<MElement *> elements;
+  _getElementsByType(entities, familyType, begin, end, elements);
+  const std::size_t N = elements.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(numTasks == 1)
+#endif
+  for(std::size_t i = 0; i < N; i++) {
+    MElement *e = elements[i];
+    SPoint3 p = fast ? e->fastBarycenter(primary) : e->barycenter(primary);
+    std::size_t idx = 3 * (begin + i);
+    barycenters[idx] = p[0];
+    barycenters[idx + 1] = p[1];
+    barycenters[idx + 2] = p[2];
   }
 }
 
@@ -4000,7 +4069,7 @@ GMSH_API void gmsh::model::mesh::getElementEdgeNodes(
     GEntity *ge = entities[i];
     int n = ge->getNumMeshElementsByType(familyType);
     if(n && !numNodesPerEdge) {
-      MElement *e = ge->getMeshElementByType(familyType, i);
+      MElement *e = ge->getMeshElementByType(familyType, 0);
       numEdgesPerEle = e->getNumEdges();
       if(primary) { numNodesPerEdge = 2; }
       else {
@@ -4024,25 +4093,24 @@ GMSH_API void gmsh::model::mesh::getElementEdgeNodes(
       Msg::Warning("Nodes should be preallocated if numTasks > 1");
     nodeTags.resize(numEdgesPerEle * numNodesPerEdge * numElements);
   }
-  size_t o = 0;
-  size_t idx = numEdgesPerEle * numNodesPerEdge * begin;
-  for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType); j++) {
-      if(o >= begin && o < end) {
-        MElement *e = ge->getMeshElementByType(familyType, j);
-        for(int k = 0; k < numEdgesPerEle; k++) {
-          std::vector<MVertex *> v;
-          // we could use e->getHighOrderEdge() here if we decide to remove
-          // getEdgeVertices
-          e->getEdgeVertices(k, v);
-          std::size_t N = primary ? 2 : v.size();
-          for(std::size_t l = 0; l < N; l++) {
-            nodeTags[idx++] = v[l]->getNum();
-          }
-        }
+  std::vector<MElement *> elements;
+  _getElementsByType(entities, familyType, begin, end, elements);
+  const std::size_t numEle = elements.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(numTasks == 1)
+#endif
+  for(std::size_t i = 0; i < numEle; i++) {
+    MElement *e = elements[i];
+    std::size_t idx = numEdgesPerEle * numNodesPerEdge * (begin + i);
+    std::vector<MVertex *> v;
+    for(int k = 0; k < numEdgesPerEle; k++) {
+      // we could use e->getHighOrderEdge() here if we decide to remove
+      // getEdgeVertices
+      e->getEdgeVertices(k, v);
+      std::size_t N = primary ? 2 : v.size();
+      for(std::size_t l = 0; l < N; l++) {
+        nodeTags[idx++] = v[l]->getNum();
       }
-      o++;
     }
   }
 }
@@ -4064,7 +4132,7 @@ GMSH_API void gmsh::model::mesh::getElementFaceNodes(
     GEntity *ge = entities[i];
     int n = ge->getNumMeshElementsByType(familyType);
     if(n && !numNodesPerFace) {
-      MElement *e = ge->getMeshElementByType(familyType, i);
+      MElement *e = ge->getMeshElementByType(familyType, 0);
       int nf = e->getNumFaces();
       numFacesPerEle = 0;
       for(int j = 0; j < nf; j++) {
@@ -4093,28 +4161,27 @@ GMSH_API void gmsh::model::mesh::getElementFaceNodes(
       Msg::Warning("Nodes should be preallocated if numTasks > 1");
     nodeTags.resize(numFacesPerEle * numNodesPerFace * numElements);
   }
-  size_t o = 0;
-  size_t idx = numFacesPerEle * numNodesPerFace * begin;
-  for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType); j++) {
-      if(o >= begin && o < end) {
-        MElement *e = ge->getMeshElementByType(familyType, j);
-        int nf = e->getNumFaces();
-        for(int k = 0; k < nf; k++) {
-          MFace f = e->getFace(k);
-          if(faceType != (int)f.getNumVertices()) continue;
-          std::vector<MVertex *> v;
-          // we could use e->getHighOrderFace() here if we decide to remove
-          // getFaceVertices
-          e->getFaceVertices(k, v);
-          std::size_t N = primary ? faceType : v.size();
-          for(std::size_t l = 0; l < N; l++) {
-            nodeTags[idx++] = v[l]->getNum();
-          }
-        }
+  std::vector<MElement *> elements;
+  _getElementsByType(entities, familyType, begin, end, elements);
+  const std::size_t numEle = elements.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(numTasks == 1)
+#endif
+  for(std::size_t i = 0; i < numEle; i++) {
+    MElement *e = elements[i];
+    std::size_t idx = numFacesPerEle * numNodesPerFace * (begin + i);
+    std::vector<MVertex *> v;
+    int nf = e->getNumFaces();
+    for(int k = 0; k < nf; k++) {
+      MFace f = e->getFace(k);
+      if(faceType != (int)f.getNumVertices()) continue;
+      // we could use e->getHighOrderFace() here if we decide to remove
+      // getFaceVertices
+      e->getFaceVertices(k, v);
+      std::size_t N = primary ? faceType : v.size();
+      for(std::size_t l = 0; l < N; l++) {
+        nodeTags[idx++] = v[l]->getNum();
       }
-      o++;
     }
   }
 }
@@ -6275,6 +6342,28 @@ GMSH_API void gmsh::view::getModelData(const int tag, const int step,
 #endif
 }
 
+#if defined(HAVE_POST)
+static void _copyHomogeneousModelData(stepData<double> *s,
+                                      const int numComponents,
+                                      const int maxMult, std::size_t *tags,
+                                      double *data)
+{
+  std::size_t j = 0;
+  for(std::size_t i = 0; i < s->getNumData(); i++) {
+    double *dd = s->getData(i);
+    if(dd) {
+      tags[j] = i;
+      int mult = s->getMult(i);
+      double *d = &data[j * numComponents * maxMult];
+      for(int k = 0; k < numComponents * mult; k++) d[k] = dd[k];
+      for(int k = numComponents * mult; k < numComponents * maxMult; k++)
+        d[k] = 0.;
+      j++;
+    }
+  }
+}
+#endif
+
 GMSH_API void gmsh::view::getHomogeneousModelData(const int tag, const int step,
                                                   std::string &dataType,
                                                   std::vector<std::size_t> &tags,
@@ -6289,26 +6378,53 @@ GMSH_API void gmsh::view::getHomogeneousModelData(const int tag, const int step,
   stepData<double> *s = _getModelData(tag, step, dataType, time, numComponents,
                                       numEnt, maxMult);
   if(!s || !numComponents || !numEnt || !maxMult) return;
-  data.resize(numEnt * numComponents * maxMult, 0.);
+  data.resize(numEnt * numComponents * maxMult);
   tags.resize(numEnt);
-  std::size_t j = 0;
-  for(std::size_t i = 0; i < s->getNumData(); i++) {
-    double *dd = s->getData(i);
-    if(dd) {
-      tags[j] = i;
-      int mult = s->getMult(i);
-      for(int k = 0; k < numComponents * mult; k++) {
-        data[j * numComponents * maxMult + k] = dd[k];
-      }
-      j++;
-    }
-  }
+  _copyHomogeneousModelData(s, numComponents, maxMult, &tags[0], &data[0]);
 #else
   Msg::Error("Views require the post-processing module");
   throw Msg::GetLastError();
 #endif
 }
 
+// for better performance (and memory usage), manual C implementation of
+// gmsh::view::getHomogeneousModelData, which directly fills the returned
+// arrays
+GMSH_API void gmshViewGetHomogeneousModelData(
+  const int tag, const int step, char **dataType, size_t **tags,
+  size_t *tags_n, double **data, size_t *data_n, double *time,
+  int *numComponents, int *ierr)
+{
+  if(ierr) *ierr = 0;
+  try {
+    _checkInit();
+    *tags_n = *data_n = 0;
+#if defined(HAVE_POST)
+    std::string api_dataType_;
+    int numEnt, maxMult;
+    stepData<double> *s = _getModelData(tag, step, api_dataType_, *time,
+                                        *numComponents, numEnt, maxMult);
+    *dataType = strdup(api_dataType_.c_str());
+    if(!s || !*numComponents || !numEnt || !maxMult) {
+      *tags = (size_t *)gmshMalloc(0);
+      *data = (double *)gmshMalloc(0);
+      return;
+    }
+    *tags_n = numEnt;
+    *tags = (size_t *)gmshMalloc(numEnt * sizeof(size_t));
+    *data_n = numEnt * *numComponents * maxMult;
+    *data = (double *)gmshMalloc(*data_n * sizeof(double));
+    _copyHomogeneousModelData(s, *numComponents, maxMult, *tags, *data);
+#else
+    Msg::Error("Views require the post-processing module");
+    throw Msg::GetLastError();
+#endif
+  }
+  catch(const std::string &api_error_) {
+    if(ierr) *ierr = 1;
+  }
+}
+
 // for better performance, manual C implementation of gmsh::view::getModelData
 GMSH_API void gmshViewGetModelData(const int tag, const int step,
                                    char **dataType, size_t **tags,
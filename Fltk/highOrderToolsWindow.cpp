@@ -141,7 +141,7 @@ static void chooseopti_cb(Fl_Widget *w, void *data)
 static void chooseopti_strategy(Fl_Widget *w, void *data)
 {
   highOrderToolsWindow *o = FlGui::instance()->highordertools;
-  if(o->choice[3]->value() == 1)
+  if(o->choice[3]->value() == 1 || o->choice[3]->value() == 3)
     for(int i = 9; i <= 11; i++) o->value[i]->activate();
   else
     for(int i = 9; i <= 11; i++) o->value[i]->deactivate();
@@ -424,6 +424,7 @@ highOrderToolsWindow::highOrderToolsWindow(int deltaFontSize)
   static Fl_Menu_Item menu_strategy[] = {{"Disjoint strong", 0, 0, 0},
                                          {"Adaptive one-by-one", 0, 0, 0},
                                          {"Disjoint weak", 0, 0, 0},
+                                         {"Adaptive concurrent", 0, 0, 0},
                                          {0}};
 
   y += BH;
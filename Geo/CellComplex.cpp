@@ -425,6 +425,173 @@ int CellComplex::coreduction(int dim, int omit,
   return count;
 }
 
+// Compact incidence structure of a cell complex: the cells of each dimension
+// are numbered contiguously (in the order of the cell complex), and their
+// boundary and coboundary relations are stored as compressed sparse rows.
+// (Co)reductions without omitted cells are performed on these arrays with a
+// work queue, instead of sweeping repeatedly over the cell sets and counting
+// the entries of the (co)boundary maps of each cell.
+class CellIncidence {
+private:
+  std::vector<Cell *> _cells[4];
+  // boundary (dimension - 1) and coboundary (dimension + 1) cell indices and
+  // coefficients of the cells of each dimension, in compressed sparse rows
+  std::vector<int> _bdRow[4], _bdCol[4], _cbdRow[4], _cbdCol[4];
+  std::vector<short> _bdVal[4], _cbdVal[4];
+  // current number of boundary and coboundary cells
+  std::vector<int> _bdSize[4], _cbdSize[4];
+  std::vector<char> _removed[4];
+
+  int _index(int dim, Cell *cell) const
+  {
+    std::vector<Cell *>::const_iterator it = std::lower_bound(
+      _cells[dim].begin(), _cells[dim].end(), cell, CellPtrLessThan());
+    if(it == _cells[dim].end() || *it != cell) return -1;
+    return it - _cells[dim].begin();
+  }
+  void _fill(int odim, Cell::biter first, Cell::biter last,
+             std::vector<int> &col, std::vector<short> &val)
+  {
+    for(Cell::biter it = first; it != last; it++) {
+      if(it->second.get() == 0) continue;
+      int j = _index(odim, it->first);
+      if(j < 0) continue;
+      col.push_back(j);
+      val.push_back(it->second.get());
+    }
+  }
+  void _remove(int dim, int i)
+  {
+    _removed[dim][i] = 1;
+    if(dim > 0)
+      for(int k = _bdRow[dim][i]; k < _bdRow[dim][i + 1]; k++)
+        _cbdSize[dim - 1][_bdCol[dim][k]]--;
+    if(dim < 3)
+      for(int k = _cbdRow[dim][i]; k < _cbdRow[dim][i + 1]; k++)
+        _bdSize[dim + 1][_cbdCol[dim][k]]--;
+  }
+  // can the pair (cell, other) be removed from the complex?
+  bool _reducible(Cell *cell, Cell *other, int coeff) const
+  {
+    return cell->getDomain() == other->getDomain() && !cell->getImmune() &&
+           !other->getImmune() && abs(coeff) < 2;
+  }
+
+public:
+  CellIncidence(CellComplex *complex)
+  {
+    for(int dim = 0; dim < 4; dim++) {
+      _cells[dim].assign(complex->firstCell(dim), complex->lastCell(dim));
+      _removed[dim].resize(_cells[dim].size(), 0);
+    }
+    for(int dim = 0; dim < 4; dim++) {
+      std::size_t n = _cells[dim].size();
+      _bdRow[dim].resize(n + 1, 0);
+      _cbdRow[dim].resize(n + 1, 0);
+      for(std::size_t i = 0; i < n; i++) {
+        Cell *cell = _cells[dim][i];
+        if(dim > 0 && cell->getBoundarySize())
+          _fill(dim - 1, cell->firstBoundary(), cell->lastBoundary(),
+                _bdCol[dim], _bdVal[dim]);
+        if(dim < 3 && cell->getCoboundarySize())
+          _fill(dim + 1, cell->firstCoboundary(),
+                cell->lastCoboundary(), _cbdCol[dim], _cbdVal[dim]);
+        _bdRow[dim][i + 1] = _bdCol[dim].size();
+        _cbdRow[dim][i + 1] = _cbdCol[dim].size();
+      }
+      _bdSize[dim].resize(n);
+      _cbdSize[dim].resize(n);
+      for(std::size_t i = 0; i < n; i++) {
+        _bdSize[dim][i] = _bdRow[dim][i + 1] - _bdRow[dim][i];
+        _cbdSize[dim][i] = _cbdRow[dim][i + 1] - _cbdRow[dim][i];
+      }
+    }
+  }
+
+  // remove all pairs of a (dim-1)-cell with a single dim-cell on its
+  // coboundary (reduction) or of a dim-cell with a single (dim-1)-cell on its
+  // boundary (coreduction); the removed cells are appended to removed, in the
+  // order in which they should be removed from the cell complex
+  int reduce(int dim, bool dual, std::vector<Cell *> &removed)
+  {
+    if(dim < 1 || dim > 3) return 0;
+    // cells that are candidates for a (co)reduction
+    int cdim = dual ? dim : dim - 1, odim = dual ? dim - 1 : dim;
+    std::vector<int> &size = dual ? _bdSize[cdim] : _cbdSize[cdim];
+    std::vector<int> &row = dual ? _bdRow[cdim] : _cbdRow[cdim];
+    std::vector<int> &col = dual ? _bdCol[cdim] : _cbdCol[cdim];
+    std::vector<short> &val = dual ? _bdVal[cdim] : _cbdVal[cdim];
+    // cells of dimension cdim whose (co)boundary changes when removing a cell
+    // of dimension odim
+    std::vector<int> &orow = dual ? _cbdRow[odim] : _bdRow[odim];
+    std::vector<int> &ocol = dual ? _cbdCol[odim] : _bdCol[odim];
+
+    std::queue<int> Q;
+    std::vector<char> queued(_cells[cdim].size(), 0);
+    for(std::size_t i = 0; i < _cells[cdim].size(); i++) {
+      if(!_removed[cdim][i] && size[i] == 1) {
+        Q.push(i);
+        queued[i] = 1;
+      }
+    }
+
+    int count = 0;
+    while(!Q.empty()) {
+      int i = Q.front();
+      Q.pop();
+      queued[i] = 0;
+      if(_removed[cdim][i] || size[i] != 1) continue;
+      int j = -1, coeff = 0;
+      for(int k = row[i]; k < row[i + 1]; k++) {
+        if(!_removed[odim][col[k]]) {
+          j = col[k];
+          coeff = val[k];
+          break;
+        }
+      }
+      if(j < 0 || !_reducible(_cells[cdim][i], _cells[odim][j], coeff))
+        continue;
+      removed.push_back(_cells[odim][j]);
+      removed.push_back(_cells[cdim][i]);
+      _remove(odim, j);
+      _remove(cdim, i);
+      count++;
+      for(int k = orow[j]; k < orow[j + 1]; k++) {
+        int l = ocol[k];
+        if(!_removed[cdim][l] && size[l] == 1 && !queued[l]) {
+          Q.push(l);
+          queued[l] = 1;
+        }
+      }
+    }
+    return count;
+  }
+};
+
+int CellComplex::_reduceIncidence(bool dual)
+{
+  int numCells[4];
+  for(int i = 0; i < 4; i++) numCells[i] = getSize(i);
+
+  CellIncidence incidence(this);
+  std::vector<Cell *> removed;
+  int count = 0;
+  if(!dual)
+    for(int dim = 3; dim > 0; dim--)
+      count += incidence.reduce(dim, false, removed);
+  else
+    for(int dim = 1; dim <= getDim(); dim++)
+      count += incidence.reduce(dim, true, removed);
+  for(std::size_t i = 0; i < removed.size(); i++) removeCell(removed[i]);
+
+  _reduced = true;
+  Msg::Debug("Cell complex %s removed %dv, %df, %de, %dn",
+             dual ? "coreduction" : "reduction", numCells[3] - getSize(3),
+             numCells[2] - getSize(2), numCells[1] - getSize(1),
+             numCells[0] - getSize(0));
+  return count;
+}
+
 int CellComplex::getSize(int dim, bool orig)
 {
   if(dim == -1) {
@@ -505,7 +672,7 @@ int CellComplex::reduceComplex(int combine, bool omit, bool homseq)
   int count = 0;
   if(relative() && !homseq) removeSubdomain();
   std::vector<Cell *> empty;
-  for(int i = 3; i > 0; i--) count = count + reduction(i, -1, empty);
+  count = _reduceIncidence(false);
 
   if(omit && !homseq) {
     std::vector<Cell *> newCells;
@@ -531,21 +698,21 @@ int CellComplex::reduceComplex(int combine, bool omit, bool homseq)
   if(combine > 0) this->combine(3);
 
   if(combine > 2)
-    for(int i = 3; i > 0; i--) reduction(i, -1, empty);
+    _reduceIncidence(false);
   else if(combine > 1)
     reduction(2, -1, empty);
 
   if(combine > 0) this->combine(2);
 
   if(combine > 2)
-    for(int i = 3; i > 0; i--) reduction(i, -1, empty);
+    _reduceIncidence(false);
   else if(combine > 1)
     reduction(1, -1, empty);
 
   if(combine > 0) this->combine(1);
 
   if(combine > 2)
-    for(int i = 3; i > 0; i--) reduction(i, -1, empty);
+    _reduceIncidence(false);
   else if(combine > 1)
     reduction(0, -1, empty);
 
@@ -596,7 +763,7 @@ int CellComplex::coreduceComplex(int combine, bool omit, int heuristic)
     }
   }
 
-  for(int j = 1; j <= getDim(); j++) count += coreduction(j, -1, empty);
+  count += _reduceIncidence(true);
 
   if(omit) {
     std::vector<Cell *> newCells;
@@ -633,21 +800,21 @@ int CellComplex::coreduceComplex(int combine, bool omit, int heuristic)
   if(combine > 0) this->cocombine(0);
 
   if(combine > 2)
-    for(int i = 1; i < 4; i++) coreduction(i, -1, empty);
+    _reduceIncidence(true);
   else if(combine > 1)
     coreduction(1, -1, empty);
 
   if(combine > 0) this->cocombine(1);
 
   if(combine > 2)
-    for(int i = 1; i < 4; i++) coreduction(i, -1, empty);
+    _reduceIncidence(true);
   else if(combine > 1)
     coreduction(2, -1, empty);
 
   if(combine > 0) this->cocombine(2);
 
   if(combine > 2)
-    for(int i = 1; i < 4; i++) coreduction(i, -1, empty);
+    _reduceIncidence(true);
   else if(combine > 1)
     coreduction(3, -1, empty);
 
@@ -78,6 +78,10 @@ private:
   // queued coreduction
   int coreduction(Cell *startCell, int omit, std::vector<Cell *> &omittedCells);
 
+  // full (co)reduction of all dimensions without omitted cells, performed on
+  // a compact array representation of the cell incidences
+  int _reduceIncidence(bool dual);
+
   static double _patience;
 
 public:
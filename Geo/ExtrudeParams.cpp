@@ -78,7 +78,7 @@ void ExtrudeParams::Extrude(int iLayer, int iElemLayer, double &x, double &y,
 
 void ExtrudeParams::Extrude(double t, double &x, double &y, double &z)
 {
-  double dx, dy, dz, angle;
+  double dx, dy, dz;
   double n[3] = {0., 0., 0.};
 
   switch(geo.Type) {
@@ -90,17 +90,9 @@ void ExtrudeParams::Extrude(double t, double &x, double &y, double &z)
     y += dy;
     z += dz;
     break;
-  case ROTATE:
-    angle = geo.angle;
-    geo.angle = geo.angle * t;
-    ProtudeXYZ(x, y, z, this);
-    geo.angle = angle;
-    break;
+  case ROTATE: ProtudeXYZ(x, y, z, this, geo.angle * t); break;
   case TRANSLATE_ROTATE:
-    angle = geo.angle;
-    geo.angle = geo.angle * t;
-    ProtudeXYZ(x, y, z, this);
-    geo.angle = angle;
+    ProtudeXYZ(x, y, z, this, geo.angle * t);
     dx = geo.trans[0] * t;
     dy = geo.trans[1] * t;
     dz = geo.trans[2] * t;
@@ -120,6 +112,45 @@ void ExtrudeParams::Extrude(double t, double &x, double &y, double &z)
   }
 }
 
+int ExtrudeParams::getNumColumnNodes()
+{
+  int n = 1;
+  for(int j = 0; j < mesh.NbLayer; j++) n += mesh.NbElmLayer[j];
+  return n;
+}
+
+void ExtrudeParams::ExtrudeColumn(double x, double y, double z, double *xyz)
+{
+  // node 0 is the (extruded) source node; node c > 0 is the top of the c-th
+  // element layer
+  int c = 0;
+  xyz[0] = x;
+  xyz[1] = y;
+  xyz[2] = z;
+  Extrude(0, 0, xyz[0], xyz[1], xyz[2]);
+  for(int j = 0; j < mesh.NbLayer; j++) {
+    for(int k = 0; k < mesh.NbElmLayer[j]; k++) {
+      c++;
+      xyz[3 * c] = x;
+      xyz[3 * c + 1] = y;
+      xyz[3 * c + 2] = z;
+      Extrude(j, k + 1, xyz[3 * c], xyz[3 * c + 1], xyz[3 * c + 2]);
+    }
+  }
+}
+
+void ExtrudeParams::ExtrudeColumns(std::vector<MVertex *> &src,
+                                   std::vector<double> &xyz)
+{
+  std::size_t nc = getNumColumnNodes();
+  xyz.resize(3 * nc * src.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t i = 0; i < src.size(); i++)
+    ExtrudeColumn(src[i]->x(), src[i]->y(), src[i]->z(), &xyz[3 * nc * i]);
+}
+
 double ExtrudeParams::u(int iLayer, int iElemLayer)
 {
   double t0, t1;
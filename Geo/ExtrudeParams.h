@@ -31,6 +31,13 @@ public:
   double u(int iLayer, int iElemLayer);
   void Extrude(int iLayer, int iElemLayer, double &dx, double &dy, double &dz);
   void Extrude(double t, double &x, double &y, double &z);
+  // number of nodes in the column extruded from a source node, and
+  // coordinates (3 per node) of all the nodes in this column (thread-safe)
+  int getNumColumnNodes();
+  void ExtrudeColumn(double x, double y, double z, double *xyz);
+  // coordinates of the columns extruded from all the source nodes, computed in
+  // parallel
+  void ExtrudeColumns(std::vector<MVertex *> &src, std::vector<double> &xyz);
   void GetAffineTransform(std::vector<double> &tfo);
   struct {
     bool ExtrudeMesh;
@@ -51,6 +51,7 @@ GEdge::~GEdge()
 
 void GEdge::deleteMesh()
 {
+  model()->destroyMeshCaches(this);
   for(std::size_t i = 0; i < mesh_vertices.size(); i++)
     delete mesh_vertices[i];
   mesh_vertices.clear();
@@ -59,7 +60,6 @@ void GEdge::deleteMesh()
   correspondingVertices.clear();
   correspondingHighOrderVertices.clear();
   deleteVertexArrays();
-  model()->destroyMeshCaches();
 }
 
 void GEdge::setMeshMaster(GEdge *ge, int ori)
@@ -49,6 +49,21 @@ public:
   // the STL discretization
   std::vector<SPoint3> stl_vertices_xyz;
 
+  // samples of the parametrization (point and first derivative at parametric
+  // coordinate t, sorted by t) cached by the 1D mesh generator, and reused
+  // when the curve is remeshed (e.g. with a different mesh size); cleared
+  // whenever the parametrization changes
+  struct parametrizationSample {
+    double t;
+    SPoint3 p;
+    SVector3 der;
+    bool operator<(const parametrizationSample &other) const
+    {
+      return t < other.t;
+    }
+  };
+  std::vector<parametrizationSample> parametrizationCache;
+
 public:
   GEdge(GModel *model, int tag, GVertex *v0, GVertex *v1);
   GEdge(GModel *model, int tag);
@@ -171,6 +171,7 @@ void GFace::setBoundEdges(const std::vector<int> &tagEdges,
 
 void GFace::deleteMesh()
 {
+  model()->destroyMeshCaches(this);
   for(std::size_t i = 0; i < mesh_vertices.size(); i++)
     delete mesh_vertices[i];
   mesh_vertices.clear();
@@ -184,7 +185,6 @@ void GFace::deleteMesh()
   correspondingVertices.clear();
   correspondingHighOrderVertices.clear();
   deleteVertexArrays();
-  model()->destroyMeshCaches();
 }
 
 std::size_t GFace::getNumMeshElements() const
@@ -1021,6 +1021,16 @@ void GFace::getMetricEigenVectors(const SPoint2 &param, double eigVal[2],
   }
 }
 
+void GFace::points(const std::vector<SPoint2> &pts,
+                   std::vector<GPoint> &gp) const
+{
+  gp.resize(pts.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t i = 0; i < pts.size(); i++) gp[i] = point(pts[i]);
+}
+
 void GFace::XYZtoUV(double X, double Y, double Z, double &U, double &V,
                     double relax, bool onSurface) const
 {
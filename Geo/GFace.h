@@ -172,6 +172,12 @@ public:
     return point(pt.x(), pt.y());
   }
 
+  // return the points on the face corresponding to a batch of parameters
+  // (evaluated in parallel by default: point() must be thread-safe, as it is
+  // also called concurrently when several surfaces are meshed in parallel)
+  virtual void points(const std::vector<SPoint2> &pts,
+                      std::vector<GPoint> &gp) const;
+
   // if the mapping is a conforming mapping, i.e. a mapping that
   // conserves angles, this function returns the eigenvalue of the
   // metric at a given point this is a special feature for
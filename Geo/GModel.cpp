@@ -42,6 +42,7 @@
 #include "CreateFile.h"
 #include "Options.h"
 #include "GModelParametrize.h"
+#include "HilbertCurve.h"
 
 #if defined(HAVE_MESH)
 #include "meshGEdge.h"
@@ -68,7 +69,7 @@ GModel::GModel(const std::string &name)
   : _destroying(false), _name(name), _visible(1), _elementOctree(0),
     _geo_internals(0), _occ_internals(0), _acis_internals(0),
     _parasolid_internals(0), _fields(0), _currentMeshEntity(0),
-    _numPartitions(0), normals(0)
+    _numPartitions(0), _numStreamPartitions(0), normals(0)
 {
   _maxVertexNum = CTX::instance()->mesh.firstNodeTag - 1;
   _maxElementNum = CTX::instance()->mesh.firstElementTag - 1;
@@ -221,10 +222,117 @@ void GModel::destroyMeshCaches()
   std::map<int, MElement *>().swap(_elementMapCache);
   _elementIndexCache.clear();
   std::map<int, int>().swap(_elementIndexCache);
+  _entitiesToCache.clear();
   delete _elementOctree;
   _elementOctree = 0;
 }
 
+void GModel::destroyMeshCaches(GEntity *ge)
+{
+  if(!_vertexVectorCache.empty() || !_vertexMapCache.empty()) {
+    for(std::size_t i = 0; i < ge->mesh_vertices.size(); i++) {
+      MVertex *v = ge->mesh_vertices[i];
+      int n = v->getNum();
+      if(n < (int)_vertexVectorCache.size()) {
+        if(_vertexVectorCache[n] == v) _vertexVectorCache[n] = 0;
+      }
+      else {
+        std::map<int, MVertex *>::iterator it = _vertexMapCache.find(n);
+        if(it != _vertexMapCache.end() && it->second == v)
+          _vertexMapCache.erase(it);
+      }
+    }
+  }
+  if(!_elementVectorCache.empty() || !_elementMapCache.empty() ||
+     !_elementIndexCache.empty()) {
+    for(std::size_t i = 0; i < ge->getNumMeshElements(); i++) {
+      MElement *e = ge->getMeshElement(i);
+      int n = e->getNum();
+      if(n < (int)_elementVectorCache.size()) {
+        if(_elementVectorCache[n] == e) _elementVectorCache[n] = 0;
+      }
+      else {
+        std::map<int, MElement *>::iterator it = _elementMapCache.find(n);
+        if(it != _elementMapCache.end() && it->second == e)
+          _elementMapCache.erase(it);
+      }
+      _elementIndexCache.erase(n);
+    }
+  }
+  updateMeshCaches(ge);
+}
+
+void GModel::updateMeshCaches(GEntity *ge)
+{
+  delete _elementOctree;
+  _elementOctree = 0;
+  if(_vertexVectorCache.empty() && _vertexMapCache.empty() &&
+     _elementVectorCache.empty() && _elementMapCache.empty())
+    return; // the caches will be rebuilt from scratch anyway
+  _entitiesToCache[ge] = std::make_pair(ge->dim(), ge->tag());
+}
+
+template <class T>
+static bool addToCache(T *t, std::vector<T *> &vectorCache,
+                       std::map<int, T *> &mapCache)
+{
+  int n = t->getNum();
+  if(n < (int)vectorCache.size()) { vectorCache[n] = t; }
+  else if(vectorCache.size()) {
+    // keep the vector cache if the numbering remains fairly dense
+    if(n >= 2 * (int)vectorCache.size()) return false;
+    vectorCache.resize(n + 1, (T *)0);
+    vectorCache[n] = t;
+  }
+  else {
+    mapCache[n] = t;
+  }
+  return true;
+}
+
+void GModel::_updateMeshCaches()
+{
+  if(_entitiesToCache.empty()) return;
+  bool vertices = !_vertexVectorCache.empty() || !_vertexMapCache.empty();
+  bool elements = !_elementVectorCache.empty() || !_elementMapCache.empty();
+  bool vertexOk = true, elementOk = true;
+  for(std::map<GEntity *, std::pair<int, int> >::iterator it =
+        _entitiesToCache.begin();
+      it != _entitiesToCache.end(); ++it) {
+    // the entity might have been deleted in the meantime
+    GEntity *ge = getEntityByTag(it->second.first, it->second.second);
+    if(ge != it->first) continue;
+    if(vertices && vertexOk) {
+      for(std::size_t i = 0; i < ge->mesh_vertices.size(); i++) {
+        if(!addToCache(ge->mesh_vertices[i], _vertexVectorCache,
+                       _vertexMapCache)) {
+          vertexOk = false;
+          break;
+        }
+      }
+    }
+    if(elements && elementOk) {
+      for(std::size_t i = 0; i < ge->getNumMeshElements(); i++) {
+        if(!addToCache(ge->getMeshElement(i), _elementVectorCache,
+                       _elementMapCache)) {
+          elementOk = false;
+          break;
+        }
+      }
+    }
+  }
+  _entitiesToCache.clear();
+  // the numbering has become too sparse: the caches will be rebuilt
+  if(!vertexOk) {
+    std::vector<MVertex *>().swap(_vertexVectorCache);
+    std::map<int, MVertex *>().swap(_vertexMapCache);
+  }
+  if(!elementOk) {
+    std::vector<MElement *>().swap(_elementVectorCache);
+    std::map<int, MElement *>().swap(_elementMapCache);
+  }
+}
+
 void GModel::deleteMesh()
 {
   for(riter it = firstRegion(); it != lastRegion(); ++it) (*it)->deleteMesh();
@@ -233,6 +341,7 @@ void GModel::deleteMesh()
   for(viter it = firstVertex(); it != lastVertex(); ++it) (*it)->deleteMesh();
   destroyMeshCaches();
   _currentMeshEntity = 0;
+  _numStreamPartitions = 0;
   _lastMeshEntityError.clear();
   _lastMeshVertexError.clear();
 }
@@ -282,7 +391,7 @@ void GModel::deleteMesh(const std::vector<GEntity *> &entities)
                    ge->dim(), ge->tag());
     }
   }
-  destroyMeshCaches();
+  // the caches have been updated entity by entity
   _currentMeshEntity = 0;
   _lastMeshEntityError.clear();
   _lastMeshVertexError.clear();
@@ -1471,9 +1580,193 @@ int GModel::addMFace(const MFace &face)
   return it.first->second;
 }
 
+// compute a reverse Cuthill-McKee ordering of the mesh nodes of the entity,
+// using the node adjacency defined by its mesh elements
+static void _rcmOrdering(GEntity *ge, std::vector<std::size_t> &ordering)
+{
+  std::size_t nv = ge->mesh_vertices.size();
+  ordering.clear();
+  if(!nv) return;
+
+  // local indices of the nodes classified on the entity (-1 for the others),
+  // saving the original indices to restore them afterwards
+  std::vector<std::pair<MVertex *, long int> > saved;
+  for(std::size_t i = 0; i < ge->getNumMeshElements(); i++) {
+    MElement *e = ge->getMeshElement(i);
+    for(std::size_t j = 0; j < e->getNumVertices(); j++) {
+      MVertex *v = e->getVertex(j);
+      saved.push_back(std::make_pair(v, v->getIndex()));
+      v->setIndex(-1);
+    }
+  }
+  for(std::size_t i = 0; i < nv; i++) {
+    MVertex *v = ge->mesh_vertices[i];
+    saved.push_back(std::make_pair(v, v->getIndex()));
+    v->setIndex(i);
+  }
+
+  // node graph in compressed sparse row format
+  std::vector<std::pair<std::size_t, std::size_t> > edges;
+  for(std::size_t i = 0; i < ge->getNumMeshElements(); i++) {
+    MElement *e = ge->getMeshElement(i);
+    std::size_t n = e->getNumVertices();
+    for(std::size_t j = 0; j < n; j++) {
+      long int a = e->getVertex(j)->getIndex();
+      if(a < 0) continue;
+      for(std::size_t k = 0; k < n; k++) {
+        long int b = e->getVertex(k)->getIndex();
+        if(b < 0 || a == b) continue;
+        edges.push_back(std::make_pair(a, b));
+      }
+    }
+  }
+  // nodes shared by several elements are saved several times, the first time
+  // with their original index: restore in reverse order
+  for(std::size_t i = saved.size(); i > 0; i--)
+    saved[i - 1].first->setIndex(saved[i - 1].second);
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  std::vector<std::size_t> start(nv + 1, 0), adj(edges.size());
+  for(std::size_t i = 0; i < edges.size(); i++) {
+    start[edges[i].first + 1]++;
+    adj[i] = edges[i].second;
+  }
+  for(std::size_t i = 0; i < nv; i++) start[i + 1] += start[i];
+  std::vector<std::size_t> degree(nv);
+  for(std::size_t i = 0; i < nv; i++) degree[i] = start[i + 1] - start[i];
+
+  // seeds by increasing degree
+  std::vector<std::pair<std::size_t, std::size_t> > seeds(nv);
+  for(std::size_t i = 0; i < nv; i++) seeds[i] = std::make_pair(degree[i], i);
+  std::sort(seeds.begin(), seeds.end());
+
+  std::vector<char> visited(nv, 0);
+  std::vector<std::size_t> level(nv, 0);
+  std::vector<std::pair<std::size_t, std::size_t> > neighbors;
+  ordering.reserve(nv);
+  for(std::size_t s = 0; s < nv; s++) {
+    std::size_t root = seeds[s].second;
+    if(visited[root]) continue;
+    // look for a pseudo-peripheral node: breadth-first traversal from the seed,
+    // keeping the node of minimum degree in the last level
+    std::size_t first = ordering.size();
+    ordering.push_back(root);
+    visited[root] = 1;
+    level[root] = 0;
+    for(std::size_t i = first; i < ordering.size(); i++) {
+      std::size_t v = ordering[i];
+      for(std::size_t j = start[v]; j < start[v + 1]; j++) {
+        if(!visited[adj[j]]) {
+          visited[adj[j]] = 1;
+          level[adj[j]] = level[v] + 1;
+          ordering.push_back(adj[j]);
+        }
+      }
+    }
+    std::size_t last = ordering.back();
+    root = last;
+    for(std::size_t i = first; i < ordering.size(); i++) {
+      std::size_t v = ordering[i];
+      if(level[v] == level[last] && degree[v] < degree[root]) root = v;
+    }
+    for(std::size_t i = first; i < ordering.size(); i++)
+      visited[ordering[i]] = 0;
+    ordering.resize(first);
+    // Cuthill-McKee traversal, visiting the neighbors by increasing degree
+    ordering.push_back(root);
+    visited[root] = 1;
+    for(std::size_t i = first; i < ordering.size(); i++) {
+      std::size_t v = ordering[i];
+      neighbors.clear();
+      for(std::size_t j = start[v]; j < start[v + 1]; j++) {
+        if(!visited[adj[j]]) {
+          visited[adj[j]] = 1;
+          neighbors.push_back(std::make_pair(degree[adj[j]], adj[j]));
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      for(std::size_t j = 0; j < neighbors.size(); j++)
+        ordering.push_back(neighbors[j].second);
+    }
+  }
+  std::reverse(ordering.begin(), ordering.end());
+}
+
+void GModel::reorderMeshVertices(int method)
+{
+  // nodes on points and curves are left untouched, as they are ordered along
+  // the curves (which is assumed by several algorithms)
+  std::vector<GEntity *> entities;
+  getEntities(entities);
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    GEntity *ge = entities[i];
+    if(ge->dim() < 2 || ge->mesh_vertices.size() < 2) continue;
+    std::vector<std::size_t> ordering;
+    if(method == 3) { _rcmOrdering(ge, ordering); }
+    else {
+      std::vector<SPoint3> points(ge->mesh_vertices.size());
+      for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++)
+        points[j] = ge->mesh_vertices[j]->point();
+      SortSpaceFillingCurve(points, ordering, method == 1);
+    }
+    if(ordering.size() != ge->mesh_vertices.size()) continue;
+    std::vector<MVertex *> vertices(ordering.size());
+    for(std::size_t j = 0; j < ordering.size(); j++)
+      vertices[j] = ge->mesh_vertices[ordering[j]];
+    ge->mesh_vertices = vertices;
+  }
+}
+
+void GModel::reorderMeshElements(int method)
+{
+  std::vector<GEntity *> entities;
+  getEntities(entities);
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    GEntity *ge = entities[i];
+    if(ge->dim() < 2) continue;
+    std::vector<int> types;
+    ge->getElementTypes(types);
+    for(std::size_t t = 0; t < types.size(); t++) {
+      std::size_t ne = ge->getNumMeshElementsByType(types[t]);
+      if(ne < 2) continue;
+      std::vector<std::size_t> ordering;
+      if(method == 3) {
+        // sort by smallest (then largest) node tag, so that the elements follow
+        // the node numbering
+        std::vector<std::pair<std::pair<std::size_t, std::size_t>,
+                              std::size_t> > keys(ne);
+        for(std::size_t j = 0; j < ne; j++) {
+          MElement *e = ge->getMeshElementByType(types[t], j);
+          std::size_t vmin = e->getVertex(0)->getNum(), vmax = vmin;
+          for(std::size_t k = 1; k < e->getNumVertices(); k++) {
+            vmin = std::min(vmin, e->getVertex(k)->getNum());
+            vmax = std::max(vmax, e->getVertex(k)->getNum());
+          }
+          keys[j] = std::make_pair(std::make_pair(vmin, vmax), j);
+        }
+        std::sort(keys.begin(), keys.end());
+        ordering.resize(ne);
+        for(std::size_t j = 0; j < ne; j++) ordering[j] = keys[j].second;
+      }
+      else {
+        std::vector<SPoint3> points(ne);
+        for(std::size_t j = 0; j < ne; j++)
+          points[j] = ge->getMeshElementByType(types[t], j)->barycenter();
+        SortSpaceFillingCurve(points, ordering, method == 1);
+      }
+      int mshType = ge->getMeshElementByType(types[t], 0)->getTypeForMSH();
+      if(!ge->reorder(mshType, ordering))
+        Msg::Debug("Could not reorder elements of type %d in entity (%d,%d)",
+                   mshType, ge->dim(), ge->tag());
+    }
+  }
+}
+
 void GModel::renumberMeshVertices()
 {
   destroyMeshCaches();
+  if(CTX::instance()->mesh.reorder)
+    reorderMeshVertices(CTX::instance()->mesh.reorder);
   setMaxVertexNumber(CTX::instance()->mesh.firstNodeTag - 1);
   std::vector<GEntity *> entities;
   getEntities(entities);
@@ -1547,6 +1840,8 @@ void GModel::renumberMeshVertices()
 void GModel::renumberMeshElements()
 {
   destroyMeshCaches();
+  if(CTX::instance()->mesh.reorder)
+    reorderMeshElements(CTX::instance()->mesh.reorder);
   setMaxElementNumber(CTX::instance()->mesh.firstElementTag - 1);
   std::vector<GEntity *> entities;
   getEntities(entities);
@@ -1643,6 +1938,7 @@ std::vector<MElement *> GModel::getMeshElementsByCoord(SPoint3 &p, int dim,
 
 void GModel::rebuildMeshVertexCache(bool onlyIfNecessary)
 {
+  _updateMeshCaches();
   if(!onlyIfNecessary ||
      (_vertexVectorCache.empty() && _vertexMapCache.empty())) {
     _vertexVectorCache.clear();
@@ -1678,6 +1974,7 @@ void GModel::rebuildMeshVertexCache(bool onlyIfNecessary)
 
 void GModel::rebuildMeshElementCache(bool onlyIfNecessary)
 {
+  _updateMeshCaches();
   if(!onlyIfNecessary || (_elementVectorCache.empty() && _elementMapCache.empty())) {
     Msg::Debug("Rebuilding mesh element cache");
     _elementVectorCache.clear();
@@ -1715,6 +2012,7 @@ void GModel::rebuildMeshElementCache(bool onlyIfNecessary)
 
 MVertex *GModel::getMeshVertexByTag(int n)
 {
+  _updateMeshCaches();
   if(_vertexVectorCache.empty() && _vertexMapCache.empty()) {
     Msg::Debug("Rebuilding mesh node cache");
     rebuildMeshVertexCache();
@@ -1754,6 +2052,7 @@ void GModel::getMeshVerticesForPhysicalGroup(int dim, int num,
 
 MElement *GModel::getMeshElementByTag(int n)
 {
+  _updateMeshCaches();
   if(_elementVectorCache.empty() && _elementMapCache.empty()) {
     Msg::Debug("Rebuilding mesh element cache");
     rebuildMeshElementCache();
@@ -84,6 +84,9 @@ private:
   int _writePartitionedMSH4(const std::string &baseName, double version,
                             bool binary, bool saveAll, bool saveParametric,
                             double scalingFactor);
+  int _writePartitionedMSH4Streaming(const std::string &baseName,
+                                     double version, bool binary, bool saveAll,
+                                     double scalingFactor);
 
 protected:
   // the name of the model
@@ -104,6 +107,11 @@ protected:
   std::map<int, MElement *> _elementMapCache;
   std::map<int, int> _elementIndexCache;
 
+  // entities (with their dimension and tag, to check that they still exist)
+  // whose mesh nodes and elements need to be added to the caches
+  std::map<GEntity *, std::pair<int, int> > _entitiesToCache;
+  void _updateMeshCaches();
+
   // ghost cell information (stores partitions for each element acting
   // as a ghost cell)
   // /!\ Use only for compatibility with mesh format msh2 and msh3
@@ -152,6 +160,10 @@ protected:
   // the set of all used mesh partition numbers
   std::size_t _numPartitions;
 
+  // the number of partitions only stored in the mesh elements, without
+  // partition entities (see Mesh.PartitionStreamMeshFiles)
+  std::size_t _numStreamPartitions;
+
 protected:
   // store the elements given in the map (indexed by elementary region
   // number) into the model, creating discrete geometrical entities on
@@ -292,9 +304,23 @@ public:
   void renumberMeshVertices();
   void renumberMeshElements();
 
+  // reorder the mesh nodes and elements of surfaces and volumes to improve
+  // memory locality (1: Hilbert curve, 2: Morton curve, 3: reverse
+  // Cuthill-McKee); this is called before renumbering if Mesh.Reorder is set
+  void reorderMeshVertices(int method);
+  void reorderMeshElements(int method);
+
   // delete all the mesh-related caches (this must be called when the
   // mesh is changed)
   void destroyMeshCaches();
+  // remove the mesh nodes and elements of the given entity from the caches
+  // (this must be called before they are deleted) and mark the entity so that
+  // its new mesh is added to the caches when they are next accessed; this
+  // allows to modify meshes entity by entity without rebuilding the caches
+  void destroyMeshCaches(GEntity *ge);
+  // mark the entity so that the mesh nodes and elements that have been added
+  // to it are added to the caches when they are next accessed
+  void updateMeshCaches(GEntity *ge);
   // delete the mesh stored in entities and call destroMeshCaches
   void deleteMesh();
   void deleteMesh(const std::vector<GEntity *> &entities);
@@ -585,6 +611,11 @@ public:
   // the list of partitions
   std::size_t getNumPartitions() const { return _numPartitions; }
   void setNumPartitions(std::size_t npart) { _numPartitions = npart; }
+  std::size_t getNumStreamPartitions() const { return _numStreamPartitions; }
+  void setNumStreamPartitions(std::size_t npart)
+  {
+    _numStreamPartitions = npart;
+  }
 
   // partition the mesh
   int partitionMesh(int num);
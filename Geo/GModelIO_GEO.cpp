@@ -797,8 +797,8 @@ bool GEO_Internals::remove(int dim, int tag, bool recursive)
 bool GEO_Internals::remove(const std::vector<std::pair<int, int> > &dimTags,
                            bool recursive)
 {
-  for(std::size_t i = 0; i < dimTags.size(); i++)
-    remove(dimTags[i].first, dimTags[i].second, recursive);
+  DeleteShapes(dimTags, recursive);
+  _changed = true;
   return true;
 }
 
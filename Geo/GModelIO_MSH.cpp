@@ -108,6 +108,15 @@ int GModel::writePartitionedMSH(const std::string &baseName, double version,
                                 bool binary, bool saveAll, bool saveParametric,
                                 double scalingFactor)
 {
+  if(!getNumPartitions() && getNumStreamPartitions()) {
+    if(version < 4.1) {
+      Msg::Error("Streaming partitioned mesh files requires MSH 4.1 or above");
+      return 0;
+    }
+    return _writePartitionedMSH4Streaming(baseName, version, binary, saveAll,
+                                          scalingFactor);
+  }
+
   if(version < 4.0 && getNumPartitions() > 0) {
     Msg::Warning("Saving a partitioned mesh in a format older than 4.0 may "
                  "cause information loss");
@@ -39,6 +39,12 @@
 #include "MPyramid.h"
 #include "MTrihedron.h"
 #include "StringUtils.h"
+#include "ElementType.h"
+#include "GmshConfig.h"
+
+#if defined(HAVE_MESH)
+#include "meshPartition.h"
+#endif
 
 static bool readMSH4Physicals(GModel *const model, FILE *fp,
                               GEntity *const entity, bool binary, char *str,
@@ -2783,6 +2789,34 @@ static void writeMSH4Parametrizations(GModel *const model, FILE *fp,
   fprintf(fp, "$EndParametrizations\n");
 }
 
+static void writeMSH4Header(GModel *const model, FILE *fp, double version,
+                            bool binary)
+{
+  // header
+  fprintf(fp, "$MeshFormat\n");
+  fprintf(fp, "%g %d %lu\n", version, (binary ? 1 : 0), sizeof(std::size_t));
+  if(binary) {
+    int one = 1;
+    fwrite(&one, sizeof(int), 1, fp); // swapping byte
+    fprintf(fp, "\n");
+  }
+  fprintf(fp, "$EndMeshFormat\n");
+
+  // physicals
+  if(model->numPhysicalNames() > 0) {
+    fprintf(fp, "$PhysicalNames\n");
+    fprintf(fp, "%d\n", model->numPhysicalNames());
+    for(GModel::piter it = model->firstPhysicalName();
+        it != model->lastPhysicalName(); ++it) {
+      std::string name = it->second;
+      if(name.size() > 128) name.resize(128);
+      fprintf(fp, "%d %d \"%s\"\n", it->first.first, it->first.second,
+              name.c_str());
+    }
+    fprintf(fp, "$EndPhysicalNames\n");
+  }
+}
+
 int GModel::_writeMSH4(const std::string &name, double version, bool binary,
                        bool saveAll, bool saveParametric, double scalingFactor,
                        bool append)
@@ -2806,28 +2840,8 @@ int GModel::_writeMSH4(const std::string &name, double version, bool binary,
   // if there are no physicals we save all the elements
   if(noPhysicalGroups()) saveAll = true;
 
-  // header
-  fprintf(fp, "$MeshFormat\n");
-  fprintf(fp, "%g %d %lu\n", version, (binary ? 1 : 0), sizeof(std::size_t));
-  if(binary) {
-    int one = 1;
-    fwrite(&one, sizeof(int), 1, fp); // swapping byte
-    fprintf(fp, "\n");
-  }
-  fprintf(fp, "$EndMeshFormat\n");
-
-  // physicals
-  if(numPhysicalNames() > 0) {
-    fprintf(fp, "$PhysicalNames\n");
-    fprintf(fp, "%d\n", numPhysicalNames());
-    for(piter it = firstPhysicalName(); it != lastPhysicalName(); ++it) {
-      std::string name = it->second;
-      if(name.size() > 128) name.resize(128);
-      fprintf(fp, "%d %d \"%s\"\n", it->first.first, it->first.second,
-              name.c_str());
-    }
-    fprintf(fp, "$EndPhysicalNames\n");
-  }
+  // header and physicals
+  writeMSH4Header(this, fp, version, binary);
 
   // entities
   writeMSH4Entities(this, fp, false, binary, scalingFactor, version);
@@ -3091,6 +3105,912 @@ int GModel::_writePartitionedMSH4(const std::string &baseName, double version,
   return 1;
 }
 
+#if defined(HAVE_MESH)
+
+// Streaming output of partitioned MSH4 files: instead of creating partition
+// entities in the model, each partition file is written directly from the
+// partition of each element (MElement::getPartition()). The partition topology
+// is the one created by the partitioner (the reference elements, partitions,
+// elements and orientations of the partition boundaries are given by the
+// functions of meshPartition.h shared with createPartitionTopology()), but is
+// computed on flat arrays: the partitioned entities are the parts of the
+// original entities containing elements of each partition; the partition
+// boundaries of dimension meshDim-1 are the facets (faces in 3D, edges in 2D,
+// nodes in 1D) shared by elements of different partitions, and the partition
+// boundaries of lower dimension are the facets of the partitioned entities and
+// partition boundaries of the next dimension where the set of partitions
+// changes. The ghost cells are the elements of the other partitions sharing a
+// node with the partition.
+
+// Partitioned entity or partition boundary
+struct MSH4StreamPiece {
+  int dim, tag;
+  // parent model entity (for partition boundaries, the parent of the
+  // reference partitioned entity)
+  GEntity *parent;
+  bool boundary;
+  std::vector<int> partitions;
+  // signed tags of the bounding pieces
+  std::vector<int> bounding;
+};
+
+// Cell from which the facets of the partition boundaries of a given dimension
+// are extracted: a mesh element, or an element of a partition boundary (item)
+struct MSH4StreamCell {
+  int dim;
+  std::size_t piece;
+  MElement *element;
+  MSH4StreamCell(int d, std::size_t p, MElement *e)
+    : dim(d), piece(p), element(e)
+  {
+  }
+};
+
+// Facet of a cell, identified by its sorted primary node tags (facet = -1 for
+// a mesh element of the dimension of the facets, i.e. the facet itself)
+struct MSH4StreamFacet {
+  std::size_t v[4];
+  std::size_t cell;
+  int facet;
+  bool operator<(const MSH4StreamFacet &other) const
+  {
+    for(int i = 0; i < 4; i++) {
+      if(v[i] != other.v[i]) return v[i] < other.v[i];
+    }
+    if(cell != other.cell) return cell < other.cell;
+    return facet < other.facet;
+  }
+  bool sameKey(const MSH4StreamFacet &other) const
+  {
+    for(int i = 0; i < 4; i++) {
+      if(v[i] != other.v[i]) return false;
+    }
+    return true;
+  }
+};
+
+static bool MSH4StreamFacetKeyLessThan(const MSH4StreamFacet &f1,
+                                       const MSH4StreamFacet &f2)
+{
+  for(int i = 0; i < 4; i++) {
+    if(f1.v[i] != f2.v[i]) return f1.v[i] < f2.v[i];
+  }
+  return false;
+}
+
+// Global data shared by all the partition files (read-only once computed)
+struct MSH4StreamData {
+  std::string header;
+  std::vector<GEntity *> entities;
+  std::vector<MElement *> elements;
+  std::vector<std::size_t> elementEntity, elementPiece;
+  std::vector<int> elementPartition;
+  // elements of each partition, in the order of the entities
+  std::vector<std::size_t> partStart, partElements;
+  // partitioned entities, sorted by partition and entity (those of partition
+  // p start at partPieceStart[p]), followed by the partition boundaries
+  std::vector<MSH4StreamPiece> pieces;
+  std::vector<std::size_t> partPieceStart;
+  // elements of the partition boundaries (and their piece), the elements of
+  // each piece, and the partition boundaries of each partition
+  std::vector<MElement *> items;
+  std::vector<std::size_t> itemPiece;
+  std::vector<std::size_t> pieceItemStart, pieceItems;
+  std::vector<std::size_t> boundaryStart, boundaryList;
+  // (partition, element) ghost cells, sorted by partition
+  std::vector<std::pair<int, std::size_t> > ghosts;
+  int maxEntityTag[4], numEntities[4];
+  std::size_t firstItemTag;
+  int numPartitions, meshDim;
+  bool binary;
+  double version, scalingFactor;
+  ~MSH4StreamData()
+  {
+    for(std::size_t i = 0; i < items.size(); i++) delete items[i];
+  }
+};
+
+// Entity (piece or ghost entity) of a partition file
+struct MSH4StreamEntity {
+  int dim, tag;
+  const MSH4StreamPiece *piece;
+  bool ghost;
+  SBoundingBox3d bbox;
+  std::vector<std::size_t> nodes;
+  MSH4StreamEntity(int d, int t, const MSH4StreamPiece *p, bool g = false)
+    : dim(d), tag(t), piece(p), ghost(g)
+  {
+  }
+};
+
+// Block of elements of the same type in an entity of a partition file, stored
+// as the element tag followed by the node tags
+struct MSH4StreamBlock {
+  std::size_t entity;
+  int type;
+  std::size_t numNodes;
+  std::vector<std::size_t> data;
+};
+
+static int getMSH4StreamNumFacets(const MSH4StreamCell &c)
+{
+  if(c.dim == 3) return c.element->getNumFaces();
+  if(c.dim == 2) return c.element->getNumEdges();
+  if(c.dim == 1) return c.element->getNumPrimaryVertices();
+  return 0;
+}
+
+// sort the (at most 4) primary node tags of a facet key
+static void sortMSH4StreamKey(std::size_t v[4], int n)
+{
+  for(int i = 1; i < n; i++) {
+    std::size_t t = v[i];
+    int j = i;
+    for(; j > 0 && v[j - 1] > t; j--) v[j] = v[j - 1];
+    v[j] = t;
+  }
+}
+
+static void getMSH4StreamFacetKey(const MSH4StreamCell &c, int j,
+                                  std::size_t v[4])
+{
+  for(int i = 0; i < 4; i++) v[i] = 0;
+  int n = 0;
+  if(c.dim == 3) {
+    MFace f = c.element->getFace(j);
+    for(std::size_t i = 0; i < f.getNumVertices() && i < 4; i++)
+      v[n++] = f.getVertex(i)->getNum();
+  }
+  else if(c.dim == 2) {
+    MEdge ed = c.element->getEdge(j);
+    v[n++] = ed.getVertex(0)->getNum();
+    v[n++] = ed.getVertex(1)->getNum();
+  }
+  else {
+    v[n++] = c.element->getVertex(j)->getNum();
+  }
+  sortMSH4StreamKey(v, n);
+}
+
+static void addMSH4StreamBounding(MSH4StreamData &d,
+                                  std::set<std::pair<std::size_t, std::size_t> >
+                                    &bounded,
+                                  std::size_t piece, std::size_t bounding,
+                                  int ori)
+{
+  if(bounded.insert(std::make_pair(piece, bounding)).second)
+    d.pieces[piece].bounding.push_back(ori * d.pieces[bounding].tag);
+}
+
+// Compute the partition boundaries of dimension meshDim-1 down to 0, and the
+// bounding pieces of all the pieces, from the partitioned entities. A facet of
+// dimension dim is a partition boundary if the pieces of dimension dim+1
+// containing it do not all have the same partitions; it belongs to the
+// partition boundary defined by the union of these partitions and by the
+// reference piece (the one with the fewest, then the lowest, partitions). The
+// partitioned entities of a partition are bounded by the partitioned entities
+// of the same partition whose elements are facets of their elements. Only the
+// facets whose nodes are shared by several partitions, or that are elements
+// themselves, are considered.
+static void computeMSH4StreamTopology(MSH4StreamData &d,
+                                      const std::vector<char> &shared)
+{
+  const std::size_t ne = d.elements.size();
+  std::vector<std::vector<std::size_t> > elementsOfDim(4);
+  for(std::size_t i = 0; i < ne; i++)
+    elementsOfDim[d.elements[i]->getDim()].push_back(i);
+
+  std::set<std::pair<std::size_t, std::size_t> > bounded;
+  std::map<std::pair<std::vector<int>, std::size_t>, std::size_t> boundaries;
+  std::size_t levelBegin = 0, levelEnd = 0;
+  for(int dim = d.meshDim - 1; dim >= 0; dim--) {
+    // cells of dimension dim + 1 (mesh elements and elements of the partition
+    // boundaries created at the previous level), followed by the mesh elements
+    // of dimension dim
+    std::vector<MSH4StreamCell> cells;
+    for(std::size_t i = 0; i < elementsOfDim[dim + 1].size(); i++) {
+      std::size_t ie = elementsOfDim[dim + 1][i];
+      cells.push_back(
+        MSH4StreamCell(dim + 1, d.elementPiece[ie], d.elements[ie]));
+    }
+    for(std::size_t i = levelBegin; i < levelEnd; i++)
+      cells.push_back(MSH4StreamCell(dim + 1, d.itemPiece[i], d.items[i]));
+    const std::size_t nc = cells.size();
+    std::vector<MSH4StreamFacet> own;
+    for(std::size_t i = 0; i < elementsOfDim[dim].size(); i++) {
+      std::size_t ie = elementsOfDim[dim][i];
+      MElement *e = d.elements[ie];
+      if(e->getNumPrimaryVertices() > 4) continue;
+      MSH4StreamFacet f;
+      for(int k = 0; k < 4; k++) f.v[k] = 0;
+      for(std::size_t k = 0; k < e->getNumPrimaryVertices(); k++)
+        f.v[k] = e->getVertex(k)->getNum();
+      sortMSH4StreamKey(f.v, e->getNumPrimaryVertices());
+      f.cell = cells.size();
+      f.facet = -1;
+      cells.push_back(MSH4StreamCell(dim, d.elementPiece[ie], e));
+      own.push_back(f);
+    }
+    std::sort(own.begin(), own.end());
+
+    std::vector<MSH4StreamFacet> facets;
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      std::vector<MSH4StreamFacet> localFacets;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 1024)
+#endif
+      for(std::size_t c = 0; c < nc; c++) {
+        for(int j = 0; j < getMSH4StreamNumFacets(cells[c]); j++) {
+          MSH4StreamFacet f;
+          getMSH4StreamFacetKey(cells[c], j, f.v);
+          bool onBoundary = true;
+          for(int k = 0; k < 4; k++) {
+            if(f.v[k] && !shared[f.v[k]]) {
+              onBoundary = false;
+              break;
+            }
+          }
+          if(!onBoundary && !std::binary_search(own.begin(), own.end(), f,
+                                                MSH4StreamFacetKeyLessThan))
+            continue;
+          f.cell = c;
+          f.facet = j;
+          localFacets.push_back(f);
+        }
+      }
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      facets.insert(facets.end(), localFacets.begin(), localFacets.end());
+    }
+    facets.insert(facets.end(), own.begin(), own.end());
+    std::vector<MSH4StreamFacet>().swap(own);
+    std::sort(facets.begin(), facets.end());
+
+    std::vector<MVertex *> verts;
+    std::vector<const std::vector<int> *> partitions;
+    std::vector<int> parts;
+    for(std::size_t i = 0; i < facets.size();) {
+      std::size_t j = i + 1;
+      while(j < facets.size() && facets[j].sameKey(facets[i])) j++;
+      // the cells containing the facet come first, followed by the mesh
+      // elements matching the facet
+      std::size_t k = i;
+      while(k < j && facets[k].facet >= 0) k++;
+
+      for(std::size_t s = k; s < j; s++) {
+        const MSH4StreamCell &cs = cells[facets[s].cell];
+        cs.element->getVertices(verts);
+        for(std::size_t c = i; c < k; c++) {
+          const MSH4StreamCell &cc = cells[facets[c].cell];
+          if(d.pieces[cc.piece].boundary ||
+             d.pieces[cc.piece].partitions != d.pieces[cs.piece].partitions)
+            continue;
+          addMSH4StreamBounding(d, bounded, cc.piece, cs.piece,
+                                getPartitionBoundaryOrientation(
+                                  cc.element, dim, facets[c].facet, verts));
+        }
+      }
+
+      partitions.clear();
+      for(std::size_t c = i; c < k; c++)
+        partitions.push_back(&d.pieces[cells[facets[c].cell].piece].partitions);
+      int ref = getPartitionBoundaryReference(partitions, parts);
+      if(ref >= 0) {
+        const MSH4StreamCell &cr = cells[facets[i + ref].cell];
+        std::pair<std::vector<int>, std::size_t> key(parts, cr.piece);
+        std::map<std::pair<std::vector<int>, std::size_t>,
+                 std::size_t>::iterator it = boundaries.find(key);
+        if(it == boundaries.end()) {
+          MSH4StreamPiece b;
+          b.dim = dim;
+          b.tag = d.maxEntityTag[dim] + (++d.numEntities[dim]);
+          b.parent = d.pieces[cr.piece].parent;
+          b.boundary = true;
+          b.partitions = parts;
+          it = boundaries.insert(std::make_pair(key, d.pieces.size())).first;
+          d.pieces.push_back(b);
+        }
+        const std::size_t bp = it->second;
+        MElement *item = createPartitionBoundaryElement(
+          cr.element, dim, facets[i + ref].facet);
+        d.items.push_back(item);
+        d.itemPiece.push_back(bp);
+        item->getVertices(verts);
+        for(std::size_t c = i; c < k; c++) {
+          const MSH4StreamCell &cc = cells[facets[c].cell];
+          addMSH4StreamBounding(d, bounded, cc.piece, bp,
+                                getPartitionBoundaryOrientation(
+                                  cc.element, dim, facets[c].facet, verts));
+        }
+      }
+      i = j;
+    }
+    levelBegin = levelEnd;
+    levelEnd = d.itemPiece.size();
+  }
+
+  // elements of each piece, and partition boundaries of each partition
+  const std::size_t np = d.pieces.size(), ni = d.itemPiece.size();
+  d.pieceItemStart.resize(np + 1, 0);
+  d.pieceItems.resize(ni);
+  for(std::size_t i = 0; i < ni; i++) d.pieceItemStart[d.itemPiece[i] + 1]++;
+  for(std::size_t i = 0; i < np; i++)
+    d.pieceItemStart[i + 1] += d.pieceItemStart[i];
+  {
+    std::vector<std::size_t> fill(d.pieceItemStart);
+    for(std::size_t i = 0; i < ni; i++)
+      d.pieceItems[fill[d.itemPiece[i]]++] = i;
+  }
+  d.boundaryStart.resize(d.numPartitions + 2, 0);
+  for(std::size_t i = 0; i < np; i++) {
+    if(!d.pieces[i].boundary) continue;
+    for(std::size_t j = 0; j < d.pieces[i].partitions.size(); j++)
+      d.boundaryStart[d.pieces[i].partitions[j] + 1]++;
+  }
+  for(int p = 1; p <= d.numPartitions; p++)
+    d.boundaryStart[p + 1] += d.boundaryStart[p];
+  d.boundaryList.resize(d.boundaryStart[d.numPartitions + 1]);
+  {
+    std::vector<std::size_t> fill(d.boundaryStart);
+    for(std::size_t i = 0; i < np; i++) {
+      if(!d.pieces[i].boundary) continue;
+      for(std::size_t j = 0; j < d.pieces[i].partitions.size(); j++)
+        d.boundaryList[fill[d.pieces[i].partitions[j]]++] = i;
+    }
+  }
+}
+
+static void writeMSH4StreamSize(FILE *fp, bool binary, std::size_t n)
+{
+  if(binary)
+    fwrite(&n, sizeof(std::size_t), 1, fp);
+  else
+    fprintf(fp, "%lu ", n);
+}
+
+static void writeMSH4StreamInt(FILE *fp, bool binary, int n)
+{
+  if(binary)
+    fwrite(&n, sizeof(int), 1, fp);
+  else
+    fprintf(fp, "%d ", n);
+}
+
+static bool writeMSH4StreamPartition(const MSH4StreamData &d, int p,
+                                     const std::string &name)
+{
+  std::vector<MSH4StreamEntity> entities;
+  std::vector<MSH4StreamBlock> blocks;
+  // (node tag, local entity, node) for the classification of the nodes
+  std::vector<std::pair<std::pair<std::size_t, std::size_t>, MVertex *> > nodes;
+
+  // partitioned entities
+  const std::size_t firstPiece = d.partPieceStart[p];
+  for(std::size_t i = firstPiece; i < d.partPieceStart[p + 1]; i++)
+    entities.push_back(
+      MSH4StreamEntity(d.pieces[i].dim, d.pieces[i].tag, &d.pieces[i]));
+  for(std::size_t i = d.partStart[p]; i < d.partStart[p + 1]; i++) {
+    std::size_t ie = d.partElements[i];
+    MElement *e = d.elements[ie];
+    std::size_t le = d.elementPiece[ie] - firstPiece;
+    int type = e->getTypeForMSH();
+    if(blocks.empty() || blocks.back().entity != le ||
+       blocks.back().type != type) {
+      blocks.push_back(MSH4StreamBlock());
+      blocks.back().entity = le;
+      blocks.back().type = type;
+      blocks.back().numNodes = e->getNumVertices();
+    }
+    blocks.back().data.push_back(e->getNum());
+    for(std::size_t j = 0; j < e->getNumVertices(); j++) {
+      MVertex *v = e->getVertex(j);
+      blocks.back().data.push_back(v->getNum());
+      entities[le].bbox += v->point();
+      nodes.push_back(std::make_pair(std::make_pair(v->getNum(), le), v));
+    }
+  }
+
+  // partition boundaries
+  for(std::size_t i = d.boundaryStart[p]; i < d.boundaryStart[p + 1]; i++) {
+    const MSH4StreamPiece &piece = d.pieces[d.boundaryList[i]];
+    std::size_t le = entities.size();
+    entities.push_back(MSH4StreamEntity(piece.dim, piece.tag, &piece));
+    std::map<int, std::size_t> typeBlocks;
+    for(std::size_t j = d.pieceItemStart[d.boundaryList[i]];
+        j < d.pieceItemStart[d.boundaryList[i] + 1]; j++) {
+      std::size_t item = d.pieceItems[j];
+      MElement *e = d.items[item];
+      int type = e->getTypeForMSH();
+      std::map<int, std::size_t>::iterator itb = typeBlocks.find(type);
+      if(itb == typeBlocks.end()) {
+        itb = typeBlocks.insert(std::make_pair(type, blocks.size())).first;
+        blocks.push_back(MSH4StreamBlock());
+        blocks.back().entity = le;
+        blocks.back().type = type;
+        blocks.back().numNodes = e->getNumVertices();
+      }
+      MSH4StreamBlock &b = blocks[itb->second];
+      b.data.push_back(d.firstItemTag + item);
+      for(std::size_t k = 0; k < e->getNumVertices(); k++) {
+        MVertex *v = e->getVertex(k);
+        b.data.push_back(v->getNum());
+        entities[le].bbox += v->point();
+        nodes.push_back(std::make_pair(std::make_pair(v->getNum(), le), v));
+      }
+    }
+  }
+
+  // ghost cells
+  std::vector<std::pair<int, std::size_t> >::const_iterator gbeg =
+    std::lower_bound(d.ghosts.begin(), d.ghosts.end(),
+                     std::make_pair(p, (std::size_t)0));
+  std::vector<std::pair<int, std::size_t> >::const_iterator gend =
+    std::lower_bound(d.ghosts.begin(), d.ghosts.end(),
+                     std::make_pair(p + 1, (std::size_t)0));
+  int ghostTag = 0;
+  if(gbeg != gend) {
+    ghostTag = d.maxEntityTag[d.meshDim] + d.numEntities[d.meshDim] + p;
+    std::size_t le = entities.size();
+    entities.push_back(MSH4StreamEntity(d.meshDim, ghostTag, 0, true));
+    std::map<int, std::size_t> ghostBlocks;
+    for(std::vector<std::pair<int, std::size_t> >::const_iterator it = gbeg;
+        it != gend; ++it) {
+      MElement *e = d.elements[it->second];
+      int type = e->getTypeForMSH();
+      std::map<int, std::size_t>::iterator itb = ghostBlocks.find(type);
+      if(itb == ghostBlocks.end()) {
+        itb = ghostBlocks.insert(std::make_pair(type, blocks.size())).first;
+        blocks.push_back(MSH4StreamBlock());
+        blocks.back().entity = le;
+        blocks.back().type = type;
+        blocks.back().numNodes = e->getNumVertices();
+      }
+      MSH4StreamBlock &b = blocks[itb->second];
+      b.data.push_back(e->getNum());
+      for(std::size_t j = 0; j < e->getNumVertices(); j++) {
+        MVertex *v = e->getVertex(j);
+        b.data.push_back(v->getNum());
+        nodes.push_back(std::make_pair(std::make_pair(v->getNum(), le), v));
+      }
+    }
+  }
+
+  // sort the entities by dimension and tag (the ghost entity last), and
+  // classify each node on the first entity containing it
+  std::vector<std::pair<std::pair<int, std::pair<int, int> >, std::size_t> >
+    order(entities.size());
+  for(std::size_t i = 0; i < entities.size(); i++)
+    order[i] = std::make_pair(
+      std::make_pair(entities[i].ghost ? 1 : 0,
+                     std::make_pair(entities[i].dim, entities[i].tag)),
+      i);
+  std::sort(order.begin(), order.end());
+  std::vector<std::size_t> rank(entities.size());
+  for(std::size_t i = 0; i < order.size(); i++) rank[order[i].second] = i;
+  for(std::size_t i = 0; i < nodes.size(); i++)
+    nodes[i].first.second = rank[nodes[i].first.second];
+  std::sort(nodes.begin(), nodes.end());
+  std::vector<MVertex *> nodeVertex;
+  std::size_t numNodes = 0, minNodeTag = 0, maxNodeTag = 0;
+  for(std::size_t i = 0; i < nodes.size(); i++) {
+    if(i && nodes[i].first.first == nodes[i - 1].first.first) continue;
+    MSH4StreamEntity &ent = entities[order[nodes[i].first.second].second];
+    ent.nodes.push_back(nodeVertex.size());
+    nodeVertex.push_back(nodes[i].second);
+    if(!numNodes) minNodeTag = nodes[i].first.first;
+    maxNodeTag = nodes[i].first.first;
+    numNodes++;
+  }
+  std::vector<std::pair<std::pair<std::size_t, std::size_t>, MVertex *> >()
+    .swap(nodes);
+
+  FILE *fp = Fopen(name.c_str(), d.binary ? "wb" : "w");
+  if(!fp) return false;
+  const bool binary = d.binary;
+
+  fwrite(d.header.c_str(), sizeof(char), d.header.size(), fp);
+
+  // partitioned entities
+  fprintf(fp, "$PartitionedEntities\n");
+  std::size_t numPerDim[4] = {0, 0, 0, 0};
+  for(std::size_t i = 0; i < entities.size(); i++)
+    if(!entities[i].ghost) numPerDim[entities[i].dim]++;
+  writeMSH4StreamSize(fp, binary, d.numPartitions);
+  if(!binary) fprintf(fp, "\n");
+  writeMSH4StreamSize(fp, binary, ghostTag ? 1 : 0);
+  if(!binary) fprintf(fp, "\n");
+  if(ghostTag) {
+    writeMSH4StreamInt(fp, binary, ghostTag);
+    writeMSH4StreamInt(fp, binary, p);
+    if(!binary) fprintf(fp, "\n");
+  }
+  for(int dim = 0; dim < 4; dim++) writeMSH4StreamSize(fp, binary, numPerDim[dim]);
+  if(!binary) fprintf(fp, "\n");
+  for(std::size_t i = 0; i < order.size(); i++) {
+    const MSH4StreamEntity &ent = entities[order[i].second];
+    if(ent.ghost) continue;
+    writeMSH4StreamInt(fp, binary, ent.tag);
+    const MSH4StreamPiece *piece = ent.piece;
+    writeMSH4StreamInt(fp, binary, piece->parent->dim());
+    writeMSH4StreamInt(fp, binary, piece->parent->tag());
+    writeMSH4StreamSize(fp, binary, piece->partitions.size());
+    for(std::size_t j = 0; j < piece->partitions.size(); j++)
+      writeMSH4StreamInt(fp, binary, piece->partitions[j]);
+    writeMSH4BoundingBox(ent.bbox, fp, d.scalingFactor, binary, ent.dim,
+                         d.version);
+    // all the partitioned entities (including partition boundaries) belong
+    // to the physical groups of their parent, as when partition entities are
+    // created
+    writeMSH4Physicals(fp, piece->parent, binary);
+    if(ent.dim > 0) {
+      writeMSH4StreamSize(fp, binary, piece->bounding.size());
+      for(std::size_t j = 0; j < piece->bounding.size(); j++)
+        writeMSH4StreamInt(fp, binary, piece->bounding[j]);
+    }
+    if(!binary) fprintf(fp, "\n");
+  }
+  if(binary) fprintf(fp, "\n");
+  fprintf(fp, "$EndPartitionedEntities\n");
+
+  // nodes
+  std::size_t numNodeBlocks = 0;
+  for(std::size_t i = 0; i < entities.size(); i++)
+    if(entities[i].nodes.size()) numNodeBlocks++;
+  fprintf(fp, "$Nodes\n");
+  if(binary) {
+    writeMSH4StreamSize(fp, binary, numNodeBlocks);
+    writeMSH4StreamSize(fp, binary, numNodes);
+    writeMSH4StreamSize(fp, binary, minNodeTag);
+    writeMSH4StreamSize(fp, binary, maxNodeTag);
+  }
+  else {
+    fprintf(fp, "%lu %lu %lu %lu\n", numNodeBlocks, numNodes, minNodeTag,
+            maxNodeTag);
+  }
+  for(std::size_t i = 0; i < order.size(); i++) {
+    const MSH4StreamEntity &ent = entities[order[i].second];
+    const std::size_t N = ent.nodes.size();
+    if(!N) continue;
+    if(binary) {
+      int parametric = 0;
+      std::size_t num = N;
+      fwrite(&ent.dim, sizeof(int), 1, fp);
+      fwrite(&ent.tag, sizeof(int), 1, fp);
+      fwrite(&parametric, sizeof(int), 1, fp);
+      fwrite(&num, sizeof(std::size_t), 1, fp);
+      std::vector<std::size_t> tags(N);
+      std::vector<double> coord(3 * N);
+      for(std::size_t j = 0; j < N; j++) {
+        MVertex *v = nodeVertex[ent.nodes[j]];
+        tags[j] = v->getNum();
+        coord[3 * j] = v->x() * d.scalingFactor;
+        coord[3 * j + 1] = v->y() * d.scalingFactor;
+        coord[3 * j + 2] = v->z() * d.scalingFactor;
+      }
+      fwrite(&tags[0], sizeof(std::size_t), N, fp);
+      fwrite(&coord[0], sizeof(double), 3 * N, fp);
+    }
+    else {
+      fprintf(fp, "%d %d 0 %lu\n", ent.dim, ent.tag, N);
+      for(std::size_t j = 0; j < N; j++)
+        fprintf(fp, "%lu\n", nodeVertex[ent.nodes[j]]->getNum());
+      for(std::size_t j = 0; j < N; j++) {
+        MVertex *v = nodeVertex[ent.nodes[j]];
+        fprintf(fp, "%.16g %.16g %.16g\n", v->x() * d.scalingFactor,
+                v->y() * d.scalingFactor, v->z() * d.scalingFactor);
+      }
+    }
+  }
+  if(binary) fprintf(fp, "\n");
+  fprintf(fp, "$EndNodes\n");
+
+  // elements, sorted by dimension and entity
+  std::vector<std::pair<std::pair<int, std::size_t>, std::size_t> > blockOrder(
+    blocks.size());
+  std::size_t numElements = 0, minElementTag = 0, maxElementTag = 0;
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    const MSH4StreamBlock &b = blocks[i];
+    blockOrder[i] = std::make_pair(
+      std::make_pair(entities[b.entity].dim, rank[b.entity]), i);
+    for(std::size_t j = 0; j < b.data.size(); j += b.numNodes + 1) {
+      if(!numElements || b.data[j] < minElementTag) minElementTag = b.data[j];
+      if(!numElements || b.data[j] > maxElementTag) maxElementTag = b.data[j];
+      numElements++;
+    }
+  }
+  std::stable_sort(blockOrder.begin(), blockOrder.end());
+  fprintf(fp, "$Elements\n");
+  if(binary) {
+    writeMSH4StreamSize(fp, binary, blocks.size());
+    writeMSH4StreamSize(fp, binary, numElements);
+    writeMSH4StreamSize(fp, binary, minElementTag);
+    writeMSH4StreamSize(fp, binary, maxElementTag);
+  }
+  else {
+    fprintf(fp, "%lu %lu %lu %lu\n", blocks.size(), numElements,
+            minElementTag, maxElementTag);
+  }
+  for(std::size_t i = 0; i < blockOrder.size(); i++) {
+    const MSH4StreamBlock &b = blocks[blockOrder[i].second];
+    const MSH4StreamEntity &ent = entities[b.entity];
+    const std::size_t n = b.numNodes + 1, N = b.data.size() / n;
+    if(binary) {
+      fwrite(&ent.dim, sizeof(int), 1, fp);
+      fwrite(&ent.tag, sizeof(int), 1, fp);
+      fwrite(&b.type, sizeof(int), 1, fp);
+      fwrite(&N, sizeof(std::size_t), 1, fp);
+      if(N) fwrite(&b.data[0], sizeof(std::size_t), N * n, fp);
+    }
+    else {
+      fprintf(fp, "%d %d %d %lu\n", ent.dim, ent.tag, b.type, N);
+      for(std::size_t j = 0; j < N; j++) {
+        for(std::size_t k = 0; k < n; k++)
+          fprintf(fp, "%lu ", b.data[j * n + k]);
+        fprintf(fp, "\n");
+      }
+    }
+  }
+  if(binary) fprintf(fp, "\n");
+  fprintf(fp, "$EndElements\n");
+
+  // ghost cells
+  if(gbeg != gend) {
+    fprintf(fp, "$GhostElements\n");
+    writeMSH4StreamSize(fp, binary, gend - gbeg);
+    if(!binary) fprintf(fp, "\n");
+    for(std::vector<std::pair<int, std::size_t> >::const_iterator it = gbeg;
+        it != gend; ++it) {
+      writeMSH4StreamSize(fp, binary, d.elements[it->second]->getNum());
+      writeMSH4StreamInt(fp, binary, d.elementPartition[it->second]);
+      writeMSH4StreamSize(fp, binary, 1);
+      writeMSH4StreamInt(fp, binary, p);
+      if(!binary) fprintf(fp, "\n");
+    }
+    if(binary) fprintf(fp, "\n");
+    fprintf(fp, "$EndGhostElements\n");
+  }
+
+  fclose(fp);
+  return true;
+}
+
+int GModel::_writePartitionedMSH4Streaming(const std::string &baseName,
+                                           double version, bool binary,
+                                           bool saveAll, double scalingFactor)
+{
+  double t1 = Cpu(), w1 = TimeOfDay();
+
+  // if there are no physicals we save all the elements
+  if(noPhysicalGroups()) saveAll = true;
+
+  MSH4StreamData d;
+  d.binary = binary;
+  d.version = version;
+  d.scalingFactor = scalingFactor;
+
+  // elements to save, in the order of the entities
+  getEntities(d.entities);
+  d.numPartitions = 0;
+  d.meshDim = 0;
+  std::size_t numUnpartitioned = 0, maxElementTag = getMaxElementNumber();
+  for(std::size_t i = 0; i < d.entities.size(); i++) {
+    GEntity *ge = d.entities[i];
+    if(!saveAll && ge->physicals.empty()) continue;
+    for(std::size_t j = 0; j < ge->getNumMeshElements(); j++) {
+      MElement *e = ge->getMeshElement(j);
+      int part = e->getPartition();
+      if(part < 1) {
+        numUnpartitioned++;
+        continue;
+      }
+      d.elements.push_back(e);
+      d.elementEntity.push_back(i);
+      d.elementPartition.push_back(part);
+      d.numPartitions = std::max(d.numPartitions, part);
+      d.meshDim = std::max(d.meshDim, e->getDim());
+      maxElementTag = std::max(maxElementTag, e->getNum());
+    }
+  }
+  if(!d.numPartitions) {
+    Msg::Error("No partitioned mesh elements to save: partition the mesh first");
+    return 0;
+  }
+  if(numUnpartitioned)
+    Msg::Warning("%lu mesh elements do not belong to any partition and will not "
+                 "be saved", numUnpartitioned);
+  const int np = d.numPartitions;
+  const std::size_t ne = d.elements.size();
+
+  // sort the elements by partition
+  d.partStart.resize(np + 2, 0);
+  d.partElements.resize(ne);
+  for(std::size_t i = 0; i < ne; i++) d.partStart[d.elementPartition[i] + 1]++;
+  for(int p = 1; p <= np; p++) d.partStart[p + 1] += d.partStart[p];
+  {
+    std::vector<std::size_t> fill(d.partStart);
+    for(std::size_t i = 0; i < ne; i++)
+      d.partElements[fill[d.elementPartition[i]]++] = i;
+  }
+
+  // partitioned entities: the entities of partition p of each dimension
+  // follow those of partitions 1, ..., p-1, and the partition boundaries
+  // follow all the partitioned entities of their dimension
+  for(int dim = 0; dim < 4; dim++) {
+    d.maxEntityTag[dim] = getMaxElementaryNumber(dim);
+    d.numEntities[dim] = 0;
+  }
+  d.elementPiece.resize(ne);
+  d.partPieceStart.resize(np + 2, 0);
+  for(int p = 1; p <= np; p++) {
+    d.partPieceStart[p] = d.pieces.size();
+    std::size_t last = d.entities.size();
+    for(std::size_t i = d.partStart[p]; i < d.partStart[p + 1]; i++) {
+      std::size_t ie = d.partElements[i];
+      if(d.elementEntity[ie] != last) {
+        last = d.elementEntity[ie];
+        MSH4StreamPiece piece;
+        piece.dim = d.entities[last]->dim();
+        piece.tag = d.maxEntityTag[piece.dim] + (++d.numEntities[piece.dim]);
+        piece.parent = d.entities[last];
+        piece.boundary = false;
+        piece.partitions.push_back(p);
+        d.pieces.push_back(piece);
+      }
+      d.elementPiece[ie] = d.pieces.size() - 1;
+    }
+  }
+  d.partPieceStart[np + 1] = d.pieces.size();
+
+  // nodes shared by elements of several partitions (all the partition
+  // boundaries are made of such nodes)
+  std::size_t maxNodeTag = getMaxVertexNumber();
+  for(std::size_t i = 0; i < ne; i++) {
+    MElement *e = d.elements[i];
+    for(std::size_t j = 0; j < e->getNumPrimaryVertices(); j++)
+      maxNodeTag = std::max(maxNodeTag, e->getVertex(j)->getNum());
+  }
+  std::vector<int> nodePartition(maxNodeTag + 1, 0);
+  std::vector<char> shared(maxNodeTag + 1, 0);
+  for(std::size_t i = 0; i < ne; i++) {
+    MElement *e = d.elements[i];
+    int part = d.elementPartition[i];
+    for(std::size_t j = 0; j < e->getNumPrimaryVertices(); j++) {
+      std::size_t n = e->getVertex(j)->getNum();
+      if(!nodePartition[n])
+        nodePartition[n] = part;
+      else if(nodePartition[n] != part)
+        shared[n] = 1;
+    }
+  }
+
+  // partition boundaries and topology of the partitioned entities
+  d.firstItemTag = maxElementTag + 1;
+  computeMSH4StreamTopology(d, shared);
+  std::vector<char>().swap(shared);
+
+  // ghost cells: elements of highest dimension sharing a node with elements
+  // of highest dimension of other partitions, computed in parallel
+  if(CTX::instance()->mesh.partitionCreateGhostCells) {
+    std::fill(nodePartition.begin(), nodePartition.end(), 0);
+    std::vector<std::pair<std::size_t, int> > sharedNodes;
+    for(std::size_t i = 0; i < ne; i++) {
+      MElement *e = d.elements[i];
+      if(e->getDim() != d.meshDim) continue;
+      int part = d.elementPartition[i];
+      for(std::size_t j = 0; j < e->getNumPrimaryVertices(); j++) {
+        std::size_t n = e->getVertex(j)->getNum();
+        if(!nodePartition[n])
+          nodePartition[n] = part;
+        else if(nodePartition[n] != part) {
+          sharedNodes.push_back(std::make_pair(n, part));
+          if(nodePartition[n] > 0)
+            sharedNodes.push_back(std::make_pair(n, nodePartition[n]));
+          nodePartition[n] = -1;
+        }
+      }
+    }
+    std::sort(sharedNodes.begin(), sharedNodes.end());
+    sharedNodes.erase(std::unique(sharedNodes.begin(), sharedNodes.end()),
+                      sharedNodes.end());
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      std::vector<std::pair<int, std::size_t> > localGhosts;
+      std::vector<int> parts;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 1024)
+#endif
+      for(std::size_t i = 0; i < ne; i++) {
+        MElement *e = d.elements[i];
+        if(e->getDim() != d.meshDim) continue;
+        parts.clear();
+        for(std::size_t j = 0; j < e->getNumPrimaryVertices(); j++) {
+          std::size_t n = e->getVertex(j)->getNum();
+          if(nodePartition[n] >= 0) continue;
+          std::vector<std::pair<std::size_t, int> >::const_iterator it =
+            std::lower_bound(sharedNodes.begin(), sharedNodes.end(),
+                             std::make_pair(n, 0));
+          for(; it != sharedNodes.end() && it->first == n; ++it)
+            if(it->second != d.elementPartition[i]) parts.push_back(it->second);
+        }
+        std::sort(parts.begin(), parts.end());
+        parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+        for(std::size_t j = 0; j < parts.size(); j++)
+          localGhosts.push_back(std::make_pair(parts[j], i));
+      }
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      d.ghosts.insert(d.ghosts.end(), localGhosts.begin(), localGhosts.end());
+    }
+    std::sort(d.ghosts.begin(), d.ghosts.end());
+  }
+  std::vector<int>().swap(nodePartition);
+
+  // common header, physical names and entities
+  FILE *tmp = tmpfile();
+  if(!tmp) {
+    Msg::Error("Unable to create temporary file");
+    return 0;
+  }
+  writeMSH4Header(this, tmp, version, binary);
+  writeMSH4Entities(this, tmp, false, binary, scalingFactor, version);
+  long size = ftell(tmp);
+  rewind(tmp);
+  d.header.resize(size);
+  if(size > 0 && fread(&d.header[0], sizeof(char), size, tmp) != (size_t)size) {
+    Msg::Error("Could not read temporary file");
+    fclose(tmp);
+    return 0;
+  }
+  fclose(tmp);
+
+  // write the partitions in parallel
+  int numErrors = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(int p = 1; p <= np; p++) {
+    std::ostringstream sstream;
+    sstream << baseName << "_" << p << ".msh";
+    bool ok = writeMSH4StreamPartition(d, p, sstream.str());
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+    {
+      if(!ok) {
+        Msg::Error("Unable to open file '%s'", sstream.str().c_str());
+        numErrors++;
+      }
+      else if(np <= 100 || p % 100 == 1) {
+        Msg::Info("Writing partition %d in file '%s'", p,
+                  sstream.str().c_str());
+      }
+    }
+  }
+
+  double t2 = Cpu(), w2 = TimeOfDay();
+  Msg::Info("Wrote %d partitions (Wall %gs, CPU %gs)", np, w2 - w1, t2 - t1);
+  return numErrors ? 0 : 1;
+}
+
+#else
+
+int GModel::_writePartitionedMSH4Streaming(const std::string &baseName,
+                                           double version, bool binary,
+                                           bool saveAll, double scalingFactor)
+{
+  Msg::Error("Mesh module not compiled");
+  return 0;
+}
+
+#endif
+
 static bool getPhyscialNameInfo(const std::string &name, int &parentPhysicalTag,
                                 std::vector<int> &partitions)
 {
@@ -15,6 +15,7 @@
 #include "MLine.h"
 #include "OpenFile.h"
 #include "StringUtils.h"
+#include "OS.h"
 #include "ExtrudeParams.h"
 
 #if defined(HAVE_OCC)
@@ -139,6 +140,10 @@ OCC_Internals::OCC_Internals()
 {
   for(int i = 0; i < 6; i++) _maxTag[i] = 0;
   _changed = true;
+  _syncModel = 0;
+  _syncIncremental = false;
+  for(int i = 0; i < 4; i++) _syncNumEntities[i] = 0;
+  _facesTessellated = false;
   _attributes = new OCCAttributesRTree(CTX::instance()->geom.tolerance);
 }
 
@@ -153,6 +158,9 @@ void OCC_Internals::reset()
   _wmap.Clear();
   _emap.Clear();
   _vmap.Clear();
+  _toSync.clear();
+  _syncModel = 0;
+  _syncIncremental = false;
   unbind();
 }
 
@@ -198,11 +206,13 @@ void OCC_Internals::bind(const TopoDS_Vertex &vertex, int tag, bool recursive)
     if(_tagVertex.IsBound(tag)) {
       // this leaves the old vertex bound in _vertexTag, but we cannot remove it
       Msg::Info("Rebinding OpenCASCADE point %d", tag);
+      _syncIncremental = false;
     }
     _vertexTag.Bind(vertex, tag);
     _tagVertex.Bind(tag, vertex);
     setMaxTag(0, tag);
     _changed = true;
+    _toSync.insert(std::pair<int, int>(0, tag));
     _attributes->insert(new OCCAttributes(0, vertex));
   }
 }
@@ -220,11 +230,13 @@ void OCC_Internals::bind(const TopoDS_Edge &edge, int tag, bool recursive)
     if(_tagEdge.IsBound(tag)) {
       // this leaves the old edge bound in _edgeTag, but we cannot remove it
       Msg::Info("Rebinding OpenCASCADE curve %d", tag);
+      _syncIncremental = false;
     }
     _edgeTag.Bind(edge, tag);
     _tagEdge.Bind(tag, edge);
     setMaxTag(1, tag);
     _changed = true;
+    _toSync.insert(std::pair<int, int>(1, tag));
     _attributes->insert(new OCCAttributes(1, edge));
   }
   if(recursive) {
@@ -252,6 +264,7 @@ void OCC_Internals::bind(const TopoDS_Wire &wire, int tag, bool recursive)
     if(_tagWire.IsBound(tag)) {
       // this leaves the old wire bound in _wireTag, but we cannot remove it
       Msg::Info("Rebinding OpenCASCADE wire %d", tag);
+      _syncIncremental = false;
     }
     _wireTag.Bind(wire, tag);
     _tagWire.Bind(tag, wire);
@@ -283,11 +296,14 @@ void OCC_Internals::bind(const TopoDS_Face &face, int tag, bool recursive)
     if(_tagFace.IsBound(tag)) {
       // this leaves the old face bound in _faceTag, but we cannot remove it
       Msg::Info("Rebinding OpenCASCADE surface %d", tag);
+      _syncIncremental = false;
     }
     _faceTag.Bind(face, tag);
     _tagFace.Bind(tag, face);
     setMaxTag(2, tag);
     _changed = true;
+    _toSync.insert(std::pair<int, int>(2, tag));
+    _facesTessellated = false;
     _attributes->insert(new OCCAttributes(2, face));
   }
   if(recursive) {
@@ -322,6 +338,7 @@ void OCC_Internals::bind(const TopoDS_Shell &shell, int tag, bool recursive)
     if(_tagShell.IsBound(tag)) {
       // this leaves the old shell bound in _faceTag, but we cannot remove it
       Msg::Info("Rebinding OpenCASCADE shell %d", tag);
+      _syncIncremental = false;
     }
     _shellTag.Bind(shell, tag);
     _tagShell.Bind(tag, shell);
@@ -353,11 +370,13 @@ void OCC_Internals::bind(const TopoDS_Solid &solid, int tag, bool recursive)
     if(_tagSolid.IsBound(tag)) {
       // this leaves the old solid bound in _faceTag, but we cannot remove it
       Msg::Info("Rebinding OpenCASCADE volume %d", tag);
+      _syncIncremental = false;
     }
     _solidTag.Bind(solid, tag);
     _tagSolid.Bind(tag, solid);
     setMaxTag(3, tag);
     _changed = true;
+    _toSync.insert(std::pair<int, int>(3, tag));
     _attributes->insert(new OCCAttributes(3, solid));
   }
   if(recursive) {
@@ -3147,6 +3166,152 @@ static void _filterTags(std::vector<std::pair<int, int> > &outDimTags,
   }
 }
 
+static int _findRoot(std::vector<int> &parent, int i)
+{
+  while(parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+// group shapes whose (enlarged) bounding boxes overlap, using a sweep along the
+// x-axis and a union-find structure; shapes in different clusters cannot
+// interact in a boolean operation
+static void _clusterBoundingBoxes(const std::vector<Bnd_Box> &boxes,
+                                  std::vector<std::vector<int> > &clusters)
+{
+  std::size_t n = boxes.size();
+  std::vector<double> bb(6 * n);
+  std::vector<std::pair<double, int> > order(n);
+  for(std::size_t i = 0; i < n; i++) {
+    boxes[i].Get(bb[6 * i], bb[6 * i + 1], bb[6 * i + 2], bb[6 * i + 3],
+                 bb[6 * i + 4], bb[6 * i + 5]);
+    order[i] = std::make_pair(bb[6 * i], (int)i);
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<int> parent(n);
+  for(std::size_t i = 0; i < n; i++) parent[i] = i;
+  std::vector<int> active;
+  for(std::size_t k = 0; k < n; k++) {
+    int i = order[k].second;
+    std::size_t numActive = 0;
+    for(std::size_t l = 0; l < active.size(); l++) {
+      int j = active[l];
+      if(bb[6 * j + 3] < bb[6 * i]) continue; // no longer active along x
+      active[numActive++] = j;
+      if(bb[6 * j + 4] < bb[6 * i + 1] || bb[6 * i + 4] < bb[6 * j + 1] ||
+         bb[6 * j + 5] < bb[6 * i + 2] || bb[6 * i + 5] < bb[6 * j + 2])
+        continue;
+      int ri = _findRoot(parent, i), rj = _findRoot(parent, j);
+      if(ri != rj) parent[std::max(ri, rj)] = std::min(ri, rj);
+    }
+    active.resize(numActive);
+    active.push_back(i);
+  }
+
+  std::map<int, int> rootToCluster;
+  for(std::size_t i = 0; i < n; i++) {
+    int r = _findRoot(parent, i);
+    std::map<int, int>::iterator it = rootToCluster.find(r);
+    if(it == rootToCluster.end()) {
+      rootToCluster[r] = clusters.size();
+      clusters.push_back(std::vector<int>(1, i));
+    }
+    else
+      clusters[it->second].push_back(i);
+  }
+}
+
+bool OCC_Internals::_fragmentsByClusters(
+  const TopTools_ListOfShape &shapes, bool parallel, double tolerance,
+  TopoDS_Shape &result, std::vector<TopoDS_Shape> &mapOriginal,
+  std::vector<TopTools_ListOfShape> &mapModified,
+  std::vector<TopTools_ListOfShape> &mapGenerated,
+  std::vector<bool> &mapDeleted)
+{
+  std::vector<TopoDS_Shape> input;
+  std::vector<Bnd_Box> boxes;
+  TopTools_ListIteratorOfListOfShape it(shapes);
+  for(; it.More(); it.Next()) {
+    input.push_back(it.Value());
+    Bnd_Box b;
+    BRepBndLib::Add(it.Value(), b);
+    // enlarge by the fuzzy value, and by the confusion tolerance so that
+    // touching shapes end up in the same cluster
+    b.Enlarge(std::max(tolerance, Precision::Confusion()));
+    boxes.push_back(b);
+  }
+
+  std::vector<std::vector<int> > clusters;
+  _clusterBoundingBoxes(boxes, clusters);
+  Msg::Info("Boolean fragments on %d shapes split into %d independent clusters",
+            (int)input.size(), (int)clusters.size());
+
+  std::size_t n = input.size();
+  mapOriginal = input;
+  mapModified.assign(n, TopTools_ListOfShape());
+  mapGenerated.assign(n, TopTools_ListOfShape());
+  std::vector<char> deleted(n, 0);
+  std::vector<TopoDS_Shape> clusterResults(clusters.size());
+  std::vector<std::string> clusterErrors(clusters.size());
+
+  // each cluster is processed by its own builder: they are independent, and
+  // each input shape belongs to exactly one cluster, so that the output maps
+  // can be filled concurrently
+  const int nc = clusters.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(int c = 0; c < nc; c++) {
+    const std::vector<int> &cluster = clusters[c];
+    if(cluster.size() == 1) {
+      clusterResults[c] = input[cluster[0]];
+      continue;
+    }
+    try {
+      TopTools_ListOfShape args;
+      for(std::size_t i = 0; i < cluster.size(); i++)
+        args.Append(input[cluster[i]]);
+      BRepAlgoAPI_BuilderAlgo fragments;
+      fragments.SetRunParallel(parallel);
+      fragments.SetArguments(args);
+      if(tolerance > 0.0) fragments.SetFuzzyValue(tolerance);
+      fragments.Build();
+      if(!fragments.IsDone()) {
+        clusterErrors[c] = "Boolean fragments failed";
+        continue;
+      }
+      clusterResults[c] = fragments.Shape();
+      for(std::size_t i = 0; i < cluster.size(); i++) {
+        const TopoDS_Shape &s = input[cluster[i]];
+        mapModified[cluster[i]] = fragments.Modified(s);
+        mapGenerated[cluster[i]] = fragments.Generated(s);
+        deleted[cluster[i]] = fragments.IsDeleted(s);
+      }
+    } catch(Standard_Failure &err) {
+      clusterErrors[c] = std::string("OpenCASCADE exception ") +
+                         err.GetMessageString();
+    }
+  }
+
+  for(int c = 0; c < nc; c++) {
+    if(clusterErrors[c].size()) {
+      Msg::Error("%s", clusterErrors[c].c_str());
+      return false;
+    }
+  }
+
+  BRep_Builder b;
+  TopoDS_Compound compound;
+  b.MakeCompound(compound);
+  for(int c = 0; c < nc; c++) b.Add(compound, clusterResults[c]);
+  result = compound;
+  mapDeleted.assign(deleted.begin(), deleted.end());
+  return true;
+}
+
 bool OCC_Internals::booleanOperator(
   int tag, BooleanOperator op,
   const std::vector<std::pair<int, int> > &objectDimTags,
@@ -3295,10 +3460,18 @@ bool OCC_Internals::booleanOperator(
 
     case OCC_Internals::Fragments:
     default: {
-      BRepAlgoAPI_BuilderAlgo fragments;
-      fragments.SetRunParallel(parallel);
       objectShapes.Append(toolShapes);
       toolShapes.Clear();
+      if(CTX::instance()->geom.occFragmentsClustering &&
+         objectShapes.Extent() > 2) {
+        if(!_fragmentsByClusters(objectShapes, parallel, tolerance, result,
+                                 mapOriginal, mapModified, mapGenerated,
+                                 mapDeleted))
+          return false;
+        break;
+      }
+      BRepAlgoAPI_BuilderAlgo fragments;
+      fragments.SetRunParallel(parallel);
       fragments.SetArguments(objectShapes);
       if(tolerance > 0.0) fragments.SetFuzzyValue(tolerance);
       fragments.Build();
@@ -3905,6 +4078,176 @@ void readAttributes(OCCAttributesRTree *attributes, T &reader,
 
 #endif
 
+static bool _tessellate(const TopoDS_Shape &s)
+{
+  // tessellate all the faces in the shape at once, using OpenCASCADE's
+  // multi-threaded mesher; faces that are already tessellated with the
+  // requested accuracy are left untouched
+#if OCC_VERSION_HEX > 0x070300
+  if(CTX::instance()->geom.occDisableSTL) return false;
+  double lin = CTX::instance()->mesh.stlLinearDeflection;
+  double ang = CTX::instance()->mesh.stlAngularDeflection;
+  try {
+    BRepMesh_IncrementalMesh aMesher(s, lin, Standard_False, ang,
+                                     Standard_True);
+  } catch(Standard_Failure &err) {
+    Msg::Error("OpenCASCADE exception %s", err.GetMessageString());
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void OCC_Internals::tessellateFaces()
+{
+  if(_facesTessellated) return;
+  _facesTessellated = true;
+
+  BRep_Builder b;
+  TopoDS_Compound c;
+  b.MakeCompound(c);
+  int num = 0;
+  TopTools_DataMapIteratorOfDataMapOfIntegerShape exp(_tagFace);
+  for(; exp.More(); exp.Next()) {
+    TopLoc_Location loc;
+    if(BRep_Tool::Triangulation(TopoDS::Face(exp.Value()), loc).IsNull()) {
+      b.Add(c, exp.Value());
+      num++;
+    }
+  }
+  if(!num) return;
+
+  Msg::Info("Tessellating %d surface%s", num, num > 1 ? "s" : "");
+  double t1 = Cpu(), w1 = TimeOfDay();
+  _tessellate(c);
+  double t2 = Cpu(), w2 = TimeOfDay();
+  Msg::Info("Done tessellating surfaces (Wall %gs, CPU %gs)", w2 - w1, t2 - t1);
+}
+
+// the tessellation of shapes imported from STEP and IGES files can be cached
+// in a BRep file stored alongside the original file, and reused when the same
+// (unmodified) file is imported again with the same import, healing and
+// tessellation parameters, which are stored in a small text file next to the
+// cache
+
+static std::string _tessellationCacheFileName(const std::string &fileName)
+{
+  return fileName + ".tessellation.brep";
+}
+
+static std::string _tessellationCacheParametersFileName(
+  const std::string &fileName)
+{
+  return fileName + ".tessellation.txt";
+}
+
+static std::string _tessellationCacheParameters()
+{
+  char tmp[1024];
+  sprintf(tmp,
+          "TargetUnit %s\nTolerance %.16g\nFixDegenerated %d\n"
+          "FixSmallEdges %d\nFixSmallFaces %d\nSewFaces %d\nMakeSolids %d\n"
+          "Scaling %.16g\nLinearDeflection %.16g\nAngularDeflection %.16g\n",
+          CTX::instance()->geom.occTargetUnit.c_str(),
+          CTX::instance()->geom.tolerance,
+          CTX::instance()->geom.occFixDegenerated,
+          CTX::instance()->geom.occFixSmallEdges,
+          CTX::instance()->geom.occFixSmallFaces,
+          CTX::instance()->geom.occSewFaces,
+          CTX::instance()->geom.occMakeSolids,
+          CTX::instance()->geom.occScaling,
+          CTX::instance()->mesh.stlLinearDeflection,
+          CTX::instance()->mesh.stlAngularDeflection);
+  return tmp;
+}
+
+static bool _readTessellationCache(const std::string &fileName,
+                                   const TopoDS_Shape &shape)
+{
+  std::string cacheFileName = _tessellationCacheFileName(fileName);
+  double tcache = GetFileModificationTime(cacheFileName);
+  if(tcache < 0. || tcache < GetFileModificationTime(fileName)) return false;
+
+  // the cache is only valid if it was created with the same parameters
+  std::string parFileName = _tessellationCacheParametersFileName(fileName);
+  FILE *fp = Fopen(parFileName.c_str(), "r");
+  if(!fp) return false;
+  std::string par;
+  char buf[256];
+  while(fgets(buf, sizeof(buf), fp)) par += buf;
+  fclose(fp);
+  if(par != _tessellationCacheParameters()) {
+    Msg::Info("Ignoring tessellation cache '%s' (created with different "
+              "parameters)", cacheFileName.c_str());
+    return false;
+  }
+
+  TopoDS_Shape cache;
+  try {
+    BRep_Builder b;
+    if(!BRepTools::Read(cache, cacheFileName.c_str(), b)) return false;
+    // the cache is only valid if the topology is identical
+    TopTools_IndexedMapOfShape f1, f2, e1, e2;
+    TopExp::MapShapes(cache, TopAbs_FACE, f1);
+    TopExp::MapShapes(shape, TopAbs_FACE, f2);
+    TopExp::MapShapes(cache, TopAbs_EDGE, e1);
+    TopExp::MapShapes(shape, TopAbs_EDGE, e2);
+    if(f1.Extent() != f2.Extent() || e1.Extent() != e2.Extent()) return false;
+    for(int i = 1; i <= f1.Extent(); i++) {
+      TopoDS_Face face1 = TopoDS::Face(f1(i)), face2 = TopoDS::Face(f2(i));
+      TopLoc_Location loc;
+      Handle(Poly_Triangulation) t = BRep_Tool::Triangulation(face1, loc);
+      if(t.IsNull()) continue;
+      b.UpdateFace(face2, t);
+      // copy the discretization of the bounding curves, if any
+      TopExp_Explorer exp1, exp2;
+      for(exp1.Init(face1, TopAbs_EDGE), exp2.Init(face2, TopAbs_EDGE);
+          exp1.More() && exp2.More(); exp1.Next(), exp2.Next()) {
+        TopoDS_Edge edge1 = TopoDS::Edge(exp1.Current());
+        TopoDS_Edge edge2 = TopoDS::Edge(exp2.Current());
+        Handle(Poly_PolygonOnTriangulation) p =
+          BRep_Tool::PolygonOnTriangulation(edge1, t, loc);
+        if(!p.IsNull()) b.UpdateEdge(edge2, p, t, loc);
+      }
+    }
+  } catch(Standard_Failure &err) {
+    Msg::Warning("Could not read tessellation cache '%s': %s",
+                 cacheFileName.c_str(), err.GetMessageString());
+    return false;
+  }
+  Msg::Info("Read tessellation cache '%s'", cacheFileName.c_str());
+  return true;
+}
+
+static void _writeTessellationCache(const std::string &fileName,
+                                    const TopoDS_Shape &shape)
+{
+  if(!_tessellate(shape)) return;
+  std::string cacheFileName = _tessellationCacheFileName(fileName);
+  try {
+    if(!BRepTools::Write(shape, cacheFileName.c_str())) {
+      Msg::Warning("Could not write tessellation cache '%s'",
+                   cacheFileName.c_str());
+      return;
+    }
+  } catch(Standard_Failure &err) {
+    Msg::Warning("Could not write tessellation cache '%s': %s",
+                 cacheFileName.c_str(), err.GetMessageString());
+    return;
+  }
+  std::string parFileName = _tessellationCacheParametersFileName(fileName);
+  FILE *fp = Fopen(parFileName.c_str(), "w");
+  if(!fp) {
+    Msg::Warning("Could not write tessellation cache parameters '%s'",
+                 parFileName.c_str());
+    return;
+  }
+  fprintf(fp, "%s", _tessellationCacheParameters().c_str());
+  fclose(fp);
+}
+
 bool OCC_Internals::importShapes(const std::string &fileName,
                                  bool highestDimOnly,
                                  std::vector<std::pair<int, int> > &outDimTags,
@@ -3983,6 +4326,12 @@ bool OCC_Internals::importShapes(const std::string &fileName,
     CTX::instance()->geom.occFixSmallFaces, CTX::instance()->geom.occSewFaces,
     CTX::instance()->geom.occMakeSolids, CTX::instance()->geom.occScaling);
 
+  if(CTX::instance()->geom.occTessellationCache &&
+     !(format == "brep" || split[2] == ".brep" || split[2] == ".BREP")) {
+    if(!_readTessellationCache(fileName, result))
+      _writeTessellationCache(fileName, result);
+  }
+
   _multiBind(result, -1, outDimTags, highestDimOnly, true);
   return true;
 }
@@ -4064,6 +4413,7 @@ void OCC_Internals::setMeshSize(int dim, int tag, double size)
     // first remove any other constraint
     _attributes->remove(a);
     _attributes->insert(a);
+    _toSync.insert(std::pair<int, int>(0, tag));
   }
 }
 
@@ -4230,6 +4580,18 @@ void OCC_Internals::synchronize(GModel *model)
 {
   Msg::Debug("Syncing OCC_Internals with GModel");
 
+  // only import the entities that have been bound since the last
+  // synchronization if the model has not been modified otherwise in the
+  // meantime (i.e. if no shape has been unbound or rebound to an existing tag,
+  // and if no entity has been added to or removed from the model directly)
+  bool incremental = CTX::instance()->geom.occSyncIncremental &&
+                     _syncIncremental && _toRemove.empty() &&
+                     model == _syncModel &&
+                     model->getNumVertices() == _syncNumEntities[0] &&
+                     model->getNumEdges() == _syncNumEntities[1] &&
+                     model->getNumFaces() == _syncNumEntities[2] &&
+                     model->getNumRegions() == _syncNumEntities[3];
+
   // make sure to remove from GModel all entities that have been deleted in
   // OCC_Internals since the last synchronization
   std::vector<std::pair<int, int> > toRemove;
@@ -4249,14 +4611,25 @@ void OCC_Internals::synchronize(GModel *model)
   _wmap.Clear();
   _emap.Clear();
   _vmap.Clear();
-  TopTools_DataMapIteratorOfDataMapOfIntegerShape exp0(_tagVertex);
-  for(; exp0.More(); exp0.Next()) _addShapeToMaps(exp0.Value());
-  TopTools_DataMapIteratorOfDataMapOfIntegerShape exp1(_tagEdge);
-  for(; exp1.More(); exp1.Next()) _addShapeToMaps(exp1.Value());
-  TopTools_DataMapIteratorOfDataMapOfIntegerShape exp2(_tagFace);
-  for(; exp2.More(); exp2.Next()) _addShapeToMaps(exp2.Value());
-  TopTools_DataMapIteratorOfDataMapOfIntegerShape exp3(_tagSolid);
-  for(; exp3.More(); exp3.Next()) _addShapeToMaps(exp3.Value());
+  if(incremental) {
+    Msg::Debug("Sync is importing %d new or modified entities",
+               (int)_toSync.size());
+    for(std::set<std::pair<int, int> >::iterator it = _toSync.begin();
+        it != _toSync.end(); ++it) {
+      int dim = it->first, tag = it->second;
+      if(_isBound(dim, tag)) _addShapeToMaps(_find(dim, tag));
+    }
+  }
+  else {
+    TopTools_DataMapIteratorOfDataMapOfIntegerShape exp0(_tagVertex);
+    for(; exp0.More(); exp0.Next()) _addShapeToMaps(exp0.Value());
+    TopTools_DataMapIteratorOfDataMapOfIntegerShape exp1(_tagEdge);
+    for(; exp1.More(); exp1.Next()) _addShapeToMaps(exp1.Value());
+    TopTools_DataMapIteratorOfDataMapOfIntegerShape exp2(_tagFace);
+    for(; exp2.More(); exp2.Next()) _addShapeToMaps(exp2.Value());
+    TopTools_DataMapIteratorOfDataMapOfIntegerShape exp3(_tagSolid);
+    for(; exp3.More(); exp3.Next()) _addShapeToMaps(exp3.Value());
+  }
 
   // import all shapes in _maps into the GModel, preserving all explicit tags
   int vTagMax = std::max(model->getMaxElementaryNumber(0), getMaxTag(0));
@@ -4303,6 +4676,11 @@ void OCC_Internals::synchronize(GModel *model)
       occe = new OCCEdge(model, edge, tag, v1, v2);
       model->add(occe);
     }
+    else {
+      // the curve is rebound to the (possibly modified) shape: discard the
+      // cached samples of its parametrization
+      occe->parametrizationCache.clear();
+    }
     _copyExtrudedAttributes(edge, occe);
     std::vector<std::string> labels;
     _attributes->getLabels(1, edge, labels);
@@ -4310,10 +4688,14 @@ void OCC_Internals::synchronize(GModel *model)
     unsigned int col = 0, boundary = 0;
     if(_attributes->getColor(1, edge, col, boundary)) { occe->setColor(col); }
   }
+  // the setup of new faces (parametric bounds, curve loops, p-curves) is
+  // costly: perform it in parallel, and only register the faces in their
+  // bounding curves and in the model afterwards, in a deterministic order
+  std::vector<TopoDS_Face> newFaces;
+  std::vector<int> newFaceTags;
   for(int i = 1; i <= _fmap.Extent(); i++) {
     TopoDS_Face face = TopoDS::Face(_fmap(i));
-    GFace *occf = getFaceForOCCShape(model, face);
-    if(!occf) {
+    if(!getFaceForOCCShape(model, face)) {
       int tag;
       if(_faceTag.IsBound(face))
         tag = _faceTag.Find(face);
@@ -4322,9 +4704,25 @@ void OCC_Internals::synchronize(GModel *model)
         Msg::Debug("Binding unbound OpenCASCADE surface to tag %d", tag);
         bind(face, tag);
       }
-      occf = new OCCFace(model, face, tag);
-      model->add(occf);
+      newFaces.push_back(face);
+      newFaceTags.push_back(tag);
     }
+  }
+  std::vector<OCCFace *> occFaces(newFaces.size());
+  const int nf = newFaces.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(int i = 0; i < nf; i++)
+    occFaces[i] = new OCCFace(model, newFaces[i], newFaceTags[i], false);
+  for(int i = 0; i < nf; i++) {
+    occFaces[i]->registerInCurves();
+    model->add(occFaces[i]);
+  }
+  for(int i = 1; i <= _fmap.Extent(); i++) {
+    TopoDS_Face face = TopoDS::Face(_fmap(i));
+    GFace *occf = getFaceForOCCShape(model, face);
+    if(!occf) continue;
     _copyExtrudedAttributes(face, occf);
     std::vector<std::string> labels;
     _attributes->getLabels(2, face, labels);
@@ -4393,6 +4791,13 @@ void OCC_Internals::synchronize(GModel *model)
   Msg::Debug("%d surfaces", model->getNumFaces());
   Msg::Debug("%d volumes", model->getNumRegions());
   _changed = false;
+  _toSync.clear();
+  _syncModel = model;
+  _syncIncremental = true;
+  _syncNumEntities[0] = model->getNumVertices();
+  _syncNumEntities[1] = model->getNumEdges();
+  _syncNumEntities[2] = model->getNumFaces();
+  _syncNumEntities[3] = model->getNumRegions();
 }
 
 GVertex *OCC_Internals::getVertexForOCCShape(GModel *model,
@@ -27,6 +27,7 @@ class ExtrudeParams;
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <TopTools_DataMapOfShapeInteger.hxx>
 #include <TopTools_DataMapOfIntegerShape.hxx>
+#include <TopTools_ListOfShape.hxx>
 
 class BRepSweep_Prism;
 class BRepSweep_Revol;
@@ -62,6 +63,20 @@ private:
   // removed from the model at the next synchronization
   std::set<std::pair<int, int> > _toRemove;
 
+  // cache of <dim,tag> pairs corresponding to entities that have been bound
+  // (or whose attributes have changed) since the last synchronization, and
+  // number of entities in the model after the last synchronization: this
+  // allows to only import the new entities if the model has not been modified
+  // otherwise in the meantime (_syncIncremental is reset when a shape is
+  // rebound to an existing tag)
+  std::set<std::pair<int, int> > _toSync;
+  GModel *_syncModel;
+  bool _syncIncremental;
+  std::size_t _syncNumEntities[4];
+
+  // have all the bound faces been tessellated?
+  bool _facesTessellated;
+
   // cache of <dim,tag> pairs corresponding to entities that should not be
   // unbound during boolean operations
   std::set<std::pair<int, int> > _toPreserve;
@@ -159,6 +174,15 @@ private:
   bool _getBoundingBox(const TopoDS_Shape &s, double &xmin, double &ymin,
                        double &zmin, double &xmax, double &ymax, double &zmax);
 
+  // boolean fragments performed independently (and concurrently) on clusters
+  // of shapes with overlapping bounding boxes
+  bool _fragmentsByClusters(const TopTools_ListOfShape &shapes, bool parallel,
+                            double tolerance, TopoDS_Shape &result,
+                            std::vector<TopoDS_Shape> &mapOriginal,
+                            std::vector<TopTools_ListOfShape> &mapModified,
+                            std::vector<TopTools_ListOfShape> &mapGenerated,
+                            std::vector<bool> &mapDeleted);
+
   // STL
   bool _makeSTL(const TopoDS_Shape &s, std::vector<SPoint3> &vertices,
                 std::vector<SVector3> &normals, std::vector<int> &triangles);
@@ -397,6 +421,7 @@ public:
   GRegion *getRegionForOCCShape(GModel *model, const TopoDS_Solid &toFind);
 
   // STL utilities
+  void tessellateFaces();
   bool makeFaceSTL(const TopoDS_Face &s, std::vector<SPoint2> &vertices_uv,
                    std::vector<int> &triangles);
   bool makeFaceSTL(const TopoDS_Face &s, std::vector<SPoint2> &vertices_uv,
@@ -38,6 +38,7 @@ GRegion::~GRegion()
 
 void GRegion::deleteMesh()
 {
+  model()->destroyMeshCaches(this);
   for(std::size_t i = 0; i < mesh_vertices.size(); i++)
     delete mesh_vertices[i];
   mesh_vertices.clear();
@@ -55,7 +56,6 @@ void GRegion::deleteMesh()
   for(std::size_t i = 0; i < polyhedra.size(); i++) delete polyhedra[i];
   polyhedra.clear();
   deleteVertexArrays();
-  model()->destroyMeshCaches();
 }
 
 std::size_t GRegion::getNumMeshElements() const
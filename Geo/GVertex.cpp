@@ -19,13 +19,13 @@ GVertex::~GVertex() { GVertex::deleteMesh(); }
 
 void GVertex::deleteMesh()
 {
+  model()->destroyMeshCaches(this);
   for(std::size_t i = 0; i < mesh_vertices.size(); i++)
     delete mesh_vertices[i];
   mesh_vertices.clear();
   for(std::size_t i = 0; i < points.size(); i++) delete points[i];
   points.clear();
   deleteVertexArrays();
-  model()->destroyMeshCaches();
 }
 
 void GVertex::resetMeshAttributes() { meshSize = MAX_LC; }
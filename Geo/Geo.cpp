@@ -5,6 +5,9 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <map>
+#include <set>
+#include <algorithm>
 #include "GmshMessage.h"
 #include "GmshConfig.h"
 #include "Numeric.h"
@@ -25,7 +28,67 @@
 #include "Parser.h"
 #endif
 
-static List_T *ListOfTransformedPoints = NULL;
+static std::set<int> TransformedPoints;
+
+// points moved by the transformations of a Translate, Rotate, Dilate or
+// Symmetry, checked for coincidences with the other points afterwards, and
+// curves referencing them
+static std::set<int> MovedPoints;
+static std::set<Curve *> MovedCurves;
+static void ReplaceDuplicatesOfMovedPoints();
+
+// When many entities are deleted at once, checking that each one is not on the
+// boundary of a higher dimensional entity by scanning all of them is
+// quadratic: the number of curves referencing each point, of surfaces
+// referencing each curve and of volumes referencing each surface are instead
+// computed once, and updated as entities get deleted.
+class GEO_References {
+public:
+  std::map<int, int> points, curves, surfaces;
+  GEO_References()
+  {
+    List_T *all = Tree2List(GModel::current()->getGEOInternals()->Curves);
+    for(int i = 0; i < List_Nbr(all); i++) {
+      Curve *c;
+      List_Read(all, i, &c);
+      for(int j = 0; j < List_Nbr(c->Control_Points); j++) {
+        Vertex *v;
+        List_Read(c->Control_Points, j, &v);
+        points[std::abs(v->Num)]++;
+      }
+    }
+    List_Delete(all);
+    all = Tree2List(GModel::current()->getGEOInternals()->Surfaces);
+    for(int i = 0; i < List_Nbr(all); i++) {
+      Surface *s;
+      List_Read(all, i, &s);
+      for(int j = 0; j < List_Nbr(s->Generatrices); j++) {
+        Curve *c;
+        List_Read(s->Generatrices, j, &c);
+        curves[std::abs(c->Num)]++;
+      }
+    }
+    List_Delete(all);
+    all = Tree2List(GModel::current()->getGEOInternals()->Volumes);
+    for(int i = 0; i < List_Nbr(all); i++) {
+      Volume *v;
+      List_Read(all, i, &v);
+      for(int j = 0; j < List_Nbr(v->Surfaces); j++) {
+        Surface *s;
+        List_Read(v->Surfaces, j, &s);
+        surfaces[s->Num]++;
+      }
+    }
+    List_Delete(all);
+  }
+  static bool used(std::map<int, int> &m, int num)
+  {
+    std::map<int, int>::iterator it = m.find(num);
+    return it != m.end() && it->second > 0;
+  }
+};
+
+static GEO_References *References = NULL;
 
 int CompareVertex(const void *a, const void *b)
 {
@@ -905,19 +968,25 @@ void DeletePoint(int ip, bool recursive)
 {
   Vertex *v = FindPoint(ip);
   if(!v) return;
-  List_T *Curves = Tree2List(GModel::current()->getGEOInternals()->Curves);
-  for(int i = 0; i < List_Nbr(Curves); i++) {
-    Curve *c;
-    List_Read(Curves, i, &c);
-    for(int j = 0; j < List_Nbr(c->Control_Points); j++) {
-      if(!CompareVertex(List_Pointer(c->Control_Points, j), &v)) {
-        List_Delete(Curves);
-        // cannot delete: it's a control point of a curve
-        return;
+  if(References) {
+    // cannot delete: it's a control point of a curve
+    if(GEO_References::used(References->points, std::abs(v->Num))) return;
+  }
+  else {
+    List_T *Curves = Tree2List(GModel::current()->getGEOInternals()->Curves);
+    for(int i = 0; i < List_Nbr(Curves); i++) {
+      Curve *c;
+      List_Read(Curves, i, &c);
+      for(int j = 0; j < List_Nbr(c->Control_Points); j++) {
+        if(!CompareVertex(List_Pointer(c->Control_Points, j), &v)) {
+          List_Delete(Curves);
+          // cannot delete: it's a control point of a curve
+          return;
+        }
       }
     }
+    List_Delete(Curves);
   }
-  List_Delete(Curves);
 
   int tmax = GModel::current()->getGEOInternals()->getMaxTag(0);
   if(v->Num == tmax)
@@ -930,25 +999,38 @@ void DeleteCurve(int ip, bool recursive)
 {
   Curve *c = FindCurve(ip);
   if(!c) return;
-  List_T *Surfs = Tree2List(GModel::current()->getGEOInternals()->Surfaces);
-  for(int i = 0; i < List_Nbr(Surfs); i++) {
-    Surface *s;
-    List_Read(Surfs, i, &s);
-    for(int j = 0; j < List_Nbr(s->Generatrices); j++) {
-      if(!CompareAbsCurve(List_Pointer(s->Generatrices, j), &c)) {
-        List_Delete(Surfs);
-        // cannot delete: it's on the boundary of a surface
-        return;
+  if(References) {
+    // cannot delete: it's on the boundary of a surface
+    if(GEO_References::used(References->curves, std::abs(c->Num))) return;
+  }
+  else {
+    List_T *Surfs = Tree2List(GModel::current()->getGEOInternals()->Surfaces);
+    for(int i = 0; i < List_Nbr(Surfs); i++) {
+      Surface *s;
+      List_Read(Surfs, i, &s);
+      for(int j = 0; j < List_Nbr(s->Generatrices); j++) {
+        if(!CompareAbsCurve(List_Pointer(s->Generatrices, j), &c)) {
+          List_Delete(Surfs);
+          // cannot delete: it's on the boundary of a surface
+          return;
+        }
       }
     }
+    List_Delete(Surfs);
   }
-  List_Delete(Surfs);
 
   int tmax = GModel::current()->getGEOInternals()->getMaxTag(1);
   if(c->Num == tmax)
     GModel::current()->getGEOInternals()->setMaxTag(1, tmax - 1);
   Tree_Suppress(GModel::current()->getGEOInternals()->Curves, &c);
   Tree_Add(GModel::current()->getGEOInternals()->DelCurves, &c);
+  if(References) {
+    for(int k = 0; k < List_Nbr(c->Control_Points); k++) {
+      Vertex *v;
+      List_Read(c->Control_Points, k, &v);
+      References->points[std::abs(v->Num)]--;
+    }
+  }
 
   if(recursive) {
     std::set<int> vv;
@@ -968,25 +1050,38 @@ void DeleteSurface(int is, bool recursive)
 {
   Surface *s = FindSurface(is);
   if(!s) return;
-  List_T *Vols = Tree2List(GModel::current()->getGEOInternals()->Volumes);
-  for(int i = 0; i < List_Nbr(Vols); i++) {
-    Volume *v;
-    List_Read(Vols, i, &v);
-    for(int j = 0; j < List_Nbr(v->Surfaces); j++) {
-      if(!CompareSurface(List_Pointer(v->Surfaces, j), &s)) {
-        List_Delete(Vols);
-        // cannot delete: it's on the boundary of a volume
-        return;
+  if(References) {
+    // cannot delete: it's on the boundary of a volume
+    if(GEO_References::used(References->surfaces, s->Num)) return;
+  }
+  else {
+    List_T *Vols = Tree2List(GModel::current()->getGEOInternals()->Volumes);
+    for(int i = 0; i < List_Nbr(Vols); i++) {
+      Volume *v;
+      List_Read(Vols, i, &v);
+      for(int j = 0; j < List_Nbr(v->Surfaces); j++) {
+        if(!CompareSurface(List_Pointer(v->Surfaces, j), &s)) {
+          List_Delete(Vols);
+          // cannot delete: it's on the boundary of a volume
+          return;
+        }
       }
     }
+    List_Delete(Vols);
   }
-  List_Delete(Vols);
 
   int tmax = GModel::current()->getGEOInternals()->getMaxTag(2);
   if(s->Num == tmax)
     GModel::current()->getGEOInternals()->setMaxTag(2, tmax - 1);
   Tree_Suppress(GModel::current()->getGEOInternals()->Surfaces, &s);
   Tree_Add(GModel::current()->getGEOInternals()->DelSurfaces, &s);
+  if(References) {
+    for(int j = 0; j < List_Nbr(s->Generatrices); j++) {
+      Curve *c;
+      List_Read(s->Generatrices, j, &c);
+      References->curves[std::abs(c->Num)]--;
+    }
+  }
 
   if(recursive) {
     std::set<int> cc, vv;
@@ -1021,6 +1116,13 @@ void DeleteVolume(int iv, bool recursive)
     GModel::current()->getGEOInternals()->setMaxTag(3, tmax - 1);
   Tree_Suppress(GModel::current()->getGEOInternals()->Volumes, &v);
   Tree_Add(GModel::current()->getGEOInternals()->DelVolumes, &v);
+  if(References) {
+    for(int i = 0; i < List_Nbr(v->Surfaces); i++) {
+      Surface *s;
+      List_Read(v->Surfaces, i, &s);
+      References->surfaces[s->Num]--;
+    }
+  }
 
   if(recursive) {
     std::set<int> ss, cc, vv;
@@ -1052,6 +1154,28 @@ void DeleteVolume(int iv, bool recursive)
   }
 }
 
+void DeleteShapes(const std::vector<std::pair<int, int> > &dimTags,
+                  bool recursive)
+{
+  GEO_References *references = NULL;
+  if(dimTags.size() > 1) references = new GEO_References();
+  References = references;
+  for(std::size_t i = 0; i < dimTags.size(); i++) {
+    int tag = dimTags[i].second;
+    switch(dimTags[i].first) {
+    case 0: DeletePoint(tag, recursive); break;
+    case 1:
+      DeleteCurve(tag, recursive);
+      DeleteCurve(-tag, recursive);
+      break;
+    case 2: DeleteSurface(tag, recursive); break;
+    case 3: DeleteVolume(tag, recursive); break;
+    }
+  }
+  References = NULL;
+  if(references) delete references;
+}
+
 void DeletePhysicalPoint(int num)
 {
   PhysicalGroup *p = FindPhysicalGroup(num, MSH_PHYSICAL_POINT);
@@ -1348,14 +1472,7 @@ static void ApplyTransformationToPointAlways(double matrix[4][4], Vertex *v)
 
 static void ApplyTransformationToPoint(double matrix[4][4], Vertex *v)
 {
-  if(!ListOfTransformedPoints)
-    ListOfTransformedPoints = List_Create(50, 50, sizeof(int));
-
-  if(!List_Search(ListOfTransformedPoints, &v->Num, fcmp_absint)) {
-    List_Add(ListOfTransformedPoints, &v->Num);
-  }
-  else
-    return;
+  if(!TransformedPoints.insert(std::abs(v->Num)).second) return;
   ApplyTransformationToPointAlways(matrix, v);
 }
 
@@ -1405,7 +1522,7 @@ static bool ApplicationOnShapes(double matrix[4][4], List_T *shapes)
   Volume *vol;
   bool ok = true;
 
-  List_Reset(ListOfTransformedPoints);
+  TransformedPoints.clear();
 
   for(int i = 0; i < List_Nbr(shapes); i++) {
     Shape O;
@@ -1478,16 +1595,23 @@ static bool ApplicationOnShapes(double matrix[4][4], List_T *shapes)
       List_Read(All, i, &c);
       for(int j = 0; j < List_Nbr(c->Control_Points); j++) {
         Vertex *pv = *(Vertex **)List_Pointer(c->Control_Points, j);
-        if(List_Search(ListOfTransformedPoints, &pv->Num, fcmp_absint)) {
+        if(TransformedPoints.count(std::abs(pv->Num))) {
           EndCurve(c);
+          MovedCurves.insert(c);
           break;
         }
       }
+      if((c->beg && TransformedPoints.count(std::abs(c->beg->Num))) ||
+         (c->end && TransformedPoints.count(std::abs(c->end->Num))) ||
+         (c->Extrude && c->Extrude->geo.Mode == EXTRUDED_ENTITY &&
+          TransformedPoints.count(std::abs(c->Extrude->geo.Source))))
+        MovedCurves.insert(c);
     }
     List_Delete(All);
   }
 
-  List_Reset(ListOfTransformedPoints);
+  MovedPoints.insert(TransformedPoints.begin(), TransformedPoints.end());
+  TransformedPoints.clear();
 
   return ok;
 }
@@ -1502,7 +1626,7 @@ bool TranslateShapes(double X, double Y, double Z, List_T *shapes)
   SetTranslationMatrix(matrix, T);
   bool ok = ApplicationOnShapes(matrix, shapes);
 
-  if(CTX::instance()->geom.autoCoherence) ReplaceAllDuplicates();
+  ReplaceDuplicatesOfMovedPoints();
 
   return ok;
 }
@@ -1518,7 +1642,7 @@ bool DilatShapes(double X, double Y, double Z, double A, double B, double C,
   SetDilatationMatrix(matrix, T, A, B, C);
   bool ok = ApplicationOnShapes(matrix, shapes);
 
-  if(CTX::instance()->geom.autoCoherence) ReplaceAllDuplicates();
+  ReplaceDuplicatesOfMovedPoints();
 
   return ok;
 }
@@ -1546,7 +1670,7 @@ bool RotateShapes(double Ax, double Ay, double Az, double Px, double Py,
   SetTranslationMatrix(matrix, T);
   ok &= ApplicationOnShapes(matrix, shapes);
 
-  if(CTX::instance()->geom.autoCoherence) ReplaceAllDuplicates();
+  ReplaceDuplicatesOfMovedPoints();
 
   return ok;
 }
@@ -1558,7 +1682,7 @@ bool SymmetryShapes(double A, double B, double C, double D, List_T *shapes)
   SetSymmetryMatrix(matrix, A, B, C, D);
   bool ok = ApplicationOnShapes(matrix, shapes);
 
-  if(CTX::instance()->geom.autoCoherence) ReplaceAllDuplicates();
+  ReplaceDuplicatesOfMovedPoints();
 
   return ok;
 }
@@ -2426,6 +2550,182 @@ void ReplaceAllDuplicates()
   ReplaceAllDuplicates(report);
 }
 
+static bool PointXLessThan(Vertex *v1, Vertex *v2)
+{
+  return v1->Pos.X < v2->Pos.X;
+}
+
+static bool CurveLessThan(Curve *c1, Curve *c2)
+{
+  return CompareTwoCurves(&c1, &c2) < 0;
+}
+
+// A transformation can only create new duplicate points among the points it
+// moved, and new duplicate curves, surfaces and volumes only through these
+// points: instead of running the (whole model) coherence pass, the moved points
+// are merged with the points they now coincide with (keeping the point with
+// the smallest tag, as the whole model pass would), in the curves that
+// reference them. The moved points are sorted by their x coordinate, so that
+// each point of the model is only compared with the moved points in the slab
+// [x - eps, x + eps]. The whole model pass is still used if the merge makes a
+// curve a duplicate of another curve or degenerate, or if a moved point
+// should replace a point that was not moved.
+static void ReplaceDuplicatesOfMovedPoints()
+{
+  std::set<int> tags;
+  std::set<Curve *> curves;
+  tags.swap(MovedPoints);
+  curves.swap(MovedCurves);
+  std::vector<Vertex *> moved;
+  if(CTX::instance()->geom.autoCoherence) {
+    for(std::set<int>::iterator it = tags.begin(); it != tags.end(); it++) {
+      Vertex *v = FindPoint(*it);
+      if(v) moved.push_back(v);
+    }
+  }
+  if(moved.empty()) return;
+
+  std::sort(moved.begin(), moved.end(), PointXLessThan);
+  double eps = CTX::instance()->geom.tolerance * CTX::instance()->lc;
+  std::map<Vertex *, Vertex *> replace;
+  bool all = false;
+  List_T *All = Tree2List(GModel::current()->getGEOInternals()->Points);
+  for(int i = 0; i < List_Nbr(All) && !all; i++) {
+    Vertex *v;
+    List_Read(All, i, &v);
+    Vertex probe(v->Pos.X - eps, 0., 0.);
+    std::vector<Vertex *>::iterator it =
+      std::lower_bound(moved.begin(), moved.end(), &probe, PointXLessThan);
+    for(; it != moved.end() && (*it)->Pos.X <= v->Pos.X + eps; it++) {
+      if(*it == v || CompareTwoPoints(&v, &(*it))) continue;
+      if(v->Num > (*it)->Num && !tags.count(v->Num)) {
+        all = true;
+        break;
+      }
+      std::map<Vertex *, Vertex *>::iterator r = replace.find(*it);
+      if(r == replace.end())
+        replace[*it] = v;
+      else if(v->Num < r->second->Num)
+        r->second = v;
+    }
+  }
+  List_Delete(All);
+
+  if(all) {
+    ReplaceAllDuplicates();
+    return;
+  }
+
+  // only keep the moved points that coincide with a point with a smaller tag,
+  // and replace them by the point with the smallest tag they are connected to
+  for(std::map<Vertex *, Vertex *>::iterator it = replace.begin();
+      it != replace.end();) {
+    if(it->second->Num > it->first->Num)
+      replace.erase(it++);
+    else
+      it++;
+  }
+  if(replace.empty()) return;
+  for(std::map<Vertex *, Vertex *>::iterator it = replace.begin();
+      it != replace.end(); it++) {
+    std::map<Vertex *, Vertex *>::iterator r;
+    while((r = replace.find(it->second)) != replace.end())
+      it->second = r->second;
+  }
+
+  Msg::Debug("Removed %d duplicate points", (int)replace.size());
+
+  std::map<Vertex *, Vertex *>::iterator r;
+  for(std::set<Curve *>::iterator it = curves.begin(); it != curves.end();
+      it++) {
+    Curve *c = *it;
+    if(c->beg && (r = replace.find(c->beg)) != replace.end())
+      c->beg = r->second;
+    if(c->end && (r = replace.find(c->end)) != replace.end())
+      c->end = r->second;
+    for(int j = 0; j < List_Nbr(c->Control_Points); j++) {
+      Vertex **pv = (Vertex **)List_Pointer(c->Control_Points, j);
+      if((r = replace.find(*pv)) != replace.end()) *pv = r->second;
+    }
+    if(c->Extrude && c->Extrude->geo.Mode == EXTRUDED_ENTITY) {
+      Vertex *v = FindPoint(std::abs(c->Extrude->geo.Source));
+      if(v && (r = replace.find(v)) != replace.end())
+        c->Extrude->geo.Source = r->second->Num;
+    }
+  }
+
+  All = Tree2List(GModel::current()->getGEOInternals()->Surfaces);
+  for(int i = 0; i < List_Nbr(All); i++) {
+    Surface *s;
+    List_Read(All, i, &s);
+    for(int j = 0; j < List_Nbr(s->TrsfPoints); j++) {
+      Vertex **pv = (Vertex **)List_Pointer(s->TrsfPoints, j);
+      if((r = replace.find(*pv)) != replace.end()) *pv = r->second;
+    }
+  }
+  List_Delete(All);
+
+  All = Tree2List(GModel::current()->getGEOInternals()->Volumes);
+  for(int i = 0; i < List_Nbr(All); i++) {
+    Volume *vol;
+    List_Read(All, i, &vol);
+    for(int j = 0; j < List_Nbr(vol->TrsfPoints); j++) {
+      Vertex **pv = (Vertex **)List_Pointer(vol->TrsfPoints, j);
+      if((r = replace.find(*pv)) != replace.end()) *pv = r->second;
+    }
+  }
+  List_Delete(All);
+
+  for(int i = 0;
+      i < List_Nbr(GModel::current()->getGEOInternals()->PhysicalGroups); i++) {
+    PhysicalGroup *p = *(PhysicalGroup **)List_Pointer(
+      GModel::current()->getGEOInternals()->PhysicalGroups, i);
+    if(p->Typ != MSH_PHYSICAL_POINT) continue;
+    for(int j = 0; j < List_Nbr(p->Entities); j++) {
+      int *num = (int *)List_Pointer(p->Entities, j);
+      Vertex *v = FindPoint(std::abs(*num));
+      if(v && (r = replace.find(v)) != replace.end()) *num = r->second->Num;
+    }
+  }
+
+  for(r = replace.begin(); r != replace.end(); r++) {
+    Vertex *v = r->first;
+    Tree_Suppress(GModel::current()->getGEOInternals()->Points, &v);
+    Tree_Add(GModel::current()->getGEOInternals()->DelPoints, &v);
+  }
+  if(CTX::instance()->geom.oldNewreg) {
+    GModel::current()->getGEOInternals()->setMaxTag(0, 0);
+    Tree_Action(GModel::current()->getGEOInternals()->Points, MaxNumPoint);
+  }
+
+  // the curves now referencing other points can be duplicates of other curves
+  // (with the same or the opposite orientation), or be degenerate
+  std::set<Curve *, bool (*)(Curve *, Curve *)> changed(CurveLessThan);
+  for(std::set<Curve *>::iterator it = curves.begin(); it != curves.end();
+      it++) {
+    if(CTX::instance()->geom.autoCoherence == 2 && (*it)->degenerate()) {
+      all = true;
+      break;
+    }
+    if((*it)->Num > 0 && !changed.insert(*it).second) {
+      all = true;
+      break;
+    }
+  }
+  All = Tree2List(GModel::current()->getGEOInternals()->Curves);
+  for(int i = 0; i < List_Nbr(All) && !all; i++) {
+    Curve *c;
+    List_Read(All, i, &c);
+    std::set<Curve *, bool (*)(Curve *, Curve *)>::iterator it =
+      changed.find(c);
+    if(it != changed.end() && std::abs((*it)->Num) != std::abs(c->Num))
+      all = true;
+  }
+  List_Delete(All);
+
+  if(all) ReplaceAllDuplicates();
+}
+
 void ReplaceAllDuplicatesNew(double tol)
 {
   if(tol < 0) tol = CTX::instance()->geom.tolerance * CTX::instance()->lc;
@@ -2434,7 +2734,8 @@ void ReplaceAllDuplicatesNew(double tol)
   ReplaceDuplicateSurfaces(NULL);
 }
 
-void ProtudeXYZ(double &x, double &y, double &z, ExtrudeParams *e)
+void ProtudeXYZ(double &x, double &y, double &z, ExtrudeParams *e,
+                double angle)
 {
   double matrix[4][4];
   double T[3];
@@ -2446,7 +2747,7 @@ void ProtudeXYZ(double &x, double &y, double &z, ExtrudeParams *e)
   SetTranslationMatrix(matrix, T);
   ApplyTransformationToPointAlways(matrix, &v);
 
-  SetRotationMatrix(matrix, e->geo.axe, e->geo.angle);
+  SetRotationMatrix(matrix, e->geo.axe, angle);
   ApplyTransformationToPointAlways(matrix, &v);
 
   T[0] = -T[0];
@@ -2458,8 +2759,6 @@ void ProtudeXYZ(double &x, double &y, double &z, ExtrudeParams *e)
   x = v.Pos.X;
   y = v.Pos.Y;
   z = v.Pos.Z;
-
-  List_Reset(ListOfTransformedPoints);
 }
 
 int ExtrudePoint(int type, int ip, double T0, double T1, double T2, double A0,
@@ -2488,7 +2787,7 @@ int ExtrudePoint(int type, int ip, double T0, double T1, double T2, double A0,
     T[1] = T1;
     T[2] = T2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToPoint(matrix, chapeau);
     if(!ComparePosition(&pv, &chapeau)) return pv->Num;
     c = CreateCurve(NEWLINE(), MSH_SEGM_LINE, 1, NULL, NULL, -1, -1, 0., 1., ok);
@@ -2520,19 +2819,19 @@ int ExtrudePoint(int type, int ip, double T0, double T1, double T2, double A0,
     T[1] = -X1;
     T[2] = -X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToPoint(matrix, chapeau);
     Ax[0] = A0;
     Ax[1] = A1;
     Ax[2] = A2;
     SetRotationMatrix(matrix, Ax, alpha);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToPoint(matrix, chapeau);
     T[0] = X0;
     T[1] = X1;
     T[2] = X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToPoint(matrix, chapeau);
     if(!ComparePosition(&pv, &chapeau)) return pv->Num;
     c = CreateCurve(NEWLINE(), MSH_SEGM_CIRC, 1, NULL, NULL, -1, -1, 0., 1., ok);
@@ -2576,25 +2875,25 @@ int ExtrudePoint(int type, int ip, double T0, double T1, double T2, double A0,
       T[1] = -X1;
       T[2] = -X2;
       SetTranslationMatrix(matrix, T);
-      List_Reset(ListOfTransformedPoints);
+      TransformedPoints.clear();
       ApplyTransformationToPoint(matrix, chapeau);
       Ax[0] = A0;
       Ax[1] = A1;
       Ax[2] = A2;
       SetRotationMatrix(matrix, Ax, alpha / d);
-      List_Reset(ListOfTransformedPoints);
+      TransformedPoints.clear();
       ApplyTransformationToPoint(matrix, chapeau);
       T[0] = X0;
       T[1] = X1;
       T[2] = X2;
       SetTranslationMatrix(matrix, T);
-      List_Reset(ListOfTransformedPoints);
+      TransformedPoints.clear();
       ApplyTransformationToPoint(matrix, chapeau);
       T[0] = T0 / d;
       T[1] = T1 / d;
       T[2] = T2 / d;
       SetTranslationMatrix(matrix, T);
-      List_Reset(ListOfTransformedPoints);
+      TransformedPoints.clear();
       ApplyTransformationToPoint(matrix, chapeau);
       List_Add(c->Control_Points, &chapeau);
     }
@@ -2609,7 +2908,7 @@ int ExtrudePoint(int type, int ip, double T0, double T1, double T2, double A0,
   *pc = c;
   *prc = FindCurve(-c->Num);
 
-  List_Reset(ListOfTransformedPoints);
+  TransformedPoints.clear();
 
   int chap_num = chapeau->Num;
   int body_num = c->Num;
@@ -2667,7 +2966,7 @@ int ExtrudeCurve(int type, int ic, double T0, double T1, double T2, double A0,
     T[1] = T1;
     T[2] = T2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     break;
   case BOUNDARY_LAYER:
@@ -2693,19 +2992,19 @@ int ExtrudeCurve(int type, int ic, double T0, double T1, double T2, double A0,
     T[1] = -X1;
     T[2] = -X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     Ax[0] = A0;
     Ax[1] = A1;
     Ax[2] = A2;
     SetRotationMatrix(matrix, Ax, alpha);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     T[0] = X0;
     T[1] = X1;
     T[2] = X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     break;
   case TRANSLATE_ROTATE:
@@ -2713,25 +3012,25 @@ int ExtrudeCurve(int type, int ic, double T0, double T1, double T2, double A0,
     T[1] = -X1;
     T[2] = -X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     Ax[0] = A0;
     Ax[1] = A1;
     Ax[2] = A2;
     SetRotationMatrix(matrix, Ax, alpha);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     T[0] = X0;
     T[1] = X1;
     T[2] = X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     T[0] = T0;
     T[1] = T1;
     T[2] = T2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToCurve(matrix, chapeau);
     break;
   default: Msg::Error("Unknown extrusion type"); return pc->Num;
@@ -2786,7 +3085,7 @@ int ExtrudeCurve(int type, int ic, double T0, double T1, double T2, double A0,
   EndSurface(s);
   Tree_Add(GModel::current()->getGEOInternals()->Surfaces, &s);
 
-  List_Reset(ListOfTransformedPoints);
+  TransformedPoints.clear();
 
   *ps = s;
 
@@ -2895,7 +3194,7 @@ int ExtrudeSurface(int type, int is, double T0, double T1, double T2, double A0,
     T[1] = T1;
     T[2] = T2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     break;
   case BOUNDARY_LAYER:
@@ -2925,19 +3224,19 @@ int ExtrudeSurface(int type, int is, double T0, double T1, double T2, double A0,
     T[1] = -X1;
     T[2] = -X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     Ax[0] = A0;
     Ax[1] = A1;
     Ax[2] = A2;
     SetRotationMatrix(matrix, Ax, alpha);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     T[0] = X0;
     T[1] = X1;
     T[2] = X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     break;
   case TRANSLATE_ROTATE:
@@ -2945,25 +3244,25 @@ int ExtrudeSurface(int type, int is, double T0, double T1, double T2, double A0,
     T[1] = -X1;
     T[2] = -X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     Ax[0] = A0;
     Ax[1] = A1;
     Ax[2] = A2;
     SetRotationMatrix(matrix, Ax, alpha);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     T[0] = X0;
     T[1] = X1;
     T[2] = X2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     T[0] = T0;
     T[1] = T1;
     T[2] = T2;
     SetTranslationMatrix(matrix, T);
-    List_Reset(ListOfTransformedPoints);
+    TransformedPoints.clear();
     ApplyTransformationToSurface(matrix, chapeau);
     break;
   default: Msg::Error("Unknown extrusion type"); break;
@@ -2995,7 +3294,7 @@ int ExtrudeSurface(int type, int is, double T0, double T1, double T2, double A0,
       chap_num = 0;
   }
 
-  List_Reset(ListOfTransformedPoints);
+  TransformedPoints.clear();
 
   return chap_num;
 }
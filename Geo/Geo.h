@@ -221,6 +221,8 @@ void DeletePoint(int Num, bool recursive = false);
 void DeleteCurve(int Num, bool recursive = false);
 void DeleteSurface(int Num, bool recursive = false);
 void DeleteVolume(int Num, bool recursive = false);
+void DeleteShapes(const std::vector<std::pair<int, int> > &dimTags,
+                  bool recursive = false);
 void DeletePhysicalPoint(int Num);
 void DeletePhysicalLine(int Num);
 void DeletePhysicalSurface(int Num);
@@ -230,7 +232,8 @@ void ExtrudeShapes(int extrude_type, List_T *in, double T0, double T1,
                    double T2, double A0, double A1, double A2, double X0,
                    double X1, double X2, double alpha, ExtrudeParams *e,
                    List_T *out);
-void ProtudeXYZ(double &x, double &y, double &z, ExtrudeParams *e);
+void ProtudeXYZ(double &x, double &y, double &z, ExtrudeParams *e,
+                double angle);
 
 void ReplaceAllDuplicates();
 void ReplaceAllDuplicatesNew(double tol = -1.);
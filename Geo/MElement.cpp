@@ -50,7 +50,7 @@ MElement::MElement(std::size_t num, int part) : _visible(1)
   else {
     _num = m->incrementAndGetMaxElementNumber();
   }
-  _partition = (short)part;
+  _partition = part;
 }
 
 void MElement::forceNum(std::size_t num)
@@ -32,8 +32,9 @@ private:
   // to change once a mesh has been generated, unless the mesh is explicitly
   // renumbered)
   std::size_t _num;
-  // the number of the mesh partition the element belongs to
-  short _partition;
+  // the number of the mesh partition the element belongs to (an int does not
+  // increase the size of the class, due to the alignment of _num)
+  int _partition;
   // a visibility flag
   char _visible;
 
@@ -88,7 +89,7 @@ public:
 
   // get/set the partition to which the element belongs
   virtual int getPartition() const { return _partition; }
-  virtual void setPartition(int num) { _partition = (short)num; }
+  virtual void setPartition(int num) { _partition = num; }
 
   // get/set the visibility flag
   virtual char getVisibility() const;
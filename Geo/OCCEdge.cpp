@@ -96,6 +96,7 @@ void OCCEdge::setTrimmed(OCCFace *f)
     const TopoDS_Face *s = (TopoDS_Face *)_trimmed->getNativePtr();
     _curve2d = BRep_Tool::CurveOnSurface(_c, *s, _s0, _s1);
     if(_curve2d.IsNull()) _trimmed = 0;
+    parametrizationCache.clear();
   }
 }
 
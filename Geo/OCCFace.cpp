@@ -41,10 +41,11 @@
 #include <gp_Sphere.hxx>
 #include <BRepTools.hxx>
 
-OCCFace::OCCFace(GModel *m, TopoDS_Face s, int num)
+OCCFace::OCCFace(GModel *m, TopoDS_Face s, int num, bool attach)
   : GFace(m, num), _s(s), _sf(s, Standard_True), _radius(-1)
 {
   _setup();
+  if(attach) registerInCurves();
 
   if(CTX::instance()->debugSurface > 0 &&
      tag() == CTX::instance()->debugSurface)
@@ -92,14 +93,6 @@ void OCCFace::_setup()
     for(GEdgeLoop::citer it = el.begin(); it != el.end(); ++it) {
       l_edges.push_back(it->ge);
       l_dirs.push_back(it->_sign);
-      if(el.count() == 2) {
-        it->ge->meshAttributes.minimumMeshSegments =
-          std::max(it->ge->meshAttributes.minimumMeshSegments, 2);
-      }
-      if(el.count() == 1) {
-        it->ge->meshAttributes.minimumMeshSegments =
-          std::max(it->ge->meshAttributes.minimumMeshSegments, 3);
-      }
     }
     edgeLoops.push_back(el);
   }
@@ -142,9 +135,20 @@ void OCCFace::_setup()
     gp_Pnt loc = sphere.Location();
     _center = SPoint3(loc.X(), loc.Y(), loc.Z());
   }
+}
 
+void OCCFace::registerInCurves()
+{
   // Only store references to this new face in edges at the end of the
-  // constructor, to avoid accessing it too early (e.g. when drawing an edge)
+  // construction, to avoid accessing it too early (e.g. when drawing an edge)
+  for(std::list<GEdgeLoop>::iterator it = edgeLoops.begin();
+      it != edgeLoops.end(); ++it) {
+    int minSegments = (it->count() == 1) ? 3 : (it->count() == 2) ? 2 : 1;
+    for(GEdgeLoop::citer it2 = it->begin(); it2 != it->end(); ++it2) {
+      it2->ge->meshAttributes.minimumMeshSegments =
+        std::max(it2->ge->meshAttributes.minimumMeshSegments, minSegments);
+    }
+  }
   for(std::size_t i = 0; i < l_edges.size(); i++) {
     GEdge *e = l_edges[i];
     e->addFace(this);
@@ -410,6 +414,12 @@ bool OCCFace::buildSTLTriangulation(bool force)
   stl_vertices_uv.clear();
   stl_vertices_xyz.clear();
   stl_triangles.clear();
+  // if this face has not been tessellated yet, tessellate all the faces in the
+  // model at once (in parallel), as the other ones will most probably be
+  // needed as well
+  TopLoc_Location loc;
+  if(BRep_Tool::Triangulation(_s, loc).IsNull())
+    model()->getOCCInternals()->tessellateFaces();
   if(!model()->getOCCInternals()->makeFaceSTL(
       _s, stl_vertices_uv, stl_vertices_xyz, stl_normals, stl_triangles)) {
     Msg::Info("OpenCASCADE triangulation of surface %d failed", tag());
@@ -29,7 +29,11 @@ private:
   void _setup();
 
 public:
-  OCCFace(GModel *m, TopoDS_Face s, int num);
+  // if attach is false, the face is not registered in its bounding curves:
+  // this allows to construct faces concurrently, and to call
+  // registerInCurves() afterwards
+  OCCFace(GModel *m, TopoDS_Face s, int num, bool attach = true);
+  void registerInCurves();
   virtual ~OCCFace();
   virtual SBoundingBox3d bounds(bool fast = false);
   virtual Range<double> parBounds(int i) const;
@@ -154,6 +154,7 @@ int discreteEdge::createGeometry()
 
   if(!_discretization.empty()) return 0;
 
+  parametrizationCache.clear();
   bool sorted = true;
 
   std::vector<MVertex*> vertices;
@@ -265,6 +266,7 @@ bool discreteEdge::readParametrization(FILE *fp, bool binary)
   }
   _pars.resize(N);
   _discretization.resize(N);
+  parametrizationCache.clear();
 
   std::vector<double> d(4 * N);
   if(binary){
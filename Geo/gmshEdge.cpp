@@ -55,6 +55,7 @@ void gmshEdge::resetNativePtr(Curve *c, GVertex *v1, GVertex *v2)
   if(_v0) _v0->addEdge(this);
   if(_v1 && _v1 != _v0) _v1->addEdge(this);
   setMeshSizeFromCurvePoints(*this, *c);
+  parametrizationCache.clear();
 }
 
 bool gmshEdge::degenerate(int dim) const
@@ -254,11 +254,30 @@ std::vector<BDS_Face *> BDS_Point::getTriangles() const
   return t;
 }
 
+BDS_Point *BDS_Mesh::_newPoint(int num, double x, double y, double z)
+{
+  BDS_Point *pp = new(_pointPool.allocate()) BDS_Point(num, x, y, z);
+  // new points are most often numbered after all the existing ones
+  points.insert(points.end(), pp);
+  return pp;
+}
+
+BDS_Edge *BDS_Mesh::_newEdge(BDS_Point *p1, BDS_Point *p2)
+{
+  BDS_Edge *e = new(_edgePool.allocate()) BDS_Edge(p1, p2);
+  edges.push_back(e);
+  return e;
+}
+
+BDS_Face *BDS_Mesh::_newFace(BDS_Edge *e1, BDS_Edge *e2, BDS_Edge *e3)
+{
+  return new(_facePool.allocate()) BDS_Face(e1, e2, e3);
+}
+
 BDS_Point *BDS_Mesh::add_point(int const num, double const x, double const y,
                                double const z)
 {
-  BDS_Point *pp = new BDS_Point(num, x, y, z);
-  points.insert(pp);
+  BDS_Point *pp = _newPoint(num, x, y, z);
   MAXPOINTNUMBER = std::max(MAXPOINTNUMBER, num);
   return pp;
 }
@@ -266,10 +285,9 @@ BDS_Point *BDS_Mesh::add_point(int const num, double const x, double const y,
 BDS_Point *BDS_Mesh::add_point(int num, double u, double v, GFace *gf)
 {
   GPoint gp = gf->point(u, v);
-  BDS_Point *pp = new BDS_Point(num, gp.x(), gp.y(), gp.z());
+  BDS_Point *pp = _newPoint(num, gp.x(), gp.y(), gp.z());
   pp->u = u;
   pp->v = v;
-  points.insert(pp);
   MAXPOINTNUMBER = std::max(MAXPOINTNUMBER, num);
   return pp;
 }
@@ -490,7 +508,7 @@ BDS_Edge *BDS_Mesh::add_edge(int const p1, int const p2)
     Msg::Error("Could not find points %d or %d", p1, p2);
     return 0;
   }
-  edges.push_back(new BDS_Edge(pp1, pp2));
+  _newEdge(pp1, pp2);
 
   return edges.back();
 }
@@ -507,7 +525,7 @@ BDS_Face *BDS_Mesh::add_triangle(int p1, int p2, int p3)
 BDS_Face *BDS_Mesh::add_triangle(BDS_Edge *e1, BDS_Edge *e2, BDS_Edge *e3)
 {
   if(e1 && e2 && e3) {
-    BDS_Face *t = new BDS_Face(e1, e2, e3);
+    BDS_Face *t = _newFace(e1, e2, e3);
     triangles.push_back(t);
     return t;
   }
@@ -535,7 +553,7 @@ void BDS_Mesh::del_edge(BDS_Edge *e)
 void BDS_Mesh::del_point(BDS_Point *p)
 {
   if(!p) return;
-  if(points.erase(p)) delete p;
+  if(points.erase(p)) _pointPool.release(p);
 }
 
 void BDS_Mesh::add_geom(int p1, int p2)
@@ -649,7 +667,7 @@ void BDS_Mesh::cleanup()
       std::partition(triangles.begin(), triangles.end(), is_not_deleted());
     std::vector<BDS_Face *>::iterator it = last;
     while(it != triangles.end()) {
-      delete *it;
+      _facePool.release(*it);
       ++it;
     }
     triangles.erase(last, triangles.end());
@@ -659,7 +677,7 @@ void BDS_Mesh::cleanup()
       std::partition(edges.begin(), edges.end(), is_not_deleted());
     std::vector<BDS_Edge *>::iterator it = last;
     while(it != edges.end()) {
-      delete *it;
+      _edgePool.release(*it);
       ++it;
     }
     edges.erase(last, edges.end());
@@ -669,10 +687,12 @@ void BDS_Mesh::cleanup()
 BDS_Mesh::~BDS_Mesh()
 {
   DESTROOOY(geom.begin(), geom.end());
-  DESTROOOY(points.begin(), points.end());
-  cleanup();
-  DESTROOOY(edges.begin(), edges.end());
-  DESTROOOY(triangles.begin(), triangles.end());
+  for(std::set<BDS_Point *, PointLessThan>::iterator it = points.begin();
+      it != points.end(); ++it)
+    _pointPool.release(*it);
+  for(std::size_t i = 0; i < edges.size(); i++) _edgePool.release(edges[i]);
+  for(std::size_t i = 0; i < triangles.size(); i++)
+    _facePool.release(triangles[i]);
 }
 
 bool BDS_Mesh::split_edge(BDS_Edge *e, BDS_Point *mid, bool check_area_param)
@@ -750,27 +770,23 @@ bool BDS_Mesh::split_edge(BDS_Edge *e, BDS_Point *mid, bool check_area_param)
 
   del_edge(e);
 
-  BDS_Edge *p1_mid = new BDS_Edge(p1, mid);
-  edges.push_back(p1_mid);
-  BDS_Edge *mid_p2 = new BDS_Edge(mid, p2);
-  edges.push_back(mid_p2);
-  BDS_Edge *op1_mid = new BDS_Edge(op[0], mid);
-  edges.push_back(op1_mid);
-  BDS_Edge *mid_op2 = new BDS_Edge(mid, op[1]);
-  edges.push_back(mid_op2);
+  BDS_Edge *p1_mid = _newEdge(p1, mid);
+  BDS_Edge *mid_p2 = _newEdge(mid, p2);
+  BDS_Edge *op1_mid = _newEdge(op[0], mid);
+  BDS_Edge *mid_op2 = _newEdge(mid, op[1]);
 
   BDS_Face *t1, *t2, *t3, *t4;
   if(orientation == 1) {
-    t1 = new BDS_Face(op1_mid, p1_op1, p1_mid);
-    t2 = new BDS_Face(mid_op2, op2_p2, mid_p2);
-    t3 = new BDS_Face(op1_p2, op1_mid, mid_p2);
-    t4 = new BDS_Face(p1_op2, mid_op2, p1_mid);
+    t1 = _newFace(op1_mid, p1_op1, p1_mid);
+    t2 = _newFace(mid_op2, op2_p2, mid_p2);
+    t3 = _newFace(op1_p2, op1_mid, mid_p2);
+    t4 = _newFace(p1_op2, mid_op2, p1_mid);
   }
   else {
-    t1 = new BDS_Face(p1_op1, op1_mid, p1_mid);
-    t2 = new BDS_Face(op2_p2, mid_op2, mid_p2);
-    t3 = new BDS_Face(op1_mid, op1_p2, mid_p2);
-    t4 = new BDS_Face(mid_op2, p1_op2, p1_mid);
+    t1 = _newFace(p1_op1, op1_mid, p1_mid);
+    t2 = _newFace(op2_p2, mid_op2, mid_p2);
+    t3 = _newFace(op1_mid, op1_p2, mid_p2);
+    t4 = _newFace(mid_op2, p1_op2, p1_mid);
   }
   t1->g = g1;
   t2->g = g2;
@@ -1023,16 +1039,16 @@ bool BDS_Mesh::swap_edge(BDS_Edge *e, const BDS_SwapEdgeTest &theTest,
   }
   del_edge(e);
 
-  edges.push_back(new BDS_Edge(op[0], op[1]));
+  _newEdge(op[0], op[1]);
 
   BDS_Face *t1, *t2;
   if(orientation == 1) {
-    t1 = new BDS_Face(p1_op1, p1_op2, edges.back());
-    t2 = new BDS_Face(edges.back(), op2_p2, op1_p2);
+    t1 = _newFace(p1_op1, p1_op2, edges.back());
+    t2 = _newFace(edges.back(), op2_p2, op1_p2);
   }
   else {
-    t1 = new BDS_Face(p1_op2, p1_op1, edges.back());
-    t2 = new BDS_Face(op2_p2, edges.back(), op1_p2);
+    t1 = _newFace(p1_op2, p1_op1, edges.back());
+    t2 = _newFace(op2_p2, edges.back(), op1_p2);
   }
 
   t1->g = g1;
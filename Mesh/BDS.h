@@ -16,6 +16,8 @@
 #include <algorithm>
 #include <functional>
 #include <cmath>
+#include <cstddef>
+#include <new>
 
 #include "GmshMessage.h"
 
@@ -335,7 +337,57 @@ struct EdgeToRecover {
   }
 };
 
+// Storage for the points, edges and faces of a BDS_Mesh: objects are
+// constructed in large chunks (so that their addresses never change and that
+// neighbouring entities are close in memory), and the slots of deleted
+// objects are kept in a free list and reused by subsequent allocations.
+template <class T> class BDS_Pool {
+private:
+  std::vector<T *> _chunks, _free;
+  std::size_t _used;
+  enum { CHUNK = 1024 };
+  BDS_Pool(const BDS_Pool &);
+  BDS_Pool &operator=(const BDS_Pool &);
+
+public:
+  BDS_Pool() : _used(CHUNK) {}
+  ~BDS_Pool()
+  {
+    for(std::size_t i = 0; i < _chunks.size(); i++)
+      ::operator delete(_chunks[i]);
+  }
+  // return uninitialized memory for one object (to be used with placement
+  // new)
+  void *allocate()
+  {
+    if(!_free.empty()) {
+      T *t = _free.back();
+      _free.pop_back();
+      return t;
+    }
+    if(_used == CHUNK) {
+      _chunks.push_back(static_cast<T *>(::operator new(CHUNK * sizeof(T))));
+      _used = 0;
+    }
+    return _chunks.back() + _used++;
+  }
+  // destroy the object and put its slot in the free list
+  void release(T *t)
+  {
+    t->~T();
+    _free.push_back(t);
+  }
+};
+
 class BDS_Mesh {
+private:
+  BDS_Pool<BDS_Point> _pointPool;
+  BDS_Pool<BDS_Edge> _edgePool;
+  BDS_Pool<BDS_Face> _facePool;
+  BDS_Point *_newPoint(int num, double x, double y, double z);
+  BDS_Edge *_newEdge(BDS_Point *p1, BDS_Point *p2);
+  BDS_Face *_newFace(BDS_Edge *e1, BDS_Edge *e2, BDS_Edge *e3);
+
 public:
   int MAXPOINTNUMBER;
   double Min[3], Max[3], LC;
@@ -222,7 +222,10 @@ double BGM_MeshSizeWithoutScaling(GEntity *ge, double U, double V, double X,
     FieldManager *fields = ge->model()->getFields();
     if(fields->getBackgroundField() > 0) {
       Field *f = fields->get(fields->getBackgroundField());
-      if(f) l3 = (*f)(X, Y, Z, ge);
+      if(f) {
+        l3 = (*f)(X, Y, Z, ge);
+        Msg::ProfileCount("field evaluations");
+      }
     }
   }
 
@@ -300,6 +303,7 @@ SMetric3 BGM_MeshMetric(GEntity *ge, double U, double V, double X, double Y,
   if(fields->getBackgroundField() > 0) {
     Field *f = fields->get(fields->getBackgroundField());
     if(f) {
+      Msg::ProfileCount("field evaluations");
       SMetric3 l4;
       if(!f->isotropic()) {
         (*f)(X, Y, Z, l4, ge);
@@ -5,6 +5,7 @@
 
 #include <stdlib.h>
 #include <stack>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "Numeric.h"
@@ -341,6 +342,7 @@ static void Mesh1D(GModel *m)
   m->getFields()->initialize();
 
   if(TooManyElements(m, 1)) return;
+  MsgProfileSection prof("Mesh 1D");
   Msg::StatusBar(true, "Meshing 1D...");
   double t1 = Cpu(), w1 = TimeOfDay();
 
@@ -382,7 +384,10 @@ static void Mesh1D(GModel *m)
     for(size_t K = 0; K < sss; K++) {
       GEdge *ed = temp[K];
       if(ed->meshStatistics.status == GEdge::PENDING) {
+        MsgProfileSection profEdge("Curve %d", ed->tag());
         ed->mesh(true);
+        Msg::ProfileCount("nodes", ed->mesh_vertices.size());
+        Msg::ProfileCount("elements", ed->lines.size());
 #if defined(_OPENMP)
 #pragma omp critical
 #endif
@@ -472,6 +477,147 @@ static void PrintMesh2dStatistics(GModel *m)
   fclose(statreport);
 }
 
+// segments of the boundary mesh of a surface in its parametric space (seams
+// are added on both sides); also accumulates the number and the total length
+// of the boundary mesh edges
+static void AddBoundaryMesh(GFace *gf, GEdge *ge, std::vector<SPoint2> &seg,
+                            double &n, double &length)
+{
+  const int nSides = ge->isSeam(gf) ? 2 : 1;
+  for(std::size_t i = 0; i < ge->lines.size(); i++) {
+    MVertex *v0 = ge->lines[i]->getVertex(0), *v1 = ge->lines[i]->getVertex(1);
+    n += 1.;
+    length += v0->distance(v1);
+    double t0, t1;
+    if(!reparamMeshVertexOnEdge(v0, ge, t0) ||
+       !reparamMeshVertexOnEdge(v1, ge, t1))
+      continue;
+    for(int side = 0; side < nSides; side++) {
+      const int dir = side ? -1 : 1;
+      seg.push_back(ge->reparamOnFace(gf, t0, dir));
+      seg.push_back(ge->reparamOnFace(gf, t1, dir));
+    }
+  }
+}
+
+// crossing number test of a point against a set of segments
+static bool InsideSegments(const SPoint2 &p, const std::vector<SPoint2> &seg)
+{
+  bool inside = false;
+  for(std::size_t i = 0; i + 1 < seg.size(); i += 2) {
+    const SPoint2 &a = seg[i], &b = seg[i + 1];
+    if((a.y() > p.y()) == (b.y() > p.y())) continue;
+    double x = a.x() + (p.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+    if(p.x() < x) inside = !inside;
+  }
+  return inside;
+}
+
+// estimated cost of meshing a surface, i.e. its expected number of triangles:
+// the integral of the element density 1/h^2 over the surface, sampled on a
+// regular grid covering the boundary mesh in the parametric domain (samples
+// outside of the boundary are discarded, so that holes and trimmed parts are
+// not counted). The size h is the one prescribed by the size fields, curvature
+// and global sizes, bounded by the average size of the boundary mesh if sizes
+// are extended from the boundary: this accounts for surfaces refined (or
+// coarsened) inside, which the boundary mesh alone does not see. Surfaces that
+// cannot be sampled are estimated from their boundary mesh only, the number
+// of triangles growing like the square of the number of boundary mesh edges.
+static double EstimatedMeshingCost(GFace *gf)
+{
+  double n = 0., length = 0.;
+  std::vector<SPoint2> seg, unused;
+  std::vector<GEdge *> const &edges = gf->edges();
+  for(std::size_t i = 0; i < edges.size(); i++)
+    AddBoundaryMesh(gf, edges[i], seg, n, length);
+  std::vector<GEdge *> &embedded = gf->embeddedEdges();
+  for(std::size_t i = 0; i < embedded.size(); i++)
+    AddBoundaryMesh(gf, embedded[i], unused, n, length);
+  // equilateral triangles of size h: sqrt(3) / 4 h^2 each; a square with n
+  // boundary edges holds about n^2 / (4 sqrt(3)) of them
+  const double density = 4. / std::sqrt(3.);
+  const double fromBoundary = n * n * density / 16.;
+  if(gf->geomType() == GEntity::DiscreteSurface || seg.empty())
+    return fromBoundary;
+
+  SBoundingBox3d bb;
+  for(std::size_t i = 0; i < seg.size(); i++)
+    bb += SPoint3(seg[i].x(), seg[i].y(), 0.);
+  const double hb = (n > 0.) ? length / n : 0.;
+  const bool extend = Extend1dMeshIn2dSurfaces(gf) && hb > 0.;
+  const int N = 8;
+  const double du = (bb.max().x() - bb.min().x()) / N;
+  const double dv = (bb.max().y() - bb.min().y()) / N;
+  double cost = 0.;
+  for(int i = 0; i < N; i++) {
+    for(int j = 0; j < N; j++) {
+      SPoint2 p(bb.min().x() + (i + 0.5) * du, bb.min().y() + (j + 0.5) * dv);
+      if(!InsideSegments(p, seg)) continue;
+      GPoint gp = gf->point(p);
+      if(!gp.succeeded()) return fromBoundary;
+      Pair<SVector3, SVector3> der = gf->firstDer(p);
+      double h = BGM_MeshSize(gf, p.x(), p.y(), gp.x(), gp.y(), gp.z());
+      if(extend) h = std::min(h, hb);
+      if(h <= 0.) return fromBoundary;
+      cost += norm(crossprod(der.first(), der.second())) * du * dv / (h * h);
+    }
+  }
+  // a triangulation of the boundary alone has about as many triangles as
+  // boundary edges
+  return std::max(cost * density, n);
+}
+
+static bool CostGreaterThan(const std::pair<double, GFace *> &a,
+                            const std::pair<double, GFace *> &b)
+{
+  return a.first > b.first;
+}
+
+// when meshing in parallel, start with the most expensive surfaces, so that the
+// cheap ones fill in the gaps at the end (with a dynamic schedule, idle threads
+// pick up the next surface as soon as they are done); entities with the same
+// cost keep their original order. A surface that costs more than all the
+// following ones together would still be meshed by a single thread long after
+// the others are done: such surfaces are moved to "large", to be meshed one at
+// a time, with all the threads available to the parallel loops inside the
+// meshing algorithms.
+static void SortByEstimatedCost(std::vector<GFace *> &faces,
+                                std::vector<GFace *> &large)
+{
+  if(Msg::GetMaxThreads() < 2 || faces.empty()) return;
+  std::vector<std::pair<double, GFace *> > cost(faces.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(std::size_t i = 0; i < faces.size(); i++) {
+    double c = 0.;
+    if(faces[i]->meshStatistics.status == GFace::PENDING)
+      c = EstimatedMeshingCost(faces[i]);
+    cost[i] = std::make_pair(c, faces[i]);
+  }
+  std::stable_sort(cost.begin(), cost.end(), CostGreaterThan);
+  double rest = 0.;
+  for(std::size_t i = 0; i < cost.size(); i++) rest += cost[i].first;
+  std::size_t first = 0;
+  while(first < cost.size()) {
+    rest -= cost[first].first;
+    if(cost[first].first <= rest) break;
+    large.push_back(cost[first++].second);
+  }
+  faces.clear();
+  for(std::size_t i = first; i < cost.size(); i++)
+    faces.push_back(cost[i].second);
+}
+
+static void MeshSurface(GFace *gf)
+{
+  MsgProfileSection profFace("Surface %d", gf->tag());
+  backgroundMesh::current()->unset();
+  gf->mesh(true);
+  Msg::ProfileCount("nodes", gf->mesh_vertices.size());
+  Msg::ProfileCount("elements", gf->getNumMeshElements());
+}
+
 static void Mesh2D(GModel *m)
 {
   if(CTX::instance()->abortOnError && Msg::GetErrorCount()) return;
@@ -479,6 +625,7 @@ static void Mesh2D(GModel *m)
   m->getFields()->initialize();
 
   if(TooManyElements(m, 2)) return;
+  MsgProfileSection prof("Mesh 2D");
   Msg::StatusBar(true, "Meshing 2D...");
   double t1 = Cpu(), w1 = TimeOfDay();
 
@@ -526,15 +673,22 @@ static void Mesh2D(GModel *m)
       }
 
       int nPending = 0;
-      std::vector<GFace *> temp;
+      std::vector<GFace *> temp, large;
       temp.insert(temp.begin(), f.begin(), f.end());
+      SortByEstimatedCost(temp, large);
+      for(std::size_t K = 0; K < large.size(); K++) {
+        if(large[K]->meshStatistics.status == GFace::PENDING) {
+          MeshSurface(large[K]);
+          nPending++;
+        }
+        if(!nIter) Msg::ProgressMeter(nPending, false, "Meshing 2D...");
+      }
 #if defined(_OPENMP)
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
       for(size_t K = 0; K < temp.size(); K++) {
         if(temp[K]->meshStatistics.status == GFace::PENDING) {
-          backgroundMesh::current()->unset();
-          temp[K]->mesh(true);
+          MeshSurface(temp[K]);
 #if defined(_OPENMP)
 #pragma omp critical
 #endif
@@ -608,6 +762,103 @@ FindConnectedRegions(const std::vector<GRegion *> &del,
             connected.size() > 1 ? "s" : "");
 }
 
+static bool GroupCostGreaterThan(const std::pair<std::size_t, std::size_t> &a,
+                                 const std::pair<std::size_t, std::size_t> &b)
+{
+  return a.first > b.first;
+}
+
+static void InsertBoundaryEntities(GEdge *ge, std::set<GEntity *> &ents)
+{
+  ents.insert(ge);
+  if(ge->getBeginVertex()) ents.insert(ge->getBeginVertex());
+  if(ge->getEndVertex()) ents.insert(ge->getEndVertex());
+}
+
+// split the groups of connected volumes into batches of groups that do not
+// share any curve or point (and thus any mesh node), so that the groups in a
+// batch can be meshed concurrently by the built-in Delaunay algorithm; the
+// batches are obtained by greedy coloring, and each batch is sorted by
+// decreasing size of the surface meshes. If the groups cannot be meshed
+// concurrently, each batch contains a single group, in the original order.
+static void
+BatchIndependentRegions(std::vector<std::vector<GRegion *> > &connected,
+                        std::vector<std::vector<std::size_t> > &batches)
+{
+  batches.clear();
+
+  bool concurrent = Msg::GetMaxThreads() > 1 && connected.size() > 1 &&
+                    (CTX::instance()->mesh.algo3d == ALGO_3D_DELAUNAY ||
+                     CTX::instance()->mesh.algo3d == ALGO_3D_INITIAL_ONLY);
+
+  std::vector<std::vector<GEntity *> > bnd(connected.size());
+  std::vector<std::pair<std::size_t, std::size_t> > cost(connected.size());
+  for(std::size_t i = 0; concurrent && i < connected.size(); i++) {
+    std::set<GEntity *> ents;
+    cost[i] = std::make_pair(0, i);
+    for(std::size_t j = 0; j < connected[i].size(); j++) {
+      GRegion *gr = connected[i][j];
+      std::vector<GFace *> faces = gr->faces();
+      faces.insert(faces.end(), gr->embeddedFaces().begin(),
+                   gr->embeddedFaces().end());
+      for(std::size_t k = 0; k < faces.size(); k++) {
+        GFace *gf = faces[k];
+        // hybrid meshes (with pyramids) are post-processed globally
+        if(gf->quadrangles.size()) concurrent = false;
+        cost[i].first += gf->triangles.size();
+        std::vector<GEdge *> const &e = gf->edges();
+        for(std::size_t l = 0; l < e.size(); l++)
+          InsertBoundaryEntities(e[l], ents);
+        for(std::size_t l = 0; l < gf->embeddedEdges().size(); l++)
+          InsertBoundaryEntities(gf->embeddedEdges()[l], ents);
+        ents.insert(gf->embeddedVertices().begin(),
+                    gf->embeddedVertices().end());
+      }
+      for(std::size_t l = 0; l < gr->embeddedEdges().size(); l++)
+        InsertBoundaryEntities(gr->embeddedEdges()[l], ents);
+      ents.insert(gr->embeddedVertices().begin(),
+                  gr->embeddedVertices().end());
+    }
+    bnd[i].insert(bnd[i].end(), ents.begin(), ents.end());
+  }
+
+  if(!concurrent) {
+    for(std::size_t i = 0; i < connected.size(); i++)
+      batches.push_back(std::vector<std::size_t>(1, i));
+    return;
+  }
+
+  std::map<GEntity *, std::vector<std::size_t> > groups;
+  for(std::size_t i = 0; i < bnd.size(); i++) {
+    for(std::size_t j = 0; j < bnd[i].size(); j++)
+      groups[bnd[i][j]].push_back(i);
+  }
+  std::vector<int> color(connected.size(), -1);
+  std::vector<std::vector<std::pair<std::size_t, std::size_t> > > sorted;
+  for(std::size_t i = 0; i < bnd.size(); i++) {
+    std::set<int> used;
+    for(std::size_t j = 0; j < bnd[i].size(); j++) {
+      std::vector<std::size_t> &g = groups[bnd[i][j]];
+      for(std::size_t k = 0; k < g.size(); k++)
+        if(color[g[k]] >= 0) used.insert(color[g[k]]);
+    }
+    int c = 0;
+    while(used.count(c)) c++;
+    color[i] = c;
+    if(c >= (int)sorted.size()) sorted.resize(c + 1);
+    sorted[c].push_back(cost[i]);
+  }
+  batches.resize(sorted.size());
+  for(std::size_t c = 0; c < sorted.size(); c++) {
+    std::stable_sort(sorted[c].begin(), sorted[c].end(), GroupCostGreaterThan);
+    for(std::size_t k = 0; k < sorted[c].size(); k++)
+      batches[c].push_back(sorted[c][k].second);
+  }
+  Msg::Info("Meshing %d groups of volumes in %d concurrent batch%s",
+            (int)connected.size(), (int)batches.size(),
+            batches.size() > 1 ? "es" : "");
+}
+
 // JFR : use hex-splitting to resolve non conformity
 //     : if howto == 1 ---> split hexes
 //     : if howto == 2 ---> create transition elements
@@ -814,6 +1065,7 @@ static void Mesh3D(GModel *m)
   m->getFields()->initialize();
 
   if(TooManyElements(m, 3)) return;
+  MsgProfileSection prof("Mesh 3D");
   Msg::StatusBar(true, "Meshing 3D...");
   double t1 = Cpu(), w1 = TimeOfDay();
 
@@ -835,15 +1087,21 @@ static void Mesh3D(GModel *m)
   }
 
   // mesh the extruded volumes first
-  std::for_each(m->firstRegion(), m->lastRegion(), meshGRegionExtruded());
+  {
+    MsgProfileSection profExtruded("Extruded volumes");
+    std::for_each(m->firstRegion(), m->lastRegion(), meshGRegionExtruded());
 
-  // then subdivide if necessary (unfortunately the subdivision is a
-  // global operation, which can require changing the surface mesh!)
-  SubdivideExtrudedMesh(m);
+    // then subdivide if necessary (unfortunately the subdivision is a
+    // global operation, which can require changing the surface mesh!)
+    SubdivideExtrudedMesh(m);
+  }
 
   // then mesh all the non-delaunay regions (front3D with netgen)
   std::vector<GRegion *> delaunay;
-  std::for_each(m->firstRegion(), m->lastRegion(), meshGRegion(delaunay));
+  {
+    MsgProfileSection profOther("Non-Delaunay volumes");
+    std::for_each(m->firstRegion(), m->lastRegion(), meshGRegion(delaunay));
+  }
 
   // and finally mesh the delaunay regions (again, this is global; but
   // we mesh each connected part separately for performance and mesh
@@ -870,61 +1128,81 @@ static void Mesh3D(GModel *m)
   int nb_elements_recombination = 0, nb_hexa_recombination = 0;
 #endif
 
-  for(std::size_t i = 0; i < connected.size(); i++) {
+  // mesh the groups of connected volumes, batch by batch (the groups in a batch
+  // are independent and are meshed concurrently)
+  std::vector<std::vector<std::size_t> > batches;
+  BatchIndependentRegions(connected, batches);
+
+  for(std::size_t ib = 0; ib < batches.size(); ib++) {
     if(CTX::instance()->abortOnError && Msg::GetErrorCount()) {
       Msg::Error("Aborted 3D meshing");
       break;
     }
 
-    MeshDelaunayVolume(connected[i]);
+    std::vector<std::size_t> &batch = batches[ib];
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1) if(batch.size() > 1)
+#endif
+    for(std::size_t b = 0; b < batch.size(); b++) {
+      std::vector<GRegion *> &group = connected[batch[b]];
+      MsgProfileSection profVolume("Volume %d", group[0]->tag());
+      MeshDelaunayVolume(group, batch.size() > 1);
+      for(std::size_t j = 0; j < group.size(); j++) {
+        Msg::ProfileCount("nodes", group[j]->mesh_vertices.size());
+        Msg::ProfileCount("elements", group[j]->getNumMeshElements());
+      }
+    }
 
 #if defined(HAVE_DOMHEX)
     // additional code for experimental hex mesh - will eventually be replaced
     // by new HXT-based code
-    for(std::size_t j = 0; j < connected[i].size(); j++) {
-      GRegion *gr = connected[i][j];
-      bool treat_region_ok = false;
-      if(CTX::instance()->mesh.algo3d == ALGO_3D_RTREE) {
-        if(old_algo_hexa()) {
-          Filler f;
-          f.treat_region(gr);
-          treat_region_ok = true;
-        }
-        else {
-          Filler3D f;
-          treat_region_ok = f.treat_region(gr);
-        }
-      }
-      if(treat_region_ok && (CTX::instance()->mesh.recombine3DAll ||
-                             gr->meshAttributes.recombine3D)) {
-        if(CTX::instance()->mesh.optimize) {
-          optimizeMeshGRegion opt;
-          opt(gr);
-        }
-        double a = TimeOfDay();
-        // CTX::instance()->mesh.recombine3DLevel = 2;
-        if(CTX::instance()->mesh.recombine3DLevel >= 0) {
-          Recombinator rec;
-          rec.execute(gr);
+    for(std::size_t b = 0; b < batch.size(); b++) {
+      std::size_t i = batch[b];
+      for(std::size_t j = 0; j < connected[i].size(); j++) {
+        GRegion *gr = connected[i][j];
+        bool treat_region_ok = false;
+        if(CTX::instance()->mesh.algo3d == ALGO_3D_RTREE) {
+          if(old_algo_hexa()) {
+            Filler f;
+            f.treat_region(gr);
+            treat_region_ok = true;
+          }
+          else {
+            Filler3D f;
+            treat_region_ok = f.treat_region(gr);
+          }
         }
-        if(CTX::instance()->mesh.recombine3DLevel >= 1) {
-          Supplementary sup;
-          sup.execute(gr);
+        if(treat_region_ok && (CTX::instance()->mesh.recombine3DAll ||
+                               gr->meshAttributes.recombine3D)) {
+          if(CTX::instance()->mesh.optimize) {
+            optimizeMeshGRegion opt;
+            opt(gr);
+          }
+          double a = TimeOfDay();
+          // CTX::instance()->mesh.recombine3DLevel = 2;
+          if(CTX::instance()->mesh.recombine3DLevel >= 0) {
+            Recombinator rec;
+            rec.execute(gr);
+          }
+          if(CTX::instance()->mesh.recombine3DLevel >= 1) {
+            Supplementary sup;
+            sup.execute(gr);
+          }
+          PostOp post;
+          post.execute(gr, CTX::instance()->mesh.recombine3DLevel,
+                       CTX::instance()->mesh.recombine3DConformity);
+          // CTX::instance()->mesh.recombine3DConformity);
+          // 0: no pyramid, 1: single-step, 2: two-steps (conforming),
+          // true: fill non-conformities with trihedra
+          RelocateVertices(gr, CTX::instance()->mesh.nbSmoothing);
+          // while(LaplaceSmoothing (gr)){
+          // }
+          nb_elements_recombination += post.get_nb_elements();
+          nb_hexa_recombination += post.get_nb_hexahedra();
+          vol_element_recombination += post.get_vol_elements();
+          vol_hexa_recombination += post.get_vol_hexahedra();
+          time_recombination += (TimeOfDay() - a);
         }
-        PostOp post;
-        post.execute(gr, CTX::instance()->mesh.recombine3DLevel,
-                     CTX::instance()->mesh.recombine3DConformity);
-        // CTX::instance()->mesh.recombine3DConformity);
-        // 0: no pyramid, 1: single-step, 2: two-steps (conforming),
-        // true: fill non-conformities with trihedra
-        RelocateVertices(gr, CTX::instance()->mesh.nbSmoothing);
-        // while(LaplaceSmoothing (gr)){
-        // }
-        nb_elements_recombination += post.get_nb_elements();
-        nb_hexa_recombination += post.get_nb_hexahedra();
-        vol_element_recombination += post.get_vol_elements();
-        vol_hexa_recombination += post.get_vol_hexahedra();
-        time_recombination += (TimeOfDay() - a);
       }
     }
 #endif
@@ -996,6 +1274,9 @@ void OptimizeMesh(GModel *m, const std::string &how, bool force, int niter)
     return;
   }
 
+  MsgProfileSection prof("Optimize mesh (%s)",
+                         how.empty() ? "Gmsh" : how.c_str());
+
   if(how == "" || how == "Gmsh" || how == "Optimize")
     Msg::StatusBar(true, "Optimizing mesh...");
   else
@@ -1027,6 +1308,7 @@ void OptimizeMesh(GModel *m, const std::string &how, bool force, int niter)
     p.dim = m->getDim();
     p.optPrimSurfMesh = CTX::instance()->mesh.hoPrimSurfMesh;
     p.optCAD = CTX::instance()->mesh.hoDistCAD;
+    p.strategy = CTX::instance()->mesh.hoPatchStrategy;
     HighOrderMeshOptimizer(m, p);
 #else
     Msg::Error("High-order mesh optimization requires the OPTHOM module");
@@ -1396,6 +1678,8 @@ void GenerateMesh(GModel *m, int ask)
   }
   CTX::instance()->lock = 1;
 
+  MsgProfileSection prof("Generate mesh");
+
   Msg::ResetErrorCounter();
 
   m->clearLastMeshEntityError();
@@ -9,6 +9,8 @@
 
 #include <sstream>
 #include <vector>
+#include <set>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "GModel.h"
 #include "HighOrder.h"
@@ -23,6 +25,7 @@
 #include "OS.h"
 #include "fullMatrix.h"
 #include "BasisFactory.h"
+#include "ElementType.h"
 #include "nodalBasis.h"
 #include "InnerVertexPlacement.h"
 #include "Context.h"
@@ -725,11 +728,11 @@ static void interpVerticesInExistingFace(GEntity *ge,
   }
 }
 
-// Get new interior vertices for a 2D element
-static void getFaceVertices(GFace *gf, MElement *ele,
-                            std::vector<MVertex *> &newVertices,
-                            faceContainer &faceVertices, bool linear,
-                            int nPts = 1)
+// Create new interior vertices for a 2D element
+static void createFaceVertices(GFace *gf, MElement *ele,
+                               const std::vector<MVertex *> &newVertices,
+                               std::vector<MVertex *> &vFace, bool linear,
+                               int nPts = 1)
 {
   if(!gf->haveParametrization()) linear = true;
 
@@ -744,14 +747,22 @@ static void getFaceVertices(GFace *gf, MElement *ele,
   }
   int type = ele->getType();
   fullMatrix<double> *coefficients = getInnerVertexPlacement(type, nPts + 1);
-  std::vector<MVertex *> vFace;
   if(!linear) { // Get vertices on geometry if asked...
     getFaceVerticesOnGeo(gf, *coefficients, boundaryVertices, vFace);
   }
   else { // ... otherwise, create from mesh interpolation
     interpVerticesInExistingFace(gf, *coefficients, boundaryVertices, vFace);
   }
+}
 
+// Get new interior vertices for a 2D element
+static void getFaceVertices(GFace *gf, MElement *ele,
+                            std::vector<MVertex *> &newVertices,
+                            faceContainer &faceVertices, bool linear,
+                            int nPts = 1)
+{
+  std::vector<MVertex *> vFace;
+  createFaceVertices(gf, ele, newVertices, vFace, linear, nPts);
   MFace face = ele->getFace(0);
   faceVertices[face].insert(faceVertices[face].end(), vFace.begin(),
                             vFace.end());
@@ -823,6 +834,24 @@ static int retrieveFaceBoundaryVertices(int k, int type, int nPts,
   }
 }
 
+// Reorder the high-order vertices vtcs of the face ref, so that they match the
+// orientation of the same face as seen from another element
+static void reorientFaceVertices(const MFace &ref, const MFace &face,
+                                 std::vector<MVertex *> &vtcs, int nPts)
+{
+  int orientation;
+  bool swap;
+  if(ref.computeCorrespondence(face, orientation, swap)) {
+    // Check correspondence and apply permutation if needed
+    if(face.getNumVertices() == 3 && nPts > 1)
+      reorientTrianglePoints(vtcs, orientation, swap);
+    else if(face.getNumVertices() == 4)
+      reorientQuadPoints(vtcs, orientation, swap, nPts - 1);
+  }
+  else
+    Msg::Error("Error in face lookup for retrieval of high order face nodes");
+}
+
 // Get new face (excluding edge) vertices for a face of a 3D element
 static void getFaceVertices(GRegion *gr, MElement *ele,
                             std::vector<MVertex *> &newVertices,
@@ -838,18 +867,7 @@ static void getFaceVertices(GRegion *gr, MElement *ele,
     faceContainer::iterator fIter = faceVertices.find(face);
     if(fIter != faceVertices.end()) { // Vertices already exist
       std::vector<MVertex *> vtcs = fIter->second;
-      int orientation;
-      bool swap;
-      if(fIter->first.computeCorrespondence(face, orientation, swap)) {
-        // Check correspondence and apply permutation if needed
-        if(face.getNumVertices() == 3 && nPts > 1)
-          reorientTrianglePoints(vtcs, orientation, swap);
-        else if(face.getNumVertices() == 4)
-          reorientQuadPoints(vtcs, orientation, swap, nPts - 1);
-      }
-      else
-        Msg::Error(
-          "Error in face lookup for retrieval of high order face nodes");
+      reorientFaceVertices(fIter->first, face, vtcs, nPts);
       vFace.assign(vtcs.begin(), vtcs.end());
     }
     else { // Vertices do not exist, create them by interpolation
@@ -896,6 +914,42 @@ static void getVolumeVertices(GRegion *gr, MElement *ele,
   }
 }
 
+// The high-order elements are built from the vertices returned by a "nodes"
+// object: containerNodes looks them up in (and adds them to) the edge and face
+// containers; the parallel path below uses read-only tables instead
+
+class containerNodes {
+private:
+  edgeContainer &_edgeVertices;
+  faceContainer &_faceVertices;
+
+public:
+  containerNodes(edgeContainer &edgeVertices, faceContainer &faceVertices)
+    : _edgeVertices(edgeVertices), _faceVertices(faceVertices)
+  {
+  }
+  void getEdgeVertices(GFace *gf, MElement *ele, std::vector<MVertex *> &ve,
+                       bool linear, int nPts)
+  {
+    ::getEdgeVertices(gf, ele, ve, _edgeVertices, linear, nPts);
+  }
+  void getFaceVertices(GFace *gf, MElement *ele, std::vector<MVertex *> &ve,
+                       bool linear, int nPts)
+  {
+    ::getFaceVertices(gf, ele, ve, _faceVertices, linear, nPts);
+  }
+  void getEdgeVertices(GRegion *gr, MElement *ele, std::vector<MVertex *> &ve,
+                       int nPts)
+  {
+    ::getEdgeVertices(gr, ele, ve, _edgeVertices, nPts);
+  }
+  void getFaceVertices(GRegion *gr, MElement *ele, std::vector<MVertex *> &ve,
+                       int nPts)
+  {
+    ::getFaceVertices(gr, ele, ve, _faceVertices, nPts);
+  }
+};
+
 // Creation of high-order elements
 
 static void setHighOrder(GEdge *ge, edgeContainer &edgeVertices, bool linear,
@@ -918,31 +972,29 @@ static void setHighOrder(GEdge *ge, edgeContainer &edgeVertices, bool linear,
   ge->deleteVertexArrays();
 }
 
-static MTriangle *setHighOrder(MTriangle *t, GFace *gf,
-                               edgeContainer &edgeVertices,
-                               faceContainer &faceVertices, bool linear,
-                               bool incomplete, int nPts)
+template <class Nodes>
+static MTriangle *setHighOrder(MTriangle *t, GFace *gf, Nodes &nodes,
+                               bool linear, bool incomplete, int nPts)
 {
   std::vector<MVertex *> v;
-  getEdgeVertices(gf, t, v, edgeVertices, linear, nPts);
+  nodes.getEdgeVertices(gf, t, v, linear, nPts);
   if(nPts == 1) {
     return new MTriangle6(t->getVertex(0), t->getVertex(1), t->getVertex(2),
                           v[0], v[1], v[2], 0, t->getPartition());
   }
   else {
-    if(!incomplete) getFaceVertices(gf, t, v, faceVertices, linear, nPts);
+    if(!incomplete) nodes.getFaceVertices(gf, t, v, linear, nPts);
     return new MTriangleN(t->getVertex(0), t->getVertex(1), t->getVertex(2), v,
                           nPts + 1, 0, t->getPartition());
   }
 }
 
-static MQuadrangle *setHighOrder(MQuadrangle *q, GFace *gf,
-                                 edgeContainer &edgeVertices,
-                                 faceContainer &faceVertices, bool linear,
-                                 bool incomplete, int nPts)
+template <class Nodes>
+static MQuadrangle *setHighOrder(MQuadrangle *q, GFace *gf, Nodes &nodes,
+                                 bool linear, bool incomplete, int nPts)
 {
   std::vector<MVertex *> v;
-  getEdgeVertices(gf, q, v, edgeVertices, linear, nPts);
+  nodes.getEdgeVertices(gf, q, v, linear, nPts);
   if(incomplete) {
     if(nPts == 1) {
       return new MQuadrangle8(q->getVertex(0), q->getVertex(1), q->getVertex(2),
@@ -956,7 +1008,7 @@ static MQuadrangle *setHighOrder(MQuadrangle *q, GFace *gf,
     }
   }
   else {
-    getFaceVertices(gf, q, v, faceVertices, linear, nPts);
+    nodes.getFaceVertices(gf, q, v, linear, nPts);
     if(nPts == 1) {
       return new MQuadrangle9(q->getVertex(0), q->getVertex(1), q->getVertex(2),
                               q->getVertex(3), v[0], v[1], v[2], v[3], v[4], 0,
@@ -974,11 +1026,12 @@ static void setHighOrder(GFace *gf, edgeContainer &edgeVertices,
                          faceContainer &faceVertices, bool linear,
                          bool incomplete, int nPts = 1)
 {
+  containerNodes nodes(edgeVertices, faceVertices);
+
   std::vector<MTriangle *> triangles2;
   for(std::size_t i = 0; i < gf->triangles.size(); i++) {
     MTriangle *t = gf->triangles[i];
-    MTriangle *tNew =
-      setHighOrder(t, gf, edgeVertices, faceVertices, linear, incomplete, nPts);
+    MTriangle *tNew = setHighOrder(t, gf, nodes, linear, incomplete, nPts);
     triangles2.push_back(tNew);
     delete t;
   }
@@ -987,8 +1040,7 @@ static void setHighOrder(GFace *gf, edgeContainer &edgeVertices,
   std::vector<MQuadrangle *> quadrangles2;
   for(std::size_t i = 0; i < gf->quadrangles.size(); i++) {
     MQuadrangle *q = gf->quadrangles[i];
-    MQuadrangle *qNew =
-      setHighOrder(q, gf, edgeVertices, faceVertices, linear, incomplete, nPts);
+    MQuadrangle *qNew = setHighOrder(q, gf, nodes, linear, incomplete, nPts);
     quadrangles2.push_back(qNew);
     delete q;
   }
@@ -996,13 +1048,12 @@ static void setHighOrder(GFace *gf, edgeContainer &edgeVertices,
   gf->deleteVertexArrays();
 }
 
-static MTetrahedron *setHighOrder(MTetrahedron *t, GRegion *gr,
-                                  edgeContainer &edgeVertices,
-                                  faceContainer &faceVertices, bool incomplete,
-                                  int nPts)
+template <class Nodes>
+static MTetrahedron *setHighOrder(MTetrahedron *t, GRegion *gr, Nodes &nodes,
+                                  bool incomplete, int nPts)
 {
   std::vector<MVertex *> v;
-  getEdgeVertices(gr, t, v, edgeVertices, nPts);
+  nodes.getEdgeVertices(gr, t, v, nPts);
   if(nPts == 1) {
     return new MTetrahedron10(t->getVertex(0), t->getVertex(1), t->getVertex(2),
                               t->getVertex(3), v[0], v[1], v[2], v[3], v[4],
@@ -1010,7 +1061,7 @@ static MTetrahedron *setHighOrder(MTetrahedron *t, GRegion *gr,
   }
   else {
     if(!incomplete) {
-      getFaceVertices(gr, t, v, faceVertices, nPts);
+      nodes.getFaceVertices(gr, t, v, nPts);
       getVolumeVertices(gr, t, v, nPts);
     }
     return new MTetrahedronN(t->getVertex(0), t->getVertex(1), t->getVertex(2),
@@ -1019,13 +1070,12 @@ static MTetrahedron *setHighOrder(MTetrahedron *t, GRegion *gr,
   }
 }
 
-static MHexahedron *setHighOrder(MHexahedron *h, GRegion *gr,
-                                 edgeContainer &edgeVertices,
-                                 faceContainer &faceVertices, bool incomplete,
-                                 int nPts)
+template <class Nodes>
+static MHexahedron *setHighOrder(MHexahedron *h, GRegion *gr, Nodes &nodes,
+                                 bool incomplete, int nPts)
 {
   std::vector<MVertex *> v;
-  getEdgeVertices(gr, h, v, edgeVertices, nPts);
+  nodes.getEdgeVertices(gr, h, v, nPts);
   if(incomplete) {
     if(nPts == 1) {
       return new MHexahedron20(
@@ -1042,7 +1092,7 @@ static MHexahedron *setHighOrder(MHexahedron *h, GRegion *gr,
     }
   }
   else {
-    getFaceVertices(gr, h, v, faceVertices, nPts);
+    nodes.getFaceVertices(gr, h, v, nPts);
     getVolumeVertices(gr, h, v, nPts);
     if(nPts == 1) {
       return new MHexahedron27(
@@ -1061,12 +1111,12 @@ static MHexahedron *setHighOrder(MHexahedron *h, GRegion *gr,
   }
 }
 
-static MPrism *setHighOrder(MPrism *p, GRegion *gr, edgeContainer &edgeVertices,
-                            faceContainer &faceVertices, bool incomplete,
-                            int nPts)
+template <class Nodes>
+static MPrism *setHighOrder(MPrism *p, GRegion *gr, Nodes &nodes,
+                            bool incomplete, int nPts)
 {
   std::vector<MVertex *> v;
-  getEdgeVertices(gr, p, v, edgeVertices, nPts);
+  nodes.getEdgeVertices(gr, p, v, nPts);
   if(incomplete) {
     if(nPts == 1) {
       return new MPrism15(p->getVertex(0), p->getVertex(1), p->getVertex(2),
@@ -1081,7 +1131,7 @@ static MPrism *setHighOrder(MPrism *p, GRegion *gr, edgeContainer &edgeVertices,
     }
   }
   else {
-    getFaceVertices(gr, p, v, faceVertices, nPts);
+    nodes.getFaceVertices(gr, p, v, nPts);
     if(nPts == 1) {
       return new MPrism18(p->getVertex(0), p->getVertex(1), p->getVertex(2),
                           p->getVertex(3), p->getVertex(4), p->getVertex(5),
@@ -1097,15 +1147,14 @@ static MPrism *setHighOrder(MPrism *p, GRegion *gr, edgeContainer &edgeVertices,
   }
 }
 
-static MPyramid *setHighOrder(MPyramid *p, GRegion *gr,
-                              edgeContainer &edgeVertices,
-                              faceContainer &faceVertices, bool incomplete,
-                              int nPts)
+template <class Nodes>
+static MPyramid *setHighOrder(MPyramid *p, GRegion *gr, Nodes &nodes,
+                              bool incomplete, int nPts)
 {
   std::vector<MVertex *> v;
-  getEdgeVertices(gr, p, v, edgeVertices, nPts);
+  nodes.getEdgeVertices(gr, p, v, nPts);
   if(!incomplete) {
-    getFaceVertices(gr, p, v, faceVertices, nPts);
+    nodes.getFaceVertices(gr, p, v, nPts);
     if(nPts > 1) { getVolumeVertices(gr, p, v, nPts); }
   }
   return new MPyramidN(p->getVertex(0), p->getVertex(1), p->getVertex(2),
@@ -1117,11 +1166,12 @@ static void setHighOrder(GRegion *gr, edgeContainer &edgeVertices,
                          faceContainer &faceVertices, bool incomplete,
                          int nPts = 1)
 {
+  containerNodes nodes(edgeVertices, faceVertices);
+
   std::vector<MTetrahedron *> tetrahedra2;
   for(std::size_t i = 0; i < gr->tetrahedra.size(); i++) {
     MTetrahedron *t = gr->tetrahedra[i];
-    MTetrahedron *tNew =
-      setHighOrder(t, gr, edgeVertices, faceVertices, incomplete, nPts);
+    MTetrahedron *tNew = setHighOrder(t, gr, nodes, incomplete, nPts);
     tetrahedra2.push_back(tNew);
     delete t;
   }
@@ -1130,8 +1180,7 @@ static void setHighOrder(GRegion *gr, edgeContainer &edgeVertices,
   std::vector<MHexahedron *> hexahedra2;
   for(std::size_t i = 0; i < gr->hexahedra.size(); i++) {
     MHexahedron *h = gr->hexahedra[i];
-    MHexahedron *hNew =
-      setHighOrder(h, gr, edgeVertices, faceVertices, incomplete, nPts);
+    MHexahedron *hNew = setHighOrder(h, gr, nodes, incomplete, nPts);
     hexahedra2.push_back(hNew);
     delete h;
   }
@@ -1140,8 +1189,7 @@ static void setHighOrder(GRegion *gr, edgeContainer &edgeVertices,
   std::vector<MPrism *> prisms2;
   for(std::size_t i = 0; i < gr->prisms.size(); i++) {
     MPrism *p = gr->prisms[i];
-    MPrism *pNew =
-      setHighOrder(p, gr, edgeVertices, faceVertices, incomplete, nPts);
+    MPrism *pNew = setHighOrder(p, gr, nodes, incomplete, nPts);
     prisms2.push_back(pNew);
     delete p;
   }
@@ -1150,8 +1198,7 @@ static void setHighOrder(GRegion *gr, edgeContainer &edgeVertices,
   std::vector<MPyramid *> pyramids2;
   for(std::size_t i = 0; i < gr->pyramids.size(); i++) {
     MPyramid *p = gr->pyramids[i];
-    MPyramid *pNew =
-      setHighOrder(p, gr, edgeVertices, faceVertices, incomplete, nPts);
+    MPyramid *pNew = setHighOrder(p, gr, nodes, incomplete, nPts);
     pyramids2.push_back(pNew);
     delete p;
   }
@@ -1160,6 +1207,454 @@ static void setHighOrder(GRegion *gr, edgeContainer &edgeVertices,
   gr->deleteVertexArrays();
 }
 
+// Parallel creation of high-order elements: the unique edges (and faces) of
+// the mesh are first enumerated by sorting, the vertices of each unique edge
+// and face are then created in parallel, and the high-order elements are
+// finally rebuilt in parallel. The new vertices and elements are renumbered
+// in the order of the unique edges, faces and elements, so that the result
+// does not depend on the number of threads.
+
+// Sort key of the edge (N = 2) or face (N = 4) i of element k: the sorted
+// vertex numbers (completed by zeros), and k * 16 + i
+template <int N> struct hoKey {
+  std::size_t num[N];
+  std::size_t ref;
+  bool operator<(const hoKey<N> &other) const
+  {
+    for(int i = 0; i < N; i++) {
+      if(num[i] != other.num[i]) return num[i] < other.num[i];
+    }
+    return ref < other.ref;
+  }
+  bool sameVertices(const hoKey<N> &other) const
+  {
+    for(int i = 0; i < N; i++) {
+      if(num[i] != other.num[i]) return false;
+    }
+    return true;
+  }
+};
+
+template <class T> static void parallelSort(std::vector<T> &v)
+{
+#if defined(_OPENMP)
+  const int nt = Msg::GetMaxThreads();
+  if(nt > 1 && v.size() > 10000) {
+    std::vector<std::size_t> b(nt + 1);
+    for(int i = 0; i <= nt; i++) b[i] = v.size() * i / nt;
+#pragma omp parallel for schedule(static)
+    for(int i = 0; i < nt; i++)
+      std::sort(v.begin() + b[i], v.begin() + b[i + 1]);
+    for(int step = 1; step < nt; step *= 2) {
+#pragma omp parallel for schedule(static)
+      for(int i = 0; i < nt; i += 2 * step) {
+        if(i + step < nt)
+          std::inplace_merge(v.begin() + b[i], v.begin() + b[i + step],
+                             v.begin() + b[std::min(i + 2 * step, nt)]);
+      }
+    }
+    return;
+  }
+#endif
+  std::sort(v.begin(), v.end());
+}
+
+// Number the unique entries of the sorted keys: ids[offset[k] + i] is the
+// unique number of the edge or face i of element k, and first[u] the reference
+// (k * 16 + i) of the first element edge or face in the unique entry u
+template <int N>
+static void numberUniqueKeys(std::vector<hoKey<N> > &keys,
+                             const std::vector<std::size_t> &offset,
+                             std::vector<std::size_t> &ids,
+                             std::vector<std::size_t> &first)
+{
+  parallelSort(keys);
+  ids.resize(keys.size());
+  first.clear();
+  for(std::size_t j = 0; j < keys.size(); j++) {
+    if(j == 0 || !keys[j].sameVertices(keys[j - 1]))
+      first.push_back(keys[j].ref);
+    ids[offset[keys[j].ref / 16] + keys[j].ref % 16] = first.size() - 1;
+  }
+}
+
+static void getUniqueEdges(const std::vector<MElement *> &elements,
+                           std::vector<std::size_t> &offset,
+                           std::vector<std::size_t> &ids,
+                           std::vector<std::size_t> &first)
+{
+  const std::size_t n = elements.size();
+  offset.assign(n + 1, 0);
+  for(std::size_t k = 0; k < n; k++)
+    offset[k + 1] = offset[k] + elements[k]->getNumEdges();
+  std::vector<hoKey<2> > keys(offset[n]);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t k = 0; k < n; k++) {
+    for(int i = 0; i < elements[k]->getNumEdges(); i++) {
+      MEdge e = elements[k]->getEdge(i);
+      hoKey<2> &key = keys[offset[k] + i];
+      key.num[0] = e.getMinVertex()->getNum();
+      key.num[1] = e.getMaxVertex()->getNum();
+      key.ref = k * 16 + i;
+    }
+  }
+  numberUniqueKeys(keys, offset, ids, first);
+}
+
+// The basis function and vertex placement caches are filled on demand, which
+// is not thread-safe: fill them before creating vertices in parallel
+static void prepareHighOrderCaches(const std::vector<MElement *> &elements,
+                                   int nPts)
+{
+  std::set<int> orders;
+  orders.insert(nPts + 1);
+  for(std::size_t k = 0; k < elements.size(); k++)
+    orders.insert(elements[k]->getPolynomialOrder());
+  for(std::set<int>::iterator it = orders.begin(); it != orders.end(); ++it)
+    BasisFactory::getNodalBasis(ElementType::getType(TYPE_LIN, *it));
+  for(int type = TYPE_TRI; type <= TYPE_HEX; type++)
+    getInnerVertexPlacement(type, nPts + 1);
+}
+
+// Nodes of a 2D element in the parallel path: all the edge vertices already
+// exist in the container (which is thus only read), and the interior vertices
+// are stored in vFace, to be added to the face container afterwards
+class surfaceNodes {
+private:
+  edgeContainer &_edgeVertices;
+  std::vector<MVertex *> &_vFace;
+
+public:
+  surfaceNodes(edgeContainer &edgeVertices, std::vector<MVertex *> &vFace)
+    : _edgeVertices(edgeVertices), _vFace(vFace)
+  {
+  }
+  void getEdgeVertices(GFace *gf, MElement *ele, std::vector<MVertex *> &ve,
+                       bool linear, int nPts)
+  {
+    ::getEdgeVertices(gf, ele, ve, _edgeVertices, linear, nPts);
+  }
+  void getFaceVertices(GFace *gf, MElement *ele, std::vector<MVertex *> &ve,
+                       bool linear, int nPts)
+  {
+    createFaceVertices(gf, ele, ve, _vFace, linear, nPts);
+    ve.insert(ve.end(), _vFace.begin(), _vFace.end());
+  }
+};
+
+static void setHighOrderParallel(GFace *gf, edgeContainer &edgeVertices,
+                                 faceContainer &faceVertices, bool linear,
+                                 bool incomplete, int nPts)
+{
+  GModel *m = GModel::current();
+  std::vector<MElement *> elements(gf->triangles.begin(),
+                                   gf->triangles.end());
+  elements.insert(elements.end(), gf->quadrangles.begin(),
+                  gf->quadrangles.end());
+  const std::size_t n = elements.size();
+  prepareHighOrderCaches(elements, nPts);
+  std::size_t numVertex = m->getMaxVertexNumber();
+
+  // create the vertices of the edges that are not in the container yet
+  std::vector<std::size_t> offset, ids, first;
+  getUniqueEdges(elements, offset, ids, first);
+  const bool edgeLinear = linear || !gf->haveParametrization();
+  std::vector<std::vector<MVertex *> > veEdges(first.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for(std::size_t u = 0; u < first.size(); u++) {
+    MElement *ele = elements[first[u] / 16];
+    std::vector<MVertex *> veOld;
+    ele->getEdgeVertices(first[u] % 16, veOld);
+    MVertex *vMin, *vMax;
+    const bool increasing = getMinMaxVert(veOld[0], veOld[1], vMin, vMax);
+    std::pair<MVertex *, MVertex *> p(vMin, vMax);
+    if(edgeVertices.find(p) != edgeVertices.end()) continue;
+    std::vector<MVertex *> &veEdge = veEdges[u];
+    bool gotVertOnGeo =
+      edgeLinear ? false :
+                   getEdgeVerticesOnGeo(gf, veOld[0], veOld[1], veEdge, nPts);
+    if(!gotVertOnGeo) {
+      const MLineN edgeEl(veOld, ele->getPolynomialOrder());
+      interpVerticesInExistingEdge(gf, &edgeEl, veEdge, nPts);
+    }
+    if(!increasing) std::reverse(veEdge.begin(), veEdge.end());
+  }
+  for(std::size_t u = 0; u < first.size(); u++) {
+    if(veEdges[u].empty()) continue;
+    MEdge e = elements[first[u] / 16]->getEdge(first[u] % 16);
+    std::pair<MVertex *, MVertex *> p(e.getMinVertex(), e.getMaxVertex());
+    for(std::size_t j = 0; j < veEdges[u].size(); j++)
+      veEdges[u][j]->forceNum(++numVertex);
+    edgeVertices[p] = veEdges[u];
+  }
+
+  // build the high-order elements
+  const std::size_t numElement = m->getMaxElementNumber();
+  std::vector<MElement *> newElements(n);
+  std::vector<std::vector<MVertex *> > vFaces(n);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for(std::size_t k = 0; k < n; k++) {
+    surfaceNodes nodes(edgeVertices, vFaces[k]);
+    if(elements[k]->getType() == TYPE_TRI)
+      newElements[k] = setHighOrder((MTriangle *)elements[k], gf, nodes,
+                                    linear, incomplete, nPts);
+    else
+      newElements[k] = setHighOrder((MQuadrangle *)elements[k], gf, nodes,
+                                    linear, incomplete, nPts);
+  }
+  for(std::size_t k = 0; k < n; k++) {
+    if(vFaces[k].size()) {
+      for(std::size_t j = 0; j < vFaces[k].size(); j++)
+        vFaces[k][j]->forceNum(++numVertex);
+      faceVertices[elements[k]->getFace(0)] = vFaces[k];
+    }
+    newElements[k]->forceNum(numElement + 1 + k);
+    delete elements[k];
+  }
+  for(std::size_t i = 0; i < gf->triangles.size(); i++)
+    gf->triangles[i] = (MTriangle *)newElements[i];
+  for(std::size_t i = 0; i < gf->quadrangles.size(); i++)
+    gf->quadrangles[i] =
+      (MQuadrangle *)newElements[gf->triangles.size() + i];
+  gf->deleteVertexArrays();
+}
+
+// High-order vertices of the unique edges and faces of the 3D elements
+struct volumeTables {
+  // edges (faces) of element k are numbered from edgeOffset[k] (faceOffset[k])
+  std::vector<std::size_t> edgeOffset, faceOffset;
+  // unique edge (face) number of each edge (face) of each element
+  std::vector<std::size_t> edgeIds, faceIds;
+  // nPts vertices per unique edge, from its lowest to its highest vertex
+  // number
+  std::vector<MVertex *> edgeVertices;
+  // reference orientation and vertices of each unique face
+  std::vector<MFace> faces;
+  std::vector<std::vector<MVertex *> > faceVertices;
+};
+
+// Nodes of the 3D element k in the parallel path
+class volumeNodes {
+private:
+  const volumeTables &_t;
+  std::size_t _k;
+
+public:
+  volumeNodes(const volumeTables &t, std::size_t k) : _t(t), _k(k) {}
+  void getEdgeVertices(GRegion *gr, MElement *ele, std::vector<MVertex *> &ve,
+                       int nPts)
+  {
+    for(int i = 0; i < ele->getNumEdges(); i++) {
+      MEdge e = ele->getEdge(i);
+      std::vector<MVertex *>::const_iterator it =
+        _t.edgeVertices.begin() + _t.edgeIds[_t.edgeOffset[_k] + i] * nPts;
+      if(e.getVertex(0) == e.getMinVertex())
+        ve.insert(ve.end(), it, it + nPts);
+      else
+        for(int j = nPts - 1; j >= 0; j--) ve.push_back(it[j]);
+    }
+  }
+  void getFaceVertices(GRegion *gr, MElement *ele, std::vector<MVertex *> &ve,
+                       int nPts)
+  {
+    for(int i = 0; i < ele->getNumFaces(); i++) {
+      std::size_t f = _t.faceIds[_t.faceOffset[_k] + i];
+      std::vector<MVertex *> vtcs = _t.faceVertices[f];
+      reorientFaceVertices(_t.faces[f], ele->getFace(i), vtcs, nPts);
+      ve.insert(ve.end(), vtcs.begin(), vtcs.end());
+    }
+  }
+};
+
+// Same conditions as in the setHighOrder() functions for 3D elements
+static bool needFaceVertices(MElement *ele, bool incomplete, int nPts)
+{
+  if(incomplete) return false;
+  return ele->getType() != TYPE_TET || nPts > 1;
+}
+
+static void setHighOrderParallel(std::vector<GRegion *> &regions,
+                                 edgeContainer &edgeVertices,
+                                 faceContainer &faceVertices, bool incomplete,
+                                 int nPts)
+{
+  GModel *m = GModel::current();
+  std::vector<MElement *> elements;
+  std::vector<GRegion *> entities;
+  for(std::size_t r = 0; r < regions.size(); r++) {
+    GRegion *gr = regions[r];
+    elements.insert(elements.end(), gr->tetrahedra.begin(),
+                    gr->tetrahedra.end());
+    elements.insert(elements.end(), gr->hexahedra.begin(), gr->hexahedra.end());
+    elements.insert(elements.end(), gr->prisms.begin(), gr->prisms.end());
+    elements.insert(elements.end(), gr->pyramids.begin(), gr->pyramids.end());
+    entities.resize(elements.size(), gr);
+  }
+  const std::size_t n = elements.size();
+  prepareHighOrderCaches(elements, nPts);
+  std::size_t numVertex = m->getMaxVertexNumber();
+  volumeTables t;
+
+  // vertices of the unique edges: reuse the ones created on the surfaces,
+  // and interpolate the others
+  std::vector<std::size_t> first;
+  getUniqueEdges(elements, t.edgeOffset, t.edgeIds, first);
+  const std::size_t numEdges = first.size();
+  t.edgeVertices.resize(numEdges * nPts);
+  std::vector<char> newEdge(numEdges, 0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(std::size_t u = 0; u < numEdges; u++) {
+    const std::size_t k = first[u] / 16;
+    std::vector<MVertex *> veOld, veEdge;
+    elements[k]->getEdgeVertices(first[u] % 16, veOld);
+    MVertex *vMin, *vMax;
+    const bool increasing = getMinMaxVert(veOld[0], veOld[1], vMin, vMax);
+    edgeContainer::const_iterator it =
+      edgeVertices.find(std::make_pair(vMin, vMax));
+    if(it != edgeVertices.end()) { veEdge = it->second; }
+    else {
+      const MLineN edgeEl(veOld, elements[k]->getPolynomialOrder());
+      interpVerticesInExistingEdge(entities[k], &edgeEl, veEdge, nPts);
+      if(!increasing) std::reverse(veEdge.begin(), veEdge.end());
+      newEdge[u] = 1;
+    }
+    std::copy(veEdge.begin(), veEdge.end(), t.edgeVertices.begin() + u * nPts);
+  }
+
+  // vertices of the unique faces
+  t.faceOffset.assign(n + 1, 0);
+  for(std::size_t k = 0; k < n; k++)
+    t.faceOffset[k + 1] =
+      t.faceOffset[k] + (needFaceVertices(elements[k], incomplete, nPts) ?
+                           elements[k]->getNumFaces() :
+                           0);
+  first.clear();
+  if(t.faceOffset[n]) {
+    std::vector<hoKey<4> > keys(t.faceOffset[n]);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for(std::size_t k = 0; k < n; k++) {
+      for(std::size_t i = 0; i < t.faceOffset[k + 1] - t.faceOffset[k]; i++) {
+        MFace f = elements[k]->getFace(i);
+        hoKey<4> &key = keys[t.faceOffset[k] + i];
+        for(int j = 0; j < 4; j++)
+          key.num[j] =
+            j < (int)f.getNumVertices() ? f.getVertex(j)->getNum() : 0;
+        std::sort(key.num, key.num + 4);
+        key.ref = k * 16 + i;
+      }
+    }
+    numberUniqueKeys(keys, t.faceOffset, t.faceIds, first);
+  }
+  const std::size_t numFaces = first.size();
+  t.faces.resize(numFaces);
+  t.faceVertices.resize(numFaces);
+  std::vector<char> newFace(numFaces, 0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(std::size_t f = 0; f < numFaces; f++) {
+    const std::size_t k = first[f] / 16;
+    const int i = first[f] % 16;
+    MElement *ele = elements[k];
+    MFace face = ele->getFace(i);
+    faceContainer::const_iterator it = faceVertices.find(face);
+    if(it != faceVertices.end()) {
+      t.faces[f] = it->first;
+      t.faceVertices[f] = it->second;
+    }
+    else {
+      std::vector<MVertex *> vCorner, vEdges, faceBoundaryVertices;
+      ele->getVertices(vCorner);
+      volumeNodes(t, k).getEdgeVertices(entities[k], ele, vEdges, nPts);
+      int type = retrieveFaceBoundaryVertices(
+        i, ele->getType(), nPts, vCorner, vEdges, faceBoundaryVertices);
+      interpVerticesInExistingFace(entities[k],
+                                   *getInnerVertexPlacement(type, nPts + 1),
+                                   faceBoundaryVertices, t.faceVertices[f]);
+      t.faces[f] = face;
+      newFace[f] = 1;
+    }
+  }
+
+  // build the high-order elements (which creates the interior vertices)
+  const std::size_t numVertexFaces = m->getMaxVertexNumber();
+  const std::size_t numElement = m->getMaxElementNumber();
+  std::vector<MElement *> newElements(n);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(std::size_t k = 0; k < n; k++) {
+    volumeNodes nodes(t, k);
+    MElement *e = elements[k];
+    switch(e->getType()) {
+    case TYPE_TET:
+      newElements[k] =
+        setHighOrder((MTetrahedron *)e, entities[k], nodes, incomplete, nPts);
+      break;
+    case TYPE_HEX:
+      newElements[k] =
+        setHighOrder((MHexahedron *)e, entities[k], nodes, incomplete, nPts);
+      break;
+    case TYPE_PRI:
+      newElements[k] =
+        setHighOrder((MPrism *)e, entities[k], nodes, incomplete, nPts);
+      break;
+    case TYPE_PYR:
+      newElements[k] =
+        setHighOrder((MPyramid *)e, entities[k], nodes, incomplete, nPts);
+      break;
+    }
+    delete e;
+  }
+
+  // deterministic numbering
+  std::vector<MVertex *> interior;
+  for(std::size_t k = 0; k < n; k++) {
+    for(std::size_t j = 0; j < newElements[k]->getNumVertices(); j++) {
+      MVertex *v = newElements[k]->getVertex(j);
+      if(v->getNum() > numVertexFaces) interior.push_back(v);
+    }
+  }
+  for(std::size_t u = 0; u < numEdges; u++) {
+    if(!newEdge[u]) continue;
+    for(int j = 0; j < nPts; j++)
+      t.edgeVertices[u * nPts + j]->forceNum(++numVertex);
+  }
+  for(std::size_t f = 0; f < numFaces; f++) {
+    if(!newFace[f]) continue;
+    for(std::size_t j = 0; j < t.faceVertices[f].size(); j++)
+      t.faceVertices[f][j]->forceNum(++numVertex);
+  }
+  for(std::size_t j = 0; j < interior.size(); j++)
+    interior[j]->forceNum(++numVertex);
+  for(std::size_t k = 0; k < n; k++)
+    newElements[k]->forceNum(numElement + 1 + k);
+
+  std::size_t k = 0;
+  for(std::size_t r = 0; r < regions.size(); r++) {
+    GRegion *gr = regions[r];
+    for(std::size_t i = 0; i < gr->tetrahedra.size(); i++)
+      gr->tetrahedra[i] = (MTetrahedron *)newElements[k++];
+    for(std::size_t i = 0; i < gr->hexahedra.size(); i++)
+      gr->hexahedra[i] = (MHexahedron *)newElements[k++];
+    for(std::size_t i = 0; i < gr->prisms.size(); i++)
+      gr->prisms[i] = (MPrism *)newElements[k++];
+    for(std::size_t i = 0; i < gr->pyramids.size(); i++)
+      gr->pyramids[i] = (MPyramid *)newElements[k++];
+    gr->deleteVertexArrays();
+  }
+}
+
 // High-level functions
 
 template <class T>
@@ -1385,6 +1880,8 @@ void SetOrderN(GModel *m, int order, bool linear, bool incomplete,
 
   int nPts = order - 1;
 
+  MsgProfileSection prof("Mesh order %d", order);
+
   char msg[256];
   sprintf(msg, "Meshing order %d (curvilinear %s)...", order,
           linear ? "off" : "on");
@@ -1416,25 +1913,40 @@ void SetOrderN(GModel *m, int order, bool linear, bool incomplete,
       setHighOrderFromExistingMesh(*it, edgeVertices);
   }
 
+  // with several threads, create the high-order vertices of each surface, and
+  // then of all the volumes at once, in parallel
+  const bool parallel = Msg::GetMaxThreads() > 1;
+
   for(GModel::fiter it = m->firstFace(); it != m->lastFace(); ++it) {
     Msg::Info("Meshing surface %d order %d", (*it)->tag(), order);
     Msg::ProgressMeter(++counter, false, msg);
     if(onlyVisible && !(*it)->getVisibility()) continue;
-    if(getOrder(*it) != order)
+    // the closest point search on discrete surfaces is not thread-safe
+    if(getOrder(*it) != order && parallel &&
+       (linear || (*it)->geomType() != GEntity::DiscreteSurface))
+      setHighOrderParallel(*it, edgeVertices, faceVertices, linear,
+                           incomplete, nPts);
+    else if(getOrder(*it) != order)
       setHighOrder(*it, edgeVertices, faceVertices, linear, incomplete, nPts);
     else
       setHighOrderFromExistingMesh(*it, edgeVertices, faceVertices);
     if((*it)->getColumns() != 0) (*it)->getColumns()->clearElementData();
   }
 
+  std::vector<GRegion *> regions;
   for(GModel::riter it = m->firstRegion(); it != m->lastRegion(); ++it) {
     Msg::Info("Meshing volume %d order %d", (*it)->tag(), order);
     Msg::ProgressMeter(++counter, false, msg);
     if(onlyVisible && !(*it)->getVisibility()) continue;
-    if(getOrder(*it) != order)
+    if(getOrder(*it) != order && parallel)
+      regions.push_back(*it);
+    else if(getOrder(*it) != order)
       setHighOrder(*it, edgeVertices, faceVertices, incomplete, nPts);
     if((*it)->getColumns() != 0) (*it)->getColumns()->clearElementData();
   }
+  if(regions.size())
+    setHighOrderParallel(regions, edgeVertices, faceVertices, incomplete,
+                         nPts);
 
   // store nodes in entities
   m->pruneMeshVertexAssociations();
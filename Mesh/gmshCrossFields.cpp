@@ -38,6 +38,22 @@
 #include "linearSystemCSR.h"
 #include "linearSystemFull.h"
 #include "linearSystemPETSc.h"
+#include "linearSystemMUMPS.h"
+
+// linear system used for the potentials and for H: the multithreaded direct
+// solver MUMPS is preferred to the iterative Gmm++ solvers when available
+static linearSystem<double> *newCrossFieldSystem()
+{
+#if defined(HAVE_PETSC)
+  return new linearSystemPETSc<double>;
+#elif defined(HAVE_MUMPS)
+  return new linearSystemMUMPS<double>;
+#elif defined(HAVE_GMM)
+  return new linearSystemGmm<double>;
+#else
+  return new linearSystemFull<double>;
+#endif
+}
 
 static inline double lifting(double a, double _a)
 {
@@ -1001,15 +1017,7 @@ static void computePotential(
     }
   }
 
-#if defined(HAVE_PETSC)
-  linearSystemPETSc<double> *_lsys = new linearSystemPETSc<double>;
-#elif defined(HAVE_GMM)
-  // linearSystemFull<double> *_lsys = new linearSystemFull<double>;
-  linearSystemGmm<double> *_lsys = new linearSystemGmm<double>;
-  ///  _lsys->setPrec(2.e-7);
-#else
-  linearSystemFull<double> *_lsys = new linearSystemFull<double>;
-#endif
+  linearSystem<double> *_lsys = newCrossFieldSystem();
 
   dofManager<double> myAssembler(_lsys);
 
@@ -1674,6 +1682,91 @@ groupBoundaries(GModel *gm, std::map<MEdge, cross2d, MEdgeLessThan> &C,
   fclose(f);
 }
 
+// greedy coloring of the graph of crosses, given by the (CSR) lists of
+// neighbors read when smoothing each cross: crosses of the same color are
+// never neighbors, and can thus be smoothed concurrently (colored
+// Gauss-Seidel)
+static void colorCrosses(const std::vector<size_t> &order,
+                         const std::vector<size_t> &start,
+                         const std::vector<size_t> &neigh,
+                         std::vector<std::vector<size_t> > &colors)
+{
+  const size_t N = start.size() - 1;
+
+  // symmetrize the graph
+  std::vector<size_t> sstart(N + 1, 0);
+  for(size_t i = 0; i < N; i++) {
+    for(size_t j = start[i]; j < start[i + 1]; j++) {
+      if(neigh[j] == i) continue;
+      sstart[i + 1]++;
+      sstart[neigh[j] + 1]++;
+    }
+  }
+  for(size_t i = 0; i < N; i++) sstart[i + 1] += sstart[i];
+  std::vector<size_t> sneigh(sstart[N]);
+  std::vector<size_t> pos(sstart.begin(), sstart.end() - 1);
+  for(size_t i = 0; i < N; i++) {
+    for(size_t j = start[i]; j < start[i + 1]; j++) {
+      if(neigh[j] == i) continue;
+      sneigh[pos[i]++] = neigh[j];
+      sneigh[pos[neigh[j]]++] = i;
+    }
+  }
+
+  // used[c] == i + 1 if color c is taken by a neighbor of cross i
+  std::vector<int> color(N, -1);
+  std::vector<size_t> used;
+  colors.clear();
+  for(size_t k = 0; k < order.size(); k++) {
+    const size_t i = order[k];
+    for(size_t j = sstart[i]; j < sstart[i + 1]; j++) {
+      const int c = color[sneigh[j]];
+      if(c >= 0) used[c] = i + 1;
+    }
+    size_t c = 0;
+    while(c < used.size() && used[c] == i + 1) c++;
+    if(c == used.size()) {
+      used.push_back(0);
+      colors.push_back(std::vector<size_t>());
+    }
+    color[i] = c;
+    colors[c].push_back(i);
+  }
+}
+
+static double smoothCrossExtrinsic(size_t i, double *data, const size_t *graph)
+{
+  double x[3], y[3];
+  double *r = &data[6 * i + 0];
+  double *n = &data[6 * i + 3];
+  SVector3 ro(r[0], r[1], r[2]);
+  const size_t *neigh = &graph[4 * i];
+  double weight = 0;
+  if(neigh[2] == neigh[3]) return 0.;
+  for(int j = 0; j < 4; j++) {
+    size_t k = neigh[j];
+    const double *r2 = &data[6 * k + 0];
+    const double *n2 = &data[6 * k + 3];
+    compat_orientation_extrinsic(r, n, r2, n2, x, y);
+    r[0] = x[0] * weight + y[0];
+    r[1] = x[1] * weight + y[1];
+    r[2] = x[2] * weight + y[2];
+    const double dd = r[0] * n[0] + r[1] * n[1] + r[2] * n[2];
+    r[0] -= n[0] * dd;
+    r[1] -= n[1] * dd;
+    r[2] -= n[2] * dd;
+    double NRM = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    if(NRM != 0.0) {
+      r[0] /= NRM;
+      r[1] /= NRM;
+      r[2] /= NRM;
+    }
+    weight += 1;
+  }
+  double dp = r[0] * ro[0] + r[1] * ro[1] + r[2] * ro[2];
+  return std::min(1. - fabs(dp), fabs(dp));
+}
+
 static void
 fastImplementationExtrinsic(std::map<MEdge, cross2d, MEdgeLessThan> &C,
                             double tol = 1.e-10)
@@ -1710,44 +1803,23 @@ fastImplementationExtrinsic(std::map<MEdge, cross2d, MEdgeLessThan> &C,
   }
 
   size_t N = C.size();
+  std::vector<size_t> order(N), start(N + 1), neigh(graph, graph + 4 * N);
+  for(size_t i = 0; i <= N; i++) start[i] = 4 * i;
+  for(size_t i = 0; i < N; i++) order[i] = i;
+  std::vector<std::vector<size_t> > colors;
+  colorCrosses(order, start, neigh, colors);
+
   int MAXITER = 10000;
   int ITER = -1;
   while(ITER++ < MAXITER) {
-    double x[3], y[3];
     double RES = 0;
-    for(size_t i = 0; i < N; i++) {
-      double *r = &data[6 * i + 0];
-      double *n = &data[6 * i + 3];
-      SVector3 ro(r[0], r[1], r[2]);
-      size_t *neigh = &graph[4 * i];
-      double weight = 0;
-      if(neigh[2] != neigh[3]) {
-        for(int j = 0; j < 4; j++) {
-          size_t k = neigh[j];
-          const double *r2 = &data[6 * k + 0];
-          const double *n2 = &data[6 * k + 3];
-          compat_orientation_extrinsic(r, n, r2, n2, x, y);
-          r[0] = x[0] * weight + y[0];
-          r[1] = x[1] * weight + y[1];
-          r[2] = x[2] * weight + y[2];
-          const double dd = r[0] * n[0] + r[1] * n[1] + r[2] * n[2];
-          r[0] -= n[0] * dd;
-          r[1] -= n[1] * dd;
-          r[2] -= n[2] * dd;
-          double NRM = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
-          if(NRM != 0.0) {
-            r[0] /= NRM;
-            r[1] /= NRM;
-            r[2] /= NRM;
-          }
-          weight += 1;
-        }
-        double dp = r[0] * ro[0] + r[1] * ro[1] + r[2] * ro[2];
-        RES += std::min(1. - fabs(dp), fabs(dp));
-      }
-      //      data[6*i+0]=r[0];
-      //      data[6*i+1]=r[1];
-      //      data[6*i+2]=r[2];
+    for(size_t c = 0; c < colors.size(); c++) {
+      const std::vector<size_t> &col = colors[c];
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : RES)
+#endif
+      for(size_t k = 0; k < col.size(); k++)
+        RES += smoothCrossExtrinsic(col[k], data, graph);
     }
     if(ITER % 1000 == 0)
       Msg::Info("NL smooth : iter %6d RES = %12.5E", ITER, RES);
@@ -1769,14 +1841,7 @@ static dofManager<double> *computeH(GModel *gm, std::vector<GFace *> &f,
                                     std::set<MVertex *, MVertexPtrLessThan> &vs,
                                     std::map<MEdge, cross2d, MEdgeLessThan> &C)
 {
-#if defined(HAVE_PETSC)
-  linearSystemPETSc<double> *_lsys = new linearSystemPETSc<double>;
-#elif defined(HAVE_GMM)
-  // MUMPS !!!
-  linearSystemGmm<double> *_lsys = new linearSystemGmm<double>;
-#else
-  linearSystemFull<double> *_lsys = new linearSystemFull<double>;
-#endif
+  linearSystem<double> *_lsys = newCrossFieldSystem();
 
   dofManager<double> *myAssembler = new dofManager<double>(_lsys);
 
@@ -2705,19 +2770,49 @@ public:
   {
     std::map<MEdge, cross2d, MEdgeLessThan>::iterator it;
     std::vector<cross2d *> pc;
-    for(it = C.begin(); it != C.end(); ++it) pc.push_back(&(it->second));
+    for(it = C.begin(); it != C.end(); ++it) {
+      it->second.counter = pc.size();
+      pc.push_back(&(it->second));
+    }
+
+    // sweeps are done color by color, the crosses of a color being
+    // independent; the sweep order is shuffled every 200 iterations
+    std::vector<size_t> order(pc.size()), start(pc.size() + 1, 0), neigh;
+    for(size_t i = 0; i < pc.size(); i++) {
+      order[i] = i;
+      for(size_t j = 0; j < pc[i]->_cneighbors.size(); j++)
+        neigh.push_back(pc[i]->_cneighbors[j]->counter);
+      start[i + 1] = neigh.size();
+    }
+    std::vector<std::vector<size_t> > colors;
+    colorCrosses(order, start, neigh, colors);
 
     size_t ITER = 0;
     while(ITER++ < nIterLaplace) {
-      if(ITER % 200 == 0) std::random_shuffle(pc.begin(), pc.end());
-      for(size_t i = 0; i < pc.size(); i++) pc[i]->average_init();
+      if(ITER % 200 == 0) {
+        std::random_shuffle(order.begin(), order.end());
+        colorCrosses(order, start, neigh, colors);
+      }
+      for(size_t c = 0; c < colors.size(); c++) {
+        const std::vector<size_t> &col = colors[c];
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+        for(size_t k = 0; k < col.size(); k++) pc[col[k]]->average_init();
+      }
       if(ITER % 1000 == 0) Msg::Info("Linear smooth : iter %6lu", ITER);
     }
 
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
     for(size_t i = 0; i < pc.size(); i++) pc[i]->computeVector();
 
     fastImplementationExtrinsic(C, tol);
 
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
     for(size_t i = 0; i < pc.size(); i++) pc[i]->computeAngle();
 
     return 0;
@@ -2762,13 +2857,7 @@ public:
   dofManager<double> *computeHFromSingularities(std::map<MVertex *, int> &sing,
                                                 int nbTurns)
   {
-#if defined(HAVE_PETSC)
-    linearSystemPETSc<double> *_lsys = new linearSystemPETSc<double>;
-#elif defined(HAVE_GMM)
-    linearSystemGmm<double> *_lsys = new linearSystemGmm<double>;
-#else
-    linearSystemFull<double> *_lsys = new linearSystemFull<double>;
-#endif
+    linearSystem<double> *_lsys = newCrossFieldSystem();
 
     dofManager<double> *dof = new dofManager<double>(_lsys);
 
@@ -2909,13 +2998,7 @@ public:
   void computeThetaUsingHCrouzeixRaviart(
     std::map<int, std::vector<double> > &dataTHETA)
   {
-#if defined(HAVE_PETSC)
-    linearSystemPETSc<double> *_lsys = new linearSystemPETSc<double>;
-#elif defined(HAVE_GMM)
-    linearSystemGmm<double> *_lsys = new linearSystemGmm<double>;
-#else
-    linearSystemFull<double> *_lsys = new linearSystemFull<double>;
-#endif
+    linearSystem<double> *_lsys = newCrossFieldSystem();
     dofManager<double> *theta = new dofManager<double>(_lsys);
 
     std::map<MEdge, size_t, MEdgeLessThan> aaa;
@@ -86,9 +86,9 @@ struct F_LcB {
 };
 
 struct F_Lc {
-  double operator()(GEdge *ge, double t)
+  double operator()(GEdge *ge, double t, const SPoint3 &p,
+                    const SVector3 &der)
   {
-    GPoint p = ge->point(t);
     Range<double> bounds = ge->parBounds(0);
     double t_begin = bounds.low();
     double t_end = bounds.high();
@@ -99,15 +99,14 @@ struct F_Lc {
       lc_here = BGM_MeshSize(ge->getEndVertex(), t, 0, p.x(), p.y(), p.z());
     else
       lc_here = BGM_MeshSize(ge, t, 0, p.x(), p.y(), p.z());
-    SVector3 der = ge->firstDer(t);
     return norm(der) / lc_here;
   }
 };
 
 struct F_Lc_aniso {
-  double operator()(GEdge *ge, double t)
+  double operator()(GEdge *ge, double t, const SPoint3 &p,
+                    const SVector3 &der)
   {
-    GPoint p = ge->point(t);
     SMetric3 lc_here;
 
     Range<double> bounds = ge->parBounds(0);
@@ -132,13 +131,13 @@ struct F_Lc_aniso {
       lc_here = intersection_conserveM1(lc_here, lc_bgm);
     }
 
-    SVector3 der = ge->firstDer(t);
     return std::sqrt(dot(der, lc_here, der));
   }
 };
 
 struct F_Transfinite {
-  double operator()(GEdge *ge, double t_)
+  double operator()(GEdge *ge, double t_, const SPoint3 &p,
+                    const SVector3 &der)
   {
     double length = ge->length();
     if(length == 0.0) {
@@ -146,7 +145,6 @@ struct F_Transfinite {
       return 1.;
     }
 
-    SVector3 der = ge->firstDer(t_);
     double d = norm(der);
     double coef = ge->meshAttributes.coeffTransfinite;
     int type = ge->meshAttributes.typeTransfinite;
@@ -206,69 +204,140 @@ struct F_Transfinite {
 };
 
 struct F_One {
-  double operator()(GEdge *ge, double t)
+  double operator()(GEdge *ge, double t, const SPoint3 &p,
+                    const SVector3 &der)
   {
-    SVector3 der = ge->firstDer(t);
     return norm(der);
   }
 };
 
-static double trapezoidal(IntPoint *const P1, IntPoint *const P2)
+// get the points and first derivatives of the curve at the parametric
+// coordinates t, reusing (and completing) the samples cached in the curve
+static void sampleCurve(GEdge *ge, const std::vector<double> &t,
+                        std::vector<GEdge::parametrizationSample> &samples)
 {
-  return 0.5 * (P1->lc + P2->lc) * (P2->t - P1->t);
-}
-
-template <typename function>
-static void RecursiveIntegration(GEdge *ge, IntPoint *from, IntPoint *to,
-                                 function f, std::vector<IntPoint> &Points,
-                                 double Prec, int *depth)
-{
-  IntPoint P, p1;
-
-  (*depth)++;
+  std::vector<GEdge::parametrizationSample> &cache = ge->parametrizationCache;
+  samples.resize(t.size());
+  std::vector<std::size_t> missing;
+  for(std::size_t i = 0; i < t.size(); i++) {
+    samples[i].t = t[i];
+    std::vector<GEdge::parametrizationSample>::iterator it =
+      std::lower_bound(cache.begin(), cache.end(), samples[i]);
+    if(it != cache.end() && it->t == t[i])
+      samples[i] = *it;
+    else
+      missing.push_back(i);
+  }
+  if(missing.empty()) return;
 
-  P.t = 0.5 * (from->t + to->t);
-  P.lc = f(ge, P.t);
+  const std::size_t n = missing.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(n > 64)
+#endif
+  for(std::size_t k = 0; k < n; k++) {
+    GEdge::parametrizationSample &s = samples[missing[k]];
+    GPoint p = ge->point(s.t);
+    s.p = SPoint3(p.x(), p.y(), p.z());
+    s.der = ge->firstDer(s.t);
+  }
 
-  double const val1 = trapezoidal(from, to);
-  double const val2 = trapezoidal(from, &P);
-  double const val3 = trapezoidal(&P, to);
-  double const err = std::abs(val1 - val2 - val3);
+  std::size_t old = cache.size();
+  for(std::size_t k = 0; k < n; k++) cache.push_back(samples[missing[k]]);
+  std::sort(cache.begin() + old, cache.end());
+  std::inplace_merge(cache.begin(), cache.begin() + old, cache.end());
+}
 
-  if(((err < Prec) && (*depth > 6)) || (*depth > 25)) {
-    p1 = Points.back();
-    P.p = p1.p + val2;
-    Points.push_back(P);
+static double trapezoidal(IntPoint *const P1, IntPoint *const P2)
+{
+  return 0.5 * (P1->lc + P2->lc) * (P2->t - P1->t);
+}
 
-    p1 = Points.back();
-    to->p = p1.p + val3;
-    Points.push_back(*to);
-  }
-  else {
-    RecursiveIntegration(ge, from, &P, f, Points, Prec, depth);
-    RecursiveIntegration(ge, &P, to, f, Points, Prec, depth);
-  }
+typedef struct {
+  IntPoint from, mid, to;
+} IntInterval;
 
-  (*depth)--;
+static bool intervalLessThan(const IntInterval &i1, const IntInterval &i2)
+{
+  return i1.from.t < i2.from.t;
 }
 
+// adaptive trapezoidal integration of f between t1 and t2: the intervals are
+// refined level by level, the curve being sampled and f being evaluated at all
+// the midpoints of a level at once
 template <typename function>
 static double Integration(GEdge *ge, double t1, double t2, function f,
                           std::vector<IntPoint> &Points, double Prec)
 {
-  IntPoint from, to;
+#if defined(_OPENMP)
+  // boundary layer fields are not yet thread-safe
+  bool parallel = !ge->model()->getFields()->getNumBoundaryLayerFields();
+#endif
 
-  int depth = 0;
+  std::vector<double> t(2);
+  std::vector<GEdge::parametrizationSample> samples;
+  t[0] = t1;
+  t[1] = t2;
+  sampleCurve(ge, t, samples);
 
+  IntPoint from, to;
   from.t = t1;
-  from.lc = f(ge, from.t);
+  from.lc = f(ge, t1, samples[0].p, samples[0].der);
   from.p = 0.0;
-  Points.push_back(from);
-
   to.t = t2;
-  to.lc = f(ge, to.t);
+  to.lc = f(ge, t2, samples[1].p, samples[1].der);
+
+  // intervals of the current level
+  std::vector<IntPoint> a(1, from), b(1, to);
+  // intervals that are fine enough
+  std::vector<IntInterval> done;
+  std::vector<double> lc;
+  for(int depth = 1; !a.empty(); depth++) {
+    const std::size_t n = a.size();
+    t.resize(n);
+    for(std::size_t i = 0; i < n; i++) t[i] = 0.5 * (a[i].t + b[i].t);
+    sampleCurve(ge, t, samples);
+    lc.resize(n);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(parallel && n > 64)
+#endif
+    for(std::size_t i = 0; i < n; i++)
+      lc[i] = f(ge, t[i], samples[i].p, samples[i].der);
+
+    std::vector<IntPoint> na, nb;
+    for(std::size_t i = 0; i < n; i++) {
+      IntPoint P;
+      P.t = t[i];
+      P.lc = lc[i];
+      double const val1 = trapezoidal(&a[i], &b[i]);
+      double const val2 = trapezoidal(&a[i], &P);
+      double const val3 = trapezoidal(&P, &b[i]);
+      double const err = std::abs(val1 - val2 - val3);
+      if(((err < Prec) && (depth > 6)) || (depth > 25)) {
+        IntInterval interval = {a[i], P, b[i]};
+        done.push_back(interval);
+      }
+      else {
+        na.push_back(a[i]);
+        nb.push_back(P);
+        na.push_back(P);
+        nb.push_back(b[i]);
+      }
+    }
+    a.swap(na);
+    b.swap(nb);
+  }
 
-  RecursiveIntegration(ge, &from, &to, f, Points, Prec, &depth);
+  // accumulate the primitive along the curve
+  std::sort(done.begin(), done.end(), intervalLessThan);
+  if(t1 > t2) std::reverse(done.begin(), done.end());
+  Points.push_back(from);
+  for(std::size_t i = 0; i < done.size(); i++) {
+    IntInterval &I = done[i];
+    I.mid.p = Points.back().p + trapezoidal(&I.from, &I.mid);
+    Points.push_back(I.mid);
+    I.to.p = I.mid.p + trapezoidal(&I.mid, &I.to);
+    Points.push_back(I.to);
+  }
 
   return Points.back().p;
 }
@@ -648,11 +717,12 @@ void meshGEdge::operator()(GEdge *ge)
     }
 
     // we should maybe provide an option to disable the smoothing
-    for(std::size_t i = 0; i < Points.size(); i++) {
-      IntPoint &pt = Points[i];
-      SVector3 der = ge->firstDer(pt.t);
-      pt.xp = der.norm();
-    }
+    std::vector<double> t(Points.size());
+    for(std::size_t i = 0; i < Points.size(); i++) t[i] = Points[i].t;
+    std::vector<GEdge::parametrizationSample> samples;
+    sampleCurve(ge, t, samples);
+    for(std::size_t i = 0; i < Points.size(); i++)
+      Points[i].xp = samples[i].der.norm();
     if(CTX::instance()->mesh.algo2d != ALGO_2D_BAMG)
       a = smoothPrimitive(ge, std::sqrt(CTX::instance()->mesh.smoothRatio),
 			  Points);
@@ -58,10 +58,8 @@ static double computeEdgeLinearLength(BDS_Point *p1, BDS_Point *p2)
 }
 
 static inline double computeEdgeLinearLength(BDS_Point *p1, BDS_Point *p2,
-                                             GFace *f)
+                                             const GPoint &GP)
 {
-  GPoint GP = f->point(SPoint2(0.5 * (p1->u + p2->u), 0.5 * (p1->v + p2->v)));
-
   if(!GP.succeeded()) return computeEdgeLinearLength(p1, p2);
 
   const double dx1 = p1->X - GP.x();
@@ -77,12 +75,13 @@ static inline double computeEdgeLinearLength(BDS_Point *p1, BDS_Point *p2,
   return l1 + l2;
 }
 
-static double computeEdgeLinearLength(BDS_Edge *e, GFace *f)
+static double computeEdgeLinearLength(BDS_Edge *e, GFace *f,
+                                      const GPoint &mid)
 {
   // FIXME !!!
   return f->geomType() == GEntity::Plane ?
            e->length() :
-           computeEdgeLinearLength(e->p1, e->p2, f);
+           computeEdgeLinearLength(e->p1, e->p2, mid);
 }
 
 static double NewGetLc(BDS_Point *point, GFace *gf)
@@ -91,18 +90,14 @@ static double NewGetLc(BDS_Point *point, GFace *gf)
     point->lcBGM();
 }
 
-static double correctLC_(BDS_Point *p1, BDS_Point *p2, GFace *f)
+static double correctLC_(BDS_Point *p1, BDS_Point *p2, GFace *f,
+                         const GPoint &mid, double U, double V)
 {
   double l1 = NewGetLc(p1, f);
   double l2 = NewGetLc(p2, f);
   double l = .5 * (l1 + l2);
 
-  const double coord = 0.5;
-  double U = coord * p1->u + (1 - coord) * p2->u;
-  double V = coord * p1->v + (1 - coord) * p2->v;
-
-  GPoint gpp = f->point(U, V);
-  double lmid = BGM_MeshSize(f, U, V, gpp.x(), gpp.y(), gpp.z());
+  double lmid = BGM_MeshSize(f, U, V, mid.x(), mid.y(), mid.z());
   l = std::min(l, lmid);
 
   if(CTX::instance()->mesh.lcFromCurvature) {
@@ -118,8 +113,42 @@ static double correctLC_(BDS_Point *p1, BDS_Point *p2, GFace *f)
 
 static double NewGetLc(BDS_Edge *const edge, GFace *const face)
 {
-  return computeEdgeLinearLength(edge, face) /
-         correctLC_(edge->p1, edge->p2, face);
+  // the midpoint of the edge is only evaluated once, both for the length and
+  // for the mesh size
+  const double U = 0.5 * (edge->p1->u + edge->p2->u);
+  const double V = 0.5 * (edge->p1->v + edge->p2->v);
+  GPoint mid = face->point(U, V);
+  return computeEdgeLinearLength(edge, face, mid) /
+         correctLC_(edge->p1, edge->p2, face, mid, U, V);
+}
+
+// same as above for a batch of edges: the midpoints are evaluated with a
+// single GFace::points() call
+static void NewGetLc(const std::vector<BDS_Edge *> &edges, GFace *const face,
+                     std::vector<double> &lone)
+{
+  std::vector<SPoint2> uv(edges.size());
+  for(std::size_t i = 0; i < edges.size(); i++)
+    uv[i] = SPoint2(0.5 * (edges[i]->p1->u + edges[i]->p2->u),
+                    0.5 * (edges[i]->p1->v + edges[i]->p2->v));
+  std::vector<GPoint> mid;
+  face->points(uv, mid);
+  lone.resize(edges.size());
+  for(std::size_t i = 0; i < edges.size(); i++)
+    lone[i] = computeEdgeLinearLength(edges[i], face, mid[i]) /
+              correctLC_(edges[i]->p1, edges[i]->p2, face, mid[i], uv[i].x(),
+                         uv[i].y());
+}
+
+// the edges of the surface mesh that can be split or collapsed
+static void getRemeshableEdges(BDS_Mesh &m, std::vector<BDS_Edge *> &edges)
+{
+  for(std::vector<BDS_Edge *>::const_iterator it = m.edges.begin();
+      it != m.edges.end(); ++it) {
+    if(!(*it)->deleted && (*it)->numfaces() == 2 && (*it)->g &&
+       (*it)->g->classif_degree == 2)
+      edges.push_back(*it);
+  }
 }
 
 // SWAP TESTS i.e. tell if swap should be done
@@ -182,11 +211,12 @@ static void swapEdgePass(GFace *gf, BDS_Mesh &m, int &nb_swap, double &t,
                          int FINALIZE = 0, double orientation = 1.0)
 {
   double t1 = Cpu();
-  BDS_SwapEdgeTest *qual;
-  if(FINALIZE && gf->getNativeType() != GEntity::GmshModel)
-    qual = new BDS_SwapEdgeTestNormals(gf, orientation);
-  else
-    qual = new BDS_SwapEdgeTestQuality(true, true);
+  BDS_SwapEdgeTestNormals normals(gf, orientation);
+  BDS_SwapEdgeTestQuality quality(true, true);
+  const BDS_SwapEdgeTest &qual =
+    (FINALIZE && gf->getNativeType() != GEntity::GmshModel) ?
+      static_cast<const BDS_SwapEdgeTest &>(normals) :
+      static_cast<const BDS_SwapEdgeTest &>(quality);
 
   typedef std::vector<BDS_Edge *>::size_type size_type;
   size_type origSize = m.edges.size();
@@ -197,13 +227,12 @@ static void swapEdgePass(GFace *gf, BDS_Mesh &m, int &nb_swap, double &t,
       if(!m.edges.at(index)->deleted && m.edges.at(index)->numfaces() == 2) {
         int const result = FINALIZE ? 1 : edgeSwapTest(gf, m.edges.at(index));
         if(result >= 0) {
-          if(m.swap_edge(m.edges.at(index), *qual)) { ++nb_swap; }
+          if(m.swap_edge(m.edges.at(index), qual)) { ++nb_swap; }
         }
       }
     }
   }
   m.cleanup();
-  delete qual;
   t += (Cpu() - t1);
 }
 
@@ -434,25 +463,25 @@ static void splitEdgePass(GFace *gf, BDS_Mesh &m, double MAXE_, int &nb_split,
     }
   }
 
-  std::vector<BDS_Edge *>::const_iterator it = m.edges.begin();
-  while(it != m.edges.end()) {
-    if(!(*it)->deleted && (*it)->numfaces() == 2 && (*it)->g &&
-       (*it)->g->classif_degree == 2) {
-      double lone = NewGetLc(*it, gf);
-      if(lone > MAXE_) edges.push_back(std::make_pair(-lone, *it));
-    }
-    ++it;
+  std::vector<BDS_Edge *> candidates;
+  getRemeshableEdges(m, candidates);
+  std::vector<double> lone;
+  NewGetLc(candidates, gf, lone);
+  for(std::size_t i = 0; i < candidates.size(); i++) {
+    if(lone[i] > MAXE_)
+      edges.push_back(std::make_pair(-lone[i], candidates[i]));
   }
 
   std::sort(edges.begin(), edges.end(), edges_sort);
 
-  std::vector<BDS_Point *> mids(edges.size());
-
   bool faceDiscrete = gf->geomType() == GEntity::DiscreteSurface;
 
+  // compute the parametric coordinates of the midpoints, then evaluate them
+  // in one batch
+  std::vector<std::size_t> toSplit;
+  std::vector<SPoint2> uv;
   for(std::size_t i = 0; i < edges.size(); ++i) {
     BDS_Edge *e = edges[i].second;
-    BDS_Point *mid = NULL;
     if(!e->deleted &&
        (neighboringModified(e->p1) || neighboringModified(e->p2))) {
       double U1 = e->p1->u;
@@ -467,25 +496,31 @@ static void splitEdgePass(GFace *gf, BDS_Mesh &m, double MAXE_, int &nb_split,
       double V = 0.5 * (V1 + V2);
       if(faceDiscrete)
         if(!middlePoint(gf, e, U, V)) continue;
-
-      GPoint gpp = gf->point(U, V);
-      bool inside = true;
       if(true_boundary) {
         SPoint2 pp(U, V);
         int N;
-        if(!pointInsideParametricDomain(*true_boundary, pp, out, N)) {
-          inside = false;
-        }
-      }
-      if(inside && gpp.succeeded()) {
-        mid = m.add_point(++m.MAXPOINTNUMBER, gpp.x(), gpp.y(), gpp.z());
-        mid->u = U;
-        mid->v = V;
-        mid->lc() = 0.5 * (e->p1->lc() + e->p2->lc());
-        mid->lcBGM() = BGM_MeshSize(gf, U, V, mid->X, mid->Y, mid->Z);
+        if(!pointInsideParametricDomain(*true_boundary, pp, out, N)) continue;
       }
+      toSplit.push_back(i);
+      uv.push_back(SPoint2(U, V));
     }
-    mids[i] = mid;
+  }
+
+  std::vector<GPoint> gpp;
+  gf->points(uv, gpp);
+
+  std::vector<BDS_Point *> mids(edges.size(), (BDS_Point *)NULL);
+  for(std::size_t j = 0; j < toSplit.size(); ++j) {
+    if(!gpp[j].succeeded()) continue;
+    BDS_Edge *e = edges[toSplit[j]].second;
+    const double U = uv[j].x(), V = uv[j].y();
+    BDS_Point *mid =
+      m.add_point(++m.MAXPOINTNUMBER, gpp[j].x(), gpp[j].y(), gpp[j].z());
+    mid->u = U;
+    mid->v = V;
+    mid->lc() = 0.5 * (e->p1->lc() + e->p2->lc());
+    mid->lcBGM() = BGM_MeshSize(gf, U, V, mid->X, mid->Y, mid->Z);
+    mids[toSplit[j]] = mid;
   }
 
   for(std::size_t i = 0; i < edges.size(); ++i) {
@@ -537,16 +572,15 @@ void collapseEdgePass(GFace *gf, BDS_Mesh &m, double MINE_, int MAXNP,
                       int &nb_collaps, double &t)
 {
   double t1 = Cpu();
-  std::vector<BDS_Edge *>::const_iterator it = m.edges.begin();
   std::vector<std::pair<double, BDS_Edge *> > edges;
 
-  while(it != m.edges.end()) {
-    if(!(*it)->deleted && (*it)->numfaces() == 2 && (*it)->g &&
-       (*it)->g->classif_degree == 2) {
-      double lone = NewGetLc(*it, gf);
-      if(lone < MINE_) edges.push_back(std::make_pair(lone, *it));
-    }
-    ++it;
+  std::vector<BDS_Edge *> candidates;
+  getRemeshableEdges(m, candidates);
+  std::vector<double> lone;
+  NewGetLc(candidates, gf, lone);
+  for(std::size_t i = 0; i < candidates.size(); i++) {
+    if(lone[i] < MINE_)
+      edges.push_back(std::make_pair(lone[i], candidates[i]));
   }
 
   std::sort(edges.begin(), edges.end(), edges_sort);
@@ -4,6 +4,7 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
 
 #include <set>
+#include <unordered_map>
 #include "GmshConfig.h"
 #include "GModel.h"
 #include "MLine.h"
@@ -88,38 +89,39 @@ extrudeMesh(GEdge *from, GFace *to, MVertexRTree &pos,
 {
   ExtrudeParams *ep = to->meshAttributes.extrude;
 
+  int nc = ep->getNumColumnNodes();
+  std::vector<double> xyz;
+
   // create vertices (if the edges are constrained, they already exist)
   if(!constrainedEdges) {
+    ep->ExtrudeColumns(from->mesh_vertices, xyz);
     for(std::size_t i = 0; i < from->mesh_vertices.size(); i++) {
       std::vector<MVertex *> extruded_vertices;
       MVertex *v = from->mesh_vertices[i];
       MEdgeVertex *mv = dynamic_cast<MEdgeVertex *>(v);
       if(mv) mv->bl_data = new MVertexBoundaryLayerData();
-      for(int j = 0; j < ep->mesh.NbLayer; j++) {
-        for(int k = 0; k < ep->mesh.NbElmLayer[j]; k++) {
-          double x = v->x(), y = v->y(), z = v->z();
-          ep->Extrude(j, k + 1, x, y, z);
-          if(j != ep->mesh.NbLayer - 1 || k != ep->mesh.NbElmLayer[j] - 1) {
-            MVertex *newv = pos.find(x, y, z);
-            if(!newv) {
-              if(from->geomType() != GEntity::DiscreteCurve &&
-                 to->geomType() != GEntity::DiscreteSurface &&
-                 to->geomType() != GEntity::BoundaryLayerSurface) {
-                // This can be inefficient, and sometimes useless. We could add an
-                // option to disable it.
-                SPoint3 xyz(x, y, z);
-                SPoint2 uv = to->parFromPoint(xyz);
-                newv = new MFaceVertex(x, y, z, to, uv[0], uv[1]);
-              }
-              else {
-                newv = new MVertex(x, y, z, to);
-              }
-              to->mesh_vertices.push_back(newv);
-            }
-            pos.insert(newv);
-            extruded_vertices.push_back(newv);
+      // all but the last vertex in the column, which is on the top curve
+      for(int c = 1; c < nc - 1; c++) {
+        double x = xyz[3 * (nc * i + c)];
+        double y = xyz[3 * (nc * i + c) + 1];
+        double z = xyz[3 * (nc * i + c) + 2];
+        MVertex *newv = pos.find(x, y, z);
+        if(!newv) {
+          if(from->geomType() != GEntity::DiscreteCurve &&
+             to->geomType() != GEntity::DiscreteSurface &&
+             to->geomType() != GEntity::BoundaryLayerSurface) {
+            // This can be inefficient, and sometimes useless. We could add an
+            // option to disable it.
+            SPoint2 uv = to->parFromPoint(SPoint3(x, y, z));
+            newv = new MFaceVertex(x, y, z, to, uv[0], uv[1]);
+          }
+          else {
+            newv = new MVertex(x, y, z, to);
           }
+          to->mesh_vertices.push_back(newv);
         }
+        pos.insert(newv);
+        extruded_vertices.push_back(newv);
       }
       if(mv) mv->bl_data->addChildrenFamily(extruded_vertices);
     }
@@ -143,35 +145,44 @@ extrudeMesh(GEdge *from, GFace *to, MVertexRTree &pos,
       to->tag());
 #endif
 
-  // create elements (note that it would be faster to access the *interior*
-  // nodes by direct indexing, but it's just simpler to query everything by
-  // position)
+  // look up all the vertices in the columns extruded from the vertices of the
+  // source lines once and for all (the rtree is not modified anymore at this
+  // stage, so the queries can be done in parallel)
+  std::unordered_map<MVertex *, std::size_t> index;
+  std::vector<MVertex *> src;
   for(std::size_t i = 0; i < from->lines.size(); i++) {
-    MVertex *v0 = from->lines[i]->getVertex(0);
-    MVertex *v1 = from->lines[i]->getVertex(1);
-    for(int j = 0; j < ep->mesh.NbLayer; j++) {
-      for(int k = 0; k < ep->mesh.NbElmLayer[j]; k++) {
-        std::vector<MVertex *> verts;
-        double x[4] = {v0->x(), v1->x(), v0->x(), v1->x()};
-        double y[4] = {v0->y(), v1->y(), v0->y(), v1->y()};
-        double z[4] = {v0->z(), v1->z(), v0->z(), v1->z()};
-        for(int p = 0; p < 2; p++) {
-          ep->Extrude(j, k, x[p], y[p], z[p]);
-          ep->Extrude(j, k + 1, x[p + 2], y[p + 2], z[p + 2]);
-        }
-        for(int p = 0; p < 4; p++) {
-          MVertex *tmp = pos.find(x[p], y[p], z[p]);
-          if(!tmp) {
-            Msg::Error("Could not find extruded node (%.16g, %.16g, %.16g) "
-                       "in surface %d",
-                       x[p], y[p], z[p], to->tag());
-            return;
-          }
-          verts.push_back(tmp);
-        }
-        createQuaTri(verts, to, constrainedEdges, from->lines[i],
-                     tri_quad_flag);
-      }
+    for(std::size_t j = 0; j < 2; j++) {
+      MVertex *v = from->lines[i]->getVertex(j);
+      if(index.insert(std::make_pair(v, src.size())).second) src.push_back(v);
+    }
+  }
+  ep->ExtrudeColumns(src, xyz);
+  std::vector<MVertex *> column(nc * src.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t i = 0; i < column.size(); i++)
+    column[i] = pos.find(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]);
+  for(std::size_t i = 0; i < column.size(); i++) {
+    if(!column[i]) {
+      Msg::Error("Could not find extruded node (%.16g, %.16g, %.16g) "
+                 "in surface %d",
+                 xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], to->tag());
+      return;
+    }
+  }
+
+  // create elements
+  std::vector<MVertex *> verts(4);
+  for(std::size_t i = 0; i < from->lines.size(); i++) {
+    std::size_t i0 = nc * index[from->lines[i]->getVertex(0)];
+    std::size_t i1 = nc * index[from->lines[i]->getVertex(1)];
+    for(int c = 0; c < nc - 1; c++) {
+      verts[0] = column[i0 + c];
+      verts[1] = column[i1 + c];
+      verts[2] = column[i0 + c + 1];
+      verts[3] = column[i1 + c + 1];
+      createQuaTri(verts, to, constrainedEdges, from->lines[i], tri_quad_flag);
     }
   }
 }
@@ -949,6 +949,99 @@ void laplaceSmoothing(GFace *gf, int niter, bool infinity_norm)
   }
 }
 
+// flat edge -> triangle table used to build the recombination graph: one
+// record per triangle edge, sorted so that the triangles sharing an edge are
+// contiguous and appear in the same order as in an e2t_cont
+struct recombineEdge {
+  MEdge e;
+  int t;
+  bool operator<(const recombineEdge &other) const
+  {
+    MEdgeLessThan lt;
+    if(lt(e, other.e)) return true;
+    if(lt(other.e, e)) return false;
+    return t < other.t;
+  }
+};
+
+static void buildRecombineEdgeTable(std::vector<MTriangle *> &tris,
+                                    std::vector<recombineEdge> &table)
+{
+  table.resize(3 * tris.size());
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < (int)tris.size(); i++) {
+    for(int j = 0; j < 3; j++) {
+      table[3 * i + j].e = tris[i]->getEdge(j);
+      table[3 * i + j].t = i;
+    }
+  }
+  std::sort(table.begin(), table.end());
+}
+
+// quadrangle made of a pair of triangles matched by the greedy algorithm
+static MQuadrangle *quadFromPair(const RecombineTriangle &p)
+{
+  int orientation = 0;
+  for(int i = 0; i < 3; i++) {
+    if(p.t1->getVertex(i) == p.n1) {
+      if(p.t1->getVertex((i + 1) % 3) == p.n2)
+        orientation = 1;
+      else
+        orientation = -1;
+      break;
+    }
+  }
+  return new MQuadrangle(p.n1, orientation < 0 ? p.n3 : p.n4, p.n2,
+                         orientation < 0 ? p.n4 : p.n3);
+}
+
+#if defined(HAVE_BLOSSOM)
+// edge weight of a pair of triangles in the blossom graph
+static int blossomWeight(const RecombineTriangle &p)
+{
+  int w = (int)1000 * std::exp(-p.angle);
+  int NB = 0;
+  if(p.n1->onWhat()->dim() < 2) NB++;
+  if(p.n2->onWhat()->dim() < 2) NB++;
+  if(p.n3->onWhat()->dim() < 2) NB++;
+  if(p.n4->onWhat()->dim() < 2) NB++;
+  if(w > static_cast<int>(1000 * std::exp(0.1)) && NB > 2) {
+    w = 5000;
+  }
+  else if(w >= 1000 && NB > 2) {
+    w = 10000;
+  }
+  return w;
+}
+
+// quadrangle made of two triangles matched by the blossom algorithm
+static MQuadrangle *quadFromTriangles(MElement *t1, MElement *t2)
+{
+  MVertex *other = NULL;
+  for(int i = 0; i < 3; i++) {
+    if(t1->getVertex(0) != t2->getVertex(i) &&
+       t1->getVertex(1) != t2->getVertex(i) &&
+       t1->getVertex(2) != t2->getVertex(i)) {
+      other = t2->getVertex(i);
+      break;
+    }
+  }
+  int start = 0;
+  for(int i = 0; i < 3; i++) {
+    if(t2->getVertex(0) != t1->getVertex(i) &&
+       t2->getVertex(1) != t1->getVertex(i) &&
+       t2->getVertex(2) != t1->getVertex(i)) {
+      start = i;
+      break;
+    }
+  }
+  return new MQuadrangle(t1->getVertex(start), t1->getVertex((start + 1) % 3),
+                         other, t1->getVertex((start + 2) % 3));
+}
+#endif
+
 static void _recombineIntoQuads(GFace *gf, bool blossom, bool cubicGraph = 1)
 {
   if(gf->triangles.empty()) return;
@@ -1003,38 +1096,57 @@ static void _recombineIntoQuads(GFace *gf, bool blossom, bool cubicGraph = 1)
   emb_edgeverts.erase(std::unique(emb_edgeverts.begin(), emb_edgeverts.end()),
                       emb_edgeverts.end());
 
-  e2t_cont adj;
-  buildEdgeToElement(gf->triangles, adj);
+  std::vector<recombineEdge> table;
+  buildRecombineEdgeTable(gf->triangles, table);
+
+  // candidate pairs of triangles (the first and the last triangles sharing
+  // an edge, as in an e2t_cont) and boundary edges
+  std::vector<std::pair<int, int> > pairTris;
+  std::vector<MEdge> pairEdges;
+  std::vector<recombineEdge> boundary;
+  MEdgeLessThan lt;
+  for(std::size_t i = 0; i < table.size();) {
+    std::size_t j = i + 1;
+    while(j < table.size() && !lt(table[i].e, table[j].e)) j++;
+    const MEdge &e = table[i].e;
+    if(j - i == 1) {
+      boundary.push_back(table[i]);
+    }
+    else if(!std::binary_search(emb_edgeverts.begin(), emb_edgeverts.end(),
+                                e.getVertex(0)) ||
+            !std::binary_search(emb_edgeverts.begin(), emb_edgeverts.end(),
+                                e.getVertex(1))) {
+      pairTris.push_back(std::make_pair(table[i].t, table[j - 1].t));
+      pairEdges.push_back(e);
+    }
+    i = j;
+  }
 
-  std::vector<RecombineTriangle> pairs;
+  std::vector<RecombineTriangle> pairs(pairTris.size());
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < (int)pairs.size(); i++)
+    pairs[i] = RecombineTriangle(pairEdges[i],
+                                 gf->triangles[pairTris[i].first],
+                                 gf->triangles[pairTris[i].second]);
 
   std::map<MVertex *, std::pair<MElement *, MElement *> > makeGraphPeriodic;
 
-  for(e2t_cont::iterator it = adj.begin(); it != adj.end(); ++it) {
-    if(it->second.second && it->second.first->getNumVertices() == 3 &&
-       it->second.second->getNumVertices() == 3 &&
-       (!std::binary_search(emb_edgeverts.begin(), emb_edgeverts.end(),
-                            it->first.getVertex(0)) ||
-        !std::binary_search(emb_edgeverts.begin(), emb_edgeverts.end(),
-                            it->first.getVertex(1)))) {
-      pairs.push_back(
-        RecombineTriangle(it->first, it->second.first, it->second.second));
-    }
-    else if(!it->second.second && it->second.first->getNumVertices() == 3) {
-      for(int i = 0; i < 2; i++) {
-        MVertex *const v = it->first.getVertex(i);
-        std::map<MVertex *, std::pair<MElement *, MElement *> >::iterator itv =
-          makeGraphPeriodic.find(v);
-        if(itv == makeGraphPeriodic.end()) {
-          makeGraphPeriodic[v] =
-            std::make_pair(it->second.first, static_cast<MElement *>(NULL));
-        }
-        else {
-          if(itv->second.first != it->second.first)
-            itv->second.second = it->second.first;
-          else
-            makeGraphPeriodic.erase(itv);
-        }
+  for(std::size_t i = 0; i < boundary.size(); i++) {
+    MElement *t = gf->triangles[boundary[i].t];
+    for(int j = 0; j < 2; j++) {
+      MVertex *const v = boundary[i].e.getVertex(j);
+      std::map<MVertex *, std::pair<MElement *, MElement *> >::iterator itv =
+        makeGraphPeriodic.find(v);
+      if(itv == makeGraphPeriodic.end()) {
+        makeGraphPeriodic[v] = std::make_pair(t, static_cast<MElement *>(NULL));
+      }
+      else {
+        if(itv->second.first != t)
+          itv->second.second = t;
+        else
+          makeGraphPeriodic.erase(itv);
       }
     }
   }
@@ -1069,18 +1181,7 @@ static void _recombineIntoQuads(GFace *gf, bool blossom, bool cubicGraph = 1)
       for(std::size_t i = 0; i < pairs.size(); ++i) {
         elist[2 * i] = t2n[pairs[i].t1];
         elist[2 * i + 1] = t2n[pairs[i].t2];
-        elen[i] = (int)1000 * std::exp(-pairs[i].angle);
-        int NB = 0;
-        if(pairs[i].n1->onWhat()->dim() < 2) NB++;
-        if(pairs[i].n2->onWhat()->dim() < 2) NB++;
-        if(pairs[i].n3->onWhat()->dim() < 2) NB++;
-        if(pairs[i].n4->onWhat()->dim() < 2) NB++;
-        if(elen[i] > static_cast<int>(1000 * std::exp(0.1)) && NB > 2) {
-          elen[i] = 5000;
-        }
-        else if(elen[i] >= 1000 && NB > 2) {
-          elen[i] = 10000;
-        }
+        elen[i] = blossomWeight(pairs[i]);
       }
 
       if(cubicGraph) {
@@ -1119,28 +1220,7 @@ static void _recombineIntoQuads(GFace *gf, bool blossom, bool cubicGraph = 1)
             MElement *t2 = n2t[i2];
             touched.insert(t1);
             touched.insert(t2);
-            MVertex *other = NULL;
-            for(int i = 0; i < 3; i++) {
-              if(t1->getVertex(0) != t2->getVertex(i) &&
-                 t1->getVertex(1) != t2->getVertex(i) &&
-                 t1->getVertex(2) != t2->getVertex(i)) {
-                other = t2->getVertex(i);
-                break;
-              }
-            }
-            int start = 0;
-            for(int i = 0; i < 3; i++) {
-              if(t2->getVertex(0) != t1->getVertex(i) &&
-                 t2->getVertex(1) != t1->getVertex(i) &&
-                 t2->getVertex(2) != t1->getVertex(i)) {
-                start = i;
-                break;
-              }
-            }
-            MQuadrangle *q = new MQuadrangle(
-              t1->getVertex(start), t1->getVertex((start + 1) % 3), other,
-              t1->getVertex((start + 2) % 3));
-            gf->quadrangles.push_back(q);
+            gf->quadrangles.push_back(quadFromTriangles(t1, t2));
           }
         }
         free(elist);
@@ -1165,19 +1245,7 @@ static void _recombineIntoQuads(GFace *gf, bool blossom, bool cubicGraph = 1)
          touched.find(t2) == touched.end()) {
         touched.insert(t1);
         touched.insert(t2);
-        int orientation = 0;
-        for(int i = 0; i < 3; i++) {
-          if(t1->getVertex(i) == itp->n1) {
-            if(t1->getVertex((i + 1) % 3) == itp->n2)
-              orientation = 1;
-            else
-              orientation = -1;
-            break;
-          }
-        }
-        gf->quadrangles.push_back
-          (new MQuadrangle(itp->n1, orientation < 0 ? itp->n3 : itp->n4, itp->n2,
-                           orientation < 0 ? itp->n4 : itp->n3));
+        gf->quadrangles.push_back(quadFromPair(*itp));
       }
     }
     ++itp;
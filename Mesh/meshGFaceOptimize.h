@@ -108,6 +108,10 @@ struct RecombineTriangle {
   double quality;
   MVertex *n1, *n2, *n3, *n4;
 
+  RecombineTriangle()
+    : t1(0), t2(0), angle(0.), quality(0.), n1(0), n2(0), n3(0), n4(0)
+  {
+  }
   RecombineTriangle(const MEdge &me, MElement *_t1, MElement *_t2)
     : t1(_t1), t2(_t2)
   {
@@ -331,10 +331,16 @@ int MeshTransfiniteSurface(GFace *gf)
   double UC1 = U[N1], UC2 = U[N2], UC3 = U[N3];
   double VC1 = V[N1], VC2 = V[N2], VC3 = V[N3];
 
-  // create points using transfinite interpolation
+  // create points using transfinite interpolation: the parameters of the
+  // interior nodes and the corresponding points on the surface are computed in
+  // parallel, then the nodes are created in order
+  std::vector<SPoint2> uv((L - 1) * (H - 1));
   if(corners.size() == 4) {
     double UC4 = U[N4];
     double VC4 = V[N4];
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
     for(int i = 1; i < L; i++) {
       double u = lengths_i[i] / L_i;
       for(int j = 1; j < H; j++) {
@@ -347,14 +353,14 @@ int MeshTransfiniteSurface(GFace *gf)
           TRAN_QUA(U[iP1], U[iP2], U[iP3], U[iP4], UC1, UC2, UC3, UC4, u, v);
         double Vp =
           TRAN_QUA(V[iP1], V[iP2], V[iP3], V[iP4], VC1, VC2, VC3, VC4, u, v);
-        GPoint gp = gf->point(SPoint2(Up, Vp));
-        MFaceVertex *newv = new MFaceVertex(gp.x(), gp.y(), gp.z(), gf, Up, Vp);
-        gf->mesh_vertices.push_back(newv);
-        tab[i][j] = newv;
+        uv[(i - 1) * (H - 1) + j - 1] = SPoint2(Up, Vp);
       }
     }
   }
   else {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
     for(int i = 1; i < L; i++) {
       double u = lengths_i[i] / L_i;
       for(int j = 1; j < H; j++) {
@@ -384,13 +390,22 @@ int MeshTransfiniteSurface(GFace *gf)
           // xp,yp,zp can be off the surface so we cannot use parFromPoint
           gf->XYZtoUV(xp, yp, zp, Up, Vp, 1.0, false);
         }
-        GPoint gp = gf->point(SPoint2(Up, Vp));
-        MFaceVertex *newv = new MFaceVertex(gp.x(), gp.y(), gp.z(), gf, Up, Vp);
-        gf->mesh_vertices.push_back(newv);
-        tab[i][j] = newv;
+        uv[(i - 1) * (H - 1) + j - 1] = SPoint2(Up, Vp);
       }
     }
   }
+  std::vector<GPoint> gp;
+  gf->points(uv, gp);
+  gf->mesh_vertices.reserve(gf->mesh_vertices.size() + uv.size());
+  for(int i = 1; i < L; i++) {
+    for(int j = 1; j < H; j++) {
+      std::size_t n = (i - 1) * (H - 1) + j - 1;
+      MFaceVertex *newv = new MFaceVertex(gp[n].x(), gp[n].y(), gp[n].z(), gf,
+                                          uv[n].x(), uv[n].y());
+      gf->mesh_vertices.push_back(newv);
+      tab[i][j] = newv;
+    }
+  }
 
   // should we apply the elliptic smoother?
   int numSmooth = 0;
@@ -462,12 +477,17 @@ int MeshTransfiniteSurface(GFace *gf)
         }
       }
     }
+    for(int i = 1; i < L; i++) {
+      for(int j = 1; j < H; j++)
+        uv[(i - 1) * (H - 1) + j - 1] = SPoint2(u[i][j], v[i][j]);
+    }
+    gf->points(uv, gp);
     for(int i = 1; i < L; i++) {
       for(int j = 1; j < H; j++) {
-        GPoint p = gf->point(SPoint2(u[i][j], v[i][j]));
-        tab[i][j]->x() = p.x();
-        tab[i][j]->y() = p.y();
-        tab[i][j]->z() = p.z();
+        std::size_t n = (i - 1) * (H - 1) + j - 1;
+        tab[i][j]->x() = gp[n].x();
+        tab[i][j]->y() = gp[n].y();
+        tab[i][j]->z() = gp[n].z();
         tab[i][j]->setParameter(0, u[i][j]);
         tab[i][j]->setParameter(1, v[i][j]);
       }
@@ -475,6 +495,12 @@ int MeshTransfiniteSurface(GFace *gf)
   }
 
   // create elements
+  bool recombine =
+    CTX::instance()->mesh.recombineAll || gf->meshAttributes.recombine;
+  if(recombine)
+    gf->quadrangles.reserve(gf->quadrangles.size() + L * H);
+  else
+    gf->triangles.reserve(gf->triangles.size() + 2 * L * H);
   if(corners.size() == 4) {
     for(int i = 0; i < L; i++) {
       for(int j = 0; j < H; j++) {
@@ -482,7 +508,7 @@ int MeshTransfiniteSurface(GFace *gf)
         MVertex *v2 = tab[i + 1][j];
         MVertex *v3 = tab[i + 1][j + 1];
         MVertex *v4 = tab[i][j + 1];
-        if(CTX::instance()->mesh.recombineAll || gf->meshAttributes.recombine)
+        if(recombine)
           gf->quadrangles.push_back(new MQuadrangle(v1, v2, v3, v4));
         else if(gf->meshAttributes.transfiniteArrangement == 1 ||
                 (gf->meshAttributes.transfiniteArrangement == 2 &&
@@ -513,7 +539,7 @@ int MeshTransfiniteSurface(GFace *gf)
         MVertex *v2 = tab[i + 1][j];
         MVertex *v3 = tab[i + 1][j + 1];
         MVertex *v4 = tab[i][j + 1];
-        if(CTX::instance()->mesh.recombineAll || gf->meshAttributes.recombine)
+        if(recombine)
           gf->quadrangles.push_back(new MQuadrangle(v1, v2, v3, v4));
         else if(gf->meshAttributes.transfiniteArrangement == 1 ||
                 (gf->meshAttributes.transfiniteArrangement == 2 &&
@@ -85,7 +85,7 @@ int splitQuadRecovery::buildPyramids(GModel *gm)
   return npyram;
 }
 
-void MeshDelaunayVolume(std::vector<GRegion *> &regions)
+void MeshDelaunayVolume(std::vector<GRegion *> &regions, bool independent)
 {
   if(regions.empty()) return;
 
@@ -150,8 +150,14 @@ void MeshDelaunayVolume(std::vector<GRegion *> &regions)
   std::vector<GVertex *> oldEmbVertices = gr->embeddedVertices();
   gr->embeddedVertices() = allEmbVertices;
 
+  // the boundary recovery code uses static data, and is thus serialized when
+  // independent groups of volumes are meshed concurrently
   splitQuadRecovery sqr;
-  bool success = meshGRegionBoundaryRecovery(gr, &sqr);
+  bool success;
+#if defined(_OPENMP)
+#pragma omp critical(MeshDelaunayVolumeRecovery)
+#endif
+  success = meshGRegionBoundaryRecovery(gr, &sqr);
 
   // sort triangles in all model faces in order to be able to search in vectors
   std::vector<GFace *>::iterator itf = allFaces.begin();
@@ -190,7 +196,7 @@ void MeshDelaunayVolume(std::vector<GRegion *> &regions)
   }
   else if(CTX::instance()->mesh.algo3d != ALGO_3D_INITIAL_ONLY) {
     insertVerticesInRegion(gr, CTX::instance()->mesh.maxIterDelaunay3D,
-                           1., true, &sqr);
+                           1., true, &sqr, independent ? &regions : 0);
 
     if(sqr.buildPyramids(gr->model())){
       Msg::Info("Optimizing pyramids for hybrid mesh...");
@@ -256,12 +262,19 @@ void optimizeMeshGRegion::operator()(GRegion *gr, bool always)
 
 bool buildFaceSearchStructure(GModel *model, fs_cont &search,
                               bool onlyTriangles)
+{
+  std::vector<GRegion *> regions(model->firstRegion(), model->lastRegion());
+  return buildFaceSearchStructure(regions, search, onlyTriangles);
+}
+
+bool buildFaceSearchStructure(std::vector<GRegion *> &regions, fs_cont &search,
+                              bool onlyTriangles)
 {
   search.clear();
 
   std::set<GFace *> faces_to_consider;
-  GModel::riter rit = model->firstRegion();
-  while(rit != model->lastRegion()) {
+  std::vector<GRegion *>::iterator rit = regions.begin();
+  while(rit != regions.end()) {
     std::vector<GFace *> _faces = (*rit)->faces();
     faces_to_consider.insert(_faces.begin(), _faces.end());
     rit++;
@@ -50,7 +50,12 @@ public:
   void operator()(GRegion *);
 };
 
-void MeshDelaunayVolume(std::vector<GRegion *> &delaunay);
+// mesh a group of connected volumes with the Delaunay algorithm; if
+// independent is set, the group does not share any node with the other volumes
+// and only its own entities are considered, so that several such groups can be
+// meshed concurrently
+void MeshDelaunayVolume(std::vector<GRegion *> &delaunay,
+                        bool independent = false);
 bool CreateAnEmptyVolumeMesh(GRegion *gr);
 int MeshTransfiniteVolume(GRegion *gr);
 int SubdivideExtrudedMesh(GModel *m);
@@ -65,6 +70,8 @@ GFace *findInFaceSearchStructure(const MFace &f, const fs_cont &search);
 GEdge *findInEdgeSearchStructure(MVertex *p1, MVertex *p2,
                                  const es_cont &search);
 bool buildFaceSearchStructure(GModel *model, fs_cont &search, bool onlyTriangles = false);
+bool buildFaceSearchStructure(std::vector<GRegion *> &regions, fs_cont &search,
+                              bool onlyTriangles = false);
 bool buildEdgeSearchStructure(GModel *model, es_cont &search);
 
 // hybrid mesh recovery structure
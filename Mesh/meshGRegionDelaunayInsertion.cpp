@@ -625,12 +625,13 @@ static void completeTheSetOfFaces(GModel *model, std::set<GFace *> &faces_bound)
 }
 
 GRegion *getRegionFromBoundingFaces(GModel *model,
+                                    std::vector<GRegion *> &regions,
                                     std::set<GFace *> &faces_bound)
 {
   completeTheSetOfFaces(model, faces_bound);
 
-  GModel::riter git = model->firstRegion();
-  while(git != model->lastRegion()) {
+  std::vector<GRegion *>::iterator git = regions.begin();
+  while(git != regions.end()) {
     GRegion *gr = *git;
     ExtrudeParams *ep = gr->meshAttributes.extrude;
     if((ep && ep->mesh.ExtrudeMesh) ||
@@ -1221,8 +1222,39 @@ static void _deleteUnusedVertices(GRegion *gr)
 }
 
 void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarget,
-                            bool _classify, splitQuadRecovery *sqr)
+                            bool _classify, splitQuadRecovery *sqr,
+                            std::vector<GRegion *> *group)
 {
+  MsgProfileSection prof("3D refinement (volume %d)", gr->tag());
+
+  // volumes and surfaces to consider: all the ones in the model, or only those
+  // in the given group of volumes (so that other groups can be meshed
+  // concurrently)
+  std::vector<GRegion *> regions;
+  std::vector<GFace *> faces;
+  if(group) {
+    regions = *group;
+    std::set<GFace *, GEntityPtrLessThan> f;
+    for(std::size_t i = 0; i < regions.size(); i++) {
+      std::vector<GFace *> const &rf = regions[i]->faces();
+      std::vector<GFace *> const &re = regions[i]->embeddedFaces();
+      f.insert(rf.begin(), rf.end());
+      f.insert(re.begin(), re.end());
+    }
+    std::set<GFace *, GEntityPtrLessThan> comp;
+    for(std::set<GFace *, GEntityPtrLessThan>::iterator it = f.begin();
+        it != f.end(); it++) {
+      if((*it)->compoundSurface) comp.insert((*it)->compoundSurface);
+    }
+    f.insert(comp.begin(), comp.end());
+    faces.insert(faces.end(), f.begin(), f.end());
+  }
+  else {
+    regions.insert(regions.end(), gr->model()->firstRegion(),
+                   gr->model()->lastRegion());
+    faces.insert(faces.end(), gr->model()->firstFace(),
+                 gr->model()->lastFace());
+  }
 
 #ifdef DEBUG_BOUNDARY_RECOVERY
   testIfBoundaryIsRecovered(gr);
@@ -1238,8 +1270,8 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
     std::map<MVertex *, double, MVertexPtrLessThan> vSizesMap;
     std::set<MVertex *, MVertexPtrLessThan> bndVertices;
 
-    for(GModel::riter rit = gr->model()->firstRegion();
-        rit != gr->model()->lastRegion(); ++rit) {
+    for(std::vector<GRegion *>::iterator rit = regions.begin();
+        rit != regions.end(); ++rit) {
       std::vector<GEdge *> const &e = (*rit)->embeddedEdges();
       for(std::vector<GEdge *>::const_iterator it = e.begin(); it != e.end();
           ++it) {
@@ -1263,8 +1295,8 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
       }
     }
 
-    for(GModel::riter rit = gr->model()->firstRegion();
-        rit != gr->model()->lastRegion(); ++rit) {
+    for(std::vector<GRegion *>::iterator rit = regions.begin();
+        rit != regions.end(); ++rit) {
       std::vector<GVertex *> const &vertices = (*rit)->embeddedVertices();
       for(std::vector<GVertex *>::const_iterator it = vertices.begin();
           it != vertices.end(); ++it) {
@@ -1276,8 +1308,8 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
       }
     }
 
-    for(GModel::fiter it = gr->model()->firstFace();
-        it != gr->model()->lastFace(); ++it) {
+    for(std::vector<GFace *>::iterator it = faces.begin(); it != faces.end();
+        ++it) {
       GFace *gf = *it;
       for(std::size_t i = 0; i < gf->triangles.size(); i++) {
         setLcs(gf->triangles[i], vSizesMap, bndVertices);
@@ -1309,7 +1341,7 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
 
   if(_classify) {
     fs_cont search;
-    buildFaceSearchStructure(gr->model(), search, true); // only triangles
+    buildFaceSearchStructure(regions, search, true); // only triangles
     if(sqr) search.insert(sqr->getTri().begin(), sqr->getTri().end());
 
     for(MTet4Factory::iterator it = allTets.begin(); it != allTets.end();
@@ -1326,7 +1358,7 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
         Msg::Debug("Found %d tets with %d faces (Wall %gs, CPU %gs)",
                    theRegion.size(), faces_bound.size(), _w2 - _w1, _t2 - _t1);
         GRegion *myGRegion =
-          getRegionFromBoundingFaces(gr->model(), faces_bound);
+          getRegionFromBoundingFaces(gr->model(), regions, faces_bound);
         if(myGRegion) { // a geometrical region associated to the list of faces
                         // has been found
           Msg::Info("Found volume %d", myGRegion->tag());
@@ -1373,8 +1405,8 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
   // store all embedded faces
   std::set<MFace, MFaceLessThan> allEmbeddedFaces;
   edgeContainerB allEmbeddedEdges;
-  for(GModel::riter it = gr->model()->firstRegion();
-      it != gr->model()->lastRegion(); ++it) {
+  for(std::vector<GRegion *>::iterator it = regions.begin();
+      it != regions.end(); ++it) {
     createAllEmbeddedFaces((*it), allEmbeddedFaces);
     createAllEmbeddedEdges((*it), allEmbeddedEdges);
   }
@@ -1535,6 +1567,8 @@ void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarge
   Msg::Info(" - %d nodes could not be inserted", COUNT_MISS);
   Msg::Info(" - %d tetrahedra created in %g sec. (%d tets/s)",
             allTets.size(), dt, (int)(allTets.size() / dt));
+  Msg::ProfileCount("cavities processed", ITER);
+  Msg::ProfileCount("cavities corrected", NB_CORRECTION_OF_CAVITY);
 
   // relocate vertices
   int nbReloc = 0;
@@ -219,7 +219,8 @@ void connectTets(std::list<MTet4 *> &, const std::set<MFace, MFaceLessThan> * =
 void connectTets(std::vector<MTet4 *> &, const std::set<MFace, MFaceLessThan> * = 0);
 void delaunayMeshIn3D(std::vector<MVertex *> &, std::vector<MTetrahedron *> &);
 void insertVerticesInRegion(GRegion *gr, int maxIter, double worstTetRadiusTarget,
-                            bool _classify = true, splitQuadRecovery *sqr = 0);
+                            bool _classify = true, splitQuadRecovery *sqr = 0,
+                            std::vector<GRegion *> *group = 0);
 void bowyerWatsonFrontalLayers(GRegion *gr, bool hex);
 
 struct compareTet4Ptr {
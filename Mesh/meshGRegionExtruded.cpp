@@ -4,6 +4,7 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
 
 #include <set>
+#include <unordered_map>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "GModel.h"
@@ -150,6 +151,22 @@ static int getExtrudedVertices(MElement *ele, ExtrudeParams *ep, int j, int k,
   return verts.size();
 }
 
+static int getColumnVertices(MElement *ele, int c, int nc,
+                             std::unordered_map<MVertex *, std::size_t> &index,
+                             std::vector<MVertex *> &column,
+                             std::vector<MVertex *> &verts)
+{
+  int n = ele->getNumVertices();
+  verts.resize(2 * n);
+  for(int p = 0; p < n; p++) {
+    std::size_t i = index[ele->getVertex(p)];
+    verts[p] = column[nc * i + c];
+    verts[p + n] = column[nc * i + c + 1];
+    if(!verts[p] || !verts[p + n]) return 0;
+  }
+  return verts.size();
+}
+
 static void extrudeMesh(GFace *from, GRegion *to, MVertexRTree &pos)
 {
   ExtrudeParams *ep = to->meshAttributes.extrude;
@@ -178,20 +195,18 @@ static void extrudeMesh(GFace *from, GRegion *to, MVertexRTree &pos)
   }
   mesh_vertices.insert(mesh_vertices.end(), seam.begin(), seam.end());
 
-  // create extruded vertices
+  // create extruded vertices (all but the last one in each column, which is
+  // on the top surface)
+  int nc = ep->getNumColumnNodes();
+  std::vector<double> xyz;
+  ep->ExtrudeColumns(mesh_vertices, xyz);
   for(std::size_t i = 0; i < mesh_vertices.size(); i++) {
-    MVertex *v = mesh_vertices[i];
-    for(int j = 0; j < ep->mesh.NbLayer; j++) {
-      for(int k = 0; k < ep->mesh.NbElmLayer[j]; k++) {
-        double x = v->x(), y = v->y(), z = v->z();
-        ep->Extrude(j, k + 1, x, y, z);
-        if(j != ep->mesh.NbLayer - 1 || k != ep->mesh.NbElmLayer[j] - 1) {
-          if(!pos.find(x, y, z)) {
-            MVertex *newv = new MVertex(x, y, z, to);
-            to->mesh_vertices.push_back(newv);
-            pos.insert(newv);
-          }
-        }
+    for(int c = 1; c < nc - 1; c++) {
+      double *p = &xyz[3 * (nc * i + c)];
+      if(!pos.find(p[0], p[1], p[2])) {
+        MVertex *newv = new MVertex(p[0], p[1], p[2], to);
+        to->mesh_vertices.push_back(newv);
+        pos.insert(newv);
       }
     }
   }
@@ -203,17 +218,39 @@ static void extrudeMesh(GFace *from, GRegion *to, MVertexRTree &pos)
   }
 #endif
 
-  // create elements (note that it would be faster to access the *interior*
-  // nodes by direct indexing, but it's just simpler to query everything by
-  // position)
+  // look up all the nodes in the columns extruded from the nodes of the source
+  // elements once and for all, instead of querying the rtree for each node of
+  // each extruded element (the rtree is not modified anymore at this stage, so
+  // the queries can be done in parallel)
+  std::unordered_map<MVertex *, std::size_t> index;
+  std::vector<MVertex *> src;
+  for(std::size_t i = 0; i < from->getNumMeshElements(); i++) {
+    MElement *e = from->getMeshElement(i);
+    for(std::size_t j = 0; j < e->getNumVertices(); j++) {
+      MVertex *v = e->getVertex(j);
+      if(index.insert(std::make_pair(v, src.size())).second) src.push_back(v);
+    }
+  }
+  ep->ExtrudeColumns(src, xyz);
+  std::vector<MVertex *> column(nc * src.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t i = 0; i < column.size(); i++)
+    column[i] = pos.find(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]);
+  for(std::size_t i = 0; i < column.size(); i++) {
+    if(!column[i])
+      Msg::Error("Could not find extruded vertex (%.16g, %.16g, %.16g)",
+                 xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]);
+  }
+
+  // create elements
+  std::vector<MVertex *> verts;
   for(std::size_t i = 0; i < from->triangles.size(); i++) {
-    for(int j = 0; j < ep->mesh.NbLayer; j++) {
-      for(int k = 0; k < ep->mesh.NbElmLayer[j]; k++) {
-        std::vector<MVertex *> verts;
-        if(getExtrudedVertices(from->triangles[i], ep, j, k, pos, verts) == 6) {
-          createPriPyrTet(verts, to, from->triangles[i]);
-        }
-      }
+    for(int c = 0; c < nc - 1; c++) {
+      if(getColumnVertices(from->triangles[i], c, nc, index, column, verts) ==
+         6)
+        createPriPyrTet(verts, to, from->triangles[i]);
     }
   }
 
@@ -222,13 +259,10 @@ static void extrudeMesh(GFace *from, GRegion *to, MVertexRTree &pos)
   }
   else {
     for(std::size_t i = 0; i < from->quadrangles.size(); i++) {
-      for(int j = 0; j < ep->mesh.NbLayer; j++) {
-        for(int k = 0; k < ep->mesh.NbElmLayer[j]; k++) {
-          std::vector<MVertex *> verts;
-          if(getExtrudedVertices(from->quadrangles[i], ep, j, k, pos, verts) ==
-             8)
-            createHexPri(verts, to, from->quadrangles[i]);
-        }
+      for(int c = 0; c < nc - 1; c++) {
+        if(getColumnVertices(from->quadrangles[i], c, nc, index, column,
+                             verts) == 8)
+          createHexPri(verts, to, from->quadrangles[i]);
       }
     }
   }
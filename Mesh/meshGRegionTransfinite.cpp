@@ -8,6 +8,7 @@
 //
 
 #include <map>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "meshGFace.h"
@@ -113,14 +114,13 @@ static double transfiniteHex(double f1, double f2, double f3, double f4,
          (1 - u) * v * w * s8;
 }
 
-static MVertex *
-transfiniteHex(GRegion *gr, MVertex *f1, MVertex *f2, MVertex *f3, MVertex *f4,
-               MVertex *f5, MVertex *f6, MVertex *c1, MVertex *c2, MVertex *c3,
-               MVertex *c4, MVertex *c5, MVertex *c6, MVertex *c7, MVertex *c8,
-               MVertex *c9, MVertex *c10, MVertex *c11, MVertex *c12,
-               MVertex *s1, MVertex *s2, MVertex *s3, MVertex *s4, MVertex *s5,
-               MVertex *s6, MVertex *s7, MVertex *s8, double u, double v,
-               double w)
+static SPoint3
+transfiniteHex(MVertex *f1, MVertex *f2, MVertex *f3, MVertex *f4, MVertex *f5,
+               MVertex *f6, MVertex *c1, MVertex *c2, MVertex *c3, MVertex *c4,
+               MVertex *c5, MVertex *c6, MVertex *c7, MVertex *c8, MVertex *c9,
+               MVertex *c10, MVertex *c11, MVertex *c12, MVertex *s1,
+               MVertex *s2, MVertex *s3, MVertex *s4, MVertex *s5, MVertex *s6,
+               MVertex *s7, MVertex *s8, double u, double v, double w)
 {
   double x = transfiniteHex(
     f1->x(), f2->x(), f3->x(), f4->x(), f5->x(), f6->x(), c1->x(), c2->x(),
@@ -137,7 +137,7 @@ transfiniteHex(GRegion *gr, MVertex *f1, MVertex *f2, MVertex *f3, MVertex *f4,
     c3->z(), c4->z(), c5->z(), c6->z(), c7->z(), c8->z(), c9->z(), c10->z(),
     c11->z(), c12->z(), s1->z(), s2->z(), s3->z(), s4->z(), s5->z(), s6->z(),
     s7->z(), s8->z(), u, v, w);
-  return new MVertex(x, y, z, gr);
+  return SPoint3(x, y, z);
 }
 
 class GOrientedTransfiniteFace {
@@ -412,6 +412,12 @@ int MeshTransfiniteVolume(GRegion *gr)
     }
   }
 
+  // the positions of the interior nodes are computed in parallel, then the
+  // nodes are created in order
+  std::vector<SPoint3> xyz(N_i * N_j * N_k);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
   for(int i = 0; i < N_i; i++) {
     double u = lengths_i[i] / L_i;
 
@@ -449,11 +455,9 @@ int MeshTransfiniteVolume(GRegion *gr)
           f3 = c8;
 
         if(i && j && k && i != N_i - 1 && j != N_j - 1 && k != N_k - 1) {
-          MVertex *newv = transfiniteHex(
-            gr, f0, f1, f2, f3, f4, f5, c0, c1, c2, c3, c4, c5, c6, c7, c8, c9,
+          xyz[(i * N_j + j) * N_k + k] = transfiniteHex(
+            f0, f1, f2, f3, f4, f5, c0, c1, c2, c3, c4, c5, c6, c7, c8, c9,
             c10, c11, s0, s1, s2, s3, s4, s5, s6, s7, u, v, w);
-          gr->mesh_vertices.push_back(newv);
-          tab[i][j][k] = newv;
         }
         else if(!i) {
           tab[i][j][k] = f3;
@@ -477,6 +481,20 @@ int MeshTransfiniteVolume(GRegion *gr)
     }
   }
 
+  gr->mesh_vertices.reserve(gr->mesh_vertices.size() +
+                            std::max(N_i - 2, 0) * std::max(N_j - 2, 0) *
+                              std::max(N_k - 2, 0));
+  for(int i = 1; i < N_i - 1; i++) {
+    for(int j = 1; j < N_j - 1; j++) {
+      for(int k = 1; k < N_k - 1; k++) {
+        SPoint3 &p = xyz[(i * N_j + j) * N_k + k];
+        MVertex *newv = new MVertex(p.x(), p.y(), p.z(), gr);
+        gr->mesh_vertices.push_back(newv);
+        tab[i][j][k] = newv;
+      }
+    }
+  }
+
 #if defined(HAVE_QUADTRI)
   // for QuadTri, get external boundary diagonals for element subdivision
   // purposes
@@ -39,7 +39,7 @@ meshMetric::meshMetric(GModel *gm)
     }
   }
   _octree = new MElementOctree(_elements);
-  buildVertexToElement(_elements, _adj);
+  buildAdjacency();
 }
 
 meshMetric::meshMetric(std::vector<MElement *> elements)
@@ -57,7 +57,31 @@ meshMetric::meshMetric(std::vector<MElement *> elements)
   }
 
   _octree = new MElementOctree(_elements);
-  buildVertexToElement(_elements, _adj);
+  buildAdjacency();
+}
+
+void meshMetric::buildAdjacency()
+{
+  // the vertices are copies owned by the metric, so that their index can be
+  // used freely; _vertexMap is sorted by vertex number
+  _vertices.clear();
+  for(std::map<int, MVertex *>::iterator it = _vertexMap.begin();
+      it != _vertexMap.end(); ++it)
+    _vertices.push_back(it->second);
+  for(std::size_t i = 0; i < _vertices.size(); i++)
+    _vertices[i]->setIndex(i);
+
+  _adjRow.assign(_vertices.size() + 1, 0);
+  for(std::size_t i = 0; i < _elements.size(); i++)
+    for(std::size_t j = 0; j < _elements[i]->getNumVertices(); j++)
+      _adjRow[_elements[i]->getVertex(j)->getIndex() + 1]++;
+  for(std::size_t i = 0; i < _vertices.size(); i++)
+    _adjRow[i + 1] += _adjRow[i];
+  _adjElements.resize(_adjRow.back());
+  std::vector<std::size_t> pos(_adjRow.begin(), _adjRow.end() - 1);
+  for(std::size_t i = 0; i < _elements.size(); i++)
+    for(std::size_t j = 0; j < _elements[i]->getNumVertices(); j++)
+      _adjElements[pos[_elements[i]->getVertex(j)->getIndex()]++] = i;
 }
 
 void meshMetric::addMetric(int technique, simpleFunction<double> *fct,
@@ -82,9 +106,8 @@ void meshMetric::updateMetrics()
     return;
   }
 
-  v2t_cont ::iterator it = _adj.begin();
-  for(; it != _adj.end(); it++) {
-    MVertex *ver = it->first;
+  for(std::size_t iv = 0; iv < _vertices.size(); iv++) {
+    MVertex *ver = _vertices[iv];
     _nodalMetrics[ver] = setOfMetrics[0][ver];
     _nodalSizes[ver] = setOfSizes[0][ver];
 
@@ -162,9 +185,10 @@ void meshMetric::exportInfo(const char *fileendname)
     }
     for(std::size_t i = 0; i < e->getNumVertices(); i++) {
       MVertex *ver = e->getVertex(i);
-      out_ls << vals[ver];
-      out_hess << (hessians[ver](0, 0) + hessians[ver](1, 1) +
-                   hessians[ver](2, 2));
+      const std::size_t iv = ver->getIndex();
+      out_ls << vals[iv];
+      out_hess << (hessians[iv](0, 0) + hessians[iv](1, 1) +
+                   hessians[iv](2, 2));
       if(i == (e->getNumVertices() - 1)) {
         out_ls << "};" << std::endl;
         out_hess << "};" << std::endl;
@@ -174,14 +198,14 @@ void meshMetric::exportInfo(const char *fileendname)
         out_hess << ",";
       }
       for(int k = 0; k < 3; k++) {
-        out_grad << grads[ver](k);
+        out_grad << grads[iv](k);
         if((k == 2) && (i == (e->getNumVertices() - 1)))
           out_grad << "};" << std::endl;
         else
           out_grad << ",";
         for(int l = 0; l < 3; l++) {
           out_metric << _nodalMetrics[ver](k, l);
-          out_hessmat << hessians[ver](k, l);
+          out_hessmat << hessians[iv](k, l);
           if((k == 2) && (l == 2) && (i == (e->getNumVertices() - 1))) {
             out_metric << "};" << std::endl;
             out_hessmat << "};" << std::endl;
@@ -214,59 +238,65 @@ meshMetric::~meshMetric()
 
 void meshMetric::computeValues()
 {
-  v2t_cont ::iterator it = _adj.begin();
-  while(it != _adj.end()) {
-    std::vector<MElement *> lt = it->second;
-    MVertex *ver = it->first;
-    vals[ver] = (*_fct)(ver->x(), ver->y(), ver->z());
-    it++;
+  // the function is evaluated serially, as it is not necessarily thread-safe
+  // (e.g. functions based on post-processing views or element data)
+  vals.resize(_vertices.size());
+  for(std::size_t iv = 0; iv < _vertices.size(); iv++) {
+    MVertex *ver = _vertices[iv];
+    vals[iv] = (*_fct)(ver->x(), ver->y(), ver->z());
   }
 }
 
-// Determines set of vertices to use for least squares
-std::vector<MVertex *> getLSBlob(std::size_t minNbPt, v2t_cont::iterator it,
-                                 v2t_cont &adj)
+// Per-thread workspace for the least squares fits, reused from one vertex to
+// the next
+class lsWorkspace {
+public:
+  std::vector<std::size_t> blob, ring;
+  std::vector<int> mark; // mark[i] == stamp if vertex i is in the blob
+  int stamp;
+  fullMatrix<double> ATA;
+  fullVector<double> ATb, coeffs;
+  std::vector<double> row;
+  lsWorkspace(std::size_t numVertices, std::size_t sysDim)
+    : mark(numVertices, 0), stamp(0), ATA(sysDim, sysDim), ATb(sysDim),
+      coeffs(sysDim), row(sysDim)
+  {
+  }
+};
+
+// Determines set of vertices to use for least squares: starting from vertex
+// iv, add rings of neighboring vertices (each ring sorted by vertex index)
+// until the minimum number of points is reached
+static void getLSBlob(std::size_t minNbPt, std::size_t iv,
+                      const std::vector<MElement *> &elements,
+                      const std::vector<std::size_t> &adjRow,
+                      const std::vector<std::size_t> &adjElements,
+                      lsWorkspace &w)
 {
-  //  static const double RADFACT = 3;
-  //
-  //  SPoint3 p0 = it->first->point();  // Vertex coordinates (center of circle)
-  //
-  //  double rad = 0.;
-  //  for (std::vector<MElement*>::iterator itEl = it->second.begin(); itEl !=
-  //  it->second.end(); itEl++)
-  //    rad = std::max(rad,(*itEl)->getOuterRadius());
-  //  rad *= RADFACT;
-
-  std::vector<MVertex *> vv(1, it->first),
-    bvv = vv; // Vector of vertices in blob and in boundary of blob
-  do {
-    std::set<MVertex *> nbvv; // Set of vertices in new boundary
-    for(std::vector<MVertex *>::iterator itBV = bvv.begin(); itBV != bvv.end();
-        itBV++) { // For each boundary vertex...
-      std::vector<MElement *> &adjBV = adj[*itBV];
-      for(std::vector<MElement *>::iterator itBVEl = adjBV.begin();
-          itBVEl != adjBV.end(); itBVEl++) {
-        for(std::size_t iV = 0; iV < (*itBVEl)->getNumVertices();
-            iV++) { // ... look for adjacent vertices...
-          MVertex *v = (*itBVEl)->getVertex(iV);
-          //          if ((find(vv.begin(),vv.end(),v) == vv.end()) &&
-          //          (p0.distance(v->point()) <= rad)) nbvv.insert(v);
-          if(find(vv.begin(), vv.end(), v) == vv.end())
-            nbvv.insert(v); // ... and add them in the new boundary if they are
-                            // not already in the blob
+  w.stamp++;
+  w.blob.assign(1, iv);
+  w.mark[iv] = w.stamp;
+  std::size_t first = 0; // the last ring is blob[first...]
+  while(w.blob.size() < minNbPt) {
+    w.ring.clear();
+    for(std::size_t i = first; i < w.blob.size(); i++) {
+      const std::size_t bv = w.blob[i];
+      for(std::size_t j = adjRow[bv]; j < adjRow[bv + 1]; j++) {
+        MElement *e = elements[adjElements[j]];
+        for(std::size_t k = 0; k < e->getNumVertices(); k++) {
+          const std::size_t v = e->getVertex(k)->getIndex();
+          if(w.mark[v] != w.stamp) {
+            w.mark[v] = w.stamp;
+            w.ring.push_back(v);
+          }
         }
       }
     }
-    if(nbvv.empty())
-      bvv.clear();
-    else {
-      bvv.assign(nbvv.begin(), nbvv.end());
-      vv.insert(vv.end(), nbvv.begin(), nbvv.end());
-    }
-    //  } while (!bvv.empty());
-  } while(vv.size() < minNbPt); // Repeat until min. number of points is reached
-
-  return vv;
+    if(w.ring.empty()) break; // not enough vertices in the mesh
+    std::sort(w.ring.begin(), w.ring.end());
+    first = w.blob.size();
+    w.blob.insert(w.blob.end(), w.ring.begin(), w.ring.end());
+  }
 }
 
 // Compute derivatives and second order derivatives using least squares
@@ -275,80 +305,100 @@ std::vector<MVertex *> getLSBlob(std::size_t minNbPt, v2t_cont::iterator it,
 // a_i0*x^2+a_i1*x*y+a_i2*x*z+a_i3*y^2+a_i4*y*z+a_i5*z^2+a_i6*x+a_i7*y+a_i8*z+a_i9=b_i
 void meshMetric::computeHessian()
 {
-  std::size_t sysDim = (_dim == 2) ? 6 : 10;
-  std::size_t minNbPtBlob = 3 * sysDim;
-
-  for(v2t_cont::iterator it = _adj.begin(); it != _adj.end(); it++) {
-    MVertex *ver = it->first;
-    std::vector<MVertex *> vv = getLSBlob(minNbPtBlob, it, _adj);
-    fullMatrix<double> A(vv.size(), sysDim), ATA(sysDim, sysDim);
-    fullVector<double> b(vv.size()), ATb(sysDim), coeffs(sysDim);
-    for(std::size_t i = 0; i < vv.size(); i++) {
-      const double &x = vv[i]->x(), &y = vv[i]->y(), &z = vv[i]->z();
+  const std::size_t sysDim = (_dim == 2) ? 6 : 10;
+  const std::size_t minNbPtBlob = 3 * sysDim;
+  const std::size_t n = _vertices.size();
+  grads.resize(n);
+  hessians.resize(n);
+
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    // the normal equations are accumulated directly in the (small) workspace
+    // matrices, without assembling the rectangular least squares system
+    lsWorkspace w(n, sysDim);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 256)
+#endif
+    for(std::size_t iv = 0; iv < n; iv++) {
+      MVertex *ver = _vertices[iv];
+      getLSBlob(minNbPtBlob, iv, _elements, _adjRow, _adjElements, w);
+      w.ATA.setAll(0.);
+      w.ATb.setAll(0.);
+      for(std::size_t i = 0; i < w.blob.size(); i++) {
+        MVertex *v = _vertices[w.blob[i]];
+        const double &x = v->x(), &y = v->y(), &z = v->z();
+        std::vector<double> &a = w.row;
+        if(_dim == 2) {
+          a[0] = x * x;
+          a[1] = x * y;
+          a[2] = y * y;
+          a[3] = x;
+          a[4] = y;
+          a[5] = 1.;
+        }
+        else {
+          a[0] = x * x;
+          a[1] = x * y;
+          a[2] = x * z;
+          a[3] = y * y;
+          a[4] = y * z;
+          a[5] = z * z;
+          a[6] = x;
+          a[7] = y;
+          a[8] = z;
+          a[9] = 1.;
+        }
+        const double b = vals[w.blob[i]];
+        for(std::size_t k = 0; k < sysDim; k++) {
+          for(std::size_t l = 0; l < sysDim; l++) w.ATA(k, l) += a[k] * a[l];
+          w.ATb(k) += a[k] * b;
+        }
+      }
+      w.ATA.luSolve(w.ATb, w.coeffs);
+      const fullVector<double> &coeffs = w.coeffs;
+      const double &x = ver->x(), &y = ver->y(), &z = ver->z();
+      double d2udx2, d2udy2, d2udz2, d2udxy, d2udxz, d2udyz, dudx, dudy, dudz;
       if(_dim == 2) {
-        A(i, 0) = x * x;
-        A(i, 1) = x * y;
-        A(i, 2) = y * y;
-        A(i, 3) = x;
-        A(i, 4) = y;
-        A(i, 5) = 1.;
+        d2udx2 = 2. * coeffs(0);
+        d2udy2 = 2. * coeffs(2);
+        d2udz2 = 0.;
+        d2udxy = coeffs(1);
+        d2udxz = 0.;
+        d2udyz = 0.;
+        dudx = d2udx2 * x + d2udxy * y + coeffs(3);
+        dudy = d2udxy * x + d2udy2 * y + coeffs(4);
+        dudz = 0.;
       }
       else {
-        A(i, 0) = x * x;
-        A(i, 1) = x * y;
-        A(i, 2) = x * z;
-        A(i, 3) = y * y;
-        A(i, 4) = y * z;
-        A(i, 5) = z * z;
-        A(i, 6) = x;
-        A(i, 7) = y;
-        A(i, 8) = z;
-        A(i, 9) = 1.;
+        d2udx2 = 2. * coeffs(0);
+        d2udy2 = 2. * coeffs(3);
+        d2udz2 = 2. * coeffs(5);
+        d2udxy = coeffs(1);
+        d2udxz = coeffs(2);
+        d2udyz = coeffs(4);
+        dudx = d2udx2 * x + d2udxy * y + d2udxz * z + coeffs(6);
+        dudy = d2udxy * x + d2udy2 * y + d2udyz * z + coeffs(7);
+        dudz = d2udxz * x + d2udyz * y + d2udz2 * z + coeffs(8);
       }
-      b(i) = vals[vv[i]];
+      double duNorm = sqrt(dudx * dudx + dudy * dudy + dudz * dudz);
+      if(duNorm == 0. || _technique == meshMetric::HESSIAN ||
+         _technique == meshMetric::EIGENDIRECTIONS ||
+         _technique == meshMetric::EIGENDIRECTIONS_LINEARINTERP_H)
+        duNorm = 1.;
+      grads[iv] = SVector3(dudx / duNorm, dudy / duNorm, dudz / duNorm);
+      SMetric3 &h = hessians[iv];
+      h(0, 0) = d2udx2;
+      h(0, 1) = d2udxy;
+      h(0, 2) = d2udxz;
+      h(1, 0) = d2udxy;
+      h(1, 1) = d2udy2;
+      h(1, 2) = d2udyz;
+      h(2, 0) = d2udxz;
+      h(2, 1) = d2udyz;
+      h(2, 2) = d2udz2;
     }
-    ATA.gemm(A, A, 1., 0., true, false);
-    A.multWithATranspose(b, 1., 0., ATb);
-    ATA.luSolve(ATb, coeffs);
-    const double &x = ver->x(), &y = ver->y(), &z = ver->z();
-    double d2udx2, d2udy2, d2udz2, d2udxy, d2udxz, d2udyz, dudx, dudy, dudz;
-    if(_dim == 2) {
-      d2udx2 = 2. * coeffs(0);
-      d2udy2 = 2. * coeffs(2);
-      d2udz2 = 0.;
-      d2udxy = coeffs(1);
-      d2udxz = 0.;
-      d2udyz = 0.;
-      dudx = d2udx2 * x + d2udxy * y + coeffs(3);
-      dudy = d2udxy * x + d2udy2 * y + coeffs(4);
-      dudz = 0.;
-    }
-    else {
-      d2udx2 = 2. * coeffs(0);
-      d2udy2 = 2. * coeffs(3);
-      d2udz2 = 2. * coeffs(5);
-      d2udxy = coeffs(1);
-      d2udxz = coeffs(2);
-      d2udyz = coeffs(4);
-      dudx = d2udx2 * x + d2udxy * y + d2udxz * z + coeffs(6);
-      dudy = d2udxy * x + d2udy2 * y + d2udyz * z + coeffs(7);
-      dudz = d2udxz * x + d2udyz * y + d2udz2 * z + coeffs(8);
-    }
-    double duNorm = sqrt(dudx * dudx + dudy * dudy + dudz * dudz);
-    if(duNorm == 0. || _technique == meshMetric::HESSIAN ||
-       _technique == meshMetric::EIGENDIRECTIONS ||
-       _technique == meshMetric::EIGENDIRECTIONS_LINEARINTERP_H)
-      duNorm = 1.;
-    grads[ver] = SVector3(dudx / duNorm, dudy / duNorm, dudz / duNorm);
-    hessians[ver](0, 0) = d2udx2;
-    hessians[ver](0, 1) = d2udxy;
-    hessians[ver](0, 2) = d2udxz;
-    hessians[ver](1, 0) = d2udxy;
-    hessians[ver](1, 1) = d2udy2;
-    hessians[ver](1, 2) = d2udyz;
-    hessians[ver](2, 0) = d2udxz;
-    hessians[ver](2, 1) = d2udyz;
-    hessians[ver](2, 2) = d2udz2;
   }
 }
 
@@ -359,9 +409,9 @@ void meshMetric::computeMetricLevelSet(MVertex *ver, SMetric3 &hessian,
   double signed_dist;
   SVector3 gr;
   if(ver) {
-    signed_dist = vals[ver];
-    gr = grads[ver];
-    hessian = hessians[ver];
+    signed_dist = vals[ver->getIndex()];
+    gr = grads[ver->getIndex()];
+    hessian = hessians[ver->getIndex()];
   }
   else {
     signed_dist = (*_fct)(x, y, z);
@@ -410,8 +460,8 @@ void meshMetric::computeMetricHessian(MVertex *ver, SMetric3 &hessian,
 {
   SVector3 gr;
   if(ver != NULL) {
-    gr = grads[ver];
-    hessian = hessians[ver];
+    gr = grads[ver->getIndex()];
+    hessian = hessians[ver->getIndex()];
   }
   else if(ver == NULL) {
     _fct->gradient(x, y, z, gr(0), gr(1), gr(2));
@@ -457,9 +507,9 @@ void meshMetric::computeMetricFrey(MVertex *ver, SMetric3 &hessian,
   double signed_dist;
   SVector3 gr;
   if(ver) {
-    signed_dist = vals[ver];
-    gr = grads[ver];
-    hessian = hessians[ver];
+    signed_dist = vals[ver->getIndex()];
+    gr = grads[ver->getIndex()];
+    hessian = hessians[ver->getIndex()];
   }
   else {
     signed_dist = (*_fct)(x, y, z);
@@ -522,9 +572,9 @@ void meshMetric::computeMetricEigenDir(MVertex *ver, SMetric3 &hessian,
   double signed_dist;
   SVector3 gVec;
   if(ver) {
-    signed_dist = vals[ver];
-    gVec = grads[ver];
-    hessian = hessians[ver];
+    signed_dist = vals[ver->getIndex()];
+    gVec = grads[ver->getIndex()];
+    hessian = hessians[ver->getIndex()];
   }
   else {
     signed_dist = (*_fct)(x, y, z);
@@ -656,9 +706,9 @@ void meshMetric::computeMetricIsoLinInterp(MVertex *ver, SMetric3 &hessian,
   double signed_dist;
   SVector3 gr;
   if(ver) {
-    signed_dist = vals[ver];
-    gr = grads[ver];
-    hessian = hessians[ver];
+    signed_dist = vals[ver->getIndex()];
+    gr = grads[ver->getIndex()];
+    hessian = hessians[ver->getIndex()];
   }
   else {
     signed_dist = (*_fct)(x, y, z);
@@ -766,10 +816,16 @@ void meshMetric::computeMetric(int metricNumber)
   computeValues();
   computeHessian();
 
-  for(v2t_cont::iterator it = _adj.begin(); it != _adj.end(); it++) {
-    MVertex *ver = it->first;
-    SMetric3 hessian, metric;
-    double size;
+  const std::size_t n = _vertices.size();
+  std::vector<SMetric3> metrics(n);
+  std::vector<double> sizes(n);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(std::size_t iv = 0; iv < n; iv++) {
+    MVertex *ver = _vertices[iv];
+    SMetric3 hessian, &metric = metrics[iv];
+    double &size = sizes[iv];
     switch(_technique) {
     case(LEVELSET): computeMetricLevelSet(ver, hessian, metric, size); break;
     case(HESSIAN): computeMetricHessian(ver, hessian, metric, size); break;
@@ -784,9 +840,12 @@ void meshMetric::computeMetric(int metricNumber)
       computeMetricIsoLinInterp(ver, hessian, metric, size);
       break;
     }
+  }
 
-    setOfSizes[metricNumber].insert(std::make_pair(ver, size));
-    setOfMetrics[metricNumber].insert(std::make_pair(ver, metric));
+  for(std::size_t iv = 0; iv < n; iv++) {
+    setOfSizes[metricNumber].insert(std::make_pair(_vertices[iv], sizes[iv]));
+    setOfMetrics[metricNumber].insert(
+      std::make_pair(_vertices[iv], metrics[iv]));
   }
 
   if(_technique == HESSIAN) scaleMetric(_epsilon, setOfMetrics[metricNumber]);
@@ -944,15 +1003,12 @@ void meshMetric::operator()(double x, double y, double z, SMetric3 &metr,
 double meshMetric::getLaplacian(MVertex *v)
 {
   MVertex *vNew = _vertexMap[v->getNum()];
-  std::map<MVertex *, SMetric3>::const_iterator it = hessians.find(vNew);
-  SMetric3 h = it->second;
+  const SMetric3 &h = hessians[vNew->getIndex()];
   return h(0, 0) + h(1, 1) + h(2, 2);
 }
 
 SVector3 meshMetric::getGradient(MVertex *v)
 {
   MVertex *vNew = _vertexMap[v->getNum()];
-  std::map<MVertex *, SVector3>::const_iterator it = grads.find(vNew);
-  SVector3 gr = it->second;
-  return gr;
+  return grads[vNew->getIndex()];
 }
@@ -43,13 +43,21 @@ private:
   simpleFunction<double> *_fct;
 
   std::vector<MElement *> _elements;
-  v2t_cont _adj;
   MElementOctree *_octree;
   std::map<int, MVertex *> _vertexMap;
 
-  std::map<MVertex *, double> vals;
-  std::map<MVertex *, SVector3> grads;
-  std::map<MVertex *, SMetric3> hessians;
+  // vertices (sorted by number; the index of each vertex is its position in
+  // the vector) and vertex-to-element adjacency in compressed row storage: the
+  // elements adjacent to vertex i are _elements[_adjElements[j]], for
+  // _adjRow[i] <= j < _adjRow[i + 1]
+  std::vector<MVertex *> _vertices;
+  std::vector<std::size_t> _adjRow, _adjElements;
+  void buildAdjacency();
+
+  // function values, gradients and hessians, indexed by vertex index
+  std::vector<double> vals;
+  std::vector<SVector3> grads;
+  std::vector<SMetric3> hessians;
 
 public:
   typedef std::map<MVertex *, SMetric3> nodalMetricTensor;
@@ -14,10 +14,13 @@
 #include <stack>
 #include <cstdlib>
 #include <map>
+#include <iterator>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "GModel.h"
 #include "ElementType.h"
+#include "MPoint.h"
+#include "meshPartition.h"
 
 struct OriGEntityPtrFullLessThan {
   bool operator()(const std::pair<int, GEntity *> &p1,
@@ -44,34 +47,84 @@ typedef std::set<std::pair<int, GEntity *>, OriGEntityPtrFullLessThan>
   std::unordered_map<MElement *, GEntity *, MElementPtrHash, MElementPtrEqual>
 #define hashmapelementpart                                                     \
   std::unordered_map<MElement *, int, MElementPtrHash, MElementPtrEqual>
-#define hashmapface                                                            \
-  std::unordered_map<MFace,                                                    \
-                     std::vector<std::pair<MElement *, std::vector<int> > >,   \
-                     MFaceHash, MFaceEqual>
-#define hashmapedge                                                            \
-  std::unordered_map<MEdge,                                                    \
-                     std::vector<std::pair<MElement *, std::vector<int> > >,   \
-                     MEdgeHash, MEdgeEqual>
-#define hashmapvertex                                                          \
-  std::unordered_map<MVertex *,                                                \
-                     std::vector<std::pair<MElement *, std::vector<int> > >,   \
-                     MVertexPtrHash, MVertexPtrEqual>
 #else
 #define hashmap std::map
 #define hashmapentity std::map<GEntity *, setorientity, GEntityPtrFullLessThan>
 #define hashmapelement std::map<MElement *, GEntity *, MElementPtrLessThan>
 #define hashmapelementpart std::map<MElement *, int, MElementPtrLessThan>
-#define hashmapface                                                            \
-  std::map<MFace, std::vector<std::pair<MElement *, std::vector<int> > >,      \
-           MFaceLessThan>
-#define hashmapedge                                                            \
-  std::map<MEdge, std::vector<std::pair<MElement *, std::vector<int> > >,      \
-           MEdgeLessThan>
-#define hashmapvertex                                                          \
-  std::map<MVertex *, std::vector<std::pair<MElement *, std::vector<int> > >,  \
-           MVertexPtrLessThan>
 #endif
 
+// Rules defining the partition topology, shared with the streaming of
+// partitioned mesh files (see _writePartitionedMSH4Streaming() in
+// GModelIO_MSH4.cpp), which computes the same topology without creating
+// partition entities
+
+int getPartitionBoundaryReference(
+  const std::vector<const std::vector<int> *> &partitions,
+  std::vector<int> &boundaryPartitions)
+{
+  boundaryPartitions.clear();
+  bool same = true;
+  std::size_t ref = 0;
+  for(std::size_t i = 0; i < partitions.size(); i++) {
+    const std::vector<int> &pi = *partitions[i];
+    const std::vector<int> &pr = *partitions[ref];
+    boundaryPartitions.insert(boundaryPartitions.end(), pi.begin(), pi.end());
+    if(pi != *partitions[0]) same = false;
+    // take the element having the fewest partitions in common, e.g. (1,2) or
+    // (3,8) rather than (2,5,9) or (1,4,5,7), then the lowest ones
+    if(pi.size() < pr.size() || (pi.size() == pr.size() && pi < pr)) ref = i;
+  }
+  std::sort(boundaryPartitions.begin(), boundaryPartitions.end());
+  boundaryPartitions.erase(
+    std::unique(boundaryPartitions.begin(), boundaryPartitions.end()),
+    boundaryPartitions.end());
+  if(same || boundaryPartitions.size() < 2) return -1;
+  return ref;
+}
+
+int getPartitionBoundaryFacet(MElement *e, int dim, int facet,
+                              std::vector<MVertex *> &verts)
+{
+  verts.clear();
+  int parentType;
+  if(dim == 2) {
+    e->getFaceVertices(facet, verts);
+    parentType =
+      (e->getFace(facet).getNumVertices() == 3) ? TYPE_TRI : TYPE_QUA;
+  }
+  else if(dim == 1) {
+    e->getEdgeVertices(facet, verts);
+    parentType = TYPE_LIN;
+  }
+  else {
+    verts.push_back(e->getVertex(facet));
+    return MSH_PNT;
+  }
+  int order = e->getPolynomialOrder();
+  int type = ElementType::getType(parentType, order, false);
+  if(ElementType::getNumVertices(type) != (int)verts.size())
+    type = ElementType::getType(parentType, order, true);
+  return type;
+}
+
+MElement *createPartitionBoundaryElement(MElement *e, int dim, int facet)
+{
+  std::vector<MVertex *> verts;
+  int type = getPartitionBoundaryFacet(e, dim, facet, verts);
+  if(type == MSH_PNT) return new MPoint(verts[0]);
+  return MElementFactory().create(type, verts);
+}
+
+int getPartitionBoundaryOrientation(MElement *e, int dim, int facet,
+                                    const std::vector<MVertex *> &verts)
+{
+  if(dim == 0) return (facet == 0) ? 1 : (facet == 1) ? -1 : 0;
+  std::vector<MVertex *> facetVerts;
+  getPartitionBoundaryFacet(e, dim, facet, facetVerts);
+  return (facetVerts == verts) ? 1 : -1;
+}
+
 #if defined(HAVE_METIS)
 
 #include "OS.h"
@@ -93,7 +146,6 @@ typedef std::set<std::pair<int, GEntity *>, OriGEntityPtrFullLessThan>
 #include "MPyramid.h"
 #include "MTrihedron.h"
 #include "MElementCut.h"
-#include "MPoint.h"
 
 extern "C" {
 #include <metis.h>
@@ -289,6 +341,44 @@ public:
       }
     }
   }
+  // Compute the neighbors of the ith element in the dual graph, in the order
+  // in which they are encountered through the nodes of the element
+  void getDualGraphNeighbors(std::size_t i, bool connectedAll,
+                             const std::vector<idx_t> &nptr,
+                             const std::vector<idx_t> &nind,
+                             std::vector<std::pair<idx_t, idx_t> > &candidates,
+                             std::vector<idx_t> &nbrs) const
+  {
+    candidates.clear();
+    nbrs.clear();
+    idx_t pos = 0;
+    for(idx_t j = _eptr[i]; j < _eptr[i + 1]; j++) {
+      for(idx_t k = nptr[_eind[j]]; k < nptr[_eind[j] + 1]; k++) {
+        if(nind[k] != (idx_t)i)
+          candidates.push_back(std::pair<idx_t, idx_t>(nind[k], pos++));
+      }
+    }
+    // the number of occurrences of a neighbor is its number of common nodes
+    // with the element
+    std::sort(candidates.begin(), candidates.end());
+    std::size_t m = 0;
+    for(std::size_t a = 0; a < candidates.size();) {
+      std::size_t b = a + 1;
+      while(b < candidates.size() &&
+            candidates[b].first == candidates[a].first)
+        b++;
+      const idx_t nbr = candidates[a].first, first = candidates[a].second;
+      if(b - a >= (std::size_t)(
+                    connectedAll ?
+                      1 :
+                      _element[i]->numCommonNodesInDualGraph(_element[nbr])))
+        candidates[m++] = std::pair<idx_t, idx_t>(first, nbr);
+      a = b;
+    }
+    candidates.resize(m);
+    std::sort(candidates.begin(), candidates.end());
+    for(std::size_t j = 0; j < m; j++) nbrs.push_back(candidates[j].second);
+  }
   void createDualGraph(bool connectedAll)
   {
     std::vector<idx_t> nptr(_nn + 1, 0);
@@ -311,68 +401,43 @@ public:
     for(std::size_t i = _nn; i > 0; i--) nptr[i] = nptr[i - 1];
     nptr[0] = 0;
 
+    // the adjacency of each element only depends on the (read-only) node to
+    // element map: count the neighbors, then fill the adjacency, in parallel
     _xadj = new idx_t[_ne + 1];
-    for(std::size_t i = 0; i < _ne + 1; i++) _xadj[i] = 0;
-
-    std::vector<idx_t> nbrs(_ne, 0);
-    std::vector<idx_t> marker(_ne, 0);
-    for(std::size_t i = 0; i < _ne; i++) {
-      std::size_t l = 0;
-      for(idx_t j = _eptr[i]; j < _eptr[i + 1]; j++) {
-        for(idx_t k = nptr[_eind[j]]; k < nptr[_eind[j] + 1]; k++) {
-          if(nind[k] != (idx_t)i) {
-            if(marker[nind[k]] == 0) nbrs[l++] = nind[k];
-            marker[nind[k]]++;
-          }
-        }
-      }
-
-      std::size_t nbrsNeighbors = 0;
-      for(std::size_t j = 0; j < l; j++) {
-        if(marker[nbrs[j]] >=
-           (connectedAll ?
-              1 :
-              _element[i]->numCommonNodesInDualGraph(_element[nbrs[j]])))
-          nbrsNeighbors++;
-        marker[nbrs[j]] = 0;
-        nbrs[j] = 0;
+    _xadj[0] = 0;
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      std::vector<std::pair<idx_t, idx_t> > candidates;
+      std::vector<idx_t> nbrs;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 1024)
+#endif
+      for(std::size_t i = 0; i < _ne; i++) {
+        getDualGraphNeighbors(i, connectedAll, nptr, nind, candidates, nbrs);
+        _xadj[i + 1] = nbrs.size();
       }
-
-      _xadj[i] = nbrsNeighbors;
     }
 
-    for(std::size_t i = 1; i < _ne; i++) _xadj[i] = _xadj[i] + _xadj[i - 1];
-    for(std::size_t i = _ne; i > 0; i--) _xadj[i] = _xadj[i - 1];
-    _xadj[0] = 0;
+    for(std::size_t i = 1; i <= _ne; i++) _xadj[i] += _xadj[i - 1];
 
     _adjncy = new idx_t[_xadj[_ne]];
-    for(idx_t i = 0; i < _xadj[_ne]; i++) _adjncy[i] = 0;
-
-    for(std::size_t i = 0; i < _ne; i++) {
-      std::size_t l = 0;
-      for(idx_t j = _eptr[i]; j < _eptr[i + 1]; j++) {
-        for(idx_t k = nptr[_eind[j]]; k < nptr[_eind[j] + 1]; k++) {
-          if(nind[k] != (idx_t)i) {
-            if(marker[nind[k]] == 0) nbrs[l++] = nind[k];
-            marker[nind[k]]++;
-          }
-        }
-      }
-
-      for(std::size_t j = 0; j < l; j++) {
-        if(marker[nbrs[j]] >=
-           (connectedAll ?
-              1 :
-              _element[i]->numCommonNodesInDualGraph(_element[nbrs[j]]))) {
-          _adjncy[_xadj[i]] = nbrs[j];
-          _xadj[i] = _xadj[i] + 1;
-        }
-        marker[nbrs[j]] = 0;
-        nbrs[j] = 0;
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      std::vector<std::pair<idx_t, idx_t> > candidates;
+      std::vector<idx_t> nbrs;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 1024)
+#endif
+      for(std::size_t i = 0; i < _ne; i++) {
+        getDualGraphNeighbors(i, connectedAll, nptr, nind, candidates, nbrs);
+        for(std::size_t j = 0; j < nbrs.size(); j++)
+          _adjncy[_xadj[i] + j] = nbrs[j];
       }
     }
-    for(std::size_t i = _ne; i > 0; i--) _xadj[i] = _xadj[i - 1];
-    _xadj[0] = 0;
   }
   void fillDefaultWeights()
   {
@@ -489,88 +554,42 @@ static std::size_t getSizeOfEind(GModel *model)
   return size;
 }
 
+template <class ITERATOR>
+static void addElementsToGraph(std::vector<MElement *> &elements,
+                               std::vector<std::size_t> &eptr, ITERATOR it_beg,
+                               ITERATOR it_end)
+{
+  for(ITERATOR it = it_beg; it != it_end; ++it) {
+    elements.push_back(*it);
+    eptr.push_back(eptr.back() + (*it)->getNumPrimaryVertices());
+  }
+}
+
 // Creates a mesh data structure used by Metis routines. Returns: 0 = success, 1
 // = no elements found, 2 = error.
 static int makeGraph(GModel *model, Graph &graph, int selectDim)
 {
-  std::size_t eindSize = 0;
-  if(selectDim < 0) {
-    graph.ne(model->getNumMeshElements());
-    graph.nn(model->getNumMeshVertices());
-    graph.dim(model->getMeshDim());
-    graph.elementResize(graph.ne());
-    graph.vertexResize(model->getMaxVertexNumber());
-    graph.eptrResize(graph.ne() + 1);
-    graph.eptr(0, 0);
-    eindSize = getSizeOfEind(model);
-    graph.eindResize(eindSize);
-  }
-  else {
-    GModel *tmp = new GModel();
-    std::vector<GEntity *> entities;
-    model->getEntities(entities);
-
-    std::set<MVertex *> vertices;
-    for(std::size_t i = 0; i < entities.size(); i++) {
-      if(entities[i]->dim() == selectDim) {
-        switch(entities[i]->dim()) {
-        case 3: tmp->add(static_cast<GRegion *>(entities[i])); break;
-        case 2: tmp->add(static_cast<GFace *>(entities[i])); break;
-        case 1: tmp->add(static_cast<GEdge *>(entities[i])); break;
-        case 0: tmp->add(static_cast<GVertex *>(entities[i])); break;
-        default: break;
-        }
-        for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++) {
-          for(std::size_t k = 0;
-              k < entities[i]->getMeshElement(j)->getNumVertices(); k++) {
-            vertices.insert(entities[i]->getMeshElement(j)->getVertex(k));
-          }
-        }
-      }
-    }
-
-    graph.ne(tmp->getNumMeshElements());
-    graph.nn(vertices.size());
-    graph.dim(tmp->getMeshDim());
-    graph.elementResize(graph.ne());
-    graph.vertexResize(model->getMaxVertexNumber());
-    graph.eptrResize(graph.ne() + 1);
-    graph.eptr(0, 0);
-    eindSize = getSizeOfEind(tmp);
-    graph.eindResize(eindSize);
-
-    tmp->remove();
-    delete tmp;
-  }
-
-  idx_t eptrIndex = 0;
-  idx_t eindIndex = 0;
-  idx_t numVertex = 0;
-
-  if(graph.ne() == 0) {
-    Msg::Error("No mesh elements were found");
-    return 1;
-  }
-  if(graph.dim() == 0) {
-    Msg::Error("Cannot partition a point");
-    return 1;
-  }
+  // list the elements in the order of the entities (this order is assumed when
+  // creating the partition topology), as well as the offsets of their nodes
+  std::vector<MElement *> elements;
+  std::vector<std::size_t> eptr(1, 0);
+  int dim = 0;
 
   // Loop over volumes
   if(selectDim < 0 || selectDim == 3) {
     for(GModel::const_riter it = model->firstRegion();
         it != model->lastRegion(); ++it) {
       GRegion *r = *it;
-      fillElementsToNodesMap(graph, r, eptrIndex, eindIndex, numVertex,
-                             r->tetrahedra.begin(), r->tetrahedra.end());
-      fillElementsToNodesMap(graph, r, eptrIndex, eindIndex, numVertex,
-                             r->hexahedra.begin(), r->hexahedra.end());
-      fillElementsToNodesMap(graph, r, eptrIndex, eindIndex, numVertex,
-                             r->prisms.begin(), r->prisms.end());
-      fillElementsToNodesMap(graph, r, eptrIndex, eindIndex, numVertex,
-                             r->pyramids.begin(), r->pyramids.end());
-      fillElementsToNodesMap(graph, r, eptrIndex, eindIndex, numVertex,
-                             r->trihedra.begin(), r->trihedra.end());
+      addElementsToGraph(elements, eptr, r->tetrahedra.begin(),
+                         r->tetrahedra.end());
+      addElementsToGraph(elements, eptr, r->hexahedra.begin(),
+                         r->hexahedra.end());
+      addElementsToGraph(elements, eptr, r->prisms.begin(), r->prisms.end());
+      addElementsToGraph(elements, eptr, r->pyramids.begin(),
+                         r->pyramids.end());
+      addElementsToGraph(elements, eptr, r->trihedra.begin(),
+                         r->trihedra.end());
+      if(elements.size() && !dim) dim = 3;
     }
   }
 
@@ -579,10 +598,11 @@ static int makeGraph(GModel *model, Graph &graph, int selectDim)
     for(GModel::const_fiter it = model->firstFace(); it != model->lastFace();
         ++it) {
       GFace *f = *it;
-      fillElementsToNodesMap(graph, f, eptrIndex, eindIndex, numVertex,
-                             f->triangles.begin(), f->triangles.end());
-      fillElementsToNodesMap(graph, f, eptrIndex, eindIndex, numVertex,
-                             f->quadrangles.begin(), f->quadrangles.end());
+      addElementsToGraph(elements, eptr, f->triangles.begin(),
+                         f->triangles.end());
+      addElementsToGraph(elements, eptr, f->quadrangles.begin(),
+                         f->quadrangles.end());
+      if(elements.size() && !dim) dim = 2;
     }
   }
 
@@ -591,8 +611,8 @@ static int makeGraph(GModel *model, Graph &graph, int selectDim)
     for(GModel::const_eiter it = model->firstEdge(); it != model->lastEdge();
         ++it) {
       GEdge *e = *it;
-      fillElementsToNodesMap(graph, e, eptrIndex, eindIndex, numVertex,
-                             e->lines.begin(), e->lines.end());
+      addElementsToGraph(elements, eptr, e->lines.begin(), e->lines.end());
+      if(elements.size() && !dim) dim = 1;
     }
   }
 
@@ -601,11 +621,50 @@ static int makeGraph(GModel *model, Graph &graph, int selectDim)
     for(GModel::const_viter it = model->firstVertex();
         it != model->lastVertex(); ++it) {
       GVertex *v = *it;
-      fillElementsToNodesMap(graph, v, eptrIndex, eindIndex, numVertex,
-                             v->points.begin(), v->points.end());
+      addElementsToGraph(elements, eptr, v->points.begin(), v->points.end());
     }
   }
 
+  if(elements.empty()) {
+    Msg::Error("No mesh elements were found");
+    return 1;
+  }
+  if(dim == 0) {
+    Msg::Error("Cannot partition a point");
+    return 1;
+  }
+
+  // number the nodes of the elements (the dual graph does not depend on this
+  // numbering, so that we simply number them by increasing tag)
+  graph.vertexResize(model->getMaxVertexNumber());
+  for(std::size_t i = 0; i < elements.size(); i++) {
+    for(std::size_t j = 0; j < elements[i]->getNumPrimaryVertices(); j++)
+      graph.vertex(elements[i]->getVertex(j)->getNum() - 1, 0);
+  }
+  idx_t numVertex = 0;
+  for(std::size_t i = 0; i < model->getMaxVertexNumber(); i++) {
+    if(graph.vertex(i) == 0) graph.vertex(i, numVertex++);
+  }
+
+  graph.ne(elements.size());
+  graph.nn(numVertex);
+  graph.dim(dim);
+  graph.elementResize(graph.ne());
+  graph.eptrResize(graph.ne() + 1);
+  graph.eindResize(eptr.back());
+
+  // fill the element-to-node connectivity
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for(std::size_t i = 0; i < elements.size(); i++) {
+    MElement *e = elements[i];
+    graph.element(i, e);
+    graph.eptr(i + 1, eptr[i + 1]);
+    for(std::size_t j = 0; j < e->getNumPrimaryVertices(); j++)
+      graph.eind(eptr[i] + j, graph.vertex(e->getVertex(j)->getNum() - 1));
+  }
+
   return 0;
 }
 
@@ -1436,84 +1495,6 @@ static void fillElementToEntity(GModel *model, hashmapelement &elmToEntity,
   }
 }
 
-static MElement *getReferenceElement(
-  const std::vector<std::pair<MElement *, std::vector<int> > > &elementPairs)
-{
-  int min = std::numeric_limits<int>::max();
-  std::vector<std::pair<MElement *, std::vector<int> > > minSizeElementPairs;
-  std::vector<std::pair<MElement *, std::vector<int> > > minSizeElementPairsTmp;
-
-  // Take only the elements having the less partition in commun. For exemple we
-  // take (1,2) and (3,8) but not (2,5,9) or (1,4,5,7)
-  for(std::size_t i = 0; i < elementPairs.size(); i++) {
-    if(min > (int)elementPairs[i].second.size()) {
-      minSizeElementPairs.clear();
-      min = elementPairs[i].second.size();
-      minSizeElementPairs.push_back(elementPairs[i]);
-    }
-    else if(min == (int)elementPairs[i].second.size()) {
-      minSizeElementPairs.push_back(elementPairs[i]);
-    }
-  }
-
-  // Check if the element separated different partitions
-  if(minSizeElementPairs.size() == elementPairs.size()) {
-    bool isEqual = true;
-    for(std::size_t i = 1; i < minSizeElementPairs.size(); i++) {
-      if(minSizeElementPairs[i].second != minSizeElementPairs[0].second) {
-        isEqual = false;
-        break;
-      }
-    }
-    if(isEqual) return 0;
-  }
-
-  while(minSizeElementPairs.size() > 1) {
-    min = std::numeric_limits<int>::max();
-    for(std::size_t i = 0; i < minSizeElementPairs.size(); i++) {
-      // The partition vector is sorted thus we can check only the first element
-      if(minSizeElementPairs[i].second.size() == 0)
-        return minSizeElementPairs[0].first;
-      if(min > minSizeElementPairs[i].second[0]) {
-        min = minSizeElementPairs[i].second[0];
-      }
-    }
-
-    for(std::size_t i = 0; i < minSizeElementPairs.size(); i++) {
-      if(min == minSizeElementPairs[i].second[0]) {
-        minSizeElementPairs[i].second.erase(
-          minSizeElementPairs[i].second.begin());
-        minSizeElementPairsTmp.push_back(minSizeElementPairs[i]);
-      }
-    }
-    minSizeElementPairs.clear();
-#if __cplusplus >= 201103L
-    minSizeElementPairs = std::move(minSizeElementPairsTmp);
-#else
-    minSizeElementPairs = minSizeElementPairsTmp;
-#endif
-    minSizeElementPairsTmp.clear();
-  }
-
-  return minSizeElementPairs[0].first;
-}
-
-static void getPartitionInVector(
-  std::vector<int> &partitions,
-  const std::vector<std::pair<MElement *, std::vector<int> > > &boundaryPair)
-{
-  for(std::size_t i = 0; i < boundaryPair.size(); i++) {
-    for(std::size_t j = 0; j < boundaryPair[i].second.size(); j++) {
-      if(std::find(partitions.begin(), partitions.end(),
-                   boundaryPair[i].second[j]) == partitions.end()) {
-        partitions.push_back(boundaryPair[i].second[j]);
-      }
-    }
-  }
-
-  std::sort(partitions.begin(), partitions.end());
-}
-
 template <class PART_ENTITY, class LESS_PART_ENTITY>
 static PART_ENTITY *createPartitionEntity(
   std::pair<typename std::multimap<PART_ENTITY *, GEntity *,
@@ -1571,55 +1552,14 @@ static partitionFace *assignPartitionBoundary(
   partitionFace *ppf =
     createPartitionEntity(ret, model, numEntity, partitions,
                           elementToEntity[reference], &newEntity, pfaces);
-  int numFace = 0;
   for(int i = 0; i < reference->getNumFaces(); i++) {
     if(reference->getFace(i) == me) {
-      numFace = i;
+      MElement *e = createPartitionBoundaryElement(reference, 2, i);
+      ppf->addElement(e->getType(), e);
       break;
     }
   }
 
-  if(me.getNumVertices() == 3) {
-    std::vector<MVertex *> verts;
-    reference->getFaceVertices(numFace, verts);
-
-    if(verts.size() == 3) {
-      MTriangle *element = new MTriangle(verts);
-      ppf->addTriangle(element);
-    }
-    else if(verts.size() == 6) {
-      MTriangle6 *element = new MTriangle6(verts);
-      ppf->addTriangle(element);
-    }
-    else {
-      MTriangleN *element =
-        new MTriangleN(verts, verts.back()->getPolynomialOrder());
-      ppf->addTriangle(element);
-    }
-  }
-  else if(me.getNumVertices() == 4) {
-    std::vector<MVertex *> verts;
-    reference->getFaceVertices(numFace, verts);
-
-    if(verts.size() == 4) {
-      MQuadrangle *element = new MQuadrangle(verts);
-      ppf->addQuadrangle(element);
-    }
-    else if(verts.size() == 8) {
-      MQuadrangle8 *element = new MQuadrangle8(verts);
-      ppf->addQuadrangle(element);
-    }
-    else if(verts.size() == 9) {
-      MQuadrangle9 *element = new MQuadrangle9(verts);
-      ppf->addQuadrangle(element);
-    }
-    else {
-      MQuadrangleN *element =
-        new MQuadrangleN(verts, verts.back()->getPolynomialOrder());
-      ppf->addQuadrangle(element);
-    }
-  }
-
   return newEntity;
 }
 
@@ -1641,32 +1581,14 @@ static partitionEdge *assignPartitionBoundary(
     createPartitionEntity(ret, model, numEntity, partitions,
                           elementToEntity[reference], &newEntity, pedges);
 
-  int numEdge = 0;
   for(int i = 0; i < reference->getNumEdges(); i++) {
     if(reference->getEdge(i) == me) {
-      numEdge = i;
+      MElement *e = createPartitionBoundaryElement(reference, 1, i);
+      ppe->addElement(e->getType(), e);
       break;
     }
   }
 
-  if(me.getNumVertices() == 2) {
-    std::vector<MVertex *> verts;
-    reference->getEdgeVertices(numEdge, verts);
-
-    if(verts.size() == 2) {
-      MLine *element = new MLine(verts);
-      ppe->addLine(element);
-    }
-    else if(verts.size() == 3) {
-      MLine3 *element = new MLine3(verts);
-      ppe->addLine(element);
-    }
-    else {
-      MLineN *element = new MLineN(verts);
-      ppe->addLine(element);
-    }
-  }
-
   return newEntity;
 }
 
@@ -1696,47 +1618,27 @@ static partitionVertex *assignPartitionBoundary(
 
 static int computeOrientation(MElement *reference, MElement *element)
 {
+  std::vector<MVertex *> vertices;
+  element->getVertices(vertices);
   if(element->getDim() == 2) {
-    std::vector<MVertex *> vertices;
-    element->getVertices(vertices);
     MFace face = element->getFace(0);
     for(int i = 0; i < reference->getNumFaces(); i++) {
-      if(reference->getFace(i) == face) {
-        std::vector<MVertex *> referenceVertices;
-        reference->getFaceVertices(i, referenceVertices);
-
-        if(referenceVertices == vertices)
-          return 1;
-        else
-          return -1;
-      }
+      if(reference->getFace(i) == face)
+        return getPartitionBoundaryOrientation(reference, 2, i, vertices);
     }
   }
   else if(element->getDim() == 1) {
-    std::vector<MVertex *> vertices;
-    element->getVertices(vertices);
-    MEdge face = element->getEdge(0);
+    MEdge edge = element->getEdge(0);
     for(int i = 0; i < reference->getNumEdges(); i++) {
-      if(reference->getEdge(i) == face) {
-        std::vector<MVertex *> referenceVertices;
-        reference->getEdgeVertices(i, referenceVertices);
-
-        if(referenceVertices == vertices)
-          return 1;
-        else
-          return -1;
-      }
+      if(reference->getEdge(i) == edge)
+        return getPartitionBoundaryOrientation(reference, 1, i, vertices);
     }
   }
   else if(element->getDim() == 0) {
-    std::vector<MVertex *> vertices;
-    element->getVertices(vertices);
-
-    std::vector<MVertex *> referenceVertices;
-    reference->getVertices(referenceVertices);
-
-    if(referenceVertices[0] == vertices[0]) return 1;
-    if(referenceVertices[1] == vertices[0]) return -1;
+    for(std::size_t i = 0; i < 2 && i < reference->getNumVertices(); i++) {
+      if(reference->getVertex(i) == vertices[0])
+        return getPartitionBoundaryOrientation(reference, 0, i, vertices);
+    }
   }
 
   return 0;
@@ -1837,6 +1739,138 @@ static void assignNewEntityBRep(Graph &graph, hashmapelement &elementToEntity)
   }
 }
 
+// Face, edge or node of an element adjacent to a partition interface, with the
+// index of the list of boundary elements it comes from
+template <class KEY> struct partitionBoundaryKey {
+  KEY key;
+  MElement *element;
+  std::size_t list;
+  partitionBoundaryKey(const KEY &k, MElement *e, std::size_t l)
+    : key(k), element(e), list(l)
+  {
+  }
+};
+
+template <class KEY, class LESS> struct partitionBoundaryKeyLessThan {
+  bool operator()(const partitionBoundaryKey<KEY> &k1,
+                  const partitionBoundaryKey<KEY> &k2) const
+  {
+    return LESS()(k1.key, k2.key);
+  }
+};
+
+static void getBoundaryKeys(MElement *e, std::vector<MFace> &keys)
+{
+  for(int j = 0; j < e->getNumFaces(); j++) keys.push_back(e->getFace(j));
+}
+
+static void getBoundaryKeys(MElement *e, std::vector<MEdge> &keys)
+{
+  for(int j = 0; j < e->getNumEdges(); j++) keys.push_back(e->getEdge(j));
+}
+
+static void getBoundaryKeys(MElement *e, std::vector<MVertex *> &keys)
+{
+  for(std::size_t j = 0; j < e->getNumPrimaryVertices(); j++)
+    keys.push_back(e->getVertex(j));
+}
+
+// Create the partition entities (and their mesh) on the faces, edges or nodes
+// shared by the boundary elements of different partitions. The keys of each
+// list of boundary elements are extracted and sorted in parallel, then merged
+// so that identical keys are consecutive (instead of using a hash map keyed by
+// the faces, edges or nodes); the reference elements are also computed in
+// parallel, and only the creation of the entities is sequential.
+template <class KEY, class LESS, class PART_ENTITY, class LESS_PART_ENTITY>
+static void createPartitionBoundaries(
+  GModel *model,
+  const std::vector<std::set<MElement *, MElementPtrLessThan> >
+    &boundaryElements,
+  const std::vector<std::vector<int> > &boundaryPartitions,
+  std::multimap<PART_ENTITY *, GEntity *, LESS_PART_ENTITY> &pentities,
+  hashmapelement &elementToEntity, int &numEntity)
+{
+  typedef partitionBoundaryKey<KEY> key_t;
+  typedef partitionBoundaryKeyLessThan<KEY, LESS> less_t;
+
+  const int nl = boundaryElements.size();
+  std::vector<std::vector<key_t> > chunks(nl);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(int i = 0; i < nl; i++) {
+    std::vector<KEY> keys;
+    for(std::set<MElement *, MElementPtrLessThan>::const_iterator it =
+          boundaryElements[i].begin();
+        it != boundaryElements[i].end(); ++it) {
+      keys.clear();
+      getBoundaryKeys(*it, keys);
+      for(std::size_t j = 0; j < keys.size(); j++)
+        chunks[i].push_back(key_t(keys[j], *it, i));
+    }
+    std::stable_sort(chunks[i].begin(), chunks[i].end(), less_t());
+  }
+
+  // merge the sorted chunks pairwise; std::merge is stable, so that the
+  // elements sharing a key remain ordered by list
+  while(chunks.size() > 1) {
+    const int nm = chunks.size() / 2;
+    std::vector<std::vector<key_t> > merged((chunks.size() + 1) / 2);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int i = 0; i < nm; i++) {
+      std::vector<key_t> &c1 = chunks[2 * i], &c2 = chunks[2 * i + 1];
+      merged[i].reserve(c1.size() + c2.size());
+      std::merge(c1.begin(), c1.end(), c2.begin(), c2.end(),
+                 std::back_inserter(merged[i]), less_t());
+      std::vector<key_t>().swap(c1);
+      std::vector<key_t>().swap(c2);
+    }
+    if(chunks.size() % 2) merged.back().swap(chunks.back());
+    chunks.swap(merged);
+  }
+  if(chunks.empty()) return;
+  const std::vector<key_t> &keys = chunks[0];
+
+  std::vector<std::size_t> groups;
+  for(std::size_t i = 0; i < keys.size(); i++) {
+    if(!i || LESS()(keys[i - 1].key, keys[i].key)) groups.push_back(i);
+  }
+  groups.push_back(keys.size());
+
+  const int ng = groups.size() - 1;
+  std::vector<std::vector<int> > partitions(ng);
+  std::vector<MElement *> references(ng, (MElement *)0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(int g = 0; g < ng; g++) {
+    std::vector<const std::vector<int> *> elementPartitions;
+    for(std::size_t i = groups[g]; i < groups[g + 1]; i++)
+      elementPartitions.push_back(&boundaryPartitions[keys[i].list]);
+    int ref = getPartitionBoundaryReference(elementPartitions, partitions[g]);
+    if(ref >= 0) references[g] = keys[groups[g] + ref].element;
+  }
+
+  for(int g = 0; g < ng; g++) {
+    if(!references[g]) continue;
+    KEY key = keys[groups[g]].key;
+    PART_ENTITY *pe =
+      assignPartitionBoundary(model, key, references[g], partitions[g],
+                              pentities, elementToEntity, numEntity);
+    if(pe) {
+      std::map<GEntity *, MElement *, GEntityPtrFullLessThan>
+        boundaryEntityAndRefElement;
+      for(std::size_t i = groups[g]; i < groups[g + 1]; i++)
+        boundaryEntityAndRefElement.insert(std::pair<GEntity *, MElement *>(
+          elementToEntity[keys[i].element], keys[i].element));
+
+      assignBrep(model, boundaryEntityAndRefElement, pe);
+    }
+  }
+}
+
 // Create the new entities between each partitions (sigma and bndSigma).
 static void createPartitionTopology(
   GModel *model,
@@ -1854,9 +1888,10 @@ static void createPartitionTopology(
   std::multimap<partitionVertex *, GEntity *, partitionVertexPtrLessThan>
     pvertices;
 
-  hashmapface faceToElement;
-  hashmapedge edgeToElement;
-  hashmapvertex vertexToElement;
+  // partitions of the elements in each list of boundary elements
+  std::vector<std::vector<int> > partitionLists;
+  for(std::size_t i = 0; i < boundaryElements.size(); i++)
+    partitionLists.push_back(std::vector<int>(1, i + 1));
 
   std::set<GRegion *, GEntityPtrLessThan> regions = model->getRegions();
   std::set<GFace *, GEntityPtrLessThan> faces = model->getFaces();
@@ -1866,43 +1901,10 @@ static void createPartitionTopology(
   if(meshDim >= 3) {
     Msg::Info(" - Creating partition surfaces");
 
-    for(std::size_t i = 0; i < model->getNumPartitions(); i++) {
-      for(std::set<MElement *, MElementPtrLessThan>::iterator it =
-            boundaryElements[i].begin();
-          it != boundaryElements[i].end(); ++it) {
-        for(int j = 0; j < (*it)->getNumFaces(); j++) {
-          faceToElement[(*it)->getFace(j)].push_back(
-            std::pair<MElement *, std::vector<int> >(
-              *it, std::vector<int>(1, i + 1)));
-        }
-      }
-    }
     int numFaceEntity = model->getMaxElementaryNumber(2);
-    for(hashmapface::const_iterator it = faceToElement.begin();
-        it != faceToElement.end(); ++it) {
-      MFace f = it->first;
-
-      std::vector<int> partitions;
-      getPartitionInVector(partitions, it->second);
-      if(partitions.size() < 2) continue;
-
-      MElement *reference = getReferenceElement(it->second);
-      if(!reference) continue;
-
-      partitionFace *pf =
-        assignPartitionBoundary(model, f, reference, partitions, pfaces,
-                                elementToEntity, numFaceEntity);
-      if(pf) {
-        std::map<GEntity *, MElement *, GEntityPtrFullLessThan>
-          boundaryEntityAndRefElement;
-        for(std::size_t i = 0; i < it->second.size(); i++)
-          boundaryEntityAndRefElement.insert(std::pair<GEntity *, MElement *>(
-            elementToEntity[it->second[i].first], it->second[i].first));
-
-        assignBrep(model, boundaryEntityAndRefElement, pf);
-      }
-    }
-    faceToElement.clear();
+    createPartitionBoundaries<MFace, MFaceLessThan>(
+      model, boundaryElements, partitionLists, pfaces, elementToEntity,
+      numFaceEntity);
 
     faces = model->getFaces();
     divideNonConnectedEntities(model, 2, regions, faces, edges, vertices);
@@ -1913,18 +1915,11 @@ static void createPartitionTopology(
   if(meshDim >= 2) {
     Msg::Info(" - Creating partition curves");
 
+    int numEdgeEntity = model->getMaxElementaryNumber(1);
     if(meshDim == 2) {
-      for(std::size_t i = 0; i < model->getNumPartitions(); i++) {
-        for(std::set<MElement *, MElementPtrLessThan>::iterator it =
-              boundaryElements[i].begin();
-            it != boundaryElements[i].end(); ++it) {
-          for(int j = 0; j < (*it)->getNumEdges(); j++) {
-            edgeToElement[(*it)->getEdge(j)].push_back(
-              std::pair<MElement *, std::vector<int> >(
-                *it, std::vector<int>(1, i + 1)));
-          }
-        }
-      }
+      createPartitionBoundaries<MEdge, MEdgeLessThan>(
+        model, boundaryElements, partitionLists, pedges, elementToEntity,
+        numEdgeEntity);
     }
     else {
       Graph subGraph(model);
@@ -1933,15 +1928,14 @@ static void createPartitionTopology(
       std::vector<idx_t> part(subGraph.ne());
       int partIndex = 0;
 
-      std::map<idx_t, std::vector<int> > mapOfPartitions;
+      std::vector<std::vector<int> > mapOfPartitions;
       idx_t mapOfPartitionsTag = 0;
       for(GModel::const_fiter it = model->firstFace(); it != model->lastFace();
           ++it) {
         if((*it)->geomType() == GEntity::PartitionSurface) {
           std::vector<int> partitions =
             static_cast<partitionFace *>(*it)->getPartitions();
-          mapOfPartitions.insert(std::pair<idx_t, std::vector<int> >(
-            mapOfPartitionsTag, partitions));
+          mapOfPartitions.push_back(partitions);
           // Must absolutely be in the same order as in the makeGraph function
           for(std::vector<MTriangle *>::iterator itElm =
                 (*it)->triangles.begin();
@@ -1959,46 +1953,10 @@ static void createPartitionTopology(
       std::vector<std::set<MElement *, MElementPtrLessThan> >
         subBoundaryElements = subGraph.getBoundaryElements(mapOfPartitionsTag);
 
-      for(idx_t i = 0; i < mapOfPartitionsTag; i++) {
-        for(std::set<MElement *, MElementPtrLessThan>::iterator it =
-              subBoundaryElements[i].begin();
-            it != subBoundaryElements[i].end(); ++it) {
-          for(int j = 0; j < (*it)->getNumEdges(); j++) {
-            edgeToElement[(*it)->getEdge(j)].push_back(
-              std::pair<MElement *, std::vector<int> >(*it,
-                                                       mapOfPartitions[i]));
-          }
-        }
-      }
-    }
-
-    int numEdgeEntity = model->getMaxElementaryNumber(1);
-    for(hashmapedge::const_iterator it = edgeToElement.begin();
-        it != edgeToElement.end(); ++it) {
-      MEdge e = it->first;
-
-      std::vector<int> partitions;
-      getPartitionInVector(partitions, it->second);
-      if(partitions.size() < 2) continue;
-
-      MElement *reference = getReferenceElement(it->second);
-      if(!reference) continue;
-
-      partitionEdge *pe =
-        assignPartitionBoundary(model, e, reference, partitions, pedges,
-                                elementToEntity, numEdgeEntity);
-      if(pe) {
-        std::map<GEntity *, MElement *, GEntityPtrFullLessThan>
-          boundaryEntityAndRefElement;
-        for(std::size_t i = 0; i < it->second.size(); i++) {
-          boundaryEntityAndRefElement.insert(std::pair<GEntity *, MElement *>(
-            elementToEntity[it->second[i].first], it->second[i].first));
-        }
-
-        assignBrep(model, boundaryEntityAndRefElement, pe);
-      }
+      createPartitionBoundaries<MEdge, MEdgeLessThan>(
+        model, subBoundaryElements, mapOfPartitions, pedges, elementToEntity,
+        numEdgeEntity);
     }
-    edgeToElement.clear();
 
     edges = model->getEdges();
     divideNonConnectedEntities(model, 1, regions, faces, edges, vertices);
@@ -2008,18 +1966,11 @@ static void createPartitionTopology(
 
   if(meshDim >= 1) {
     Msg::Info(" - Creating partition points");
+    int numVertexEntity = model->getMaxElementaryNumber(0);
     if(meshDim == 1) {
-      for(std::size_t i = 0; i < model->getNumPartitions(); i++) {
-        for(std::set<MElement *, MElementPtrLessThan>::iterator it =
-              boundaryElements[i].begin();
-            it != boundaryElements[i].end(); ++it) {
-          for(std::size_t j = 0; j < (*it)->getNumPrimaryVertices(); j++) {
-            vertexToElement[(*it)->getVertex(j)].push_back(
-              std::pair<MElement *, std::vector<int> >(
-                *it, std::vector<int>(1, i + 1)));
-          }
-        }
-      }
+      createPartitionBoundaries<MVertex *, MVertexPtrLessThan>(
+        model, boundaryElements, partitionLists, pvertices, elementToEntity,
+        numVertexEntity);
     }
     else {
       Graph subGraph(model);
@@ -2028,15 +1979,14 @@ static void createPartitionTopology(
       std::vector<idx_t> part(subGraph.ne());
       int partIndex = 0;
 
-      std::map<idx_t, std::vector<int> > mapOfPartitions;
+      std::vector<std::vector<int> > mapOfPartitions;
       idx_t mapOfPartitionsTag = 0;
       for(GModel::const_eiter it = model->firstEdge(); it != model->lastEdge();
           ++it) {
         if((*it)->geomType() == GEntity::PartitionCurve) {
           std::vector<int> partitions =
             static_cast<partitionEdge *>(*it)->getPartitions();
-          mapOfPartitions.insert(std::pair<idx_t, std::vector<int> >(
-            mapOfPartitionsTag, partitions));
+          mapOfPartitions.push_back(partitions);
           // Must absolutely be in the same order as in the makeGraph function
           for(std::vector<MLine *>::iterator itElm = (*it)->lines.begin();
               itElm != (*it)->lines.end(); ++itElm)
@@ -2049,44 +1999,10 @@ static void createPartitionTopology(
       std::vector<std::set<MElement *, MElementPtrLessThan> >
         subBoundaryElements = subGraph.getBoundaryElements(mapOfPartitionsTag);
 
-      for(idx_t i = 0; i < mapOfPartitionsTag; i++) {
-        for(std::set<MElement *, MElementPtrLessThan>::iterator it =
-              subBoundaryElements[i].begin();
-            it != subBoundaryElements[i].end(); ++it) {
-          for(std::size_t j = 0; j < (*it)->getNumPrimaryVertices(); j++) {
-            vertexToElement[(*it)->getVertex(j)].push_back(
-              std::pair<MElement *, std::vector<int> >(*it,
-                                                       mapOfPartitions[i]));
-          }
-        }
-      }
-    }
-    int numVertexEntity = model->getMaxElementaryNumber(0);
-    for(hashmapvertex::const_iterator it = vertexToElement.begin();
-        it != vertexToElement.end(); ++it) {
-      MVertex *v = it->first;
-
-      std::vector<int> partitions;
-      getPartitionInVector(partitions, it->second);
-      if(partitions.size() < 2) continue;
-
-      MElement *reference = getReferenceElement(it->second);
-      if(!reference) continue;
-
-      partitionVertex *pv =
-        assignPartitionBoundary(model, v, reference, partitions, pvertices,
-                                elementToEntity, numVertexEntity);
-      if(pv) {
-        std::map<GEntity *, MElement *, GEntityPtrFullLessThan>
-          boundaryEntityAndRefElement;
-        for(std::size_t i = 0; i < it->second.size(); i++)
-          boundaryEntityAndRefElement.insert(std::pair<GEntity *, MElement *>(
-            elementToEntity[it->second[i].first], it->second[i].first));
-
-        assignBrep(model, boundaryEntityAndRefElement, pv);
-      }
+      createPartitionBoundaries<MVertex *, MVertexPtrLessThan>(
+        model, subBoundaryElements, mapOfPartitions, pvertices,
+        elementToEntity, numVertexEntity);
     }
-    vertexToElement.clear();
 
     vertices = model->getVertices();
     divideNonConnectedEntities(model, 0, regions, faces, edges, vertices);
@@ -2351,24 +2267,38 @@ int PartitionMesh(GModel *model)
   }
 
   // Assign partitions to elements
+  const bool stream = CTX::instance()->mesh.partitionStreamMeshFiles;
   hashmapelementpart elmToPartition;
   for(std::size_t i = 0; i < graph.ne(); i++) {
     if(graph.element(i)) {
       if(graph.nparts() > 1) {
-        elmToPartition.insert(std::pair<MElement *, idx_t>(
-          graph.element(i), graph.partition(i) + 1));
+        if(!stream)
+          elmToPartition.insert(std::pair<MElement *, idx_t>(
+            graph.element(i), graph.partition(i) + 1));
         elmCount[graph.element(i)->getType()][graph.partition(i)]++;
         // Should be removed
         graph.element(i)->setPartition(graph.partition(i) + 1);
       }
       else {
-        elmToPartition.insert(
-          std::pair<MElement *, idx_t>(graph.element(i), 1));
+        if(!stream)
+          elmToPartition.insert(
+            std::pair<MElement *, idx_t>(graph.element(i), 1));
         // Should be removed
         graph.element(i)->setPartition(1);
       }
     }
   }
+
+  if(stream) {
+    // the partition entities are not created: the partitioned files are
+    // written directly from the partition of each element
+    model->setNumStreamPartitions(graph.nparts());
+    double t2 = Cpu(), w2 = TimeOfDay();
+    Msg::StatusBar(true, "Done partitioning mesh elements (Wall %gs, CPU %gs)",
+                   w2 - w1, t2 - t1);
+    return 0;
+  }
+
   model->setNumPartitions(graph.nparts());
 
   createNewEntities(model, elmToPartition);
@@ -2584,6 +2514,7 @@ int UnpartitionMesh(GModel *model)
   }
 
   model->setNumPartitions(0);
+  model->setNumStreamPartitions(0);
 
   std::map<std::pair<int, int>, std::string> physicalNames =
     model->getPhysicalNames();
@@ -2617,6 +2548,15 @@ int PartitionUsingThisSplit(GModel *model, std::size_t npart,
     return 1;
   }
 
+  for(hashmapelementpart::iterator it = elmToPartition.begin();
+      it != elmToPartition.end(); ++it) {
+    if(it->second < 1 || it->second > (int)npart) {
+      Msg::Error("Invalid partition %d for element %lu (should be in [1, %lu])",
+                 it->second, it->first->getNum(), npart);
+      return 1;
+    }
+  }
+
   std::vector<idx_t> part(graph.ne());
   for(std::size_t i = 0; i < graph.ne(); i++) {
     if(graph.element(i)) { part[i] = elmToPartition[graph.element(i)] - 1; }
@@ -2640,6 +2580,17 @@ int PartitionUsingThisSplit(GModel *model, std::size_t npart,
   }
   graph.partition(part);
 
+  if(CTX::instance()->mesh.partitionStreamMeshFiles) {
+    // only store the (corrected) partition of each element: the partitioned
+    // files are written directly from the element partitions
+    for(std::size_t i = 0; i < graph.ne(); i++) {
+      if(graph.element(i))
+        graph.element(i)->setPartition(graph.partition(i) + 1);
+    }
+    model->setNumStreamPartitions(graph.nparts());
+    return 0;
+  }
+
   model->setNumPartitions(graph.nparts());
 
   createNewEntities(model, elmToPartition);
@@ -8,6 +8,7 @@
 
 class GModel;
 class MElement;
+class MVertex;
 class GFace;
 
 int PartitionMesh(GModel *model);
@@ -20,4 +21,24 @@ int ConvertOldPartitioningToNewOne(GModel *model);
 
 int PartitionFaceMinEdgeLength(GFace *gf, int np, double tol = 1.02);
 
+// Partition topology: a face, edge or node shared by elements with the given
+// partitions lies on a partition boundary if these partitions are not all the
+// same; the function returns the index of the reference element (the one with
+// the fewest, then the lowest, partitions) and the partitions of the boundary,
+// or -1 if there is no boundary
+int getPartitionBoundaryReference(
+  const std::vector<const std::vector<int> *> &partitions,
+  std::vector<int> &boundaryPartitions);
+
+// Nodes and MSH type of the face (dim 2), edge (dim 1) or node (dim 0) facet
+// of an element, as saved in the partition boundaries
+int getPartitionBoundaryFacet(MElement *e, int dim, int facet,
+                              std::vector<MVertex *> &verts);
+MElement *createPartitionBoundaryElement(MElement *e, int dim, int facet);
+
+// Orientation of the facet of an element with respect to the boundary element
+// with nodes verts
+int getPartitionBoundaryOrientation(MElement *e, int dim, int facet,
+                                    const std::vector<MVertex *> &verts);
+
 #endif
@@ -85,6 +85,130 @@ static bool setBLData(MElement *el)
   return true;
 }
 
+static void splitTriangle(MTriangle *t, MTriangle **s)
+{
+  s[0] = new MTriangle(t->getVertex(0), t->getVertex(3), t->getVertex(5));
+  s[1] = new MTriangle(t->getVertex(3), t->getVertex(4), t->getVertex(5));
+  s[2] = new MTriangle(t->getVertex(3), t->getVertex(1), t->getVertex(4));
+  s[3] = new MTriangle(t->getVertex(5), t->getVertex(4), t->getVertex(2));
+}
+
+static void splitQuadrangle(MQuadrangle *q, MQuadrangle **s)
+{
+  s[0] = new MQuadrangle(q->getVertex(0), q->getVertex(4), q->getVertex(8),
+                         q->getVertex(7));
+  s[1] = new MQuadrangle(q->getVertex(4), q->getVertex(1), q->getVertex(5),
+                         q->getVertex(8));
+  s[2] = new MQuadrangle(q->getVertex(8), q->getVertex(5), q->getVertex(2),
+                         q->getVertex(6));
+  s[3] = new MQuadrangle(q->getVertex(7), q->getVertex(8), q->getVertex(6),
+                         q->getVertex(3));
+}
+
+// Use a template that maximizes the quality, which is a modification of
+// Algorithm RedRefinement3D in: Bey, Jürgen. "Simplicial grid refinement: on
+// Freudenthal's algorithm and the optimal number of congruence classes."
+// Numerische Mathematik 85.1 (2000): 1-29. Contributed by Jose Paulo Moitinho
+// de Almeida, April 2019.
+static void splitTetrahedron(MTetrahedron *t, MTetrahedron **s)
+{
+  s[0] = new MTetrahedron(t->getVertex(0), t->getVertex(4), t->getVertex(6),
+                          t->getVertex(7));
+  s[1] = new MTetrahedron(t->getVertex(4), t->getVertex(1), t->getVertex(5),
+                          t->getVertex(9));
+  s[2] = new MTetrahedron(t->getVertex(6), t->getVertex(5), t->getVertex(2),
+                          t->getVertex(8));
+  s[3] = new MTetrahedron(t->getVertex(7), t->getVertex(9), t->getVertex(8),
+                          t->getVertex(3));
+  s[4] = new MTetrahedron(t->getVertex(4), t->getVertex(6), t->getVertex(7),
+                          t->getVertex(9));
+  s[5] = new MTetrahedron(t->getVertex(4), t->getVertex(9), t->getVertex(5),
+                          t->getVertex(6));
+  s[6] = new MTetrahedron(t->getVertex(6), t->getVertex(7), t->getVertex(9),
+                          t->getVertex(8));
+  s[7] = new MTetrahedron(t->getVertex(6), t->getVertex(8), t->getVertex(9),
+                          t->getVertex(5));
+}
+
+static void splitHexahedron(MHexahedron *h, MHexahedron **s)
+{
+  s[0] = new MHexahedron(h->getVertex(0), h->getVertex(8), h->getVertex(20),
+                         h->getVertex(9), h->getVertex(10), h->getVertex(21),
+                         h->getVertex(26), h->getVertex(22));
+  s[1] = new MHexahedron(h->getVertex(10), h->getVertex(21), h->getVertex(26),
+                         h->getVertex(22), h->getVertex(4), h->getVertex(16),
+                         h->getVertex(25), h->getVertex(17));
+  s[2] = new MHexahedron(h->getVertex(8), h->getVertex(1), h->getVertex(11),
+                         h->getVertex(20), h->getVertex(21), h->getVertex(12),
+                         h->getVertex(23), h->getVertex(26));
+  s[3] = new MHexahedron(h->getVertex(21), h->getVertex(12), h->getVertex(23),
+                         h->getVertex(26), h->getVertex(16), h->getVertex(5),
+                         h->getVertex(18), h->getVertex(25));
+  s[4] = new MHexahedron(h->getVertex(9), h->getVertex(20), h->getVertex(13),
+                         h->getVertex(3), h->getVertex(22), h->getVertex(26),
+                         h->getVertex(24), h->getVertex(15));
+  s[5] = new MHexahedron(h->getVertex(22), h->getVertex(26), h->getVertex(24),
+                         h->getVertex(15), h->getVertex(17), h->getVertex(25),
+                         h->getVertex(19), h->getVertex(7));
+  s[6] = new MHexahedron(h->getVertex(20), h->getVertex(11), h->getVertex(2),
+                         h->getVertex(13), h->getVertex(26), h->getVertex(23),
+                         h->getVertex(14), h->getVertex(24));
+  s[7] = new MHexahedron(h->getVertex(26), h->getVertex(23), h->getVertex(14),
+                         h->getVertex(24), h->getVertex(25), h->getVertex(18),
+                         h->getVertex(6), h->getVertex(19));
+}
+
+static void splitPrism(MPrism *p, MPrism **s)
+{
+  s[0] = new MPrism(p->getVertex(0), p->getVertex(6), p->getVertex(7),
+                    p->getVertex(8), p->getVertex(15), p->getVertex(16));
+  s[1] = new MPrism(p->getVertex(8), p->getVertex(15), p->getVertex(16),
+                    p->getVertex(3), p->getVertex(12), p->getVertex(13));
+  s[2] = new MPrism(p->getVertex(6), p->getVertex(1), p->getVertex(9),
+                    p->getVertex(15), p->getVertex(10), p->getVertex(17));
+  s[3] = new MPrism(p->getVertex(15), p->getVertex(10), p->getVertex(17),
+                    p->getVertex(12), p->getVertex(4), p->getVertex(14));
+  s[4] = new MPrism(p->getVertex(7), p->getVertex(9), p->getVertex(2),
+                    p->getVertex(16), p->getVertex(17), p->getVertex(11));
+  s[5] = new MPrism(p->getVertex(16), p->getVertex(17), p->getVertex(11),
+                    p->getVertex(13), p->getVertex(14), p->getVertex(5));
+  s[6] = new MPrism(p->getVertex(9), p->getVertex(7), p->getVertex(6),
+                    p->getVertex(17), p->getVertex(16), p->getVertex(15));
+  s[7] = new MPrism(p->getVertex(17), p->getVertex(16), p->getVertex(15),
+                    p->getVertex(14), p->getVertex(13), p->getVertex(12));
+}
+
+// Split the second order elements with numVertices nodes into N first order
+// elements, and delete the original elements. The new elements are created in
+// parallel, then numbered in the order of the serial loop, so that the result
+// does not depend on the number of threads.
+template <class T, int N>
+static void splitElements(std::vector<T *> &elements, std::size_t numVertices,
+                          void (*split)(T *, T **),
+                          std::vector<T *> &elements2)
+{
+  const std::size_t n = elements.size();
+  std::size_t num = GModel::current()->getMaxElementNumber();
+  std::vector<T *> s(N * n, (T *)0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(n > 1000)
+#endif
+  for(std::size_t i = 0; i < n; i++) {
+    if(elements[i]->getNumVertices() == numVertices)
+      split(elements[i], &s[N * i]);
+  }
+  for(std::size_t i = 0; i < n; i++) {
+    if(s[N * i]) {
+      for(int j = 0; j < N; j++) {
+        s[N * i + j]->forceNum(++num);
+        elements2.push_back(s[N * i + j]);
+      }
+      setBLData(elements[i]);
+    }
+    delete elements[i];
+  }
+}
+
 static void Subdivide(GEdge *ge)
 {
   std::vector<MLine *> lines2;
@@ -112,40 +236,13 @@ static void Subdivide(GFace *gf, bool splitIntoQuads, bool splitIntoHexas,
 {
   if(!splitIntoQuads && !splitIntoHexas) {
     std::vector<MTriangle *> triangles2;
-    for(std::size_t i = 0; i < gf->triangles.size(); i++) {
-      MTriangle *t = gf->triangles[i];
-      if(t->getNumVertices() == 6) {
-        triangles2.push_back(
-          new MTriangle(t->getVertex(0), t->getVertex(3), t->getVertex(5)));
-        triangles2.push_back(
-          new MTriangle(t->getVertex(3), t->getVertex(4), t->getVertex(5)));
-        triangles2.push_back(
-          new MTriangle(t->getVertex(3), t->getVertex(1), t->getVertex(4)));
-        triangles2.push_back(
-          new MTriangle(t->getVertex(5), t->getVertex(4), t->getVertex(2)));
-        setBLData(t);
-      }
-      delete t;
-    }
+    splitElements<MTriangle, 4>(gf->triangles, 6, splitTriangle, triangles2);
     gf->triangles = triangles2;
   }
 
   std::vector<MQuadrangle *> quadrangles2;
-  for(std::size_t i = 0; i < gf->quadrangles.size(); i++) {
-    MQuadrangle *q = gf->quadrangles[i];
-    if(q->getNumVertices() == 9) {
-      quadrangles2.push_back(new MQuadrangle(q->getVertex(0), q->getVertex(4),
-                                             q->getVertex(8), q->getVertex(7)));
-      quadrangles2.push_back(new MQuadrangle(q->getVertex(4), q->getVertex(1),
-                                             q->getVertex(5), q->getVertex(8)));
-      quadrangles2.push_back(new MQuadrangle(q->getVertex(8), q->getVertex(5),
-                                             q->getVertex(2), q->getVertex(6)));
-      quadrangles2.push_back(new MQuadrangle(q->getVertex(7), q->getVertex(8),
-                                             q->getVertex(6), q->getVertex(3)));
-      setBLData(q);
-    }
-    delete q;
-  }
+  splitElements<MQuadrangle, 4>(gf->quadrangles, 9, splitQuadrangle,
+                                quadrangles2);
   if(splitIntoQuads || splitIntoHexas) {
     for(std::size_t i = 0; i < gf->triangles.size(); i++) {
       MTriangle *t = gf->triangles[i];
@@ -197,74 +294,15 @@ static void Subdivide(GRegion *gr, bool splitIntoHexas,
   if(!splitIntoHexas) {
     // Split tets into other tets
     std::vector<MTetrahedron *> tetrahedra2;
-    for(std::size_t i = 0; i < gr->tetrahedra.size(); i++) {
-      MTetrahedron *t = gr->tetrahedra[i];
-      // Use a template that maximizes the quality, which is a modification of
-      // Algorithm RedRefinement3D in: Bey, Jürgen. "Simplicial grid refinement:
-      // on Freudenthal's algorithm and the optimal number of congruence
-      // classes." Numerische Mathematik 85.1 (2000): 1-29. Contributed by Jose
-      // Paulo Moitinho de Almeida, April 2019.
-      if(t->getNumVertices() == 10) {
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(0), t->getVertex(4), t->getVertex(6), t->getVertex(7)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(4), t->getVertex(1), t->getVertex(5), t->getVertex(9)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(6), t->getVertex(5), t->getVertex(2), t->getVertex(8)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(7), t->getVertex(9), t->getVertex(8), t->getVertex(3)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(4), t->getVertex(6), t->getVertex(7), t->getVertex(9)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(4), t->getVertex(9), t->getVertex(5), t->getVertex(6)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(6), t->getVertex(7), t->getVertex(9), t->getVertex(8)));
-        tetrahedra2.push_back(new MTetrahedron(
-          t->getVertex(6), t->getVertex(8), t->getVertex(9), t->getVertex(5)));
-        setBLData(t);
-      }
-      delete t;
-    }
+    splitElements<MTetrahedron, 8>(gr->tetrahedra, 10, splitTetrahedron,
+                                   tetrahedra2);
     gr->tetrahedra = tetrahedra2;
   }
 
   // Split hexes into other hexes.
   std::vector<MHexahedron *> hexahedra2;
-  for(std::size_t i = 0; i < gr->hexahedra.size(); i++) {
-    MHexahedron *h = gr->hexahedra[i];
-    if(h->getNumVertices() == 27) {
-      hexahedra2.push_back(new MHexahedron(h->getVertex(0), h->getVertex(8),
-                                           h->getVertex(20), h->getVertex(9),
-                                           h->getVertex(10), h->getVertex(21),
-                                           h->getVertex(26), h->getVertex(22)));
-      hexahedra2.push_back(new MHexahedron(
-        h->getVertex(10), h->getVertex(21), h->getVertex(26), h->getVertex(22),
-        h->getVertex(4), h->getVertex(16), h->getVertex(25), h->getVertex(17)));
-      hexahedra2.push_back(new MHexahedron(h->getVertex(8), h->getVertex(1),
-                                           h->getVertex(11), h->getVertex(20),
-                                           h->getVertex(21), h->getVertex(12),
-                                           h->getVertex(23), h->getVertex(26)));
-      hexahedra2.push_back(new MHexahedron(
-        h->getVertex(21), h->getVertex(12), h->getVertex(23), h->getVertex(26),
-        h->getVertex(16), h->getVertex(5), h->getVertex(18), h->getVertex(25)));
-      hexahedra2.push_back(new MHexahedron(h->getVertex(9), h->getVertex(20),
-                                           h->getVertex(13), h->getVertex(3),
-                                           h->getVertex(22), h->getVertex(26),
-                                           h->getVertex(24), h->getVertex(15)));
-      hexahedra2.push_back(new MHexahedron(
-        h->getVertex(22), h->getVertex(26), h->getVertex(24), h->getVertex(15),
-        h->getVertex(17), h->getVertex(25), h->getVertex(19), h->getVertex(7)));
-      hexahedra2.push_back(new MHexahedron(h->getVertex(20), h->getVertex(11),
-                                           h->getVertex(2), h->getVertex(13),
-                                           h->getVertex(26), h->getVertex(23),
-                                           h->getVertex(14), h->getVertex(24)));
-      hexahedra2.push_back(new MHexahedron(
-        h->getVertex(26), h->getVertex(23), h->getVertex(14), h->getVertex(24),
-        h->getVertex(25), h->getVertex(18), h->getVertex(6), h->getVertex(19)));
-      setBLData(h);
-    }
-    delete h;
-  }
+  splitElements<MHexahedron, 8>(gr->hexahedra, 27, splitHexahedron,
+                                hexahedra2);
 
   // Split tets into other hexes.
   if(splitIntoHexas) {
@@ -374,37 +412,7 @@ static void Subdivide(GRegion *gr, bool splitIntoHexas,
   gr->hexahedra = hexahedra2;
 
   std::vector<MPrism *> prisms2;
-  for(std::size_t i = 0; i < gr->prisms.size(); i++) {
-    MPrism *p = gr->prisms[i];
-    if(p->getNumVertices() == 18) {
-      prisms2.push_back(new MPrism(p->getVertex(0), p->getVertex(6),
-                                   p->getVertex(7), p->getVertex(8),
-                                   p->getVertex(15), p->getVertex(16)));
-      prisms2.push_back(new MPrism(p->getVertex(8), p->getVertex(15),
-                                   p->getVertex(16), p->getVertex(3),
-                                   p->getVertex(12), p->getVertex(13)));
-      prisms2.push_back(new MPrism(p->getVertex(6), p->getVertex(1),
-                                   p->getVertex(9), p->getVertex(15),
-                                   p->getVertex(10), p->getVertex(17)));
-      prisms2.push_back(new MPrism(p->getVertex(15), p->getVertex(10),
-                                   p->getVertex(17), p->getVertex(12),
-                                   p->getVertex(4), p->getVertex(14)));
-      prisms2.push_back(new MPrism(p->getVertex(7), p->getVertex(9),
-                                   p->getVertex(2), p->getVertex(16),
-                                   p->getVertex(17), p->getVertex(11)));
-      prisms2.push_back(new MPrism(p->getVertex(16), p->getVertex(17),
-                                   p->getVertex(11), p->getVertex(13),
-                                   p->getVertex(14), p->getVertex(5)));
-      prisms2.push_back(new MPrism(p->getVertex(9), p->getVertex(7),
-                                   p->getVertex(6), p->getVertex(17),
-                                   p->getVertex(16), p->getVertex(15)));
-      prisms2.push_back(new MPrism(p->getVertex(17), p->getVertex(16),
-                                   p->getVertex(15), p->getVertex(14),
-                                   p->getVertex(13), p->getVertex(12)));
-      setBLData(p);
-    }
-    delete p;
-  }
+  splitElements<MPrism, 8>(gr->prisms, 18, splitPrism, prisms2);
   gr->prisms = prisms2;
 
   std::vector<MPyramid *> pyramids2;
@@ -467,6 +475,7 @@ static void Subdivide(GRegion *gr, bool splitIntoHexas,
 void RefineMesh(GModel *m, bool linear, bool splitIntoQuads,
                 bool splitIntoHexas)
 {
+  MsgProfileSection prof("Refine mesh");
   Msg::StatusBar(true, "Refining mesh...");
   double t1 = Cpu(), w1 = TimeOfDay();
 
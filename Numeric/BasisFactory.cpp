@@ -71,8 +71,20 @@ const JacobianBasis *BasisFactory::getJacobianBasis(int tag, FuncSpaceData fsd)
   if(it != js.end()) return it->second;
 
   JacobianBasis *J = new JacobianBasis(tag, data);
-  js.insert(std::make_pair(data, J));
-  return J;
+
+  std::pair<std::map<FuncSpaceData, JacobianBasis *>::const_iterator, bool>
+    inserted;
+
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+  {
+    inserted = js.insert(std::make_pair(data, J));
+
+    if(!inserted.second) delete J;
+  }
+
+  return inserted.first->second;
 }
 
 const JacobianBasis *BasisFactory::getJacobianBasis(int tag, int order)
@@ -102,8 +114,19 @@ const CondNumBasis *BasisFactory::getCondNumBasis(int tag, int cnOrder)
   if(it != cs.end()) return it->second;
 
   CondNumBasis *M = new CondNumBasis(tag, cnOrder);
-  cs.insert(std::make_pair(tag, M));
-  return M;
+
+  std::pair<std::map<int, CondNumBasis *>::const_iterator, bool> inserted;
+
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+  {
+    inserted = cs.insert(std::make_pair(tag, M));
+
+    if(!inserted.second) delete M;
+  }
+
+  return inserted.first->second;
 }
 
 const GradientBasis *BasisFactory::getGradientBasis(int tag, FuncSpaceData fsd)
@@ -114,8 +137,20 @@ const GradientBasis *BasisFactory::getGradientBasis(int tag, FuncSpaceData fsd)
   if(it != gs.end()) return it->second;
 
   GradientBasis *G = new GradientBasis(tag, data);
-  gs.insert(std::make_pair(data, G));
-  return G;
+
+  std::pair<std::map<FuncSpaceData, GradientBasis *>::const_iterator, bool>
+    inserted;
+
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+  {
+    inserted = gs.insert(std::make_pair(data, G));
+
+    if(!inserted.second) delete G;
+  }
+
+  return inserted.first->second;
 }
 
 const GradientBasis *BasisFactory::getGradientBasis(int tag, int order)
@@ -137,8 +172,20 @@ const bezierBasis *BasisFactory::getBezierBasis(FuncSpaceData fsd)
   if(it != bs.end()) return it->second;
 
   bezierBasis *B = new bezierBasis(data);
-  bs.insert(std::make_pair(data, B));
-  return B;
+
+  std::pair<std::map<FuncSpaceData, bezierBasis *>::const_iterator, bool>
+    inserted;
+
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+  {
+    inserted = bs.insert(std::make_pair(data, B));
+
+    if(!inserted.second) delete B;
+  }
+
+  return inserted.first->second;
 }
 
 const bezierBasis *BasisFactory::getBezierBasis(int parentType, int order)
@@ -3,8 +3,10 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
 
+#include <algorithm>
 #include "SBoundingBox3d.h"
 #include "MVertex.h"
+#include "HilbertCurve.h"
 
 struct HilbertSort {
   // The code for generating table transgc
@@ -269,3 +271,68 @@ void SortHilbert(std::vector<MVertex *> &v)
   // HilbertSort h;
   h.Apply(v);
 }
+
+// number of bits per coordinate in the space-filling curve indices (3 x 21 bits
+// fit in 64 bits)
+static const int sfcBits = 21;
+
+static unsigned long long hilbertIndex(unsigned int X[3])
+{
+  // convert the coordinates into the "transposed" Hilbert index (J. Skilling,
+  // Programming the Hilbert curve, AIP Conf. Proc. 707, 2004)
+  unsigned int M = 1U << (sfcBits - 1), P, Q, t;
+  for(Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for(int i = 0; i < 3; i++) {
+      if(X[i] & Q)
+        X[0] ^= P;
+      else {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+  for(int i = 1; i < 3; i++) X[i] ^= X[i - 1];
+  t = 0;
+  for(Q = M; Q > 1; Q >>= 1)
+    if(X[2] & Q) t ^= Q - 1;
+  for(int i = 0; i < 3; i++) X[i] ^= t;
+  // interleave the bits
+  unsigned long long index = 0;
+  for(int j = sfcBits - 1; j >= 0; j--)
+    for(int i = 0; i < 3; i++) index = (index << 1) | ((X[i] >> j) & 1);
+  return index;
+}
+
+static unsigned long long mortonIndex(unsigned int X[3])
+{
+  unsigned long long index = 0;
+  for(int j = sfcBits - 1; j >= 0; j--)
+    for(int i = 0; i < 3; i++) index = (index << 1) | ((X[i] >> j) & 1);
+  return index;
+}
+
+void SortSpaceFillingCurve(const std::vector<SPoint3> &points,
+                           std::vector<std::size_t> &ordering, bool hilbert)
+{
+  SBoundingBox3d bbox;
+  for(std::size_t i = 0; i < points.size(); i++) bbox += points[i];
+  double scale[3];
+  for(int j = 0; j < 3; j++) {
+    double d = bbox.max()[j] - bbox.min()[j];
+    scale[j] = (d > 0.) ? ((1U << sfcBits) - 1) / d : 0.;
+  }
+  std::vector<std::pair<unsigned long long, std::size_t> > indices(
+    points.size());
+  for(std::size_t i = 0; i < points.size(); i++) {
+    unsigned int X[3];
+    for(int j = 0; j < 3; j++)
+      X[j] = (unsigned int)((points[i][j] - bbox.min()[j]) * scale[j]);
+    indices[i] = std::make_pair(hilbert ? hilbertIndex(X) : mortonIndex(X), i);
+  }
+  std::sort(indices.begin(), indices.end());
+  ordering.resize(points.size());
+  for(std::size_t i = 0; i < points.size(); i++)
+    ordering[i] = indices[i].second;
+}
@@ -6,6 +6,18 @@
 #ifndef HILBERT_CURVE
 #define HILBERT_CURVE
 
+#include <vector>
+#include "SPoint3.h"
+
+class MVertex;
+
 void SortHilbert(std::vector<MVertex *> &);
 
+// compute the ordering of the points along a Hilbert (or, if hilbert is false,
+// a Morton) space-filling curve, i.e. the indices of the points sorted by
+// increasing curvilinear coordinate along the curve
+void SortSpaceFillingCurve(const std::vector<SPoint3> &points,
+                           std::vector<std::size_t> &ordering,
+                           bool hilbert = true);
+
 #endif
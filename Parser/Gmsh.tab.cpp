@@ -587,6 +587,7 @@
 #include "GModelIO_GEO.h"
 #include "GModelIO_OCC.h"
 #include "GeoDefines.h"
+#include "Geo.h"
 #include "ExtrudeParams.h"
 #include "Options.h"
 #include "Parser.h"
@@ -650,6 +651,7 @@ static fpos_t yyposImbricatedLoopsTab[MAX_RECUR_LOOPS];
 static int yylinenoImbricatedLoopsTab[MAX_RECUR_LOOPS];
 static double LoopControlVariablesTab[MAX_RECUR_LOOPS][3];
 static std::string LoopControlVariablesNameTab[MAX_RECUR_LOOPS];
+static int yytokenImbricatedLoopsTab[MAX_RECUR_LOOPS];
 static std::string struct_name, struct_namespace;
 static int dim_entity;
 
@@ -670,6 +672,13 @@ char *strsave(char *ptr);
 void skip(const char *skip, const char *until);
 void skipTest(const char *skip, const char *until,
               const char *until2, int l_until2_sub, int *type_until2);
+void yyskip(const char *skip, const char *until);
+void yyskipTest(const char *skip, const char *until,
+                const char *until2, int l_until2_sub, int *type_until2);
+int gmsh_yyscan();
+int cacheLoopBody();
+bool replayLoopBody(int index);
+void leaveLoopBody();
 void assignVariable(const std::string &name, int index, int assignType,
                     double value);
 void assignVariables(const std::string &name, List_T *indices, int assignType,
@@ -747,7 +756,7 @@ struct doubleXstring{
 
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 typedef union YYSTYPE
-#line 165 "Gmsh.y"
+#line 174 "Gmsh.y"
 {
   char *c;
   int i;
@@ -759,7 +768,7 @@ typedef union YYSTYPE
   struct TwoChar c2;
 }
 /* Line 193 of yacc.c.  */
-#line 763 "Gmsh.tab.cpp"
+#line 772 "Gmsh.tab.cpp"
 	YYSTYPE;
 # define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
@@ -772,7 +781,7 @@ typedef union YYSTYPE
 
 
 /* Line 216 of yacc.c.  */
-#line 776 "Gmsh.tab.cpp"
+#line 785 "Gmsh.tab.cpp"
 
 #ifdef short
 # undef short
@@ -6941,27 +6950,27 @@ yyreduce:
   switch (yyn)
     {
         case 3:
-#line 272 "Gmsh.y"
+#line 281 "Gmsh.y"
     { yyerrok; return 1; ;}
     break;
 
   case 6:
-#line 283 "Gmsh.y"
+#line 292 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 7:
-#line 284 "Gmsh.y"
+#line 293 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 8:
-#line 285 "Gmsh.y"
+#line 294 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 9:
-#line 287 "Gmsh.y"
+#line 296 "Gmsh.y"
     {
       gmsh_yyfactory = (yyvsp[(3) - (5)].c);
       if(gmsh_yyfactory == "OpenCASCADE"){
@@ -6983,101 +6992,101 @@ yyreduce:
     break;
 
   case 10:
-#line 305 "Gmsh.y"
+#line 314 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 11:
-#line 306 "Gmsh.y"
+#line 315 "Gmsh.y"
     { List_Delete((yyvsp[(1) - (1)].l)); return 1; ;}
     break;
 
   case 12:
-#line 307 "Gmsh.y"
+#line 316 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 13:
-#line 308 "Gmsh.y"
+#line 317 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 14:
-#line 309 "Gmsh.y"
+#line 318 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 15:
-#line 310 "Gmsh.y"
+#line 319 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 16:
-#line 311 "Gmsh.y"
+#line 320 "Gmsh.y"
     { List_Delete((yyvsp[(1) - (1)].l)); return 1; ;}
     break;
 
   case 17:
-#line 312 "Gmsh.y"
+#line 321 "Gmsh.y"
     { List_Delete((yyvsp[(1) - (1)].l)); return 1; ;}
     break;
 
   case 18:
-#line 313 "Gmsh.y"
+#line 322 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 19:
-#line 314 "Gmsh.y"
+#line 323 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 20:
-#line 315 "Gmsh.y"
+#line 324 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 21:
-#line 316 "Gmsh.y"
+#line 325 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 22:
-#line 317 "Gmsh.y"
+#line 326 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 23:
-#line 318 "Gmsh.y"
+#line 327 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 24:
-#line 319 "Gmsh.y"
+#line 328 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 25:
-#line 320 "Gmsh.y"
+#line 329 "Gmsh.y"
     { return 1; ;}
     break;
 
   case 26:
-#line 325 "Gmsh.y"
+#line 334 "Gmsh.y"
     {
       (yyval.c) = (char*)"w";
     ;}
     break;
 
   case 27:
-#line 329 "Gmsh.y"
+#line 338 "Gmsh.y"
     {
       (yyval.c) = (char*)"a";
     ;}
     break;
 
   case 28:
-#line 336 "Gmsh.y"
+#line 345 "Gmsh.y"
     {
       Msg::Direct((yyvsp[(3) - (5)].c));
       Free((yyvsp[(3) - (5)].c));
@@ -7085,7 +7094,7 @@ yyreduce:
     break;
 
   case 29:
-#line 341 "Gmsh.y"
+#line 350 "Gmsh.y"
     {
       Msg::Warning((yyvsp[(3) - (5)].c));
       Free((yyvsp[(3) - (5)].c));
@@ -7093,7 +7102,7 @@ yyreduce:
     break;
 
   case 30:
-#line 346 "Gmsh.y"
+#line 355 "Gmsh.y"
     {
       Msg::Error((yyvsp[(3) - (5)].c));
       Free((yyvsp[(3) - (5)].c));
@@ -7101,7 +7110,7 @@ yyreduce:
     break;
 
   case 31:
-#line 351 "Gmsh.y"
+#line 360 "Gmsh.y"
     {
       std::string tmp = FixRelativePath(gmsh_yyname, (yyvsp[(6) - (7)].c));
       FILE *fp = Fopen(tmp.c_str(), (yyvsp[(5) - (7)].c));
@@ -7118,7 +7127,7 @@ yyreduce:
     break;
 
   case 32:
-#line 365 "Gmsh.y"
+#line 374 "Gmsh.y"
     {
       char tmpstring[5000];
       int i = printListOfDouble((yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].l), tmpstring);
@@ -7134,7 +7143,7 @@ yyreduce:
     break;
 
   case 33:
-#line 378 "Gmsh.y"
+#line 387 "Gmsh.y"
     {
       char tmpstring[5000];
       int i = printListOfDouble((yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].l), tmpstring);
@@ -7150,7 +7159,7 @@ yyreduce:
     break;
 
   case 34:
-#line 391 "Gmsh.y"
+#line 400 "Gmsh.y"
     {
       char tmpstring[5000];
       int i = printListOfDouble((yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].l), tmpstring);
@@ -7166,7 +7175,7 @@ yyreduce:
     break;
 
   case 35:
-#line 404 "Gmsh.y"
+#line 413 "Gmsh.y"
     {
       char tmpstring[5000];
       int i = printListOfDouble((yyvsp[(3) - (9)].c), (yyvsp[(5) - (9)].l), tmpstring);
@@ -7192,7 +7201,7 @@ yyreduce:
     break;
 
   case 36:
-#line 432 "Gmsh.y"
+#line 441 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(1) - (6)].c), "View") && ViewData->finalize()){
@@ -7209,7 +7218,7 @@ yyreduce:
     break;
 
   case 37:
-#line 446 "Gmsh.y"
+#line 455 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (6)].c), "View")){
@@ -7225,7 +7234,7 @@ yyreduce:
     break;
 
   case 38:
-#line 459 "Gmsh.y"
+#line 468 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (6)].c), "View")){
@@ -7241,7 +7250,7 @@ yyreduce:
     break;
 
   case 39:
-#line 472 "Gmsh.y"
+#line 481 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (8)].c), "View")){
@@ -7259,7 +7268,7 @@ yyreduce:
     break;
 
   case 40:
-#line 490 "Gmsh.y"
+#line 499 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       ViewData = new PViewDataList();
@@ -7268,27 +7277,27 @@ yyreduce:
     break;
 
   case 47:
-#line 505 "Gmsh.y"
+#line 514 "Gmsh.y"
     { ViewCoord.push_back((yyvsp[(1) - (1)].d)); ;}
     break;
 
   case 48:
-#line 507 "Gmsh.y"
+#line 516 "Gmsh.y"
     { ViewCoord.push_back((yyvsp[(3) - (3)].d)); ;}
     break;
 
   case 49:
-#line 512 "Gmsh.y"
+#line 521 "Gmsh.y"
     { if(ViewValueList) ViewValueList->push_back((yyvsp[(1) - (1)].d)); ;}
     break;
 
   case 50:
-#line 514 "Gmsh.y"
+#line 523 "Gmsh.y"
     { if(ViewValueList) ViewValueList->push_back((yyvsp[(3) - (3)].d)); ;}
     break;
 
   case 51:
-#line 519 "Gmsh.y"
+#line 528 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strncmp((yyvsp[(1) - (1)].c), "SP", 2)){
@@ -7395,7 +7404,7 @@ yyreduce:
     break;
 
   case 52:
-#line 623 "Gmsh.y"
+#line 632 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(ViewValueList){
@@ -7408,7 +7417,7 @@ yyreduce:
     break;
 
   case 53:
-#line 633 "Gmsh.y"
+#line 642 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(ViewValueList) (*ViewNumList)++;
@@ -7417,7 +7426,7 @@ yyreduce:
     break;
 
   case 54:
-#line 642 "Gmsh.y"
+#line 651 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       for(int i = 0; i < (int)strlen((yyvsp[(1) - (1)].c)) + 1; i++) ViewData->T2C.push_back((yyvsp[(1) - (1)].c)[i]);
@@ -7427,7 +7436,7 @@ yyreduce:
     break;
 
   case 55:
-#line 649 "Gmsh.y"
+#line 658 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       for(int i = 0; i < (int)strlen((yyvsp[(3) - (3)].c)) + 1; i++) ViewData->T2C.push_back((yyvsp[(3) - (3)].c)[i]);
@@ -7437,7 +7446,7 @@ yyreduce:
     break;
 
   case 56:
-#line 659 "Gmsh.y"
+#line 668 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       ViewData->T2D.push_back((yyvsp[(3) - (8)].d));
@@ -7449,7 +7458,7 @@ yyreduce:
     break;
 
   case 57:
-#line 668 "Gmsh.y"
+#line 677 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       ViewData->NbT2++;
@@ -7458,7 +7467,7 @@ yyreduce:
     break;
 
   case 58:
-#line 677 "Gmsh.y"
+#line 686 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       for(int i = 0; i < (int)strlen((yyvsp[(1) - (1)].c)) + 1; i++) ViewData->T3C.push_back((yyvsp[(1) - (1)].c)[i]);
@@ -7468,7 +7477,7 @@ yyreduce:
     break;
 
   case 59:
-#line 684 "Gmsh.y"
+#line 693 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       for(int i = 0; i < (int)strlen((yyvsp[(3) - (3)].c)) + 1; i++) ViewData->T3C.push_back((yyvsp[(3) - (3)].c)[i]);
@@ -7478,7 +7487,7 @@ yyreduce:
     break;
 
   case 60:
-#line 694 "Gmsh.y"
+#line 703 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       ViewData->T3D.push_back((yyvsp[(3) - (10)].d)); ViewData->T3D.push_back((yyvsp[(5) - (10)].d));
@@ -7489,7 +7498,7 @@ yyreduce:
     break;
 
   case 61:
-#line 702 "Gmsh.y"
+#line 711 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       ViewData->NbT3++;
@@ -7498,7 +7507,7 @@ yyreduce:
     break;
 
   case 62:
-#line 712 "Gmsh.y"
+#line 721 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       int type =
@@ -7517,7 +7526,7 @@ yyreduce:
     break;
 
   case 63:
-#line 731 "Gmsh.y"
+#line 740 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       int type =
@@ -7536,7 +7545,7 @@ yyreduce:
     break;
 
   case 64:
-#line 750 "Gmsh.y"
+#line 759 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       ViewValueList = &ViewData->Time;
@@ -7545,93 +7554,93 @@ yyreduce:
     break;
 
   case 65:
-#line 756 "Gmsh.y"
+#line 765 "Gmsh.y"
     {
     ;}
     break;
 
   case 66:
-#line 763 "Gmsh.y"
+#line 772 "Gmsh.y"
     { (yyval.i) = 0; ;}
     break;
 
   case 67:
-#line 764 "Gmsh.y"
+#line 773 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 68:
-#line 765 "Gmsh.y"
+#line 774 "Gmsh.y"
     { (yyval.i) = 2; ;}
     break;
 
   case 69:
-#line 766 "Gmsh.y"
+#line 775 "Gmsh.y"
     { (yyval.i) = 3; ;}
     break;
 
   case 70:
-#line 767 "Gmsh.y"
+#line 776 "Gmsh.y"
     { (yyval.i) = 4; ;}
     break;
 
   case 71:
-#line 771 "Gmsh.y"
+#line 780 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 72:
-#line 772 "Gmsh.y"
+#line 781 "Gmsh.y"
     { (yyval.i) = -1; ;}
     break;
 
   case 73:
-#line 778 "Gmsh.y"
+#line 787 "Gmsh.y"
     { (yyval.c) = (char*)"("; ;}
     break;
 
   case 74:
-#line 778 "Gmsh.y"
+#line 787 "Gmsh.y"
     { (yyval.c) = (char*)"["; ;}
     break;
 
   case 75:
-#line 780 "Gmsh.y"
+#line 789 "Gmsh.y"
     { (yyval.c) = (char*)")"; ;}
     break;
 
   case 76:
-#line 780 "Gmsh.y"
+#line 789 "Gmsh.y"
     { (yyval.c) = (char*)"]"; ;}
     break;
 
   case 77:
-#line 785 "Gmsh.y"
+#line 794 "Gmsh.y"
     { (yyval.c) = (yyvsp[(1) - (1)].c); ;}
     break;
 
   case 78:
-#line 786 "Gmsh.y"
+#line 795 "Gmsh.y"
     { (yyval.c) = (char *)Malloc(4 * sizeof(char)); strcpy((yyval.c), "Min"); ;}
     break;
 
   case 79:
-#line 787 "Gmsh.y"
+#line 796 "Gmsh.y"
     { (yyval.c) = (char *)Malloc(4 * sizeof(char)); strcpy((yyval.c), "Max"); ;}
     break;
 
   case 80:
-#line 788 "Gmsh.y"
+#line 797 "Gmsh.y"
     { (yyval.c) = (char *)Malloc(4 * sizeof(char)); strcpy((yyval.c), "Box"); ;}
     break;
 
   case 81:
-#line 789 "Gmsh.y"
+#line 798 "Gmsh.y"
     { (yyval.c) = (char *)Malloc(9 * sizeof(char)); strcpy((yyval.c), "Cylinder"); ;}
     break;
 
   case 85:
-#line 799 "Gmsh.y"
+#line 808 "Gmsh.y"
     {
       Msg::SetOnelabNumber((yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].d));
       Free((yyvsp[(3) - (7)].c));
@@ -7639,7 +7648,7 @@ yyreduce:
     break;
 
   case 86:
-#line 804 "Gmsh.y"
+#line 813 "Gmsh.y"
     {
       Msg::SetOnelabString((yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].c));
       Free((yyvsp[(3) - (7)].c));
@@ -7648,13 +7657,18 @@ yyreduce:
     break;
 
   case 87:
-#line 810 "Gmsh.y"
+#line 819 "Gmsh.y"
     {
-      if(!gmsh_yysymbols.count((yyvsp[(1) - (4)].c)) && (yyvsp[(2) - (4)].i) && List_Nbr((yyvsp[(3) - (4)].l)) == 1){
+      std::map<std::string, gmsh_yysymbol>::iterator its =
+        gmsh_yysymbols.find((yyvsp[(1) - (4)].c));
+      if(its == gmsh_yysymbols.end() && (yyvsp[(2) - (4)].i) && List_Nbr((yyvsp[(3) - (4)].l)) == 1){
         yymsg(0, "Unknown variable '%s'", (yyvsp[(1) - (4)].c));
       }
       else{
-        gmsh_yysymbol &s(gmsh_yysymbols[(yyvsp[(1) - (4)].c)]);
+        if(its == gmsh_yysymbols.end())
+          its = gmsh_yysymbols.insert
+            (std::make_pair(std::string((yyvsp[(1) - (4)].c)), gmsh_yysymbol())).first;
+        gmsh_yysymbol &s(its->second);
         if(!(yyvsp[(2) - (4)].i)) s.list = (List_Nbr((yyvsp[(3) - (4)].l)) != 1); // list if 0 or > 1 elements
         if(!s.list){ // single expression
           if(List_Nbr((yyvsp[(3) - (4)].l)) != 1){
@@ -7713,12 +7727,14 @@ yyreduce:
     break;
 
   case 88:
-#line 872 "Gmsh.y"
+#line 886 "Gmsh.y"
     {
-      if(!gmsh_yysymbols.count((yyvsp[(1) - (3)].c)))
+      std::map<std::string, gmsh_yysymbol>::iterator its =
+        gmsh_yysymbols.find((yyvsp[(1) - (3)].c));
+      if(its == gmsh_yysymbols.end())
 	yymsg(0, "Unknown variable '%s'", (yyvsp[(1) - (3)].c));
       else{
-        gmsh_yysymbol &s(gmsh_yysymbols[(yyvsp[(1) - (3)].c)]);
+        gmsh_yysymbol &s(its->second);
         if(!s.list && s.value.empty())
           yymsg(0, "Uninitialized variable '%s'", (yyvsp[(1) - (3)].c));
         else if(!s.list)
@@ -7731,7 +7747,7 @@ yyreduce:
     break;
 
   case 89:
-#line 887 "Gmsh.y"
+#line 903 "Gmsh.y"
     {
       gmsh_yysymbol &s(gmsh_yysymbols[(yyvsp[(1) - (6)].c)]);
       s.list = true;
@@ -7763,7 +7779,7 @@ yyreduce:
     break;
 
   case 90:
-#line 916 "Gmsh.y"
+#line 932 "Gmsh.y"
     {
       assignVariables((yyvsp[(1) - (9)].c), (yyvsp[(4) - (9)].l), (yyvsp[(7) - (9)].i), (yyvsp[(8) - (9)].l));
       Free((yyvsp[(1) - (9)].c));
@@ -7773,7 +7789,7 @@ yyreduce:
     break;
 
   case 91:
-#line 926 "Gmsh.y"
+#line 942 "Gmsh.y"
     {
       assignVariable((yyvsp[(1) - (7)].c), (int)(yyvsp[(3) - (7)].d), (yyvsp[(5) - (7)].i), (yyvsp[(6) - (7)].d));
       Free((yyvsp[(1) - (7)].c));
@@ -7781,7 +7797,7 @@ yyreduce:
     break;
 
   case 92:
-#line 931 "Gmsh.y"
+#line 947 "Gmsh.y"
     {
       incrementVariable((yyvsp[(1) - (6)].c), (int)(yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].i));
       Free((yyvsp[(1) - (6)].c));
@@ -7789,7 +7805,7 @@ yyreduce:
     break;
 
   case 93:
-#line 939 "Gmsh.y"
+#line 955 "Gmsh.y"
     {
       assignVariable((yyvsp[(1) - (7)].c), (int)(yyvsp[(3) - (7)].d), (yyvsp[(5) - (7)].i), (yyvsp[(6) - (7)].d));
       Free((yyvsp[(1) - (7)].c));
@@ -7797,7 +7813,7 @@ yyreduce:
     break;
 
   case 94:
-#line 944 "Gmsh.y"
+#line 960 "Gmsh.y"
     {
       incrementVariable((yyvsp[(1) - (6)].c), (yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].i));
       Free((yyvsp[(1) - (6)].c));
@@ -7805,7 +7821,7 @@ yyreduce:
     break;
 
   case 95:
-#line 952 "Gmsh.y"
+#line 968 "Gmsh.y"
     {
       gmsh_yystringsymbols[(yyvsp[(1) - (4)].c)] = std::vector<std::string>(1, (yyvsp[(3) - (4)].c));
       Free((yyvsp[(1) - (4)].c));
@@ -7814,7 +7830,7 @@ yyreduce:
     break;
 
   case 96:
-#line 961 "Gmsh.y"
+#line 977 "Gmsh.y"
     {
       gmsh_yystringsymbols[(yyvsp[(1) - (8)].c)] = std::vector<std::string>();
       Free((yyvsp[(1) - (8)].c));
@@ -7822,7 +7838,7 @@ yyreduce:
     break;
 
   case 97:
-#line 966 "Gmsh.y"
+#line 982 "Gmsh.y"
     {
       std::vector<std::string> s;
       for(int i = 0; i < List_Nbr((yyvsp[(7) - (9)].l)); i++){
@@ -7837,7 +7853,7 @@ yyreduce:
     break;
 
   case 98:
-#line 978 "Gmsh.y"
+#line 994 "Gmsh.y"
     {
       if(gmsh_yystringsymbols.count((yyvsp[(1) - (9)].c))){
         for(int i = 0; i < List_Nbr((yyvsp[(7) - (9)].l)); i++){
@@ -7854,7 +7870,7 @@ yyreduce:
     break;
 
   case 99:
-#line 995 "Gmsh.y"
+#line 1011 "Gmsh.y"
     {
       std::string tmp((yyvsp[(5) - (6)].c));
       StringOption(GMSH_SET|GMSH_GUI, (yyvsp[(1) - (6)].c), 0, (yyvsp[(3) - (6)].c), tmp);
@@ -7863,7 +7879,7 @@ yyreduce:
     break;
 
   case 100:
-#line 1001 "Gmsh.y"
+#line 1017 "Gmsh.y"
     {
       std::string tmp((yyvsp[(8) - (9)].c));
       StringOption(GMSH_SET|GMSH_GUI, (yyvsp[(1) - (9)].c), (int)(yyvsp[(3) - (9)].d), (yyvsp[(6) - (9)].c), tmp);
@@ -7872,7 +7888,7 @@ yyreduce:
     break;
 
   case 101:
-#line 1010 "Gmsh.y"
+#line 1026 "Gmsh.y"
     {
       double d = 0.;
       if(NumberOption(GMSH_GET, (yyvsp[(1) - (6)].c), 0, (yyvsp[(3) - (6)].c), d)){
@@ -7893,7 +7909,7 @@ yyreduce:
     break;
 
   case 102:
-#line 1028 "Gmsh.y"
+#line 1044 "Gmsh.y"
     {
       double d = 0.;
       if(NumberOption(GMSH_GET, (yyvsp[(1) - (9)].c), (int)(yyvsp[(3) - (9)].d), (yyvsp[(6) - (9)].c), d)){
@@ -7914,7 +7930,7 @@ yyreduce:
     break;
 
   case 103:
-#line 1046 "Gmsh.y"
+#line 1062 "Gmsh.y"
     {
       double d = 0.;
       if(NumberOption(GMSH_GET, (yyvsp[(1) - (5)].c), 0, (yyvsp[(3) - (5)].c), d)){
@@ -7926,7 +7942,7 @@ yyreduce:
     break;
 
   case 104:
-#line 1055 "Gmsh.y"
+#line 1071 "Gmsh.y"
     {
       double d = 0.;
       if(NumberOption(GMSH_GET, (yyvsp[(1) - (8)].c), (int)(yyvsp[(3) - (8)].d), (yyvsp[(6) - (8)].c), d)){
@@ -7938,7 +7954,7 @@ yyreduce:
     break;
 
   case 105:
-#line 1067 "Gmsh.y"
+#line 1083 "Gmsh.y"
     {
       ColorOption(GMSH_SET|GMSH_GUI, (yyvsp[(1) - (8)].c), 0, (yyvsp[(5) - (8)].c), (yyvsp[(7) - (8)].u));
       Free((yyvsp[(1) - (8)].c)); Free((yyvsp[(5) - (8)].c));
@@ -7946,7 +7962,7 @@ yyreduce:
     break;
 
   case 106:
-#line 1072 "Gmsh.y"
+#line 1088 "Gmsh.y"
     {
       ColorOption(GMSH_SET|GMSH_GUI, (yyvsp[(1) - (11)].c), (int)(yyvsp[(3) - (11)].d), (yyvsp[(8) - (11)].c), (yyvsp[(10) - (11)].u));
       Free((yyvsp[(1) - (11)].c)); Free((yyvsp[(8) - (11)].c));
@@ -7954,7 +7970,7 @@ yyreduce:
     break;
 
   case 107:
-#line 1080 "Gmsh.y"
+#line 1096 "Gmsh.y"
     {
       GmshColorTable *ct = GetColorTable(0);
       if(!ct)
@@ -7977,7 +7993,7 @@ yyreduce:
     break;
 
   case 108:
-#line 1100 "Gmsh.y"
+#line 1116 "Gmsh.y"
     {
       GmshColorTable *ct = GetColorTable((int)(yyvsp[(3) - (9)].d));
       if(!ct)
@@ -8000,7 +8016,7 @@ yyreduce:
     break;
 
   case 109:
-#line 1123 "Gmsh.y"
+#line 1139 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(4) - (5)].l), tags);
@@ -8023,7 +8039,7 @@ yyreduce:
     break;
 
   case 110:
-#line 1143 "Gmsh.y"
+#line 1159 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       if(!GModel::current()->getFields()->newField((int)(yyvsp[(3) - (7)].d), (yyvsp[(6) - (7)].c)))
@@ -8034,7 +8050,7 @@ yyreduce:
     break;
 
   case 111:
-#line 1151 "Gmsh.y"
+#line 1167 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       Field *field = GModel::current()->getFields()->get((int)(yyvsp[(3) - (9)].d));
@@ -8059,7 +8075,7 @@ yyreduce:
     break;
 
   case 112:
-#line 1173 "Gmsh.y"
+#line 1189 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       Field *field = GModel::current()->getFields()->get((int)(yyvsp[(3) - (9)].d));
@@ -8085,7 +8101,7 @@ yyreduce:
     break;
 
   case 113:
-#line 1196 "Gmsh.y"
+#line 1212 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       Field *field = GModel::current()->getFields()->get((int)(yyvsp[(3) - (11)].d));
@@ -8126,7 +8142,7 @@ yyreduce:
     break;
 
   case 114:
-#line 1234 "Gmsh.y"
+#line 1250 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       Field *field = GModel::current()->getFields()->get((int)(yyvsp[(3) - (7)].d));
@@ -8147,7 +8163,7 @@ yyreduce:
     break;
 
   case 115:
-#line 1255 "Gmsh.y"
+#line 1271 "Gmsh.y"
     {
 #if defined(HAVE_PLUGINS)
       try {
@@ -8162,7 +8178,7 @@ yyreduce:
     break;
 
   case 116:
-#line 1267 "Gmsh.y"
+#line 1283 "Gmsh.y"
     {
 #if defined(HAVE_PLUGINS)
       try {
@@ -8177,7 +8193,7 @@ yyreduce:
     break;
 
   case 120:
-#line 1285 "Gmsh.y"
+#line 1301 "Gmsh.y"
     {
       std::string key((yyvsp[(3) - (3)].c));
       std::vector<double> val(1, 0.);
@@ -8189,7 +8205,7 @@ yyreduce:
     break;
 
   case 121:
-#line 1294 "Gmsh.y"
+#line 1310 "Gmsh.y"
     {
       std::string key((yyvsp[(3) - (5)].c));
       std::vector<double> val(1, (yyvsp[(5) - (5)].d));
@@ -8201,12 +8217,12 @@ yyreduce:
     break;
 
   case 122:
-#line 1303 "Gmsh.y"
+#line 1319 "Gmsh.y"
     { init_options(); ;}
     break;
 
   case 123:
-#line 1305 "Gmsh.y"
+#line 1321 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(6) - (9)].l)) != 1)
 	yymsg(1, "List notation should be used to define list '%s[]'", (yyvsp[(3) - (9)].c));
@@ -8227,12 +8243,12 @@ yyreduce:
     break;
 
   case 124:
-#line 1323 "Gmsh.y"
+#line 1339 "Gmsh.y"
     { init_options(); ;}
     break;
 
   case 125:
-#line 1325 "Gmsh.y"
+#line 1341 "Gmsh.y"
     {
       std::string key((yyvsp[(3) - (11)].c));
       std::vector<double> val;
@@ -8251,7 +8267,7 @@ yyreduce:
     break;
 
   case 126:
-#line 1341 "Gmsh.y"
+#line 1357 "Gmsh.y"
     {
       std::string key((yyvsp[(3) - (5)].c)), val((yyvsp[(5) - (5)].c));
       if(!gmsh_yystringsymbols.count(key)){
@@ -8263,12 +8279,12 @@ yyreduce:
     break;
 
   case 127:
-#line 1350 "Gmsh.y"
+#line 1366 "Gmsh.y"
     { init_options(); ;}
     break;
 
   case 128:
-#line 1352 "Gmsh.y"
+#line 1368 "Gmsh.y"
     {
       std::string key((yyvsp[(3) - (9)].c)), val((yyvsp[(6) - (9)].c));
       if(!gmsh_yystringsymbols.count(key)){
@@ -8281,7 +8297,7 @@ yyreduce:
     break;
 
   case 130:
-#line 1366 "Gmsh.y"
+#line 1382 "Gmsh.y"
     {
       std::string name((yyvsp[(3) - (3)].c));
       Msg::UndefineOnelabParameter(name);
@@ -8290,7 +8306,7 @@ yyreduce:
     break;
 
   case 131:
-#line 1374 "Gmsh.y"
+#line 1390 "Gmsh.y"
     {
       (yyval.l) = List_Create(20,20,sizeof(doubleXstring));
       doubleXstring v = {(yyvsp[(1) - (3)].d), (yyvsp[(3) - (3)].c)};
@@ -8299,7 +8315,7 @@ yyreduce:
     break;
 
   case 132:
-#line 1380 "Gmsh.y"
+#line 1396 "Gmsh.y"
     {
       doubleXstring v = {(yyvsp[(3) - (5)].d), (yyvsp[(5) - (5)].c)};
       List_Add((yyval.l), &v);
@@ -8307,7 +8323,7 @@ yyreduce:
     break;
 
   case 133:
-#line 1385 "Gmsh.y"
+#line 1401 "Gmsh.y"
     {
       (yyval.l) = List_Create(20,20,sizeof(doubleXstring));
       int n = List_Nbr((yyvsp[(1) - (5)].l));
@@ -8335,7 +8351,7 @@ yyreduce:
     break;
 
   case 140:
-#line 1428 "Gmsh.y"
+#line 1444 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       for(int i = 0; i < List_Nbr((yyvsp[(2) - (2)].l)); i++){
@@ -8350,21 +8366,21 @@ yyreduce:
     break;
 
   case 141:
-#line 1440 "Gmsh.y"
+#line 1456 "Gmsh.y"
     {
       floatOptions["Min"].push_back((yyvsp[(2) - (2)].d));
     ;}
     break;
 
   case 142:
-#line 1444 "Gmsh.y"
+#line 1460 "Gmsh.y"
     {
       floatOptions["Max"].push_back((yyvsp[(2) - (2)].d));
     ;}
     break;
 
   case 143:
-#line 1448 "Gmsh.y"
+#line 1464 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (1)].c));
       double v;
@@ -8380,7 +8396,7 @@ yyreduce:
     break;
 
   case 144:
-#line 1461 "Gmsh.y"
+#line 1477 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (4)].c));
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (4)].l)); i++){
@@ -8397,7 +8413,7 @@ yyreduce:
     break;
 
   case 145:
-#line 1475 "Gmsh.y"
+#line 1491 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       std::string val((yyvsp[(2) - (2)].c));
@@ -8408,7 +8424,7 @@ yyreduce:
     break;
 
   case 146:
-#line 1483 "Gmsh.y"
+#line 1499 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       for(int i = 0; i < List_Nbr((yyvsp[(2) - (2)].l)); i++){
@@ -8422,7 +8438,7 @@ yyreduce:
     break;
 
   case 151:
-#line 1508 "Gmsh.y"
+#line 1524 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       double val = (yyvsp[(2) - (2)].d);
@@ -8432,7 +8448,7 @@ yyreduce:
     break;
 
   case 152:
-#line 1516 "Gmsh.y"
+#line 1532 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       std::string val((yyvsp[(2) - (2)].c));
@@ -8443,7 +8459,7 @@ yyreduce:
     break;
 
   case 153:
-#line 1525 "Gmsh.y"
+#line 1541 "Gmsh.y"
     {
       std::string key("Macro");
       std::string val((yyvsp[(2) - (2)].c));
@@ -8453,7 +8469,7 @@ yyreduce:
     break;
 
   case 154:
-#line 1533 "Gmsh.y"
+#line 1549 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       for(int i = 0; i < List_Nbr((yyvsp[(2) - (2)].l)); i++){
@@ -8469,7 +8485,7 @@ yyreduce:
     break;
 
   case 155:
-#line 1547 "Gmsh.y"
+#line 1563 "Gmsh.y"
     {
       std::string key((yyvsp[(1) - (2)].c));
       for(int i = 0; i < List_Nbr((yyvsp[(2) - (2)].l)); i++){
@@ -8485,14 +8501,14 @@ yyreduce:
     break;
 
   case 156:
-#line 1565 "Gmsh.y"
+#line 1581 "Gmsh.y"
     {
       (yyval.i) = (int)(yyvsp[(1) - (1)].d);
     ;}
     break;
 
   case 157:
-#line 1569 "Gmsh.y"
+#line 1585 "Gmsh.y"
     {
       int t = GModel::current()->getGEOInternals()->getMaxPhysicalTag();
       GModel::current()->getGEOInternals()->setMaxPhysicalTag(t + 1);
@@ -8502,7 +8518,7 @@ yyreduce:
     break;
 
   case 158:
-#line 1576 "Gmsh.y"
+#line 1592 "Gmsh.y"
     {
       (yyval.i) = GModel::current()->setPhysicalName(std::string((yyvsp[(1) - (3)].c)), dim_entity, (yyvsp[(3) - (3)].d));
       Free((yyvsp[(1) - (3)].c));
@@ -8510,14 +8526,14 @@ yyreduce:
     break;
 
   case 159:
-#line 1584 "Gmsh.y"
+#line 1600 "Gmsh.y"
     {
       (yyval.l) = 0;
     ;}
     break;
 
   case 160:
-#line 1588 "Gmsh.y"
+#line 1604 "Gmsh.y"
     {
       (yyval.l) = List_Create(1, 1, sizeof(double));
       double p = (yyvsp[(4) - (5)].d);
@@ -8526,14 +8542,14 @@ yyreduce:
     break;
 
   case 161:
-#line 1594 "Gmsh.y"
+#line 1610 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(4) - (5)].l);
     ;}
     break;
 
   case 162:
-#line 1598 "Gmsh.y"
+#line 1614 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       double flag = -1;
@@ -8545,35 +8561,35 @@ yyreduce:
     break;
 
   case 163:
-#line 1609 "Gmsh.y"
+#line 1625 "Gmsh.y"
     {
       for(int i = 0; i < 4; i++) (yyval.v)[i] = 0.;
     ;}
     break;
 
   case 164:
-#line 1613 "Gmsh.y"
+#line 1629 "Gmsh.y"
     {
       for(int i = 0; i < 4; i++) (yyval.v)[i] = (yyvsp[(2) - (2)].v)[i];
     ;}
     break;
 
   case 165:
-#line 1619 "Gmsh.y"
+#line 1635 "Gmsh.y"
     {
       (yyval.d) = 0;
     ;}
     break;
 
   case 166:
-#line 1623 "Gmsh.y"
+#line 1639 "Gmsh.y"
     {
       (yyval.d) = 1;
     ;}
     break;
 
   case 167:
-#line 1629 "Gmsh.y"
+#line 1645 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       double x = CTX::instance()->geom.scalingFactor * (yyvsp[(6) - (7)].v)[0];
@@ -8599,7 +8615,7 @@ yyreduce:
     break;
 
   case 168:
-#line 1652 "Gmsh.y"
+#line 1668 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -8618,7 +8634,7 @@ yyreduce:
     break;
 
   case 169:
-#line 1668 "Gmsh.y"
+#line 1684 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -8637,7 +8653,7 @@ yyreduce:
     break;
 
   case 170:
-#line 1684 "Gmsh.y"
+#line 1700 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (10)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(7) - (10)].l), tags);
@@ -8657,7 +8673,7 @@ yyreduce:
     break;
 
   case 171:
-#line 1701 "Gmsh.y"
+#line 1717 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (10)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(7) - (10)].l), tags);
@@ -8677,7 +8693,7 @@ yyreduce:
     break;
 
   case 172:
-#line 1718 "Gmsh.y"
+#line 1734 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (8)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (8)].l), tags);
@@ -8717,7 +8733,7 @@ yyreduce:
     break;
 
   case 173:
-#line 1755 "Gmsh.y"
+#line 1771 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (8)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (8)].l), tags);
@@ -8764,7 +8780,7 @@ yyreduce:
     break;
 
   case 174:
-#line 1799 "Gmsh.y"
+#line 1815 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -8783,7 +8799,7 @@ yyreduce:
     break;
 
   case 175:
-#line 1815 "Gmsh.y"
+#line 1831 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -8802,7 +8818,7 @@ yyreduce:
     break;
 
   case 176:
-#line 1832 "Gmsh.y"
+#line 1848 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (11)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (11)].l), tags);
@@ -8836,7 +8852,7 @@ yyreduce:
     break;
 
   case 177:
-#line 1863 "Gmsh.y"
+#line 1879 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -8855,7 +8871,7 @@ yyreduce:
     break;
 
   case 178:
-#line 1879 "Gmsh.y"
+#line 1895 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (8)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(7) - (8)].l), tags);
@@ -8875,7 +8891,7 @@ yyreduce:
     break;
 
   case 179:
-#line 1896 "Gmsh.y"
+#line 1912 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (8)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(7) - (8)].l), tags);
@@ -8894,7 +8910,7 @@ yyreduce:
     break;
 
   case 180:
-#line 1912 "Gmsh.y"
+#line 1928 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (8)].d);
       std::vector<int> wires; ListOfDouble2Vector((yyvsp[(6) - (8)].l), wires);
@@ -8947,7 +8963,7 @@ yyreduce:
     break;
 
   case 181:
-#line 1962 "Gmsh.y"
+#line 1978 "Gmsh.y"
     {
       yymsg(2, "'Ruled Surface' command is deprecated: use 'Surface' instead");
       int num = (int)(yyvsp[(4) - (9)].d);
@@ -8968,7 +8984,7 @@ yyreduce:
     break;
 
   case 182:
-#line 1980 "Gmsh.y"
+#line 1996 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (8)].d);
       std::vector<int> wires; ListOfDouble2Vector((yyvsp[(7) - (8)].l), wires);
@@ -8992,7 +9008,7 @@ yyreduce:
     break;
 
   case 183:
-#line 2001 "Gmsh.y"
+#line 2017 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (8)].d);
       std::vector<int> wires; ListOfDouble2Vector((yyvsp[(7) - (8)].l), wires);
@@ -9016,7 +9032,7 @@ yyreduce:
     break;
 
   case 184:
-#line 2022 "Gmsh.y"
+#line 2038 "Gmsh.y"
     {
       myGmshSurface = 0;
       (yyval.s).Type = 0;
@@ -9025,7 +9041,7 @@ yyreduce:
     break;
 
   case 185:
-#line 2028 "Gmsh.y"
+#line 2044 "Gmsh.y"
     {
       myGmshSurface = gmshSurface::getSurface((int)(yyvsp[(3) - (4)].d));
       (yyval.s).Type = 0;
@@ -9034,7 +9050,7 @@ yyreduce:
     break;
 
   case 186:
-#line 2034 "Gmsh.y"
+#line 2050 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (10)].d);
       myGmshSurface = gmshParametricSurface::NewParametricSurface(num, (yyvsp[(7) - (10)].c), (yyvsp[(8) - (10)].c), (yyvsp[(9) - (10)].c));
@@ -9044,7 +9060,7 @@ yyreduce:
     break;
 
   case 187:
-#line 2041 "Gmsh.y"
+#line 2057 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -9078,7 +9094,7 @@ yyreduce:
     break;
 
   case 188:
-#line 2072 "Gmsh.y"
+#line 2088 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -9096,7 +9112,7 @@ yyreduce:
     break;
 
   case 189:
-#line 2087 "Gmsh.y"
+#line 2103 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9121,7 +9137,7 @@ yyreduce:
     break;
 
   case 190:
-#line 2109 "Gmsh.y"
+#line 2125 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9147,7 +9163,7 @@ yyreduce:
     break;
 
   case 191:
-#line 2132 "Gmsh.y"
+#line 2148 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9173,7 +9189,7 @@ yyreduce:
     break;
 
   case 192:
-#line 2155 "Gmsh.y"
+#line 2171 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9199,7 +9215,7 @@ yyreduce:
     break;
 
   case 193:
-#line 2178 "Gmsh.y"
+#line 2194 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9226,7 +9242,7 @@ yyreduce:
     break;
 
   case 194:
-#line 2202 "Gmsh.y"
+#line 2218 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9253,7 +9269,7 @@ yyreduce:
     break;
 
   case 195:
-#line 2226 "Gmsh.y"
+#line 2242 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9280,7 +9296,7 @@ yyreduce:
     break;
 
   case 196:
-#line 2250 "Gmsh.y"
+#line 2266 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<double> param; ListOfDouble2Vector((yyvsp[(6) - (7)].l), param);
@@ -9309,7 +9325,7 @@ yyreduce:
     break;
 
   case 197:
-#line 2276 "Gmsh.y"
+#line 2292 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (9)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(7) - (9)].l), tags);
@@ -9329,7 +9345,7 @@ yyreduce:
     break;
 
   case 198:
-#line 2293 "Gmsh.y"
+#line 2309 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (7)].l), tags);
@@ -9348,7 +9364,7 @@ yyreduce:
     break;
 
   case 199:
-#line 2309 "Gmsh.y"
+#line 2325 "Gmsh.y"
     {
       int num = (int)(yyvsp[(3) - (7)].d);
       std::vector<int> wires; ListOfDouble2Vector((yyvsp[(6) - (7)].l), wires);
@@ -9369,7 +9385,7 @@ yyreduce:
     break;
 
   case 200:
-#line 2327 "Gmsh.y"
+#line 2343 "Gmsh.y"
     {
       int num = (int)(yyvsp[(4) - (8)].d);
       std::vector<int> wires; ListOfDouble2Vector((yyvsp[(7) - (8)].l), wires);
@@ -9390,7 +9406,7 @@ yyreduce:
     break;
 
   case 201:
-#line 2345 "Gmsh.y"
+#line 2361 "Gmsh.y"
     {
       if((yyvsp[(2) - (8)].i) == 1)
         yymsg(0, "`Compound Line (...) = {...};' is deprecated: use `Compound "
@@ -9405,7 +9421,7 @@ yyreduce:
     break;
 
   case 202:
-#line 2358 "Gmsh.y"
+#line 2374 "Gmsh.y"
     {
       if((yyvsp[(2) - (12)].i) == 1)
         yymsg(0, "`Compound Line (...) = {...};' is deprecated: use `Compound "
@@ -9420,14 +9436,14 @@ yyreduce:
     break;
 
   case 203:
-#line 2370 "Gmsh.y"
+#line 2386 "Gmsh.y"
     {
       dim_entity = (yyvsp[(2) - (2)].i);
     ;}
     break;
 
   case 204:
-#line 2374 "Gmsh.y"
+#line 2390 "Gmsh.y"
     {
       int num = (int)(yyvsp[(5) - (9)].i);
       int op = (yyvsp[(7) - (9)].i);
@@ -9453,27 +9469,27 @@ yyreduce:
     break;
 
   case 205:
-#line 2400 "Gmsh.y"
+#line 2416 "Gmsh.y"
     { (yyval.i) = 0; ;}
     break;
 
   case 206:
-#line 2402 "Gmsh.y"
+#line 2418 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 207:
-#line 2404 "Gmsh.y"
+#line 2420 "Gmsh.y"
     { (yyval.i) = 2; ;}
     break;
 
   case 208:
-#line 2406 "Gmsh.y"
+#line 2422 "Gmsh.y"
     { (yyval.i) = 3; ;}
     break;
 
   case 209:
-#line 2408 "Gmsh.y"
+#line 2424 "Gmsh.y"
     {
       (yyval.i) = (int)(yyvsp[(3) - (4)].d);
       if ((yyval.i)<0 || (yyval.i)>3) yymsg(0, "GeoEntity dim out of range [0,3]");
@@ -9481,22 +9497,22 @@ yyreduce:
     break;
 
   case 210:
-#line 2416 "Gmsh.y"
+#line 2432 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 211:
-#line 2418 "Gmsh.y"
+#line 2434 "Gmsh.y"
     { (yyval.i) = 2; ;}
     break;
 
   case 212:
-#line 2420 "Gmsh.y"
+#line 2436 "Gmsh.y"
     { (yyval.i) = 3; ;}
     break;
 
   case 213:
-#line 2422 "Gmsh.y"
+#line 2438 "Gmsh.y"
     {
       (yyval.i) = (int)(yyvsp[(3) - (4)].d);
       if ((yyval.i)<1 || (yyval.i)>3) yymsg(0, "GeoEntity dim out of range [1,3]");
@@ -9504,17 +9520,17 @@ yyreduce:
     break;
 
   case 214:
-#line 2430 "Gmsh.y"
+#line 2446 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 215:
-#line 2432 "Gmsh.y"
+#line 2448 "Gmsh.y"
     { (yyval.i) = 2; ;}
     break;
 
   case 216:
-#line 2434 "Gmsh.y"
+#line 2450 "Gmsh.y"
     {
       (yyval.i) = (int)(yyvsp[(3) - (4)].d);
       if ((yyval.i)<1 || (yyval.i)>2) yymsg(0, "GeoEntity dim out of range [1,2]");
@@ -9522,22 +9538,22 @@ yyreduce:
     break;
 
   case 217:
-#line 2442 "Gmsh.y"
+#line 2458 "Gmsh.y"
     { (yyval.i) = 0; ;}
     break;
 
   case 218:
-#line 2444 "Gmsh.y"
+#line 2460 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 219:
-#line 2446 "Gmsh.y"
+#line 2462 "Gmsh.y"
     { (yyval.i) = 2; ;}
     break;
 
   case 220:
-#line 2448 "Gmsh.y"
+#line 2464 "Gmsh.y"
     {
       (yyval.i) = (int)(yyvsp[(3) - (4)].d);
       if ((yyval.i)<0 || (yyval.i)>2) yymsg(0, "GeoEntity dim out of range [0,2]");
@@ -9545,7 +9561,7 @@ yyreduce:
     break;
 
   case 221:
-#line 2458 "Gmsh.y"
+#line 2474 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -9564,7 +9580,7 @@ yyreduce:
     break;
 
   case 222:
-#line 2474 "Gmsh.y"
+#line 2490 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(10) - (11)].l), dimTags);
@@ -9583,7 +9599,7 @@ yyreduce:
     break;
 
   case 223:
-#line 2490 "Gmsh.y"
+#line 2506 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -9602,7 +9618,7 @@ yyreduce:
     break;
 
   case 224:
-#line 2506 "Gmsh.y"
+#line 2522 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(8) - (9)].l), dimTags);
@@ -9621,7 +9637,7 @@ yyreduce:
     break;
 
   case 225:
-#line 2522 "Gmsh.y"
+#line 2538 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(8) - (9)].l), dimTags);
@@ -9640,7 +9656,7 @@ yyreduce:
     break;
 
   case 226:
-#line 2538 "Gmsh.y"
+#line 2554 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(6) - (7)].l), dimTags);
@@ -9660,7 +9676,7 @@ yyreduce:
     break;
 
   case 227:
-#line 2555 "Gmsh.y"
+#line 2571 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (4)].l), inDimTags);
@@ -9700,7 +9716,7 @@ yyreduce:
     break;
 
   case 228:
-#line 2592 "Gmsh.y"
+#line 2608 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -9724,7 +9740,7 @@ yyreduce:
     break;
 
   case 229:
-#line 2613 "Gmsh.y"
+#line 2629 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -9748,7 +9764,7 @@ yyreduce:
     break;
 
   case 230:
-#line 2634 "Gmsh.y"
+#line 2650 "Gmsh.y"
     {
       yymsg(2, "'Split Curve(c) {...}' is deprecated: "
             "use 'Split Curve {c} Point {...}' instead");
@@ -9774,31 +9790,31 @@ yyreduce:
     break;
 
   case 231:
-#line 2659 "Gmsh.y"
+#line 2675 "Gmsh.y"
     { (yyval.l) = (yyvsp[(1) - (1)].l); ;}
     break;
 
   case 232:
-#line 2660 "Gmsh.y"
+#line 2676 "Gmsh.y"
     { (yyval.l) = (yyvsp[(1) - (1)].l); ;}
     break;
 
   case 233:
-#line 2665 "Gmsh.y"
+#line 2681 "Gmsh.y"
     {
       (yyval.l) = List_Create(3, 3, sizeof(Shape));
     ;}
     break;
 
   case 234:
-#line 2669 "Gmsh.y"
+#line 2685 "Gmsh.y"
     {
       List_Add((yyval.l), &(yyvsp[(2) - (2)].s));
     ;}
     break;
 
   case 235:
-#line 2673 "Gmsh.y"
+#line 2689 "Gmsh.y"
     {
       for(int i = 0; i < List_Nbr((yyvsp[(4) - (6)].l)); i++){
 	double d;
@@ -9818,7 +9834,7 @@ yyreduce:
     break;
 
   case 236:
-#line 2690 "Gmsh.y"
+#line 2706 "Gmsh.y"
     {
       List_T *tmp = List_Create(10, 10, sizeof(double));
       getElementaryTagsForPhysicalGroups((yyvsp[(3) - (7)].i), (yyvsp[(5) - (7)].l), tmp);
@@ -9841,7 +9857,7 @@ yyreduce:
     break;
 
   case 237:
-#line 2710 "Gmsh.y"
+#line 2726 "Gmsh.y"
     {
       List_T *tmp = List_Create(10, 10, sizeof(double));
       getParentTags((yyvsp[(3) - (7)].i), (yyvsp[(5) - (7)].l), tmp);
@@ -9864,7 +9880,7 @@ yyreduce:
     break;
 
   case 238:
-#line 2730 "Gmsh.y"
+#line 2746 "Gmsh.y"
     {
       List_T *tmp = List_Create(10, 10, sizeof(double));
       getAllElementaryTags((yyvsp[(2) - (6)].i), tmp);
@@ -9886,7 +9902,7 @@ yyreduce:
     break;
 
   case 239:
-#line 2749 "Gmsh.y"
+#line 2765 "Gmsh.y"
     {
       List_T *tmp = List_Create(10, 10, sizeof(double));
       List_T *tmp2 = List_Create(10, 10, sizeof(double));
@@ -9911,7 +9927,7 @@ yyreduce:
     break;
 
   case 240:
-#line 2776 "Gmsh.y"
+#line 2792 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(7) - (8)].l)) == 4){
         int t = (int)(yyvsp[(4) - (8)].d);
@@ -9933,7 +9949,7 @@ yyreduce:
     break;
 
   case 241:
-#line 2795 "Gmsh.y"
+#line 2811 "Gmsh.y"
     {
       int t = (int)(yyvsp[(4) - (10)].d);
       if(gLevelset::find(t)){
@@ -9957,7 +9973,7 @@ yyreduce:
     break;
 
   case 242:
-#line 2817 "Gmsh.y"
+#line 2833 "Gmsh.y"
     {
       int t = (int)(yyvsp[(4) - (14)].d);
       if(gLevelset::find(t)){
@@ -9974,7 +9990,7 @@ yyreduce:
     break;
 
   case 243:
-#line 2832 "Gmsh.y"
+#line 2848 "Gmsh.y"
     {
       int t = (int)(yyvsp[(4) - (16)].d);
       if(gLevelset::find(t)){
@@ -9992,7 +10008,7 @@ yyreduce:
     break;
 
   case 244:
-#line 2847 "Gmsh.y"
+#line 2863 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(10) - (12)].l)) == 1){
         int t = (int)(yyvsp[(4) - (12)].d);
@@ -10013,7 +10029,7 @@ yyreduce:
     break;
 
   case 245:
-#line 2866 "Gmsh.y"
+#line 2882 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(12) - (14)].l)) == 1){
         int t = (int)(yyvsp[(4) - (14)].d);
@@ -10066,7 +10082,7 @@ yyreduce:
     break;
 
   case 246:
-#line 2917 "Gmsh.y"
+#line 2933 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(12) - (14)].l)) == 1){
         int t = (int)(yyvsp[(4) - (14)].d);
@@ -10089,7 +10105,7 @@ yyreduce:
     break;
 
   case 247:
-#line 2938 "Gmsh.y"
+#line 2954 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(12) - (14)].l)) == 3){
         int t = (int)(yyvsp[(4) - (14)].d);
@@ -10113,7 +10129,7 @@ yyreduce:
     break;
 
   case 248:
-#line 2960 "Gmsh.y"
+#line 2976 "Gmsh.y"
     {
       if(List_Nbr((yyvsp[(12) - (14)].l)) == 5){
         int t = (int)(yyvsp[(4) - (14)].d);
@@ -10138,7 +10154,7 @@ yyreduce:
     break;
 
   case 249:
-#line 2982 "Gmsh.y"
+#line 2998 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (8)].c), "Union")){
         int t = (int)(yyvsp[(4) - (8)].d);
@@ -10246,7 +10262,7 @@ yyreduce:
     break;
 
   case 250:
-#line 3087 "Gmsh.y"
+#line 3103 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (8)].c), "MathEval")){
         int t = (int)(yyvsp[(4) - (8)].d);
@@ -10265,7 +10281,7 @@ yyreduce:
     break;
 
   case 251:
-#line 3103 "Gmsh.y"
+#line 3119 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (6)].c), "CutMesh")){
         int t = (int)(yyvsp[(4) - (6)].d);
@@ -10298,7 +10314,7 @@ yyreduce:
     break;
 
   case 252:
-#line 3138 "Gmsh.y"
+#line 3154 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (4)].l), dimTags);
@@ -10323,7 +10339,7 @@ yyreduce:
     break;
 
   case 253:
-#line 3160 "Gmsh.y"
+#line 3176 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -10348,7 +10364,7 @@ yyreduce:
     break;
 
   case 254:
-#line 3182 "Gmsh.y"
+#line 3198 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -10363,7 +10379,7 @@ yyreduce:
     break;
 
   case 255:
-#line 3194 "Gmsh.y"
+#line 3210 "Gmsh.y"
     {
 #if defined(HAVE_MESH)
       GModel::current()->getFields()->deleteField((int)(yyvsp[(4) - (6)].d));
@@ -10372,7 +10388,7 @@ yyreduce:
     break;
 
   case 256:
-#line 3200 "Gmsh.y"
+#line 3216 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (6)].c), "View")){
@@ -10390,7 +10406,7 @@ yyreduce:
     break;
 
   case 257:
-#line 3215 "Gmsh.y"
+#line 3231 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (3)].c), "All")){
         ClearProject();
@@ -10424,7 +10440,7 @@ yyreduce:
     break;
 
   case 258:
-#line 3246 "Gmsh.y"
+#line 3262 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (4)].c), "Empty") && !strcmp((yyvsp[(3) - (4)].c), "Views")){
@@ -10439,14 +10455,14 @@ yyreduce:
     break;
 
   case 259:
-#line 3258 "Gmsh.y"
+#line 3274 "Gmsh.y"
     {
       gmsh_yynamespaces.clear();
     ;}
     break;
 
   case 260:
-#line 3267 "Gmsh.y"
+#line 3283 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -10456,7 +10472,7 @@ yyreduce:
     break;
 
   case 261:
-#line 3274 "Gmsh.y"
+#line 3290 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(5) - (6)].l), dimTags);
@@ -10466,7 +10482,7 @@ yyreduce:
     break;
 
   case 262:
-#line 3286 "Gmsh.y"
+#line 3302 "Gmsh.y"
     {
       yymsg(2, "'SetPartition' command is deprecated");
       std::vector<std::pair<int, int> > dimTags;
@@ -10484,14 +10500,14 @@ yyreduce:
     break;
 
   case 263:
-#line 3306 "Gmsh.y"
+#line 3322 "Gmsh.y"
     {
       setVisibility(-1, 1, false);
     ;}
     break;
 
   case 264:
-#line 3310 "Gmsh.y"
+#line 3326 "Gmsh.y"
     {
       setVisibility(-1, 1, false);
       Free((yyvsp[(2) - (3)].c));
@@ -10499,14 +10515,14 @@ yyreduce:
     break;
 
   case 265:
-#line 3315 "Gmsh.y"
+#line 3331 "Gmsh.y"
     {
       setVisibility(-1, 0, false);
     ;}
     break;
 
   case 266:
-#line 3319 "Gmsh.y"
+#line 3335 "Gmsh.y"
     {
       setVisibility(-1, 0, false);
       Free((yyvsp[(2) - (3)].c));
@@ -10514,7 +10530,7 @@ yyreduce:
     break;
 
   case 267:
-#line 3324 "Gmsh.y"
+#line 3340 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (4)].l), dimTags);
@@ -10524,7 +10540,7 @@ yyreduce:
     break;
 
   case 268:
-#line 3331 "Gmsh.y"
+#line 3347 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -10534,7 +10550,7 @@ yyreduce:
     break;
 
   case 269:
-#line 3338 "Gmsh.y"
+#line 3354 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (4)].l), dimTags);
@@ -10544,7 +10560,7 @@ yyreduce:
     break;
 
   case 270:
-#line 3345 "Gmsh.y"
+#line 3361 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), dimTags);
@@ -10554,7 +10570,7 @@ yyreduce:
     break;
 
   case 271:
-#line 3357 "Gmsh.y"
+#line 3373 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(1) - (3)].c), "Include")){
         std::string tmp = FixRelativePath(gmsh_yyname, (yyvsp[(2) - (3)].c));
@@ -10630,7 +10646,7 @@ yyreduce:
     break;
 
   case 272:
-#line 3430 "Gmsh.y"
+#line 3446 "Gmsh.y"
     {
       int n = List_Nbr((yyvsp[(3) - (5)].l));
       if(n == 1){
@@ -10651,7 +10667,7 @@ yyreduce:
     break;
 
   case 273:
-#line 3448 "Gmsh.y"
+#line 3464 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (7)].c), "View")){
@@ -10679,7 +10695,7 @@ yyreduce:
     break;
 
   case 274:
-#line 3473 "Gmsh.y"
+#line 3489 "Gmsh.y"
     {
 #if defined(HAVE_POST) && defined(HAVE_MESH)
       if(!strcmp((yyvsp[(1) - (7)].c), "Background") && !strcmp((yyvsp[(2) - (7)].c), "Mesh")  && !strcmp((yyvsp[(3) - (7)].c), "View")){
@@ -10697,7 +10713,7 @@ yyreduce:
     break;
 
   case 275:
-#line 3488 "Gmsh.y"
+#line 3504 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(1) - (3)].c), "Sleep")){
 	SleepInSeconds((yyvsp[(2) - (3)].d));
@@ -10733,7 +10749,7 @@ yyreduce:
     break;
 
   case 276:
-#line 3521 "Gmsh.y"
+#line 3537 "Gmsh.y"
     {
 #if defined(HAVE_PLUGINS)
        try {
@@ -10748,7 +10764,7 @@ yyreduce:
     break;
 
   case 277:
-#line 3533 "Gmsh.y"
+#line 3549 "Gmsh.y"
     {
 #if defined(HAVE_POST)
       if(!strcmp((yyvsp[(2) - (3)].c), "ElementsFromAllViews"))
@@ -10783,14 +10799,14 @@ yyreduce:
     break;
 
   case 278:
-#line 3565 "Gmsh.y"
+#line 3581 "Gmsh.y"
     {
       Msg::Exit(0);
     ;}
     break;
 
   case 279:
-#line 3569 "Gmsh.y"
+#line 3585 "Gmsh.y"
     {
       gmsh_yyerrorstate = 999; // this will be checked when yyparse returns
       YYABORT;
@@ -10798,7 +10814,7 @@ yyreduce:
     break;
 
   case 280:
-#line 3574 "Gmsh.y"
+#line 3590 "Gmsh.y"
     {
       // force sync
       if(GModel::current()->getOCCInternals())
@@ -10808,7 +10824,7 @@ yyreduce:
     break;
 
   case 281:
-#line 3581 "Gmsh.y"
+#line 3597 "Gmsh.y"
     {
       new GModel();
       GModel::current(GModel::list.size() - 1);
@@ -10816,7 +10832,7 @@ yyreduce:
     break;
 
   case 282:
-#line 3586 "Gmsh.y"
+#line 3602 "Gmsh.y"
     {
       CTX::instance()->forcedBBox = 0;
       if(GModel::current()->getOCCInternals() &&
@@ -10829,7 +10845,7 @@ yyreduce:
     break;
 
   case 283:
-#line 3596 "Gmsh.y"
+#line 3612 "Gmsh.y"
     {
       CTX::instance()->forcedBBox = 1;
       SetBoundingBox((yyvsp[(3) - (15)].d), (yyvsp[(5) - (15)].d), (yyvsp[(7) - (15)].d), (yyvsp[(9) - (15)].d), (yyvsp[(11) - (15)].d), (yyvsp[(13) - (15)].d));
@@ -10837,7 +10853,7 @@ yyreduce:
     break;
 
   case 284:
-#line 3601 "Gmsh.y"
+#line 3617 "Gmsh.y"
     {
 #if defined(HAVE_OPENGL)
       drawContext::global()->draw();
@@ -10846,7 +10862,7 @@ yyreduce:
     break;
 
   case 285:
-#line 3607 "Gmsh.y"
+#line 3623 "Gmsh.y"
     {
 #if defined(HAVE_OPENGL)
      CTX::instance()->mesh.changed = ENT_ALL;
@@ -10857,7 +10873,7 @@ yyreduce:
     break;
 
   case 286:
-#line 3615 "Gmsh.y"
+#line 3631 "Gmsh.y"
     {
       GModel::current()->makeDiscreteRegionsSimplyConnected();
       GModel::current()->makeDiscreteFacesSimplyConnected();
@@ -10868,28 +10884,28 @@ yyreduce:
     break;
 
   case 287:
-#line 3623 "Gmsh.y"
+#line 3639 "Gmsh.y"
     {
       GModel::current()->classifySurfaces((yyvsp[(3) - (9)].d), (yyvsp[(5) - (9)].d), (yyvsp[(7) - (9)].d), M_PI);
     ;}
     break;
 
   case 288:
-#line 3627 "Gmsh.y"
+#line 3643 "Gmsh.y"
     {
       GModel::current()->classifySurfaces((yyvsp[(3) - (11)].d), (yyvsp[(5) - (11)].d), (yyvsp[(7) - (11)].d), (yyvsp[(9) - (11)].d));
     ;}
     break;
 
   case 289:
-#line 3631 "Gmsh.y"
+#line 3647 "Gmsh.y"
     {
       GModel::current()->createGeometryOfDiscreteEntities();
     ;}
     break;
 
   case 290:
-#line 3635 "Gmsh.y"
+#line 3651 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > dimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (4)].l), dimTags);
@@ -10899,21 +10915,21 @@ yyreduce:
     break;
 
   case 291:
-#line 3642 "Gmsh.y"
+#line 3658 "Gmsh.y"
     {
       GModel::current()->renumberMeshVertices();
     ;}
     break;
 
   case 292:
-#line 3646 "Gmsh.y"
+#line 3662 "Gmsh.y"
     {
       GModel::current()->renumberMeshElements();
     ;}
     break;
 
   case 293:
-#line 3650 "Gmsh.y"
+#line 3666 "Gmsh.y"
     {
       if(GModel::current()->getOCCInternals() &&
          GModel::current()->getOCCInternals()->getChanged())
@@ -10928,7 +10944,7 @@ yyreduce:
     break;
 
   case 294:
-#line 3662 "Gmsh.y"
+#line 3678 "Gmsh.y"
     {
       if(GModel::current()->getOCCInternals() &&
          GModel::current()->getOCCInternals()->getChanged())
@@ -10940,7 +10956,7 @@ yyreduce:
     break;
 
   case 295:
-#line 3672 "Gmsh.y"
+#line 3688 "Gmsh.y"
     {
       int lock = CTX::instance()->lock;
       CTX::instance()->lock = 0;
@@ -11001,7 +11017,7 @@ yyreduce:
     break;
 
   case 296:
-#line 3735 "Gmsh.y"
+#line 3751 "Gmsh.y"
     {
 #if defined(HAVE_POPPLER)
        std::vector<int> is;
@@ -11016,7 +11032,7 @@ yyreduce:
     break;
 
   case 297:
-#line 3751 "Gmsh.y"
+#line 3767 "Gmsh.y"
     {
       LoopControlVariablesTab[ImbricatedLoop][0] = (yyvsp[(3) - (6)].d);
       LoopControlVariablesTab[ImbricatedLoop][1] = (yyvsp[(5) - (6)].d);
@@ -11025,9 +11041,11 @@ yyreduce:
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if((yyvsp[(3) - (6)].d) > (yyvsp[(5) - (6)].d))
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -11036,7 +11054,7 @@ yyreduce:
     break;
 
   case 298:
-#line 3768 "Gmsh.y"
+#line 3786 "Gmsh.y"
     {
       LoopControlVariablesTab[ImbricatedLoop][0] = (yyvsp[(3) - (8)].d);
       LoopControlVariablesTab[ImbricatedLoop][1] = (yyvsp[(5) - (8)].d);
@@ -11045,9 +11063,11 @@ yyreduce:
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if(((yyvsp[(7) - (8)].d) > 0. && (yyvsp[(3) - (8)].d) > (yyvsp[(5) - (8)].d)) || ((yyvsp[(7) - (8)].d) < 0. && (yyvsp[(3) - (8)].d) < (yyvsp[(5) - (8)].d)))
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -11056,7 +11076,7 @@ yyreduce:
     break;
 
   case 299:
-#line 3785 "Gmsh.y"
+#line 3805 "Gmsh.y"
     {
       LoopControlVariablesTab[ImbricatedLoop][0] = (yyvsp[(5) - (8)].d);
       LoopControlVariablesTab[ImbricatedLoop][1] = (yyvsp[(7) - (8)].d);
@@ -11069,9 +11089,11 @@ yyreduce:
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if((yyvsp[(5) - (8)].d) > (yyvsp[(7) - (8)].d))
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -11081,7 +11103,7 @@ yyreduce:
     break;
 
   case 300:
-#line 3807 "Gmsh.y"
+#line 3829 "Gmsh.y"
     {
       LoopControlVariablesTab[ImbricatedLoop][0] = (yyvsp[(5) - (10)].d);
       LoopControlVariablesTab[ImbricatedLoop][1] = (yyvsp[(7) - (10)].d);
@@ -11094,9 +11116,11 @@ yyreduce:
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if(((yyvsp[(9) - (10)].d) > 0. && (yyvsp[(5) - (10)].d) > (yyvsp[(7) - (10)].d)) || ((yyvsp[(9) - (10)].d) < 0. && (yyvsp[(5) - (10)].d) < (yyvsp[(7) - (10)].d)))
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -11106,7 +11130,7 @@ yyreduce:
     break;
 
   case 301:
-#line 3829 "Gmsh.y"
+#line 3853 "Gmsh.y"
     {
       if(ImbricatedLoop <= 0){
 	yymsg(0, "Invalid For/EndFor loop");
@@ -11116,10 +11140,12 @@ yyreduce:
 	double step = LoopControlVariablesTab[ImbricatedLoop - 1][2];
         std::string name = LoopControlVariablesNameTab[ImbricatedLoop - 1];
         if(name.size()){
-          if(!gmsh_yysymbols.count(name))
+          std::map<std::string, gmsh_yysymbol>::iterator its =
+            gmsh_yysymbols.find(name);
+          if(its == gmsh_yysymbols.end())
             yymsg(0, "Unknown loop variable '%s'", name.c_str());
           else{
-            gmsh_yysymbol &s(gmsh_yysymbols[name]);
+            gmsh_yysymbol &s(its->second);
             if(!s.list && s.value.size()){
               s.value[0] += step;
               LoopControlVariablesTab[ImbricatedLoop - 1][0] = s.value[0];
@@ -11134,17 +11160,21 @@ yyreduce:
 	double x0 = LoopControlVariablesTab[ImbricatedLoop - 1][0];
 	double x1 = LoopControlVariablesTab[ImbricatedLoop - 1][1];
         if((step > 0. && x0 <= x1) || (step < 0. && x0 >= x1)){
-	  fsetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop - 1]);
-	  gmsh_yylineno = yylinenoImbricatedLoopsTab[ImbricatedLoop - 1];
+          if(!replayLoopBody(yytokenImbricatedLoopsTab[ImbricatedLoop - 1])){
+	    fsetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop - 1]);
+	    gmsh_yylineno = yylinenoImbricatedLoopsTab[ImbricatedLoop - 1];
+          }
 	}
-	else
+	else{
 	  ImbricatedLoop--;
+          leaveLoopBody();
+        }
       }
     ;}
     break;
 
   case 302:
-#line 3864 "Gmsh.y"
+#line 3894 "Gmsh.y"
     {
       if(!FunctionManager::Instance()->createFunction
          (std::string((yyvsp[(2) - (2)].c)), gmsh_yyin, gmsh_yyname, gmsh_yylineno))
@@ -11155,7 +11185,7 @@ yyreduce:
     break;
 
   case 303:
-#line 3872 "Gmsh.y"
+#line 3902 "Gmsh.y"
     {
       if(!FunctionManager::Instance()->createFunction
          (std::string((yyvsp[(2) - (2)].c)), gmsh_yyin, gmsh_yyname, gmsh_yylineno))
@@ -11166,7 +11196,7 @@ yyreduce:
     break;
 
   case 304:
-#line 3880 "Gmsh.y"
+#line 3910 "Gmsh.y"
     {
       if(!FunctionManager::Instance()->leaveFunction
          (&gmsh_yyin, gmsh_yyname, gmsh_yylineno))
@@ -11175,7 +11205,7 @@ yyreduce:
     break;
 
   case 305:
-#line 3886 "Gmsh.y"
+#line 3916 "Gmsh.y"
     {
       if(!FunctionManager::Instance()->enterFunction
          (std::string((yyvsp[(2) - (3)].c)), &gmsh_yyin, gmsh_yyname, gmsh_yylineno))
@@ -11185,7 +11215,7 @@ yyreduce:
     break;
 
   case 306:
-#line 3893 "Gmsh.y"
+#line 3923 "Gmsh.y"
     {
       if(!FunctionManager::Instance()->enterFunction
          (std::string((yyvsp[(2) - (3)].c)), &gmsh_yyin, gmsh_yyname, gmsh_yylineno))
@@ -11195,7 +11225,7 @@ yyreduce:
     break;
 
   case 307:
-#line 3900 "Gmsh.y"
+#line 3930 "Gmsh.y"
     {
       ImbricatedTest++;
       if(ImbricatedTest > MAX_RECUR_TESTS-1){
@@ -11211,19 +11241,19 @@ yyreduce:
         statusImbricatedTests[ImbricatedTest] = 0;
         // Go after the next ElseIf or Else or EndIf
         int type_until2 = 0;
-        skipTest("If", "EndIf", "ElseIf", 4, &type_until2);
+        yyskipTest("If", "EndIf", "ElseIf", 4, &type_until2);
         if(!type_until2) ImbricatedTest--; // EndIf reached
       }
     ;}
     break;
 
   case 308:
-#line 3920 "Gmsh.y"
+#line 3950 "Gmsh.y"
     {
       if(ImbricatedTest > 0){
         if (statusImbricatedTests[ImbricatedTest]){
           // Last test (If or ElseIf) was true, thus go after EndIf (out of If EndIf)
-          skip("If", "EndIf");
+          yyskip("If", "EndIf");
           ImbricatedTest--;
         }
         else{
@@ -11235,7 +11265,7 @@ yyreduce:
             // Current test still not true: statusImbricatedTests[ImbricatedTest] = 0;
             // Go after the next ElseIf or Else or EndIf
             int type_until2 = 0;
-            skipTest("If", "EndIf", "ElseIf", 4, &type_until2);
+            yyskipTest("If", "EndIf", "ElseIf", 4, &type_until2);
             if(!type_until2) ImbricatedTest--;
           }
         }
@@ -11247,11 +11277,11 @@ yyreduce:
     break;
 
   case 309:
-#line 3946 "Gmsh.y"
+#line 3976 "Gmsh.y"
     {
       if(ImbricatedTest > 0){
         if(statusImbricatedTests[ImbricatedTest]){
-          skip("If", "EndIf");
+          yyskip("If", "EndIf");
           ImbricatedTest--;
         }
       }
@@ -11262,7 +11292,7 @@ yyreduce:
     break;
 
   case 310:
-#line 3958 "Gmsh.y"
+#line 3988 "Gmsh.y"
     {
       ImbricatedTest--;
       if(ImbricatedTest < 0)
@@ -11271,7 +11301,7 @@ yyreduce:
     break;
 
   case 311:
-#line 3969 "Gmsh.y"
+#line 3999 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (5)].l), inDimTags);
@@ -11292,7 +11322,7 @@ yyreduce:
     break;
 
   case 312:
-#line 3987 "Gmsh.y"
+#line 4017 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(10) - (11)].l), inDimTags);
@@ -11313,7 +11343,7 @@ yyreduce:
     break;
 
   case 313:
-#line 4005 "Gmsh.y"
+#line 4035 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(12) - (13)].l), inDimTags);
@@ -11334,7 +11364,7 @@ yyreduce:
     break;
 
   case 314:
-#line 4023 "Gmsh.y"
+#line 4053 "Gmsh.y"
     {
       extr.mesh.ExtrudeMesh = extr.mesh.Recombine = false;
       extr.mesh.QuadToTri = NO_QUADTRI;
@@ -11343,7 +11373,7 @@ yyreduce:
     break;
 
   case 315:
-#line 4029 "Gmsh.y"
+#line 4059 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(4) - (7)].l), inDimTags);
@@ -11364,7 +11394,7 @@ yyreduce:
     break;
 
   case 316:
-#line 4047 "Gmsh.y"
+#line 4077 "Gmsh.y"
     {
       extr.mesh.ExtrudeMesh = extr.mesh.Recombine = false;
       extr.mesh.QuadToTri = NO_QUADTRI;
@@ -11373,7 +11403,7 @@ yyreduce:
     break;
 
   case 317:
-#line 4053 "Gmsh.y"
+#line 4083 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(10) - (13)].l), inDimTags);
@@ -11396,7 +11426,7 @@ yyreduce:
     break;
 
   case 318:
-#line 4073 "Gmsh.y"
+#line 4103 "Gmsh.y"
     {
       extr.mesh.ExtrudeMesh = extr.mesh.Recombine = false;
       extr.mesh.QuadToTri = NO_QUADTRI;
@@ -11405,7 +11435,7 @@ yyreduce:
     break;
 
   case 319:
-#line 4079 "Gmsh.y"
+#line 4109 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(12) - (15)].l), inDimTags);
@@ -11426,7 +11456,7 @@ yyreduce:
     break;
 
   case 320:
-#line 4097 "Gmsh.y"
+#line 4127 "Gmsh.y"
     {
       extr.mesh.ExtrudeMesh = extr.mesh.Recombine = false;
       extr.mesh.QuadToTri = NO_QUADTRI;
@@ -11435,7 +11465,7 @@ yyreduce:
     break;
 
   case 321:
-#line 4103 "Gmsh.y"
+#line 4133 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (6)].l), inDimTags);
@@ -11455,7 +11485,7 @@ yyreduce:
     break;
 
   case 322:
-#line 4120 "Gmsh.y"
+#line 4150 "Gmsh.y"
     {
       std::vector<std::pair<int, int> > inDimTags, outDimTags;
       ListOfShapes2VectorOfPairs((yyvsp[(3) - (9)].l), inDimTags);
@@ -11474,7 +11504,7 @@ yyreduce:
     break;
 
   case 323:
-#line 4136 "Gmsh.y"
+#line 4166 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -11494,7 +11524,7 @@ yyreduce:
     break;
 
   case 324:
-#line 4153 "Gmsh.y"
+#line 4183 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -11514,7 +11544,7 @@ yyreduce:
     break;
 
   case 325:
-#line 4171 "Gmsh.y"
+#line 4201 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -11539,7 +11569,7 @@ yyreduce:
     break;
 
   case 326:
-#line 4194 "Gmsh.y"
+#line 4224 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -11566,19 +11596,19 @@ yyreduce:
     break;
 
   case 327:
-#line 4221 "Gmsh.y"
+#line 4251 "Gmsh.y"
     {
     ;}
     break;
 
   case 328:
-#line 4224 "Gmsh.y"
+#line 4254 "Gmsh.y"
     {
     ;}
     break;
 
   case 329:
-#line 4230 "Gmsh.y"
+#line 4260 "Gmsh.y"
     {
       int n = (int)fabs((yyvsp[(3) - (5)].d));
       if(n){ // we accept n==0 to easily disable layers
@@ -11593,7 +11623,7 @@ yyreduce:
     break;
 
   case 330:
-#line 4242 "Gmsh.y"
+#line 4272 "Gmsh.y"
     {
       extr.mesh.ExtrudeMesh = true;
       extr.mesh.NbLayer = List_Nbr((yyvsp[(3) - (7)].l));
@@ -11616,56 +11646,56 @@ yyreduce:
     break;
 
   case 331:
-#line 4262 "Gmsh.y"
+#line 4292 "Gmsh.y"
     {
       extr.mesh.ScaleLast = true;
     ;}
     break;
 
   case 332:
-#line 4266 "Gmsh.y"
+#line 4296 "Gmsh.y"
     {
       extr.mesh.Recombine = true;
     ;}
     break;
 
   case 333:
-#line 4270 "Gmsh.y"
+#line 4300 "Gmsh.y"
     {
       extr.mesh.Recombine = (yyvsp[(2) - (3)].d) ? true : false;
     ;}
     break;
 
   case 334:
-#line 4274 "Gmsh.y"
+#line 4304 "Gmsh.y"
     {
       extr.mesh.QuadToTri = QUADTRI_ADDVERTS_1;
     ;}
     break;
 
   case 335:
-#line 4278 "Gmsh.y"
+#line 4308 "Gmsh.y"
     {
       extr.mesh.QuadToTri = QUADTRI_ADDVERTS_1_RECOMB;
     ;}
     break;
 
   case 336:
-#line 4282 "Gmsh.y"
+#line 4312 "Gmsh.y"
     {
       extr.mesh.QuadToTri = QUADTRI_NOVERTS_1;
     ;}
     break;
 
   case 337:
-#line 4286 "Gmsh.y"
+#line 4316 "Gmsh.y"
     {
       extr.mesh.QuadToTri = QUADTRI_NOVERTS_1_RECOMB;
     ;}
     break;
 
   case 338:
-#line 4290 "Gmsh.y"
+#line 4320 "Gmsh.y"
     {
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(6) - (9)].l), tags);
       int num = (int)(yyvsp[(3) - (9)].d);
@@ -11677,7 +11707,7 @@ yyreduce:
     break;
 
   case 339:
-#line 4299 "Gmsh.y"
+#line 4329 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (6)].c), "Index"))
         extr.mesh.BoundaryLayerIndex = (yyvsp[(4) - (6)].d);
@@ -11688,57 +11718,57 @@ yyreduce:
     break;
 
   case 340:
-#line 4311 "Gmsh.y"
+#line 4341 "Gmsh.y"
     { (yyval.i) = OCC_Internals::Union; ;}
     break;
 
   case 341:
-#line 4312 "Gmsh.y"
+#line 4342 "Gmsh.y"
     { (yyval.i) = OCC_Internals::Intersection; ;}
     break;
 
   case 342:
-#line 4313 "Gmsh.y"
+#line 4343 "Gmsh.y"
     { (yyval.i) = OCC_Internals::Difference; ;}
     break;
 
   case 343:
-#line 4314 "Gmsh.y"
+#line 4344 "Gmsh.y"
     { (yyval.i) = OCC_Internals::Section; ;}
     break;
 
   case 344:
-#line 4315 "Gmsh.y"
+#line 4345 "Gmsh.y"
     { (yyval.i) = OCC_Internals::Fragments; ;}
     break;
 
   case 345:
-#line 4319 "Gmsh.y"
+#line 4349 "Gmsh.y"
     { (yyval.i) = 0; ;}
     break;
 
   case 346:
-#line 4320 "Gmsh.y"
+#line 4350 "Gmsh.y"
     { (yyval.i) = 1; ;}
     break;
 
   case 347:
-#line 4321 "Gmsh.y"
+#line 4351 "Gmsh.y"
     { (yyval.i) = 2; ;}
     break;
 
   case 348:
-#line 4322 "Gmsh.y"
+#line 4352 "Gmsh.y"
     { (yyval.i) = (yyvsp[(2) - (3)].d) ? 1 : 0; ;}
     break;
 
   case 349:
-#line 4323 "Gmsh.y"
+#line 4353 "Gmsh.y"
     { (yyval.i) = (yyvsp[(3) - (4)].d) ? 2 : 0; ;}
     break;
 
   case 350:
-#line 4328 "Gmsh.y"
+#line 4358 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -11764,7 +11794,7 @@ yyreduce:
     break;
 
   case 351:
-#line 4351 "Gmsh.y"
+#line 4381 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(Shape));
       bool r = true;
@@ -11783,7 +11813,7 @@ yyreduce:
     break;
 
   case 352:
-#line 4371 "Gmsh.y"
+#line 4401 "Gmsh.y"
     {
       bool r = true;
       if(gmsh_yyfactory == "OpenCASCADE" && GModel::current()->getOCCInternals()){
@@ -11804,14 +11834,14 @@ yyreduce:
     break;
 
   case 353:
-#line 4392 "Gmsh.y"
+#line 4422 "Gmsh.y"
     {
       (yyval.v)[0] = (yyval.v)[1] = 1.;
     ;}
     break;
 
   case 354:
-#line 4396 "Gmsh.y"
+#line 4426 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (3)].c), "Progression") || !strcmp((yyvsp[(2) - (3)].c), "Power"))
         (yyval.v)[0] = 1.;
@@ -11827,14 +11857,14 @@ yyreduce:
     break;
 
   case 355:
-#line 4411 "Gmsh.y"
+#line 4441 "Gmsh.y"
     {
       (yyval.i) = -1; // left
     ;}
     break;
 
   case 356:
-#line 4415 "Gmsh.y"
+#line 4445 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(1) - (1)].c), "Right"))
         (yyval.i) = 1;
@@ -11851,49 +11881,49 @@ yyreduce:
     break;
 
   case 357:
-#line 4431 "Gmsh.y"
+#line 4461 "Gmsh.y"
     {
      (yyval.l) = List_Create(1, 1, sizeof(double));
    ;}
     break;
 
   case 358:
-#line 4435 "Gmsh.y"
+#line 4465 "Gmsh.y"
     {
      (yyval.l) = (yyvsp[(2) - (2)].l);
    ;}
     break;
 
   case 359:
-#line 4440 "Gmsh.y"
+#line 4470 "Gmsh.y"
     {
       (yyval.i) = 45;
     ;}
     break;
 
   case 360:
-#line 4444 "Gmsh.y"
+#line 4474 "Gmsh.y"
     {
       (yyval.i) = (int)(yyvsp[(2) - (2)].d);
     ;}
     break;
 
   case 361:
-#line 4450 "Gmsh.y"
+#line 4480 "Gmsh.y"
     {
       (yyval.l) = List_Create(1, 1, sizeof(double));
     ;}
     break;
 
   case 362:
-#line 4454 "Gmsh.y"
+#line 4484 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(2) - (2)].l);
     ;}
     break;
 
   case 363:
-#line 4461 "Gmsh.y"
+#line 4491 "Gmsh.y"
     {
       // mesh sizes at vertices are stored in internal CAD data, as they can be
       // specified during vertex creation and copied around during CAD
@@ -11918,7 +11948,7 @@ yyreduce:
     break;
 
   case 364:
-#line 4483 "Gmsh.y"
+#line 4513 "Gmsh.y"
     {
       // transfinite constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -11962,7 +11992,7 @@ yyreduce:
     break;
 
   case 365:
-#line 4524 "Gmsh.y"
+#line 4554 "Gmsh.y"
     {
       // transfinite constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12009,7 +12039,7 @@ yyreduce:
     break;
 
   case 366:
-#line 4568 "Gmsh.y"
+#line 4598 "Gmsh.y"
     {
       // transfinite constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12051,7 +12081,7 @@ yyreduce:
     break;
 
   case 367:
-#line 4607 "Gmsh.y"
+#line 4637 "Gmsh.y"
     {
       // transfinite constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12079,7 +12109,7 @@ yyreduce:
     break;
 
   case 368:
-#line 4632 "Gmsh.y"
+#line 4662 "Gmsh.y"
     {
       int dim = (int)(yyvsp[(2) - (8)].i);
       int tag = (int)(yyvsp[(4) - (8)].d);
@@ -12095,7 +12125,7 @@ yyreduce:
     break;
 
   case 369:
-#line 4645 "Gmsh.y"
+#line 4675 "Gmsh.y"
     {
       int dim = (int)(yyvsp[(2) - (6)].i);
       int tag = (int)(yyvsp[(4) - (6)].d);
@@ -12109,7 +12139,7 @@ yyreduce:
     break;
 
   case 370:
-#line 4656 "Gmsh.y"
+#line 4686 "Gmsh.y"
     {
       // mesh algorithm constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12129,7 +12159,7 @@ yyreduce:
     break;
 
   case 371:
-#line 4673 "Gmsh.y"
+#line 4703 "Gmsh.y"
     {
       // lcExtendFromBoundary onstraints are stored in GEO internals in addition
       // to GModel, as they can be copied around during GEO operations
@@ -12149,7 +12179,7 @@ yyreduce:
     break;
 
   case 372:
-#line 4690 "Gmsh.y"
+#line 4720 "Gmsh.y"
     {
       // recombine constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12182,7 +12212,7 @@ yyreduce:
     break;
 
   case 373:
-#line 4720 "Gmsh.y"
+#line 4750 "Gmsh.y"
     {
       // recombine constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12211,7 +12241,7 @@ yyreduce:
     break;
 
   case 374:
-#line 4746 "Gmsh.y"
+#line 4776 "Gmsh.y"
     {
       // smoothing constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12240,7 +12270,7 @@ yyreduce:
     break;
 
   case 375:
-#line 4773 "Gmsh.y"
+#line 4803 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(4) - (11)].l)) != List_Nbr((yyvsp[(8) - (11)].l))){
         yymsg(0, "Number of master lines (%d) different from number of "
@@ -12274,7 +12304,7 @@ yyreduce:
     break;
 
   case 376:
-#line 4805 "Gmsh.y"
+#line 4835 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(4) - (11)].l)) != List_Nbr((yyvsp[(8) - (11)].l))){
         yymsg(0, "Number of master surfaces (%d) different from number of "
@@ -12303,7 +12333,7 @@ yyreduce:
     break;
 
   case 377:
-#line 4832 "Gmsh.y"
+#line 4862 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(4) - (18)].l)) != List_Nbr((yyvsp[(8) - (18)].l))){
         yymsg(0, "Number of master curves (%d) different from number of "
@@ -12331,7 +12361,7 @@ yyreduce:
     break;
 
   case 378:
-#line 4858 "Gmsh.y"
+#line 4888 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(4) - (18)].l)) != List_Nbr((yyvsp[(8) - (18)].l))){
         yymsg(0, "Number of master surfaces (%d) different from number of "
@@ -12359,7 +12389,7 @@ yyreduce:
     break;
 
   case 379:
-#line 4884 "Gmsh.y"
+#line 4914 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(4) - (12)].l)) != List_Nbr((yyvsp[(8) - (12)].l))){
         yymsg(0, "Number of master curves (%d) different from number of "
@@ -12387,7 +12417,7 @@ yyreduce:
     break;
 
   case 380:
-#line 4910 "Gmsh.y"
+#line 4940 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(4) - (12)].l)) != List_Nbr((yyvsp[(8) - (12)].l))){
         yymsg(0, "Number of master surfaces (%d) different from number of "
@@ -12415,7 +12445,7 @@ yyreduce:
     break;
 
   case 381:
-#line 4936 "Gmsh.y"
+#line 4966 "Gmsh.y"
     {
       if (List_Nbr((yyvsp[(5) - (12)].l)) != List_Nbr((yyvsp[(10) - (12)].l))){
         yymsg(0, "Number of master surface curves (%d) different from number of "
@@ -12439,7 +12469,7 @@ yyreduce:
     break;
 
   case 382:
-#line 4957 "Gmsh.y"
+#line 4987 "Gmsh.y"
     {
       if (((yyvsp[(6) - (10)].i)==2 || (yyvsp[(6) - (10)].i)==3) && (yyvsp[(1) - (10)].i)<(yyvsp[(6) - (10)].i) ) {
         std::vector<int> tags; ListOfDouble2Vector((yyvsp[(3) - (10)].l), tags);
@@ -12453,7 +12483,7 @@ yyreduce:
     break;
 
   case 383:
-#line 4968 "Gmsh.y"
+#line 4998 "Gmsh.y"
     {
       // reverse mesh constraints are stored in GEO internals in addition to
       // GModel, as they can be copied around during GEO operations
@@ -12504,7 +12534,7 @@ yyreduce:
     break;
 
   case 384:
-#line 5016 "Gmsh.y"
+#line 5046 "Gmsh.y"
     {
       if(GModel::current()->getOCCInternals() &&
          GModel::current()->getOCCInternals()->getChanged())
@@ -12561,7 +12591,7 @@ yyreduce:
     break;
 
   case 385:
-#line 5070 "Gmsh.y"
+#line 5100 "Gmsh.y"
     {
       if(GModel::current()->getOCCInternals() &&
          GModel::current()->getOCCInternals()->getChanged())
@@ -12579,7 +12609,7 @@ yyreduce:
     break;
 
   case 386:
-#line 5085 "Gmsh.y"
+#line 5115 "Gmsh.y"
     {
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (4)].l)); i++){
 	double dnum;
@@ -12594,7 +12624,7 @@ yyreduce:
     break;
 
   case 387:
-#line 5097 "Gmsh.y"
+#line 5127 "Gmsh.y"
     {
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(3) - (4)].l), tags);
       GModel::current()->getGEOInternals()->setCompoundMesh((yyvsp[(2) - (4)].i), tags);
@@ -12603,7 +12633,7 @@ yyreduce:
     break;
 
   case 388:
-#line 5108 "Gmsh.y"
+#line 5138 "Gmsh.y"
     {
       if(gmsh_yyfactory == "OpenCASCADE" && GModel::current()->getOCCInternals())
         GModel::current()->getOCCInternals()->removeAllDuplicates();
@@ -12613,7 +12643,7 @@ yyreduce:
     break;
 
   case 389:
-#line 5115 "Gmsh.y"
+#line 5145 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(2) - (3)].c), "Geometry")){
         if(gmsh_yyfactory == "OpenCASCADE" && GModel::current()->getOCCInternals())
@@ -12631,7 +12661,7 @@ yyreduce:
     break;
 
   case 390:
-#line 5130 "Gmsh.y"
+#line 5160 "Gmsh.y"
     {
       std::vector<int> tags; ListOfDouble2Vector((yyvsp[(4) - (6)].l), tags);
       if(gmsh_yyfactory == "OpenCASCADE" && GModel::current()->getOCCInternals())
@@ -12643,22 +12673,22 @@ yyreduce:
     break;
 
   case 391:
-#line 5143 "Gmsh.y"
+#line 5173 "Gmsh.y"
     { (yyval.c) = (char*)"Homology"; ;}
     break;
 
   case 392:
-#line 5144 "Gmsh.y"
+#line 5174 "Gmsh.y"
     { (yyval.c) = (char*)"Cohomology"; ;}
     break;
 
   case 393:
-#line 5145 "Gmsh.y"
+#line 5175 "Gmsh.y"
     { (yyval.c) = (char*)"Betti"; ;}
     break;
 
   case 394:
-#line 5150 "Gmsh.y"
+#line 5180 "Gmsh.y"
     {
       std::vector<int> domain, subdomain, dim;
       for(int i = 0; i < 4; i++) dim.push_back(i);
@@ -12667,7 +12697,7 @@ yyreduce:
     break;
 
   case 395:
-#line 5156 "Gmsh.y"
+#line 5186 "Gmsh.y"
     {
       std::vector<int> domain, subdomain, dim;
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (5)].l)); i++){
@@ -12682,7 +12712,7 @@ yyreduce:
     break;
 
   case 396:
-#line 5168 "Gmsh.y"
+#line 5198 "Gmsh.y"
     {
       std::vector<int> domain, subdomain, dim;
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (7)].l)); i++){
@@ -12703,7 +12733,7 @@ yyreduce:
     break;
 
   case 397:
-#line 5186 "Gmsh.y"
+#line 5216 "Gmsh.y"
     {
       std::vector<int> domain, subdomain, dim;
       for(int i = 0; i < List_Nbr((yyvsp[(6) - (10)].l)); i++){
@@ -12729,47 +12759,47 @@ yyreduce:
     break;
 
   case 398:
-#line 5213 "Gmsh.y"
+#line 5243 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (1)].d);           ;}
     break;
 
   case 399:
-#line 5214 "Gmsh.y"
+#line 5244 "Gmsh.y"
     { (yyval.d) = (yyvsp[(2) - (3)].d);           ;}
     break;
 
   case 400:
-#line 5215 "Gmsh.y"
+#line 5245 "Gmsh.y"
     { (yyval.d) = -(yyvsp[(2) - (2)].d);          ;}
     break;
 
   case 401:
-#line 5216 "Gmsh.y"
+#line 5246 "Gmsh.y"
     { (yyval.d) = (yyvsp[(2) - (2)].d);           ;}
     break;
 
   case 402:
-#line 5217 "Gmsh.y"
+#line 5247 "Gmsh.y"
     { (yyval.d) = !(yyvsp[(2) - (2)].d);          ;}
     break;
 
   case 403:
-#line 5218 "Gmsh.y"
+#line 5248 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) - (yyvsp[(3) - (3)].d);      ;}
     break;
 
   case 404:
-#line 5219 "Gmsh.y"
+#line 5249 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) + (yyvsp[(3) - (3)].d);      ;}
     break;
 
   case 405:
-#line 5220 "Gmsh.y"
+#line 5250 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) * (yyvsp[(3) - (3)].d);      ;}
     break;
 
   case 406:
-#line 5222 "Gmsh.y"
+#line 5252 "Gmsh.y"
     {
       if(!(yyvsp[(3) - (3)].d))
 	yymsg(0, "Division by zero in '%g / %g'", (yyvsp[(1) - (3)].d), (yyvsp[(3) - (3)].d));
@@ -12779,267 +12809,267 @@ yyreduce:
     break;
 
   case 407:
-#line 5228 "Gmsh.y"
+#line 5258 "Gmsh.y"
     { (yyval.d) = (int)(yyvsp[(1) - (3)].d) | (int)(yyvsp[(3) - (3)].d); ;}
     break;
 
   case 408:
-#line 5229 "Gmsh.y"
+#line 5259 "Gmsh.y"
     { (yyval.d) = (int)(yyvsp[(1) - (3)].d) & (int)(yyvsp[(3) - (3)].d); ;}
     break;
 
   case 409:
-#line 5230 "Gmsh.y"
+#line 5260 "Gmsh.y"
     { (yyval.d) = (int)(yyvsp[(1) - (3)].d) % (int)(yyvsp[(3) - (3)].d); ;}
     break;
 
   case 410:
-#line 5231 "Gmsh.y"
+#line 5261 "Gmsh.y"
     { (yyval.d) = pow((yyvsp[(1) - (3)].d), (yyvsp[(3) - (3)].d));  ;}
     break;
 
   case 411:
-#line 5232 "Gmsh.y"
+#line 5262 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) < (yyvsp[(3) - (3)].d);      ;}
     break;
 
   case 412:
-#line 5233 "Gmsh.y"
+#line 5263 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) > (yyvsp[(3) - (3)].d);      ;}
     break;
 
   case 413:
-#line 5234 "Gmsh.y"
+#line 5264 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) <= (yyvsp[(3) - (3)].d);     ;}
     break;
 
   case 414:
-#line 5235 "Gmsh.y"
+#line 5265 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) >= (yyvsp[(3) - (3)].d);     ;}
     break;
 
   case 415:
-#line 5236 "Gmsh.y"
+#line 5266 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) == (yyvsp[(3) - (3)].d);     ;}
     break;
 
   case 416:
-#line 5237 "Gmsh.y"
+#line 5267 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) != (yyvsp[(3) - (3)].d);     ;}
     break;
 
   case 417:
-#line 5238 "Gmsh.y"
+#line 5268 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) && (yyvsp[(3) - (3)].d);     ;}
     break;
 
   case 418:
-#line 5239 "Gmsh.y"
+#line 5269 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (3)].d) || (yyvsp[(3) - (3)].d);     ;}
     break;
 
   case 419:
-#line 5240 "Gmsh.y"
+#line 5270 "Gmsh.y"
     { (yyval.d) = ((int)(yyvsp[(1) - (3)].d) >> (int)(yyvsp[(3) - (3)].d)); ;}
     break;
 
   case 420:
-#line 5241 "Gmsh.y"
+#line 5271 "Gmsh.y"
     { (yyval.d) = ((int)(yyvsp[(1) - (3)].d) << (int)(yyvsp[(3) - (3)].d)); ;}
     break;
 
   case 421:
-#line 5242 "Gmsh.y"
+#line 5272 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (5)].d) ? (yyvsp[(3) - (5)].d) : (yyvsp[(5) - (5)].d); ;}
     break;
 
   case 422:
-#line 5243 "Gmsh.y"
+#line 5273 "Gmsh.y"
     { (yyval.d) = exp((yyvsp[(3) - (4)].d));      ;}
     break;
 
   case 423:
-#line 5244 "Gmsh.y"
+#line 5274 "Gmsh.y"
     { (yyval.d) = log((yyvsp[(3) - (4)].d));      ;}
     break;
 
   case 424:
-#line 5245 "Gmsh.y"
+#line 5275 "Gmsh.y"
     { (yyval.d) = log10((yyvsp[(3) - (4)].d));    ;}
     break;
 
   case 425:
-#line 5246 "Gmsh.y"
+#line 5276 "Gmsh.y"
     { (yyval.d) = sqrt((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 426:
-#line 5247 "Gmsh.y"
+#line 5277 "Gmsh.y"
     { (yyval.d) = sin((yyvsp[(3) - (4)].d));      ;}
     break;
 
   case 427:
-#line 5248 "Gmsh.y"
+#line 5278 "Gmsh.y"
     { (yyval.d) = asin((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 428:
-#line 5249 "Gmsh.y"
+#line 5279 "Gmsh.y"
     { (yyval.d) = cos((yyvsp[(3) - (4)].d));      ;}
     break;
 
   case 429:
-#line 5250 "Gmsh.y"
+#line 5280 "Gmsh.y"
     { (yyval.d) = acos((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 430:
-#line 5251 "Gmsh.y"
+#line 5281 "Gmsh.y"
     { (yyval.d) = tan((yyvsp[(3) - (4)].d));      ;}
     break;
 
   case 431:
-#line 5252 "Gmsh.y"
+#line 5282 "Gmsh.y"
     { (yyval.d) = atan((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 432:
-#line 5253 "Gmsh.y"
+#line 5283 "Gmsh.y"
     { (yyval.d) = atan2((yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].d));;}
     break;
 
   case 433:
-#line 5254 "Gmsh.y"
+#line 5284 "Gmsh.y"
     { (yyval.d) = sinh((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 434:
-#line 5255 "Gmsh.y"
+#line 5285 "Gmsh.y"
     { (yyval.d) = cosh((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 435:
-#line 5256 "Gmsh.y"
+#line 5286 "Gmsh.y"
     { (yyval.d) = tanh((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 436:
-#line 5257 "Gmsh.y"
+#line 5287 "Gmsh.y"
     { (yyval.d) = fabs((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 437:
-#line 5258 "Gmsh.y"
+#line 5288 "Gmsh.y"
     { (yyval.d) = std::abs((yyvsp[(3) - (4)].d)); ;}
     break;
 
   case 438:
-#line 5259 "Gmsh.y"
+#line 5289 "Gmsh.y"
     { (yyval.d) = floor((yyvsp[(3) - (4)].d));    ;}
     break;
 
   case 439:
-#line 5260 "Gmsh.y"
+#line 5290 "Gmsh.y"
     { (yyval.d) = ceil((yyvsp[(3) - (4)].d));     ;}
     break;
 
   case 440:
-#line 5261 "Gmsh.y"
+#line 5291 "Gmsh.y"
     { (yyval.d) = floor((yyvsp[(3) - (4)].d) + 0.5); ;}
     break;
 
   case 441:
-#line 5262 "Gmsh.y"
+#line 5292 "Gmsh.y"
     { (yyval.d) = fmod((yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].d)); ;}
     break;
 
   case 442:
-#line 5263 "Gmsh.y"
+#line 5293 "Gmsh.y"
     { (yyval.d) = fmod((yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].d)); ;}
     break;
 
   case 443:
-#line 5264 "Gmsh.y"
+#line 5294 "Gmsh.y"
     { (yyval.d) = sqrt((yyvsp[(3) - (6)].d) * (yyvsp[(3) - (6)].d) + (yyvsp[(5) - (6)].d) * (yyvsp[(5) - (6)].d)); ;}
     break;
 
   case 444:
-#line 5265 "Gmsh.y"
+#line 5295 "Gmsh.y"
     { (yyval.d) = (yyvsp[(3) - (4)].d) * (double)rand() / (double)RAND_MAX; ;}
     break;
 
   case 445:
-#line 5266 "Gmsh.y"
+#line 5296 "Gmsh.y"
     { (yyval.d) = std::max((yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].d)); ;}
     break;
 
   case 446:
-#line 5267 "Gmsh.y"
+#line 5297 "Gmsh.y"
     { (yyval.d) = std::min((yyvsp[(3) - (6)].d), (yyvsp[(5) - (6)].d)); ;}
     break;
 
   case 447:
-#line 5276 "Gmsh.y"
+#line 5306 "Gmsh.y"
     { (yyval.d) = (yyvsp[(1) - (1)].d); ;}
     break;
 
   case 448:
-#line 5277 "Gmsh.y"
+#line 5307 "Gmsh.y"
     { (yyval.d) = 3.141592653589793; ;}
     break;
 
   case 449:
-#line 5278 "Gmsh.y"
+#line 5308 "Gmsh.y"
     { (yyval.d) = (double)ImbricatedTest; ;}
     break;
 
   case 450:
-#line 5279 "Gmsh.y"
+#line 5309 "Gmsh.y"
     { (yyval.d) = Msg::GetCommRank(); ;}
     break;
 
   case 451:
-#line 5280 "Gmsh.y"
+#line 5310 "Gmsh.y"
     { (yyval.d) = Msg::GetCommSize(); ;}
     break;
 
   case 452:
-#line 5281 "Gmsh.y"
+#line 5311 "Gmsh.y"
     { (yyval.d) = GetGmshMajorVersion(); ;}
     break;
 
   case 453:
-#line 5282 "Gmsh.y"
+#line 5312 "Gmsh.y"
     { (yyval.d) = GetGmshMinorVersion(); ;}
     break;
 
   case 454:
-#line 5283 "Gmsh.y"
+#line 5313 "Gmsh.y"
     { (yyval.d) = GetGmshPatchVersion(); ;}
     break;
 
   case 455:
-#line 5284 "Gmsh.y"
+#line 5314 "Gmsh.y"
     { (yyval.d) = Cpu(); ;}
     break;
 
   case 456:
-#line 5285 "Gmsh.y"
+#line 5315 "Gmsh.y"
     { (yyval.d) = GetMemoryUsage()/1024./1024.; ;}
     break;
 
   case 457:
-#line 5286 "Gmsh.y"
+#line 5316 "Gmsh.y"
     { (yyval.d) = TotalRam(); ;}
     break;
 
   case 458:
-#line 5291 "Gmsh.y"
+#line 5321 "Gmsh.y"
     { init_options(); ;}
     break;
 
   case 459:
-#line 5293 "Gmsh.y"
+#line 5323 "Gmsh.y"
     {
       std::vector<double> val(1, (yyvsp[(3) - (6)].d));
       Msg::ExchangeOnelabParameter("", val, floatOptions, charOptions);
@@ -13048,14 +13078,14 @@ yyreduce:
     break;
 
   case 460:
-#line 5299 "Gmsh.y"
+#line 5329 "Gmsh.y"
     {
       (yyval.d) = (yyvsp[(1) - (1)].d);
     ;}
     break;
 
   case 461:
-#line 5303 "Gmsh.y"
+#line 5333 "Gmsh.y"
     {
       (yyval.d) = Msg::GetOnelabNumber((yyvsp[(3) - (4)].c));
       Free((yyvsp[(3) - (4)].c));
@@ -13063,7 +13093,7 @@ yyreduce:
     break;
 
   case 462:
-#line 5308 "Gmsh.y"
+#line 5338 "Gmsh.y"
     {
       (yyval.d) = Msg::GetOnelabNumber((yyvsp[(3) - (6)].c), (yyvsp[(5) - (6)].d));
       Free((yyvsp[(3) - (6)].c));
@@ -13071,70 +13101,70 @@ yyreduce:
     break;
 
   case 463:
-#line 5313 "Gmsh.y"
+#line 5343 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_Float((yyvsp[(1) - (1)].c2).char1, (yyvsp[(1) - (1)].c2).char2);
     ;}
     break;
 
   case 464:
-#line 5318 "Gmsh.y"
+#line 5348 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_Float(NULL, (yyvsp[(1) - (4)].c), 2, (int)(yyvsp[(3) - (4)].d));
     ;}
     break;
 
   case 465:
-#line 5323 "Gmsh.y"
+#line 5353 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_Float(NULL, (yyvsp[(1) - (4)].c), 2, (int)(yyvsp[(3) - (4)].d));
     ;}
     break;
 
   case 466:
-#line 5327 "Gmsh.y"
+#line 5357 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_Float((yyvsp[(3) - (4)].c2).char1, (yyvsp[(3) - (4)].c2).char2, 1, 0, 0., 1);
     ;}
     break;
 
   case 467:
-#line 5331 "Gmsh.y"
+#line 5361 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float((yyvsp[(3) - (6)].c2).char1, (yyvsp[(3) - (6)].c2).char2, (yyvsp[(5) - (6)].c), 0, 0., 1);
     ;}
     break;
 
   case 468:
-#line 5335 "Gmsh.y"
+#line 5365 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_Float((yyvsp[(3) - (5)].c2).char1, (yyvsp[(3) - (5)].c2).char2, 1, 0, (yyvsp[(4) - (5)].d), 2);
     ;}
     break;
 
   case 469:
-#line 5339 "Gmsh.y"
+#line 5369 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float((yyvsp[(3) - (7)].c2).char1, (yyvsp[(3) - (7)].c2).char2, (yyvsp[(5) - (7)].c), 0, (yyvsp[(6) - (7)].d), 2);
     ;}
     break;
 
   case 470:
-#line 5343 "Gmsh.y"
+#line 5373 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_Float((yyvsp[(3) - (8)].c2).char1, (yyvsp[(3) - (8)].c2).char2, 2, (int)(yyvsp[(5) - (8)].d), (yyvsp[(7) - (8)].d), 2);
     ;}
     break;
 
   case 471:
-#line 5347 "Gmsh.y"
+#line 5377 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float((yyvsp[(3) - (10)].c2).char1, (yyvsp[(3) - (10)].c2).char2, (yyvsp[(5) - (10)].c), (int)(yyvsp[(7) - (10)].d), (yyvsp[(9) - (10)].d), 2);
     ;}
     break;
 
   case 472:
-#line 5351 "Gmsh.y"
+#line 5381 "Gmsh.y"
     {
       std::string tmp = FixRelativePath(gmsh_yyname, (yyvsp[(3) - (4)].c));
       (yyval.d) = !StatFile(tmp);
@@ -13143,7 +13173,7 @@ yyreduce:
     break;
 
   case 473:
-#line 5357 "Gmsh.y"
+#line 5387 "Gmsh.y"
     {
       if(gmsh_yysymbols.count((yyvsp[(2) - (4)].c))){
         gmsh_yysymbol &s(gmsh_yysymbols[(yyvsp[(2) - (4)].c)]);
@@ -13161,14 +13191,14 @@ yyreduce:
     break;
 
   case 474:
-#line 5372 "Gmsh.y"
+#line 5402 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float_getDim((yyvsp[(2) - (6)].c2).char1, (yyvsp[(2) - (6)].c2).char2, (yyvsp[(4) - (6)].c));
     ;}
     break;
 
   case 475:
-#line 5376 "Gmsh.y"
+#line 5406 "Gmsh.y"
     {
       std::string struct_namespace((yyvsp[(3) - (4)].c));
       (yyval.d) = (double)gmsh_yynamespaces[struct_namespace].size();
@@ -13177,7 +13207,7 @@ yyreduce:
     break;
 
   case 476:
-#line 5382 "Gmsh.y"
+#line 5412 "Gmsh.y"
     {
       std::string struct_namespace(std::string(""));
       (yyval.d) = (double)gmsh_yynamespaces[struct_namespace].size();
@@ -13185,7 +13215,7 @@ yyreduce:
     break;
 
   case 477:
-#line 5387 "Gmsh.y"
+#line 5417 "Gmsh.y"
     {
       if(!gmsh_yysymbols.count((yyvsp[(1) - (2)].c))){
 	yymsg(0, "Unknown variable '%s'", (yyvsp[(1) - (2)].c));
@@ -13207,7 +13237,7 @@ yyreduce:
     break;
 
   case 478:
-#line 5406 "Gmsh.y"
+#line 5436 "Gmsh.y"
     {
       int index = (int)(yyvsp[(3) - (5)].d);
       if(!gmsh_yysymbols.count((yyvsp[(1) - (5)].c))){
@@ -13230,7 +13260,7 @@ yyreduce:
     break;
 
   case 479:
-#line 5426 "Gmsh.y"
+#line 5456 "Gmsh.y"
     {
       int index = (int)(yyvsp[(3) - (5)].d);
       if(!gmsh_yysymbols.count((yyvsp[(1) - (5)].c))){
@@ -13253,49 +13283,49 @@ yyreduce:
     break;
 
   case 480:
-#line 5447 "Gmsh.y"
+#line 5477 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float(NULL, (yyvsp[(1) - (3)].c), (yyvsp[(3) - (3)].c));
     ;}
     break;
 
   case 481:
-#line 5451 "Gmsh.y"
+#line 5481 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float((yyvsp[(1) - (5)].c), (yyvsp[(3) - (5)].c), (yyvsp[(5) - (5)].c));
     ;}
     break;
 
   case 482:
-#line 5455 "Gmsh.y"
+#line 5485 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float(NULL, (yyvsp[(1) - (6)].c), (yyvsp[(3) - (6)].c), (int)(yyvsp[(5) - (6)].d));
     ;}
     break;
 
   case 483:
-#line 5459 "Gmsh.y"
+#line 5489 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float((yyvsp[(1) - (8)].c), (yyvsp[(3) - (8)].c), (yyvsp[(5) - (8)].c), (int)(yyvsp[(7) - (8)].d));
     ;}
     break;
 
   case 484:
-#line 5463 "Gmsh.y"
+#line 5493 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float(NULL, (yyvsp[(1) - (6)].c), (yyvsp[(3) - (6)].c), (int)(yyvsp[(5) - (6)].d));
     ;}
     break;
 
   case 485:
-#line 5467 "Gmsh.y"
+#line 5497 "Gmsh.y"
     {
       (yyval.d) = treat_Struct_FullName_dot_tSTRING_Float((yyvsp[(1) - (8)].c), (yyvsp[(3) - (8)].c), (yyvsp[(5) - (8)].c), (int)(yyvsp[(7) - (8)].d));
     ;}
     break;
 
   case 486:
-#line 5471 "Gmsh.y"
+#line 5501 "Gmsh.y"
     {
       NumberOption(GMSH_GET, (yyvsp[(1) - (6)].c), (int)(yyvsp[(3) - (6)].d), (yyvsp[(6) - (6)].c), (yyval.d));
       Free((yyvsp[(1) - (6)].c)); Free((yyvsp[(6) - (6)].c));
@@ -13303,7 +13333,7 @@ yyreduce:
     break;
 
   case 487:
-#line 5476 "Gmsh.y"
+#line 5506 "Gmsh.y"
     {
       double d = 0.;
       if(NumberOption(GMSH_GET, (yyvsp[(1) - (4)].c), 0, (yyvsp[(3) - (4)].c), d)){
@@ -13316,7 +13346,7 @@ yyreduce:
     break;
 
   case 488:
-#line 5486 "Gmsh.y"
+#line 5516 "Gmsh.y"
     {
       double d = 0.;
       if(NumberOption(GMSH_GET, (yyvsp[(1) - (7)].c), (int)(yyvsp[(3) - (7)].d), (yyvsp[(6) - (7)].c), d)){
@@ -13329,7 +13359,7 @@ yyreduce:
     break;
 
   case 489:
-#line 5496 "Gmsh.y"
+#line 5526 "Gmsh.y"
     {
       (yyval.d) = Msg::GetValue((yyvsp[(3) - (6)].c), (yyvsp[(5) - (6)].d));
       Free((yyvsp[(3) - (6)].c));
@@ -13337,7 +13367,7 @@ yyreduce:
     break;
 
   case 490:
-#line 5501 "Gmsh.y"
+#line 5531 "Gmsh.y"
     {
       int matches = 0;
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (6)].l)); i++){
@@ -13351,7 +13381,7 @@ yyreduce:
     break;
 
   case 491:
-#line 5512 "Gmsh.y"
+#line 5542 "Gmsh.y"
     {
       std::string s((yyvsp[(3) - (6)].c)), substr((yyvsp[(5) - (6)].c));
       if(s.find(substr) != std::string::npos)
@@ -13363,7 +13393,7 @@ yyreduce:
     break;
 
   case 492:
-#line 5521 "Gmsh.y"
+#line 5551 "Gmsh.y"
     {
       (yyval.d) = strlen((yyvsp[(3) - (4)].c));
       Free((yyvsp[(3) - (4)].c));
@@ -13371,7 +13401,7 @@ yyreduce:
     break;
 
   case 493:
-#line 5526 "Gmsh.y"
+#line 5556 "Gmsh.y"
     {
       (yyval.d) = strcmp((yyvsp[(3) - (6)].c), (yyvsp[(5) - (6)].c));
       Free((yyvsp[(3) - (6)].c)); Free((yyvsp[(5) - (6)].c));
@@ -13379,7 +13409,7 @@ yyreduce:
     break;
 
   case 494:
-#line 5531 "Gmsh.y"
+#line 5561 "Gmsh.y"
     {
       int align = 0, font = 0, fontsize = CTX::instance()->glFontSize;
       if(List_Nbr((yyvsp[(3) - (4)].l)) % 2){
@@ -13406,27 +13436,27 @@ yyreduce:
     break;
 
   case 495:
-#line 5558 "Gmsh.y"
+#line 5588 "Gmsh.y"
     { (yyval.d) = 0.; ;}
     break;
 
   case 496:
-#line 5560 "Gmsh.y"
+#line 5590 "Gmsh.y"
     { (yyval.d) = (yyvsp[(2) - (2)].d);;}
     break;
 
   case 497:
-#line 5565 "Gmsh.y"
+#line 5595 "Gmsh.y"
     { (yyval.c) = NULL; ;}
     break;
 
   case 498:
-#line 5567 "Gmsh.y"
+#line 5597 "Gmsh.y"
     { (yyval.c) = (yyvsp[(2) - (2)].c);;}
     break;
 
   case 499:
-#line 5572 "Gmsh.y"
+#line 5602 "Gmsh.y"
     {
       std::string struct_namespace((yyvsp[(2) - (3)].c2).char1? (yyvsp[(2) - (3)].c2).char1 : std::string("")),
         struct_name((yyvsp[(2) - (3)].c2).char2);
@@ -13436,7 +13466,7 @@ yyreduce:
     break;
 
   case 500:
-#line 5579 "Gmsh.y"
+#line 5609 "Gmsh.y"
     {
       std::string struct_namespace((yyvsp[(2) - (7)].c2).char1? (yyvsp[(2) - (7)].c2).char1 : std::string("")),
         struct_name((yyvsp[(2) - (7)].c2).char2);
@@ -13452,100 +13482,100 @@ yyreduce:
     break;
 
   case 501:
-#line 5595 "Gmsh.y"
+#line 5625 "Gmsh.y"
     { (yyval.c2).char1 = NULL; (yyval.c2).char2 = (yyvsp[(1) - (1)].c); ;}
     break;
 
   case 502:
-#line 5597 "Gmsh.y"
+#line 5627 "Gmsh.y"
     { (yyval.c2).char1 = (yyvsp[(1) - (3)].c); (yyval.c2).char2 = (yyvsp[(3) - (3)].c); ;}
     break;
 
   case 503:
-#line 5602 "Gmsh.y"
+#line 5632 "Gmsh.y"
     { (yyval.i) = 99; ;}
     break;
 
   case 504:
-#line 5604 "Gmsh.y"
+#line 5634 "Gmsh.y"
     { (yyval.i) = (int)(yyvsp[(2) - (2)].d); ;}
     break;
 
   case 505:
-#line 5609 "Gmsh.y"
+#line 5639 "Gmsh.y"
     { (yyval.i) = 0; ;}
     break;
 
   case 506:
-#line 5611 "Gmsh.y"
+#line 5641 "Gmsh.y"
     { (yyval.i) = (yyvsp[(2) - (3)].i); ;}
     break;
 
   case 507:
-#line 5616 "Gmsh.y"
+#line 5646 "Gmsh.y"
     {
       memcpy((yyval.v), (yyvsp[(1) - (1)].v), 5*sizeof(double));
     ;}
     break;
 
   case 508:
-#line 5620 "Gmsh.y"
+#line 5650 "Gmsh.y"
     {
       for(int i = 0; i < 5; i++) (yyval.v)[i] = -(yyvsp[(2) - (2)].v)[i];
     ;}
     break;
 
   case 509:
-#line 5624 "Gmsh.y"
+#line 5654 "Gmsh.y"
     {
       for(int i = 0; i < 5; i++) (yyval.v)[i] = (yyvsp[(2) - (2)].v)[i];
     ;}
     break;
 
   case 510:
-#line 5628 "Gmsh.y"
+#line 5658 "Gmsh.y"
     {
       for(int i = 0; i < 5; i++) (yyval.v)[i] = (yyvsp[(1) - (3)].v)[i] - (yyvsp[(3) - (3)].v)[i];
     ;}
     break;
 
   case 511:
-#line 5632 "Gmsh.y"
+#line 5662 "Gmsh.y"
     {
       for(int i = 0; i < 5; i++) (yyval.v)[i] = (yyvsp[(1) - (3)].v)[i] + (yyvsp[(3) - (3)].v)[i];
     ;}
     break;
 
   case 512:
-#line 5639 "Gmsh.y"
+#line 5669 "Gmsh.y"
     {
       (yyval.v)[0] = (yyvsp[(2) - (11)].d);  (yyval.v)[1] = (yyvsp[(4) - (11)].d);  (yyval.v)[2] = (yyvsp[(6) - (11)].d);  (yyval.v)[3] = (yyvsp[(8) - (11)].d); (yyval.v)[4] = (yyvsp[(10) - (11)].d);
     ;}
     break;
 
   case 513:
-#line 5643 "Gmsh.y"
+#line 5673 "Gmsh.y"
     {
       (yyval.v)[0] = (yyvsp[(2) - (9)].d);  (yyval.v)[1] = (yyvsp[(4) - (9)].d);  (yyval.v)[2] = (yyvsp[(6) - (9)].d);  (yyval.v)[3] = (yyvsp[(8) - (9)].d); (yyval.v)[4] = 1.0;
     ;}
     break;
 
   case 514:
-#line 5647 "Gmsh.y"
+#line 5677 "Gmsh.y"
     {
       (yyval.v)[0] = (yyvsp[(2) - (7)].d);  (yyval.v)[1] = (yyvsp[(4) - (7)].d);  (yyval.v)[2] = (yyvsp[(6) - (7)].d);  (yyval.v)[3] = 0.0; (yyval.v)[4] = 1.0;
     ;}
     break;
 
   case 515:
-#line 5651 "Gmsh.y"
+#line 5681 "Gmsh.y"
     {
       (yyval.v)[0] = (yyvsp[(2) - (7)].d);  (yyval.v)[1] = (yyvsp[(4) - (7)].d);  (yyval.v)[2] = (yyvsp[(6) - (7)].d);  (yyval.v)[3] = 0.0; (yyval.v)[4] = 1.0;
     ;}
     break;
 
   case 516:
-#line 5658 "Gmsh.y"
+#line 5688 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(List_T*));
       List_Add((yyval.l), &((yyvsp[(1) - (1)].l)));
@@ -13553,14 +13583,14 @@ yyreduce:
     break;
 
   case 517:
-#line 5663 "Gmsh.y"
+#line 5693 "Gmsh.y"
     {
       List_Add((yyval.l), &((yyvsp[(3) - (3)].l)));
     ;}
     break;
 
   case 518:
-#line 5670 "Gmsh.y"
+#line 5700 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(double));
       List_Add((yyval.l), &((yyvsp[(1) - (1)].d)));
@@ -13568,14 +13598,14 @@ yyreduce:
     break;
 
   case 519:
-#line 5675 "Gmsh.y"
+#line 5705 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(1) - (1)].l);
     ;}
     break;
 
   case 520:
-#line 5679 "Gmsh.y"
+#line 5709 "Gmsh.y"
     {
       // creates an empty list
       (yyval.l) = List_Create(2, 1, sizeof(double));
@@ -13583,14 +13613,14 @@ yyreduce:
     break;
 
   case 521:
-#line 5684 "Gmsh.y"
+#line 5714 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(2) - (3)].l);
     ;}
     break;
 
   case 522:
-#line 5688 "Gmsh.y"
+#line 5718 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(3) - (4)].l);
       for(int i = 0; i < List_Nbr((yyval.l)); i++){
@@ -13601,7 +13631,7 @@ yyreduce:
     break;
 
   case 523:
-#line 5696 "Gmsh.y"
+#line 5726 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(4) - (5)].l);
       for(int i = 0; i < List_Nbr((yyval.l)); i++){
@@ -13612,21 +13642,21 @@ yyreduce:
     break;
 
   case 524:
-#line 5707 "Gmsh.y"
+#line 5737 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(1) - (1)].l);
     ;}
     break;
 
   case 525:
-#line 5711 "Gmsh.y"
+#line 5741 "Gmsh.y"
     {
       (yyval.l) = 0;
     ;}
     break;
 
   case 526:
-#line 5715 "Gmsh.y"
+#line 5745 "Gmsh.y"
     {
       if(!strcmp((yyvsp[(1) - (1)].c), "*") || !strcmp((yyvsp[(1) - (1)].c), "all")){
         (yyval.l) = 0;
@@ -13640,7 +13670,7 @@ yyreduce:
     break;
 
   case 527:
-#line 5729 "Gmsh.y"
+#line 5759 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(2) - (2)].l);
       for(int i = 0; i < List_Nbr((yyval.l)); i++){
@@ -13651,7 +13681,7 @@ yyreduce:
     break;
 
   case 528:
-#line 5737 "Gmsh.y"
+#line 5767 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(3) - (3)].l);
       for(int i = 0; i < List_Nbr((yyval.l)); i++){
@@ -13662,7 +13692,7 @@ yyreduce:
     break;
 
   case 529:
-#line 5745 "Gmsh.y"
+#line 5775 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(double));
       for(double d = (yyvsp[(1) - (3)].d); ((yyvsp[(1) - (3)].d) < (yyvsp[(3) - (3)].d)) ? (d <= (yyvsp[(3) - (3)].d)) : (d >= (yyvsp[(3) - (3)].d));
@@ -13672,7 +13702,7 @@ yyreduce:
     break;
 
   case 530:
-#line 5752 "Gmsh.y"
+#line 5782 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(double));
       if(!(yyvsp[(5) - (5)].d)){  //|| ($1 < $3 && $5 < 0) || ($1 > $3 && $5 > 0)
@@ -13685,7 +13715,7 @@ yyreduce:
     break;
 
   case 531:
-#line 5762 "Gmsh.y"
+#line 5792 "Gmsh.y"
     {
       (yyval.l) = List_Create(3, 1, sizeof(double));
       int tag = (int)(yyvsp[(3) - (4)].d);
@@ -13711,7 +13741,7 @@ yyreduce:
     break;
 
   case 532:
-#line 5785 "Gmsh.y"
+#line 5815 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       getAllElementaryTags(0, (yyval.l));
@@ -13719,7 +13749,7 @@ yyreduce:
     break;
 
   case 533:
-#line 5790 "Gmsh.y"
+#line 5820 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       getAllElementaryTags(0, (yyval.l));
@@ -13728,7 +13758,7 @@ yyreduce:
     break;
 
   case 534:
-#line 5796 "Gmsh.y"
+#line 5826 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       getAllElementaryTags((yyvsp[(1) - (4)].i), (yyval.l));
@@ -13736,7 +13766,7 @@ yyreduce:
     break;
 
   case 535:
-#line 5801 "Gmsh.y"
+#line 5831 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       getAllElementaryTags((yyvsp[(1) - (2)].i), (yyval.l));
@@ -13745,7 +13775,7 @@ yyreduce:
     break;
 
   case 536:
-#line 5807 "Gmsh.y"
+#line 5837 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       if(!(yyvsp[(3) - (3)].l)){
@@ -13759,7 +13789,7 @@ yyreduce:
     break;
 
   case 537:
-#line 5818 "Gmsh.y"
+#line 5848 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       getParentTags((yyvsp[(2) - (3)].i), (yyvsp[(3) - (3)].l), (yyval.l));
@@ -13768,7 +13798,7 @@ yyreduce:
     break;
 
   case 538:
-#line 5824 "Gmsh.y"
+#line 5854 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       if(List_Nbr((yyvsp[(4) - (4)].l)) < 6) {
@@ -13785,7 +13815,7 @@ yyreduce:
     break;
 
   case 539:
-#line 5838 "Gmsh.y"
+#line 5868 "Gmsh.y"
     {
       (yyval.l) = List_Create(10, 10, sizeof(double));
       getBoundingBox((yyvsp[(2) - (5)].i), (yyvsp[(4) - (5)].l), (yyval.l));
@@ -13794,7 +13824,7 @@ yyreduce:
     break;
 
   case 540:
-#line 5844 "Gmsh.y"
+#line 5874 "Gmsh.y"
     {
       (yyval.l) = List_Create(1, 1, sizeof(double));
       double m = 0;
@@ -13809,7 +13839,7 @@ yyreduce:
     break;
 
   case 541:
-#line 5856 "Gmsh.y"
+#line 5886 "Gmsh.y"
     {
       (yyval.l) = List_Create(3, 1, sizeof(double));
       double x = 0., y = 0., z = 0.;
@@ -13826,7 +13856,7 @@ yyreduce:
     break;
 
   case 542:
-#line 5870 "Gmsh.y"
+#line 5900 "Gmsh.y"
     {
       (yyval.l) = List_Create(List_Nbr((yyvsp[(1) - (1)].l)), 1, sizeof(double));
       for(int i = 0; i < List_Nbr((yyvsp[(1) - (1)].l)); i++){
@@ -13839,7 +13869,7 @@ yyreduce:
     break;
 
   case 543:
-#line 5880 "Gmsh.y"
+#line 5910 "Gmsh.y"
     {
       (yyval.l) = List_Create(List_Nbr((yyvsp[(1) - (1)].l)), 1, sizeof(double));
       for(int i = 0; i < List_Nbr((yyvsp[(1) - (1)].l)); i++){
@@ -13852,7 +13882,7 @@ yyreduce:
     break;
 
   case 544:
-#line 5890 "Gmsh.y"
+#line 5920 "Gmsh.y"
     {
       (yyval.l) = List_Create(List_Nbr((yyvsp[(1) - (1)].l)), 1, sizeof(double));
       for(int i = 0; i < List_Nbr((yyvsp[(1) - (1)].l)); i++){
@@ -13865,7 +13895,7 @@ yyreduce:
     break;
 
   case 545:
-#line 5900 "Gmsh.y"
+#line 5930 "Gmsh.y"
     {
       (yyval.l) = List_Create(20, 20, sizeof(double));
       if(!gmsh_yysymbols.count((yyvsp[(1) - (3)].c)))
@@ -13880,21 +13910,21 @@ yyreduce:
     break;
 
   case 546:
-#line 5912 "Gmsh.y"
+#line 5942 "Gmsh.y"
     {
       (yyval.l) = treat_Struct_FullName_dot_tSTRING_ListOfFloat(NULL, (yyvsp[(1) - (5)].c), (yyvsp[(3) - (5)].c));
     ;}
     break;
 
   case 547:
-#line 5916 "Gmsh.y"
+#line 5946 "Gmsh.y"
     {
       (yyval.l) = treat_Struct_FullName_dot_tSTRING_ListOfFloat((yyvsp[(1) - (7)].c), (yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].c));
     ;}
     break;
 
   case 548:
-#line 5921 "Gmsh.y"
+#line 5951 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(double));
       if(!gmsh_yysymbols.count((yyvsp[(3) - (4)].c)))
@@ -13909,28 +13939,28 @@ yyreduce:
     break;
 
   case 549:
-#line 5933 "Gmsh.y"
+#line 5963 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(3) - (4)].l);
     ;}
     break;
 
   case 550:
-#line 5937 "Gmsh.y"
+#line 5967 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(3) - (4)].l);
     ;}
     break;
 
   case 551:
-#line 5941 "Gmsh.y"
+#line 5971 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(4) - (6)].l);
     ;}
     break;
 
   case 552:
-#line 5945 "Gmsh.y"
+#line 5975 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(double));
       if(!gmsh_yysymbols.count((yyvsp[(1) - (6)].c)))
@@ -13951,7 +13981,7 @@ yyreduce:
     break;
 
   case 553:
-#line 5963 "Gmsh.y"
+#line 5993 "Gmsh.y"
     {
       (yyval.l) = List_Create(20,20,sizeof(double));
       for(int i = 0; i < (int)(yyvsp[(7) - (8)].d); i++) {
@@ -13962,7 +13992,7 @@ yyreduce:
     break;
 
   case 554:
-#line 5971 "Gmsh.y"
+#line 6001 "Gmsh.y"
     {
       (yyval.l) = List_Create(20,20,sizeof(double));
       for(int i = 0; i < (int)(yyvsp[(7) - (8)].d); i++) {
@@ -13973,7 +14003,7 @@ yyreduce:
     break;
 
   case 555:
-#line 5979 "Gmsh.y"
+#line 6009 "Gmsh.y"
     {
       Msg::Barrier();
       FILE *File;
@@ -14005,7 +14035,7 @@ yyreduce:
     break;
 
   case 556:
-#line 6008 "Gmsh.y"
+#line 6038 "Gmsh.y"
     {
       double x0 = (yyvsp[(3) - (14)].d), x1 = (yyvsp[(5) - (14)].d), y0 = (yyvsp[(7) - (14)].d), y1 = (yyvsp[(9) - (14)].d), ys = (yyvsp[(11) - (14)].d);
       int N = (int)(yyvsp[(13) - (14)].d);
@@ -14018,7 +14048,7 @@ yyreduce:
     break;
 
   case 557:
-#line 6018 "Gmsh.y"
+#line 6048 "Gmsh.y"
     {
       std::vector<double> tmp;
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (4)].l)); i++){
@@ -14037,7 +14067,7 @@ yyreduce:
     break;
 
   case 558:
-#line 6034 "Gmsh.y"
+#line 6064 "Gmsh.y"
     {
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (4)].l)); i++){
         double *d = (double*)List_Pointer((yyvsp[(3) - (4)].l), i);
@@ -14048,7 +14078,7 @@ yyreduce:
     break;
 
   case 559:
-#line 6045 "Gmsh.y"
+#line 6075 "Gmsh.y"
     {
       (yyval.l) = List_Create(2, 1, sizeof(double));
       List_Add((yyval.l), &((yyvsp[(1) - (1)].d)));
@@ -14056,21 +14086,21 @@ yyreduce:
     break;
 
   case 560:
-#line 6050 "Gmsh.y"
+#line 6080 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(1) - (1)].l);
     ;}
     break;
 
   case 561:
-#line 6054 "Gmsh.y"
+#line 6084 "Gmsh.y"
     {
       List_Add((yyval.l), &((yyvsp[(3) - (3)].d)));
     ;}
     break;
 
   case 562:
-#line 6058 "Gmsh.y"
+#line 6088 "Gmsh.y"
     {
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (3)].l)); i++){
 	double d;
@@ -14082,21 +14112,21 @@ yyreduce:
     break;
 
   case 563:
-#line 6070 "Gmsh.y"
+#line 6100 "Gmsh.y"
     {
       (yyval.u) = CTX::instance()->packColor((int)(yyvsp[(2) - (9)].d), (int)(yyvsp[(4) - (9)].d), (int)(yyvsp[(6) - (9)].d), (int)(yyvsp[(8) - (9)].d));
     ;}
     break;
 
   case 564:
-#line 6074 "Gmsh.y"
+#line 6104 "Gmsh.y"
     {
       (yyval.u) = CTX::instance()->packColor((int)(yyvsp[(2) - (7)].d), (int)(yyvsp[(4) - (7)].d), (int)(yyvsp[(6) - (7)].d), 255);
     ;}
     break;
 
   case 565:
-#line 6086 "Gmsh.y"
+#line 6116 "Gmsh.y"
     {
       int flag = 0;
       if(gmsh_yystringsymbols.count((yyvsp[(1) - (1)].c))){
@@ -14116,7 +14146,7 @@ yyreduce:
     break;
 
   case 566:
-#line 6103 "Gmsh.y"
+#line 6133 "Gmsh.y"
     {
       unsigned int val = 0;
       ColorOption(GMSH_GET, (yyvsp[(1) - (5)].c), 0, (yyvsp[(5) - (5)].c), val);
@@ -14126,14 +14156,14 @@ yyreduce:
     break;
 
   case 567:
-#line 6113 "Gmsh.y"
+#line 6143 "Gmsh.y"
     {
       (yyval.l) = (yyvsp[(2) - (3)].l);
     ;}
     break;
 
   case 568:
-#line 6117 "Gmsh.y"
+#line 6147 "Gmsh.y"
     {
       (yyval.l) = List_Create(256, 10, sizeof(unsigned int));
       GmshColorTable *ct = GetColorTable((int)(yyvsp[(3) - (6)].d));
@@ -14148,7 +14178,7 @@ yyreduce:
     break;
 
   case 569:
-#line 6132 "Gmsh.y"
+#line 6162 "Gmsh.y"
     {
       (yyval.l) = List_Create(256, 10, sizeof(unsigned int));
       List_Add((yyval.l), &((yyvsp[(1) - (1)].u)));
@@ -14156,21 +14186,21 @@ yyreduce:
     break;
 
   case 570:
-#line 6137 "Gmsh.y"
+#line 6167 "Gmsh.y"
     {
       List_Add((yyval.l), &((yyvsp[(3) - (3)].u)));
     ;}
     break;
 
   case 571:
-#line 6144 "Gmsh.y"
+#line 6174 "Gmsh.y"
     {
       (yyval.c) = (yyvsp[(1) - (1)].c);
     ;}
     break;
 
   case 572:
-#line 6148 "Gmsh.y"
+#line 6178 "Gmsh.y"
     {
       // No need to extend to Struct_FullName (a Tag is not a String)
       (yyval.c) = treat_Struct_FullName_String(NULL, (yyvsp[(1) - (1)].c));
@@ -14178,7 +14208,7 @@ yyreduce:
     break;
 
   case 573:
-#line 6153 "Gmsh.y"
+#line 6183 "Gmsh.y"
     {
       std::string val;
       int j = (int)(yyvsp[(3) - (4)].d);
@@ -14195,7 +14225,7 @@ yyreduce:
     break;
 
   case 574:
-#line 6167 "Gmsh.y"
+#line 6197 "Gmsh.y"
     {
       std::string val;
       int j = (int)(yyvsp[(3) - (4)].d);
@@ -14212,35 +14242,35 @@ yyreduce:
     break;
 
   case 575:
-#line 6181 "Gmsh.y"
+#line 6211 "Gmsh.y"
     {
       (yyval.c) = treat_Struct_FullName_dot_tSTRING_String(NULL, (yyvsp[(1) - (3)].c), (yyvsp[(3) - (3)].c));
     ;}
     break;
 
   case 576:
-#line 6185 "Gmsh.y"
+#line 6215 "Gmsh.y"
     {
       (yyval.c) = treat_Struct_FullName_dot_tSTRING_String((yyvsp[(1) - (5)].c), (yyvsp[(3) - (5)].c), (yyvsp[(5) - (5)].c));
     ;}
     break;
 
   case 577:
-#line 6189 "Gmsh.y"
+#line 6219 "Gmsh.y"
     {
       (yyval.c) = treat_Struct_FullName_dot_tSTRING_String(NULL, (yyvsp[(1) - (6)].c), (yyvsp[(3) - (6)].c), (int)(yyvsp[(5) - (6)].d));
     ;}
     break;
 
   case 578:
-#line 6193 "Gmsh.y"
+#line 6223 "Gmsh.y"
     {
       (yyval.c) = treat_Struct_FullName_dot_tSTRING_String((yyvsp[(1) - (8)].c), (yyvsp[(3) - (8)].c), (yyvsp[(5) - (8)].c), (int)(yyvsp[(7) - (8)].d));
     ;}
     break;
 
   case 579:
-#line 6197 "Gmsh.y"
+#line 6227 "Gmsh.y"
     {
       std::string out;
       StringOption(GMSH_GET, (yyvsp[(1) - (6)].c), (int)(yyvsp[(3) - (6)].d), (yyvsp[(6) - (6)].c), out);
@@ -14251,7 +14281,7 @@ yyreduce:
     break;
 
   case 580:
-#line 6205 "Gmsh.y"
+#line 6235 "Gmsh.y"
     {
       std::string name = GModel::current()->getElementaryName((yyvsp[(1) - (4)].i), (int)(yyvsp[(3) - (4)].d));
       (yyval.c) = (char*)Malloc((name.size() + 1) * sizeof(char));
@@ -14260,7 +14290,7 @@ yyreduce:
     break;
 
   case 581:
-#line 6211 "Gmsh.y"
+#line 6241 "Gmsh.y"
     {
       std::string name = GModel::current()->getPhysicalName((yyvsp[(2) - (5)].i), (int)(yyvsp[(4) - (5)].d));
       (yyval.c) = (char*)Malloc((name.size() + 1) * sizeof(char));
@@ -14269,21 +14299,21 @@ yyreduce:
     break;
 
   case 582:
-#line 6220 "Gmsh.y"
+#line 6250 "Gmsh.y"
     {
       (yyval.c) = (yyvsp[(1) - (1)].c);
     ;}
     break;
 
   case 583:
-#line 6224 "Gmsh.y"
+#line 6254 "Gmsh.y"
     {
       (yyval.c) = (yyvsp[(3) - (4)].c);
     ;}
     break;
 
   case 584:
-#line 6228 "Gmsh.y"
+#line 6258 "Gmsh.y"
     {
       (yyval.c) = (char *)Malloc(32 * sizeof(char));
       time_t now;
@@ -14294,7 +14324,7 @@ yyreduce:
     break;
 
   case 585:
-#line 6236 "Gmsh.y"
+#line 6266 "Gmsh.y"
     {
       std::string exe = Msg::GetExecutableName();
       (yyval.c) = (char *)Malloc(exe.size() + 1);
@@ -14303,7 +14333,7 @@ yyreduce:
     break;
 
   case 586:
-#line 6242 "Gmsh.y"
+#line 6272 "Gmsh.y"
     {
       std::string action = Msg::GetOnelabAction();
       (yyval.c) = (char *)Malloc(action.size() + 1);
@@ -14312,14 +14342,14 @@ yyreduce:
     break;
 
   case 587:
-#line 6248 "Gmsh.y"
+#line 6278 "Gmsh.y"
     {
       (yyval.c) = strsave((char*)"Gmsh");
     ;}
     break;
 
   case 588:
-#line 6252 "Gmsh.y"
+#line 6282 "Gmsh.y"
     {
       std::string env = GetEnvironmentVar((yyvsp[(3) - (4)].c));
       (yyval.c) = (char *)Malloc((env.size() + 1) * sizeof(char));
@@ -14329,7 +14359,7 @@ yyreduce:
     break;
 
   case 589:
-#line 6259 "Gmsh.y"
+#line 6289 "Gmsh.y"
     {
       std::string s = Msg::GetString((yyvsp[(3) - (6)].c), (yyvsp[(5) - (6)].c));
       (yyval.c) = (char *)Malloc((s.size() + 1) * sizeof(char));
@@ -14340,7 +14370,7 @@ yyreduce:
     break;
 
   case 590:
-#line 6267 "Gmsh.y"
+#line 6297 "Gmsh.y"
     {
       std::string s = Msg::GetOnelabString((yyvsp[(3) - (4)].c));
       (yyval.c) = (char *)Malloc((s.size() + 1) * sizeof(char));
@@ -14350,7 +14380,7 @@ yyreduce:
     break;
 
   case 591:
-#line 6274 "Gmsh.y"
+#line 6304 "Gmsh.y"
     {
       std::string s = Msg::GetOnelabString((yyvsp[(3) - (6)].c), (yyvsp[(5) - (6)].c));
       (yyval.c) = (char *)Malloc((s.size() + 1) * sizeof(char));
@@ -14361,21 +14391,21 @@ yyreduce:
     break;
 
   case 592:
-#line 6283 "Gmsh.y"
+#line 6313 "Gmsh.y"
     {
       (yyval.c) = treat_Struct_FullName_String(NULL, (yyvsp[(3) - (5)].c2).char2, 1, 0, (yyvsp[(4) - (5)].c), 2);
     ;}
     break;
 
   case 593:
-#line 6287 "Gmsh.y"
+#line 6317 "Gmsh.y"
     {
       (yyval.c) = treat_Struct_FullName_dot_tSTRING_String((yyvsp[(3) - (7)].c2).char1, (yyvsp[(3) - (7)].c2).char2, (yyvsp[(5) - (7)].c), 0, (yyvsp[(6) - (7)].c), 2);
     ;}
     break;
 
   case 594:
-#line 6291 "Gmsh.y"
+#line 6321 "Gmsh.y"
     {
       int size = 1;
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (4)].l)); i++)
@@ -14393,7 +14423,7 @@ yyreduce:
     break;
 
   case 595:
-#line 6306 "Gmsh.y"
+#line 6336 "Gmsh.y"
     {
       (yyval.c) = (char *)Malloc((strlen((yyvsp[(3) - (4)].c)) + 1) * sizeof(char));
       int i;
@@ -14410,7 +14440,7 @@ yyreduce:
     break;
 
   case 596:
-#line 6320 "Gmsh.y"
+#line 6350 "Gmsh.y"
     {
       (yyval.c) = (char *)Malloc((strlen((yyvsp[(3) - (4)].c)) + 1) * sizeof(char));
       int i;
@@ -14427,7 +14457,7 @@ yyreduce:
     break;
 
   case 597:
-#line 6334 "Gmsh.y"
+#line 6364 "Gmsh.y"
     {
       std::string input = (yyvsp[(3) - (8)].c);
       std::string substr_old = (yyvsp[(5) - (8)].c);
@@ -14442,7 +14472,7 @@ yyreduce:
     break;
 
   case 598:
-#line 6346 "Gmsh.y"
+#line 6376 "Gmsh.y"
     {
       int size = 1;
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (4)].l)); i++)
@@ -14461,7 +14491,7 @@ yyreduce:
     break;
 
   case 599:
-#line 6362 "Gmsh.y"
+#line 6392 "Gmsh.y"
     {
       int i = 0;
       while ((yyvsp[(3) - (4)].c)[i]) {
@@ -14473,7 +14503,7 @@ yyreduce:
     break;
 
   case 600:
-#line 6371 "Gmsh.y"
+#line 6401 "Gmsh.y"
     {
       int i = 0;
       while ((yyvsp[(3) - (4)].c)[i]) {
@@ -14485,7 +14515,7 @@ yyreduce:
     break;
 
   case 601:
-#line 6380 "Gmsh.y"
+#line 6410 "Gmsh.y"
     {
       int i = 0;
       while ((yyvsp[(3) - (4)].c)[i]) {
@@ -14498,7 +14528,7 @@ yyreduce:
     break;
 
   case 602:
-#line 6390 "Gmsh.y"
+#line 6420 "Gmsh.y"
     {
       if((yyvsp[(3) - (8)].d)){
         (yyval.c) = (yyvsp[(5) - (8)].c);
@@ -14512,7 +14542,7 @@ yyreduce:
     break;
 
   case 603:
-#line 6401 "Gmsh.y"
+#line 6431 "Gmsh.y"
     {
       std::string in = (yyvsp[(3) - (8)].c);
       std::string out = in.substr((int)(yyvsp[(5) - (8)].d), (int)(yyvsp[(7) - (8)].d));
@@ -14523,7 +14553,7 @@ yyreduce:
     break;
 
   case 604:
-#line 6409 "Gmsh.y"
+#line 6439 "Gmsh.y"
     {
       std::string in = (yyvsp[(3) - (6)].c);
       std::string out = in.substr((int)(yyvsp[(5) - (6)].d), std::string::npos);
@@ -14534,14 +14564,14 @@ yyreduce:
     break;
 
   case 605:
-#line 6417 "Gmsh.y"
+#line 6447 "Gmsh.y"
     {
       (yyval.c) = (yyvsp[(3) - (4)].c);
     ;}
     break;
 
   case 606:
-#line 6421 "Gmsh.y"
+#line 6451 "Gmsh.y"
     {
       char tmpstring[5000];
       int i = printListOfDouble((yyvsp[(3) - (6)].c), (yyvsp[(5) - (6)].l), tmpstring);
@@ -14563,7 +14593,7 @@ yyreduce:
     break;
 
   case 607:
-#line 6440 "Gmsh.y"
+#line 6470 "Gmsh.y"
     {
       std::string tmp = FixRelativePath(gmsh_yyname, (yyvsp[(3) - (4)].c));
       (yyval.c) = (char*)Malloc((tmp.size() + 1) * sizeof(char));
@@ -14573,7 +14603,7 @@ yyreduce:
     break;
 
   case 608:
-#line 6447 "Gmsh.y"
+#line 6477 "Gmsh.y"
     {
       std::string tmp = SplitFileName(GetAbsolutePath(gmsh_yyname))[0];
       (yyval.c) = (char*)Malloc((tmp.size() + 1) * sizeof(char));
@@ -14582,7 +14612,7 @@ yyreduce:
     break;
 
   case 609:
-#line 6453 "Gmsh.y"
+#line 6483 "Gmsh.y"
     {
       std::string tmp = GetFileNameWithoutPath(gmsh_yyname);
       (yyval.c) = (char*)Malloc((tmp.size() + 1) * sizeof(char));
@@ -14591,7 +14621,7 @@ yyreduce:
     break;
 
   case 610:
-#line 6459 "Gmsh.y"
+#line 6489 "Gmsh.y"
     {
       std::string tmp = SplitFileName((yyvsp[(3) - (4)].c))[0];
       (yyval.c) = (char*)Malloc((tmp.size() + 1) * sizeof(char));
@@ -14601,7 +14631,7 @@ yyreduce:
     break;
 
   case 611:
-#line 6466 "Gmsh.y"
+#line 6496 "Gmsh.y"
     {
       std::string tmp = GetAbsolutePath((yyvsp[(3) - (4)].c));
       (yyval.c) = (char*)Malloc((tmp.size() + 1) * sizeof(char));
@@ -14611,12 +14641,12 @@ yyreduce:
     break;
 
   case 612:
-#line 6473 "Gmsh.y"
+#line 6503 "Gmsh.y"
     { init_options(); ;}
     break;
 
   case 613:
-#line 6475 "Gmsh.y"
+#line 6505 "Gmsh.y"
     {
       std::string val((yyvsp[(3) - (6)].c));
       Msg::ExchangeOnelabParameter("", val, floatOptions, charOptions);
@@ -14627,7 +14657,7 @@ yyreduce:
     break;
 
   case 614:
-#line 6483 "Gmsh.y"
+#line 6513 "Gmsh.y"
     {
       std::string out;
       const std::string * key_struct = NULL;
@@ -14651,37 +14681,37 @@ yyreduce:
     break;
 
   case 615:
-#line 6507 "Gmsh.y"
+#line 6537 "Gmsh.y"
     { struct_namespace = std::string(""); (yyval.d) = (yyvsp[(2) - (2)].d); ;}
     break;
 
   case 616:
-#line 6509 "Gmsh.y"
+#line 6539 "Gmsh.y"
     { struct_namespace = (yyvsp[(1) - (4)].c); Free((yyvsp[(1) - (4)].c)); (yyval.d) = (yyvsp[(4) - (4)].d); ;}
     break;
 
   case 617:
-#line 6515 "Gmsh.y"
+#line 6545 "Gmsh.y"
     { (yyval.l) = (yyvsp[(3) - (4)].l); ;}
     break;
 
   case 618:
-#line 6520 "Gmsh.y"
+#line 6550 "Gmsh.y"
     { (yyval.l) = (yyvsp[(1) - (1)].l); ;}
     break;
 
   case 619:
-#line 6522 "Gmsh.y"
+#line 6552 "Gmsh.y"
     { (yyval.l) = (yyvsp[(1) - (1)].l); ;}
     break;
 
   case 620:
-#line 6527 "Gmsh.y"
+#line 6557 "Gmsh.y"
     { (yyval.l) = (yyvsp[(2) - (3)].l); ;}
     break;
 
   case 621:
-#line 6532 "Gmsh.y"
+#line 6562 "Gmsh.y"
     {
       (yyval.l) = List_Create(20,20,sizeof(char*));
       List_Add((yyval.l), &((yyvsp[(1) - (1)].c)));
@@ -14689,19 +14719,19 @@ yyreduce:
     break;
 
   case 622:
-#line 6537 "Gmsh.y"
+#line 6567 "Gmsh.y"
     { (yyval.l) = (yyvsp[(1) - (1)].l); ;}
     break;
 
   case 623:
-#line 6539 "Gmsh.y"
+#line 6569 "Gmsh.y"
     {
       List_Add((yyval.l), &((yyvsp[(3) - (3)].c)));
     ;}
     break;
 
   case 624:
-#line 6543 "Gmsh.y"
+#line 6573 "Gmsh.y"
     {
       for(int i = 0; i < List_Nbr((yyvsp[(3) - (3)].l)); i++){
 	char* c;
@@ -14713,7 +14743,7 @@ yyreduce:
     break;
 
   case 625:
-#line 6555 "Gmsh.y"
+#line 6585 "Gmsh.y"
     {
       (yyval.l) = List_Create(20, 20, sizeof(char *));
       if(!gmsh_yystringsymbols.count((yyvsp[(1) - (3)].c)))
@@ -14730,21 +14760,21 @@ yyreduce:
     break;
 
   case 626:
-#line 6569 "Gmsh.y"
+#line 6599 "Gmsh.y"
     {
       (yyval.l) = treat_Struct_FullName_dot_tSTRING_ListOfString(NULL, (yyvsp[(1) - (5)].c), (yyvsp[(3) - (5)].c));
     ;}
     break;
 
   case 627:
-#line 6573 "Gmsh.y"
+#line 6603 "Gmsh.y"
     {
       (yyval.l) = treat_Struct_FullName_dot_tSTRING_ListOfString((yyvsp[(1) - (7)].c), (yyvsp[(3) - (7)].c), (yyvsp[(5) - (7)].c));
     ;}
     break;
 
   case 628:
-#line 6580 "Gmsh.y"
+#line 6610 "Gmsh.y"
     {
       char tmpstr[256];
       sprintf(tmpstr, "_%d", (int)(yyvsp[(4) - (5)].d));
@@ -14755,7 +14785,7 @@ yyreduce:
     break;
 
   case 629:
-#line 6588 "Gmsh.y"
+#line 6618 "Gmsh.y"
     {
       char tmpstr[256];
       sprintf(tmpstr, "_%d", (int)(yyvsp[(4) - (5)].d));
@@ -14766,7 +14796,7 @@ yyreduce:
     break;
 
   case 630:
-#line 6596 "Gmsh.y"
+#line 6626 "Gmsh.y"
     {
       char tmpstr[256];
       sprintf(tmpstr, "_%d", (int)(yyvsp[(7) - (8)].d));
@@ -14777,23 +14807,23 @@ yyreduce:
     break;
 
   case 631:
-#line 6607 "Gmsh.y"
+#line 6637 "Gmsh.y"
     { (yyval.c) = (yyvsp[(1) - (1)].c); ;}
     break;
 
   case 632:
-#line 6609 "Gmsh.y"
+#line 6639 "Gmsh.y"
     { (yyval.c) = (yyvsp[(1) - (1)].c); ;}
     break;
 
   case 633:
-#line 6612 "Gmsh.y"
+#line 6642 "Gmsh.y"
     { (yyval.c) = (yyvsp[(3) - (4)].c); ;}
     break;
 
 
 /* Line 1267 of yacc.c.  */
-#line 14797 "Gmsh.tab.cpp"
+#line 14827 "Gmsh.tab.cpp"
       default: break;
     }
   YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
@@ -15007,7 +15037,7 @@ yyreturn:
 }
 
 
-#line 6615 "Gmsh.y"
+#line 6645 "Gmsh.y"
 
 
 void assignVariable(const std::string &name, int index, int assignType,
@@ -15282,10 +15312,193 @@ void VectorOfPairs2ListOfShapes(const std::vector<std::pair<int, int> > &v, List
   }
 }
 
+// The tokens of For loop bodies are recorded while the body of the outermost
+// running loop is read from the file, and are replayed from memory for the
+// next iterations (of that loop and of the loops nested in it). Bodies that
+// define or call functions, or that read other files (Macro, Call, Return,
+// Include, Merge), are not recorded: their loops seek back in the file instead.
+
+struct gmsh_yytoken {
+  int type, lineno;
+  double d;
+  std::string c; // value of strings, or "newp", "newl", etc. for new tags
+  std::string text; // for error messages
+};
+
+static std::vector<gmsh_yytoken> loopTokens;
+static std::size_t loopTokenIndex = 0;
+static int loopCacheLevel = -1, loopCacheLineno = 0, unreadToken = 0;
+static bool loopReplay = false;
+static FILE *loopCacheFile = 0;
+
+static bool loopCacheActive()
+{
+  return loopCacheLevel >= 0 && gmsh_yyin == loopCacheFile;
+}
+
+void flushLoopCache()
+{
+  // files parsed while a loop body is recorded or replayed (e.g. strings
+  // parsed by ONELAB clients or print commands) must not flush its tokens
+  if(loopCacheLevel >= 0 && gmsh_yyin != loopCacheFile) return;
+  unreadToken = 0;
+  if(loopCacheLevel < 0) return;
+  if(loopReplay) gmsh_yylineno = loopCacheLineno;
+  for(int i = loopCacheLevel; i < ImbricatedLoop; i++)
+    yytokenImbricatedLoopsTab[i] = -1;
+  loopTokens.clear();
+  loopTokenIndex = 0;
+  loopCacheLevel = -1;
+  loopReplay = false;
+  loopCacheFile = 0;
+}
+
+int cacheLoopBody()
+{
+  if(loopCacheLevel < 0){
+    loopCacheLevel = ImbricatedLoop;
+    loopCacheFile = gmsh_yyin;
+  }
+  else if(gmsh_yyin != loopCacheFile)
+    return -1;
+  return (int)loopTokenIndex;
+}
+
+bool replayLoopBody(int index)
+{
+  if(index < 0 || !loopCacheActive()) return false;
+  if(!loopReplay){
+    loopCacheLineno = gmsh_yylineno;
+    loopReplay = true;
+  }
+  loopTokenIndex = index;
+  return true;
+}
+
+void leaveLoopBody()
+{
+  if(ImbricatedLoop <= loopCacheLevel) flushLoopCache();
+}
+
+static double newTag(const std::string &s)
+{
+  if(s == "newreg") return NEWREG();
+  else if(s == "newp") return NEWPOINT();
+  else if(s == "newl" || s == "newc") return NEWLINE();
+  else if(s == "newll") return NEWLINELOOP();
+  else if(s == "news") return NEWSURFACE();
+  else if(s == "newsl") return NEWSURFACELOOP();
+  else if(s == "newv") return NEWVOLUME();
+  return NEWFIELD();
+}
+
+int gmsh_yylex()
+{
+  if(unreadToken){
+    int type = unreadToken;
+    unreadToken = 0;
+    return type;
+  }
+
+  if(!loopCacheActive()) return gmsh_yyscan();
+
+  if(loopTokenIndex < loopTokens.size()){
+    const gmsh_yytoken &t = loopTokens[loopTokenIndex++];
+    if(t.type == tDOUBLE)
+      gmsh_yylval.d = t.c.empty() ? t.d : newTag(t.c);
+    else if(t.type == tSTRING || t.type == tBIGSTR)
+      gmsh_yylval.c = strsave((char *)t.c.c_str());
+    gmsh_yylineno = t.lineno;
+    return t.type;
+  }
+
+  if(loopReplay){ // back to the file
+    gmsh_yylineno = loopCacheLineno;
+    loopReplay = false;
+  }
+
+  int type = gmsh_yyscan();
+  if(type <= 0) return type;
+  if(type == tMacro || type == tCall || type == tReturn ||
+     (type == tSTRING && (!strcmp(gmsh_yylval.c, "Include") ||
+                          !strcmp(gmsh_yylval.c, "Merge") ||
+                          !strcmp(gmsh_yylval.c, "MergeWithBoundingBox")))){
+    flushLoopCache();
+    return type;
+  }
+
+  gmsh_yytoken t;
+  t.type = type;
+  t.lineno = gmsh_yylineno;
+  t.d = 0.;
+  t.text = gmsh_yytext;
+  if(type == tDOUBLE){
+    t.d = gmsh_yylval.d;
+    if(gmsh_yytext[0] == 'n') t.c = gmsh_yytext;
+  }
+  else if(type == tSTRING || type == tBIGSTR)
+    t.c = gmsh_yylval.c;
+  loopTokens.push_back(t);
+  loopTokenIndex++;
+  return type;
+}
+
+static void skipTokens(int skip, int until, int *type_until2)
+{
+  int nb_skip = 0;
+  while(1){
+    int type = gmsh_yylex();
+    if(type == tSTRING || type == tBIGSTR) Free(gmsh_yylval.c);
+    if(type <= 0){
+      Msg::Error("Unexpected end of file");
+      return;
+    }
+    if(type_until2 && !nb_skip && type == tElseIf){
+      // leave ElseIf to the parser
+      unreadToken = type;
+      *type_until2 = 1;
+      return;
+    }
+    else if(type_until2 && !nb_skip && type == tElse){
+      *type_until2 = 2;
+      return;
+    }
+    else if(type == until){
+      if(!nb_skip) return;
+      nb_skip--;
+    }
+    else if(type == skip){
+      nb_skip++;
+    }
+  }
+}
+
+void yyskip(const char *skip, const char *until)
+{
+  // the skipped tokens of a recorded loop body must be recorded as well
+  if(!loopCacheActive())
+    ::skip(skip, until);
+  else if(!strcmp(until, "EndFor"))
+    skipTokens(tFor, tEndFor, 0);
+  else
+    skipTokens(tIf, tEndIf, 0);
+}
+
+void yyskipTest(const char *skip, const char *until,
+                const char *until2, int l_until2_sub, int *type_until2)
+{
+  if(!loopCacheActive())
+    skipTest(skip, until, until2, l_until2_sub, type_until2);
+  else
+    skipTokens(tIf, tEndIf, type_until2);
+}
+
 void yyerror(const char *s)
 {
+  const char *text = (loopReplay && loopTokenIndex) ?
+    loopTokens[loopTokenIndex - 1].text.c_str() : gmsh_yytext;
   Msg::Error("'%s', line %d : %s (%s)", gmsh_yyname.c_str(), gmsh_yylineno - 1,
-             s, gmsh_yytext);
+             s, text);
   gmsh_yyerrorstate++;
 }
 
@@ -15675,11 +15888,15 @@ double treat_Struct_FullName_Float
 (char* c1, char* c2, int type_var, int index, double val_default, int type_treat)
 {
   double out;
-  if(!c1 && gmsh_yysymbols.count(c2)){
+  // this is called for every variable in every expression: only look the name
+  // up once in the symbol table
+  std::map<std::string, gmsh_yysymbol>::iterator its =
+    c1 ? gmsh_yysymbols.end() : gmsh_yysymbols.find(c2);
+  if(its != gmsh_yysymbols.end()){
     if (type_treat == 1) out = 1.; // Exists (type_treat == 1)
     else { // Get (0) or GetForced (2)
       if (type_var == 1) {
-        gmsh_yysymbol &s(gmsh_yysymbols[c2]);
+        gmsh_yysymbol &s(its->second);
         if(s.value.empty()){
           out = val_default;
           if (type_treat == 0) yymsg(0, "Uninitialized variable '%s'", c2);
@@ -15688,7 +15905,7 @@ double treat_Struct_FullName_Float
           out = s.value[0];
       }
       else if (type_var == 2) {
-        gmsh_yysymbol &s(gmsh_yysymbols[c2]);
+        gmsh_yysymbol &s(its->second);
         if(index < 0 || (int)s.value.size() < index + 1){
           out = val_default;
           if (type_treat == 0) yymsg(0, "Uninitialized variable '%s[%d]'", c2, index);
@@ -22,6 +22,7 @@
 #include "GModelIO_GEO.h"
 #include "GModelIO_OCC.h"
 #include "GeoDefines.h"
+#include "Geo.h"
 #include "ExtrudeParams.h"
 #include "Options.h"
 #include "Parser.h"
@@ -85,6 +86,7 @@ static fpos_t yyposImbricatedLoopsTab[MAX_RECUR_LOOPS];
 static int yylinenoImbricatedLoopsTab[MAX_RECUR_LOOPS];
 static double LoopControlVariablesTab[MAX_RECUR_LOOPS][3];
 static std::string LoopControlVariablesNameTab[MAX_RECUR_LOOPS];
+static int yytokenImbricatedLoopsTab[MAX_RECUR_LOOPS];
 static std::string struct_name, struct_namespace;
 static int dim_entity;
 
@@ -105,6 +107,13 @@ char *strsave(char *ptr);
 void skip(const char *skip, const char *until);
 void skipTest(const char *skip, const char *until,
               const char *until2, int l_until2_sub, int *type_until2);
+void yyskip(const char *skip, const char *until);
+void yyskipTest(const char *skip, const char *until,
+                const char *until2, int l_until2_sub, int *type_until2);
+int gmsh_yyscan();
+int cacheLoopBody();
+bool replayLoopBody(int index);
+void leaveLoopBody();
 void assignVariable(const std::string &name, int index, int assignType,
                     double value);
 void assignVariables(const std::string &name, List_T *indices, int assignType,
@@ -808,11 +817,16 @@ Affectation :
     }
   | String__Index NumericAffectation ListOfDouble tEND
     {
-      if(!gmsh_yysymbols.count($1) && $2 && List_Nbr($3) == 1){
+      std::map<std::string, gmsh_yysymbol>::iterator its =
+        gmsh_yysymbols.find($1);
+      if(its == gmsh_yysymbols.end() && $2 && List_Nbr($3) == 1){
         yymsg(0, "Unknown variable '%s'", $1);
       }
       else{
-        gmsh_yysymbol &s(gmsh_yysymbols[$1]);
+        if(its == gmsh_yysymbols.end())
+          its = gmsh_yysymbols.insert
+            (std::make_pair(std::string($1), gmsh_yysymbol())).first;
+        gmsh_yysymbol &s(its->second);
         if(!$2) s.list = (List_Nbr($3) != 1); // list if 0 or > 1 elements
         if(!s.list){ // single expression
           if(List_Nbr($3) != 1){
@@ -870,10 +884,12 @@ Affectation :
     }
   | String__Index NumericIncrement tEND
     {
-      if(!gmsh_yysymbols.count($1))
+      std::map<std::string, gmsh_yysymbol>::iterator its =
+        gmsh_yysymbols.find($1);
+      if(its == gmsh_yysymbols.end())
 	yymsg(0, "Unknown variable '%s'", $1);
       else{
-        gmsh_yysymbol &s(gmsh_yysymbols[$1]);
+        gmsh_yysymbol &s(its->second);
         if(!s.list && s.value.empty())
           yymsg(0, "Uninitialized variable '%s'", $1);
         else if(!s.list)
@@ -3756,9 +3772,11 @@ Loop :
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if($3 > $5)
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -3773,9 +3791,11 @@ Loop :
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if(($7 > 0. && $3 > $5) || ($7 < 0. && $3 < $5))
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -3794,9 +3814,11 @@ Loop :
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if($5 > $7)
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -3816,9 +3838,11 @@ Loop :
       fgetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop]);
       yylinenoImbricatedLoopsTab[ImbricatedLoop] = gmsh_yylineno;
       if(($9 > 0. && $5 > $7) || ($9 < 0. && $5 < $7))
-	skip("For", "EndFor");
-      else
+	yyskip("For", "EndFor");
+      else{
+        yytokenImbricatedLoopsTab[ImbricatedLoop] = cacheLoopBody();
 	ImbricatedLoop++;
+      }
       if(ImbricatedLoop > MAX_RECUR_LOOPS - 1){
 	yymsg(0, "Reached maximum number of imbricated loops");
 	ImbricatedLoop = MAX_RECUR_LOOPS - 1;
@@ -3835,10 +3859,12 @@ Loop :
 	double step = LoopControlVariablesTab[ImbricatedLoop - 1][2];
         std::string name = LoopControlVariablesNameTab[ImbricatedLoop - 1];
         if(name.size()){
-          if(!gmsh_yysymbols.count(name))
+          std::map<std::string, gmsh_yysymbol>::iterator its =
+            gmsh_yysymbols.find(name);
+          if(its == gmsh_yysymbols.end())
             yymsg(0, "Unknown loop variable '%s'", name.c_str());
           else{
-            gmsh_yysymbol &s(gmsh_yysymbols[name]);
+            gmsh_yysymbol &s(its->second);
             if(!s.list && s.value.size()){
               s.value[0] += step;
               LoopControlVariablesTab[ImbricatedLoop - 1][0] = s.value[0];
@@ -3853,11 +3879,15 @@ Loop :
 	double x0 = LoopControlVariablesTab[ImbricatedLoop - 1][0];
 	double x1 = LoopControlVariablesTab[ImbricatedLoop - 1][1];
         if((step > 0. && x0 <= x1) || (step < 0. && x0 >= x1)){
-	  fsetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop - 1]);
-	  gmsh_yylineno = yylinenoImbricatedLoopsTab[ImbricatedLoop - 1];
+          if(!replayLoopBody(yytokenImbricatedLoopsTab[ImbricatedLoop - 1])){
+	    fsetpos(gmsh_yyin, &yyposImbricatedLoopsTab[ImbricatedLoop - 1]);
+	    gmsh_yylineno = yylinenoImbricatedLoopsTab[ImbricatedLoop - 1];
+          }
 	}
-	else
+	else{
 	  ImbricatedLoop--;
+          leaveLoopBody();
+        }
       }
     }
   | tMacro tSTRING
@@ -3912,7 +3942,7 @@ Loop :
         statusImbricatedTests[ImbricatedTest] = 0;
         // Go after the next ElseIf or Else or EndIf
         int type_until2 = 0;
-        skipTest("If", "EndIf", "ElseIf", 4, &type_until2);
+        yyskipTest("If", "EndIf", "ElseIf", 4, &type_until2);
         if(!type_until2) ImbricatedTest--; // EndIf reached
       }
     }
@@ -3921,7 +3951,7 @@ Loop :
       if(ImbricatedTest > 0){
         if (statusImbricatedTests[ImbricatedTest]){
           // Last test (If or ElseIf) was true, thus go after EndIf (out of If EndIf)
-          skip("If", "EndIf");
+          yyskip("If", "EndIf");
           ImbricatedTest--;
         }
         else{
@@ -3933,7 +3963,7 @@ Loop :
             // Current test still not true: statusImbricatedTests[ImbricatedTest] = 0;
             // Go after the next ElseIf or Else or EndIf
             int type_until2 = 0;
-            skipTest("If", "EndIf", "ElseIf", 4, &type_until2);
+            yyskipTest("If", "EndIf", "ElseIf", 4, &type_until2);
             if(!type_until2) ImbricatedTest--;
           }
         }
@@ -3946,7 +3976,7 @@ Loop :
     {
       if(ImbricatedTest > 0){
         if(statusImbricatedTests[ImbricatedTest]){
-          skip("If", "EndIf");
+          yyskip("If", "EndIf");
           ImbricatedTest--;
         }
       }
@@ -6886,10 +6916,193 @@ void VectorOfPairs2ListOfShapes(const std::vector<std::pair<int, int> > &v, List
   }
 }
 
+// The tokens of For loop bodies are recorded while the body of the outermost
+// running loop is read from the file, and are replayed from memory for the
+// next iterations (of that loop and of the loops nested in it). Bodies that
+// define or call functions, or that read other files (Macro, Call, Return,
+// Include, Merge), are not recorded: their loops seek back in the file instead.
+
+struct gmsh_yytoken {
+  int type, lineno;
+  double d;
+  std::string c; // value of strings, or "newp", "newl", etc. for new tags
+  std::string text; // for error messages
+};
+
+static std::vector<gmsh_yytoken> loopTokens;
+static std::size_t loopTokenIndex = 0;
+static int loopCacheLevel = -1, loopCacheLineno = 0, unreadToken = 0;
+static bool loopReplay = false;
+static FILE *loopCacheFile = 0;
+
+static bool loopCacheActive()
+{
+  return loopCacheLevel >= 0 && gmsh_yyin == loopCacheFile;
+}
+
+void flushLoopCache()
+{
+  // files parsed while a loop body is recorded or replayed (e.g. strings
+  // parsed by ONELAB clients or print commands) must not flush its tokens
+  if(loopCacheLevel >= 0 && gmsh_yyin != loopCacheFile) return;
+  unreadToken = 0;
+  if(loopCacheLevel < 0) return;
+  if(loopReplay) gmsh_yylineno = loopCacheLineno;
+  for(int i = loopCacheLevel; i < ImbricatedLoop; i++)
+    yytokenImbricatedLoopsTab[i] = -1;
+  loopTokens.clear();
+  loopTokenIndex = 0;
+  loopCacheLevel = -1;
+  loopReplay = false;
+  loopCacheFile = 0;
+}
+
+int cacheLoopBody()
+{
+  if(loopCacheLevel < 0){
+    loopCacheLevel = ImbricatedLoop;
+    loopCacheFile = gmsh_yyin;
+  }
+  else if(gmsh_yyin != loopCacheFile)
+    return -1;
+  return (int)loopTokenIndex;
+}
+
+bool replayLoopBody(int index)
+{
+  if(index < 0 || !loopCacheActive()) return false;
+  if(!loopReplay){
+    loopCacheLineno = gmsh_yylineno;
+    loopReplay = true;
+  }
+  loopTokenIndex = index;
+  return true;
+}
+
+void leaveLoopBody()
+{
+  if(ImbricatedLoop <= loopCacheLevel) flushLoopCache();
+}
+
+static double newTag(const std::string &s)
+{
+  if(s == "newreg") return NEWREG();
+  else if(s == "newp") return NEWPOINT();
+  else if(s == "newl" || s == "newc") return NEWLINE();
+  else if(s == "newll") return NEWLINELOOP();
+  else if(s == "news") return NEWSURFACE();
+  else if(s == "newsl") return NEWSURFACELOOP();
+  else if(s == "newv") return NEWVOLUME();
+  return NEWFIELD();
+}
+
+int gmsh_yylex()
+{
+  if(unreadToken){
+    int type = unreadToken;
+    unreadToken = 0;
+    return type;
+  }
+
+  if(!loopCacheActive()) return gmsh_yyscan();
+
+  if(loopTokenIndex < loopTokens.size()){
+    const gmsh_yytoken &t = loopTokens[loopTokenIndex++];
+    if(t.type == tDOUBLE)
+      gmsh_yylval.d = t.c.empty() ? t.d : newTag(t.c);
+    else if(t.type == tSTRING || t.type == tBIGSTR)
+      gmsh_yylval.c = strsave((char *)t.c.c_str());
+    gmsh_yylineno = t.lineno;
+    return t.type;
+  }
+
+  if(loopReplay){ // back to the file
+    gmsh_yylineno = loopCacheLineno;
+    loopReplay = false;
+  }
+
+  int type = gmsh_yyscan();
+  if(type <= 0) return type;
+  if(type == tMacro || type == tCall || type == tReturn ||
+     (type == tSTRING && (!strcmp(gmsh_yylval.c, "Include") ||
+                          !strcmp(gmsh_yylval.c, "Merge") ||
+                          !strcmp(gmsh_yylval.c, "MergeWithBoundingBox")))){
+    flushLoopCache();
+    return type;
+  }
+
+  gmsh_yytoken t;
+  t.type = type;
+  t.lineno = gmsh_yylineno;
+  t.d = 0.;
+  t.text = gmsh_yytext;
+  if(type == tDOUBLE){
+    t.d = gmsh_yylval.d;
+    if(gmsh_yytext[0] == 'n') t.c = gmsh_yytext;
+  }
+  else if(type == tSTRING || type == tBIGSTR)
+    t.c = gmsh_yylval.c;
+  loopTokens.push_back(t);
+  loopTokenIndex++;
+  return type;
+}
+
+static void skipTokens(int skip, int until, int *type_until2)
+{
+  int nb_skip = 0;
+  while(1){
+    int type = gmsh_yylex();
+    if(type == tSTRING || type == tBIGSTR) Free(gmsh_yylval.c);
+    if(type <= 0){
+      Msg::Error("Unexpected end of file");
+      return;
+    }
+    if(type_until2 && !nb_skip && type == tElseIf){
+      // leave ElseIf to the parser
+      unreadToken = type;
+      *type_until2 = 1;
+      return;
+    }
+    else if(type_until2 && !nb_skip && type == tElse){
+      *type_until2 = 2;
+      return;
+    }
+    else if(type == until){
+      if(!nb_skip) return;
+      nb_skip--;
+    }
+    else if(type == skip){
+      nb_skip++;
+    }
+  }
+}
+
+void yyskip(const char *skip, const char *until)
+{
+  // the skipped tokens of a recorded loop body must be recorded as well
+  if(!loopCacheActive())
+    ::skip(skip, until);
+  else if(!strcmp(until, "EndFor"))
+    skipTokens(tFor, tEndFor, 0);
+  else
+    skipTokens(tIf, tEndIf, 0);
+}
+
+void yyskipTest(const char *skip, const char *until,
+                const char *until2, int l_until2_sub, int *type_until2)
+{
+  if(!loopCacheActive())
+    skipTest(skip, until, until2, l_until2_sub, type_until2);
+  else
+    skipTokens(tIf, tEndIf, type_until2);
+}
+
 void yyerror(const char *s)
 {
+  const char *text = (loopReplay && loopTokenIndex) ?
+    loopTokens[loopTokenIndex - 1].text.c_str() : gmsh_yytext;
   Msg::Error("'%s', line %d : %s (%s)", gmsh_yyname.c_str(), gmsh_yylineno - 1,
-             s, gmsh_yytext);
+             s, text);
   gmsh_yyerrorstate++;
 }
 
@@ -7279,11 +7492,15 @@ double treat_Struct_FullName_Float
 (char* c1, char* c2, int type_var, int index, double val_default, int type_treat)
 {
   double out;
-  if(!c1 && gmsh_yysymbols.count(c2)){
+  // this is called for every variable in every expression: only look the name
+  // up once in the symbol table
+  std::map<std::string, gmsh_yysymbol>::iterator its =
+    c1 ? gmsh_yysymbols.end() : gmsh_yysymbols.find(c2);
+  if(its != gmsh_yysymbols.end()){
     if (type_treat == 1) out = 1.; // Exists (type_treat == 1)
     else { // Get (0) or GetForced (2)
       if (type_var == 1) {
-        gmsh_yysymbol &s(gmsh_yysymbols[c2]);
+        gmsh_yysymbol &s(its->second);
         if(s.value.empty()){
           out = val_default;
           if (type_treat == 0) yymsg(0, "Uninitialized variable '%s'", c2);
@@ -7292,7 +7509,7 @@ double treat_Struct_FullName_Float
           out = s.value[0];
       }
       else if (type_var == 2) {
-        gmsh_yysymbol &s(gmsh_yysymbols[c2]);
+        gmsh_yysymbol &s(its->second);
         if(index < 0 || (int)s.value.size() < index + 1){
           out = val_default;
           if (type_treat == 0) yymsg(0, "Uninitialized variable '%s[%d]'", c2, index);
@@ -123,6 +123,7 @@ void PluginManager::action(const std::string &pluginName,
 
   if(action == "Run") {
     Msg::Info("Running Plugin(%s)...", pluginName.c_str());
+    MsgProfileSection prof("Plugin(%s)", pluginName.c_str());
     plugin->run();
     Msg::Info("Done running Plugin(%s)", pluginName.c_str());
   }
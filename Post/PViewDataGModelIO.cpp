@@ -1141,5 +1141,13 @@ void PViewDataGModel::sendToServer(const std::string &name)
     }
   }
 
+  if(CTX::instance()->post.streamIncremental) {
+    // don't resend unchanged data
+    static std::map<std::string, std::vector<double> > sent;
+    std::vector<double> &last = sent[name];
+    if(last == exp) return;
+    last = exp;
+  }
+
   Msg::SetOnelabNumber(name, exp, false);
 }
@@ -1503,9 +1503,8 @@ public:
       return false;
     if(!opt->visible || opt->type != PViewOptions::Plot3D) return false;
 
-    p->deleteVertexArrays();
-
     if(data->isRemote()) {
+      // the current arrays are kept until the server replaces or updates them
       // FIXME: need to rewrite option code and add nice serialization
       std::string fileName =
         CTX::instance()->homeDir + CTX::instance()->tmpFileName;
@@ -1515,6 +1514,8 @@ public:
       return false;
     }
 
+    p->deleteVertexArrays();
+
     if(opt->useGenRaise) opt->createGeneralRaise();
 
     if(opt->rangeType == PViewOptions::Custom) {
@@ -1575,11 +1576,11 @@ void PView::fillVertexArray(onelab::localNetworkClient *remote, int length,
                             const char *bytes, int swap)
 {
   std::string name;
-  int tag, type, numSteps;
+  int tag, type, numSteps, encoding = 0;
   double min, max, time, xmin, ymin, zmin, xmax, ymax, zmax;
   if(!VertexArray::decodeHeader(length, bytes, swap, name, tag, type, min, max,
                                 numSteps, time, xmin, ymin, zmin, xmax, ymax,
-                                zmax))
+                                zmax, &encoding))
     return;
 
   Msg::Debug("Filling vertex array (type %d) in view tag %d", type, tag);
@@ -1607,35 +1608,32 @@ void PView::fillVertexArray(onelab::localNetworkClient *remote, int length,
   // not perfect (does not take transformations into account)
   p->getOptions()->tmpBBox = bbox;
 
+  VertexArray **va;
+  int numVerticesPerElement;
   switch(type) {
-  case 1:
-    if(p->va_points) delete p->va_points;
-    p->va_points = new VertexArray(1, 100);
-    p->va_points->fromChar(length, bytes, swap);
-    break;
-  case 2:
-    if(p->va_lines) delete p->va_lines;
-    p->va_lines = new VertexArray(2, 100);
-    p->va_lines->fromChar(length, bytes, swap);
-    break;
-  case 3:
-    if(p->va_triangles) delete p->va_triangles;
-    p->va_triangles = new VertexArray(3, 100);
-    p->va_triangles->fromChar(length, bytes, swap);
-    break;
-  case 4:
-    if(p->va_vectors) delete p->va_vectors;
-    p->va_vectors = new VertexArray(2, 100);
-    p->va_vectors->fromChar(length, bytes, swap);
-    break;
-  case 5:
-    if(p->va_ellipses) delete p->va_ellipses;
-    p->va_ellipses = new VertexArray(4, 100);
-    p->va_ellipses->fromChar(length, bytes, swap);
-    break;
+  case 1: va = &p->va_points; numVerticesPerElement = 1; break;
+  case 2: va = &p->va_lines; numVerticesPerElement = 2; break;
+  case 3: va = &p->va_triangles; numVerticesPerElement = 3; break;
+  case 4: va = &p->va_vectors; numVerticesPerElement = 2; break;
+  case 5: va = &p->va_ellipses; numVerticesPerElement = 4; break;
   default: Msg::Error("Cannot fill vertex array of type %d", type); return;
   }
 
+  // chunks and incremental updates complete the existing array
+  if(encoding & (VertexArray::Append | VertexArray::ColorsOnly)) {
+    if(!*va && (encoding & VertexArray::ColorsOnly)) {
+      Msg::Warning("Missing vertex array (type %d) to update in view tag %d",
+                   type, tag);
+      return;
+    }
+  }
+  else if(*va) {
+    delete *va;
+    *va = 0;
+  }
+  if(!*va) *va = new VertexArray(numVerticesPerElement, 100);
+  (*va)->fromChar(length, bytes, swap);
+
   p->setChanged(false);
   p->getData()->setDirty(false);
 }
@@ -875,23 +875,6 @@ GMSH_API void gmshModelMeshClear(int * dimTags, size_t dimTags_n, int * ierr)
   }
 }
 
-GMSH_API void gmshModelMeshGetNodes(size_t ** nodeTags, size_t * nodeTags_n, double ** coord, size_t * coord_n, double ** parametricCoord, size_t * parametricCoord_n, const int dim, const int tag, const int includeBoundary, const int returnParametricCoord, int * ierr)
-{
-  if(ierr) *ierr = 0;
-  try {
-    std::vector<std::size_t> api_nodeTags_;
-    std::vector<double> api_coord_;
-    std::vector<double> api_parametricCoord_;
-    gmsh::model::mesh::getNodes(api_nodeTags_, api_coord_, api_parametricCoord_, dim, tag, includeBoundary, returnParametricCoord);
-    vector2ptr(api_nodeTags_, nodeTags, nodeTags_n);
-    vector2ptr(api_coord_, coord, coord_n);
-    vector2ptr(api_parametricCoord_, parametricCoord, parametricCoord_n);
-  }
-  catch(const std::string &api_error_){
-    if(ierr) *ierr = 1;
-  }
-}
-
 GMSH_API void gmshModelMeshGetNodesByElementType(const int elementType, size_t ** nodeTags, size_t * nodeTags_n, double ** coord, size_t * coord_n, double ** parametricCoord, size_t * parametricCoord_n, const int tag, const int returnParametricCoord, int * ierr)
 {
   if(ierr) *ierr = 0;
@@ -1118,21 +1101,6 @@ GMSH_API void gmshModelMeshGetElementProperties(const int elementType, char ** e
   }
 }
 
-GMSH_API void gmshModelMeshGetElementsByType(const int elementType, size_t ** elementTags, size_t * elementTags_n, size_t ** nodeTags, size_t * nodeTags_n, const int tag, const size_t task, const size_t numTasks, int * ierr)
-{
-  if(ierr) *ierr = 0;
-  try {
-    std::vector<std::size_t> api_elementTags_;
-    std::vector<std::size_t> api_nodeTags_;
-    gmsh::model::mesh::getElementsByType(elementType, api_elementTags_, api_nodeTags_, tag, task, numTasks);
-    vector2ptr(api_elementTags_, elementTags, elementTags_n);
-    vector2ptr(api_nodeTags_, nodeTags, nodeTags_n);
-  }
-  catch(const std::string &api_error_){
-    if(ierr) *ierr = 1;
-  }
-}
-
 GMSH_API void gmshModelMeshPreallocateElementsByType(const int elementType, const int elementTag, const int nodeTag, size_t ** elementTags, size_t * elementTags_n, size_t ** nodeTags, size_t * nodeTags_n, const int tag, int * ierr)
 {
   if(ierr) *ierr = 0;
@@ -3405,23 +3373,6 @@ GMSH_API void gmshViewAddHomogeneousModelData(const int tag, const int step, con
   }
 }
 
-GMSH_API void gmshViewGetHomogeneousModelData(const int tag, const int step, char ** dataType, size_t ** tags, size_t * tags_n, double ** data, size_t * data_n, double * time, int * numComponents, int * ierr)
-{
-  if(ierr) *ierr = 0;
-  try {
-    std::string api_dataType_;
-    std::vector<std::size_t> api_tags_;
-    std::vector<double> api_data_;
-    gmsh::view::getHomogeneousModelData(tag, step, api_dataType_, api_tags_, api_data_, *time, *numComponents);
-    *dataType = strdup(api_dataType_.c_str());
-    vector2ptr(api_tags_, tags, tags_n);
-    vector2ptr(api_data_, data, data_n);
-  }
-  catch(const std::string &api_error_){
-    if(ierr) *ierr = 1;
-  }
-}
-
 GMSH_API void gmshViewAddListData(const int tag, const char * dataType, const int numEle, double * data, size_t data_n, int * ierr)
 {
   if(ierr) *ierr = 0;
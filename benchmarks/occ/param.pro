@@ -0,0 +1 @@
+// my not so great surface selection...
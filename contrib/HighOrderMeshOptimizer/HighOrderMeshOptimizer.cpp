@@ -244,6 +244,7 @@ HOPatchDefParameters::HOPatchDefParameters(const OptHomParameters &p)
   jacMin = p.BARRIER_MIN;
   jacMax = (p.BARRIER_MAX > 0.) ? p.BARRIER_MAX : 1.e300;
   strategy = (p.strategy == 1) ? MeshOptPatchDef::STRAT_ONEBYONE :
+             (p.strategy == 3) ? MeshOptPatchDef::STRAT_CONCURRENT :
                                  MeshOptPatchDef::STRAT_DISJOINT;
   minLayers = (p.dim == 3) ? 1 : 0;
   maxLayers = p.nbLayers;
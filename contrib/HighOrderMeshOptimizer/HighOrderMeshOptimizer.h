@@ -47,7 +47,8 @@ struct OptHomParameters {
                          // straight sided version of an element are optimized
   bool fixBndNodes; // how jacobians are computed and if points can move on
                     // boundaries
-  int strategy; // 0 = connected blobs, 1 = adaptive one-by-one
+  int strategy; // 0 = connected blobs, 1 = adaptive one-by-one, 2 = connected
+                // blobs with weak merging, 3 = adaptive concurrent
   int maxAdaptBlob; // Max. nb. of blob adaptation interations
   int
     adaptBlobLayerFact; // Growth factor in number of layers for blob adaptation
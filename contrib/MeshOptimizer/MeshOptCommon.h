@@ -66,12 +66,13 @@ public:
 
 class MeshOptPatchDef {
 public:
-  enum { STRAT_DISJOINT, STRAT_ONEBYONE };
-  int strategy; // Strategy: disjoint patches or adaptive one-by-one
+  enum { STRAT_DISJOINT, STRAT_ONEBYONE, STRAT_CONCURRENT };
+  int strategy; // Strategy: disjoint patches, adaptive one-by-one or adaptive
+                // concurrent (independent patches optimized in parallel)
   int minLayers,
     maxLayers; // Min. and max. nb. of layers around a bad element in patch
   union {
-    struct { // If adaptive strategy:
+    struct { // If adaptive strategies:
       int maxPatchAdapt; // Max. nb. of adaptation iterations
       int maxLayersAdaptFact; // Growth rate in number of layers around a bad
                               // element
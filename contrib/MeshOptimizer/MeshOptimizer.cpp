@@ -30,6 +30,7 @@
 #include <limits>
 #include <string.h>
 #include <stack>
+#include <algorithm>
 #include "Context.h"
 #include "GmshConfig.h"
 #include "GModel.h"
@@ -37,6 +38,7 @@
 #include "MQuadrangle.h"
 #include "MLine.h"
 #include "OS.h"
+#include "BasisFactory.h"
 #include "MeshOpt.h"
 #include "MeshOptCommon.h"
 #include "MeshOptimizer.h"
@@ -722,6 +724,338 @@ namespace {
     }
   }
 
+  // Vertex -> element connectivity in flat arrays (compressed rows), built
+  // from the vertex -> element map, whose keys are sorted by pointer so that
+  // vertices can be looked up by binary search
+  class flatVertex2Elements {
+  private:
+    std::vector<MVertex *> _vert;
+    std::vector<std::size_t> _row;
+    std::vector<MElement *> _el;
+
+  public:
+    flatVertex2Elements(const vertElVecMap &vertex2elements)
+    {
+      _vert.reserve(vertex2elements.size());
+      _row.reserve(vertex2elements.size() + 1);
+      _row.push_back(0);
+      for(vertElVecMap::const_iterator it = vertex2elements.begin();
+          it != vertex2elements.end(); ++it) {
+        _vert.push_back(it->first);
+        _el.insert(_el.end(), it->second.begin(), it->second.end());
+        _row.push_back(_el.size());
+      }
+    }
+    // Elements adjacent to vertex v are in [begin, end)
+    void elements(MVertex *v, std::size_t &begin, std::size_t &end) const
+    {
+      std::vector<MVertex *>::const_iterator it =
+        std::lower_bound(_vert.begin(), _vert.end(), v);
+      if(it == _vert.end() || *it != v) {
+        begin = end = 0;
+        return;
+      }
+      begin = _row[it - _vert.begin()];
+      end = _row[it - _vert.begin() + 1];
+    }
+    MElement *element(std::size_t i) const { return _el[i]; }
+  };
+
+  // Same as getSurroundingPatch, but without caching the element to element
+  // connectivity, so that it can be called concurrently
+  elSet getSurroundingPatchFlat(MElement *el, const MeshOptPatchDef *patchDef,
+                                double limDist, int maxLayers,
+                                const flatVertex2Elements &vertex2elements,
+                                const elEntMap &element2entity)
+  {
+    const SPoint3 pnt = el->barycenter(true);
+
+    GEntity *gEnt = 0;
+    if(!element2entity.empty()) {
+      elEntMap::const_iterator itEl2Ent = element2entity.find(el);
+      if(itEl2Ent != element2entity.end()) gEnt = itEl2Ent->second;
+    }
+
+    elSet patch, currentLayer, lastLayer, excluded;
+
+    patch.insert(el);
+    lastLayer.insert(el);
+    for(int d = 0; d < maxLayers; ++d) {
+      currentLayer.clear();
+      for(elSetIter it = lastLayer.begin(); it != lastLayer.end(); ++it) {
+        for(int i = 0; i < (*it)->getNumPrimaryVertices(); ++i) {
+          std::size_t begin, end;
+          vertex2elements.elements((*it)->getVertex(i), begin, end);
+          for(std::size_t k = begin; k < end; k++) {
+            MElement *n = vertex2elements.element(k);
+            if(n == *it || lastLayer.count(n) || excluded.count(n)) continue;
+            const int elIn = patchDef->inPatch(pnt, limDist, n, gEnt);
+            if((elIn > 0) || ((d < patchDef->minLayers) && (elIn == 0))) {
+              if(patch.insert(n).second) currentLayer.insert(n);
+            }
+            else
+              excluded.insert(n);
+          }
+        }
+      }
+      lastLayer = currentLayer;
+    }
+
+    return patch;
+  }
+
+  bool isBadElement(MElement *el, const elEntMap &element2entity,
+                    const elElMap &el2BndEl, const elEntMap &bndEl2Ent,
+                    const MeshOptParameters &par)
+  {
+    GEntity *gEnt = 0;
+    if(!element2entity.empty()) {
+      elEntMap::const_iterator itEl2Ent = element2entity.find(el);
+      if(itEl2Ent != element2entity.end()) gEnt = itEl2Ent->second;
+    }
+    if(par.patchDef->elBadness(el, gEnt) < 0.) return true;
+    elElMap::const_iterator itBndEl = el2BndEl.find(el);
+    if(itBndEl == el2BndEl.end()) return false;
+    elEntMap::const_iterator itEnt = bndEl2Ent.find(itBndEl->second);
+    GEntity *bndEnt = (itEnt != bndEl2Ent.end()) ? itEnt->second : 0;
+    return par.patchDef->bndElBadness(itBndEl->second, bndEnt) < 0.;
+  }
+
+  struct lessBadness {
+    bool operator()(const std::pair<double, MElement *> &a,
+                    const std::pair<double, MElement *> &b) const
+    {
+      return a.first < b.first;
+    }
+  };
+
+  // Make sure that the interpolation bases used in the optimization are
+  // created before patches are optimized concurrently
+  void prepareBases(const flatVertex2Elements &vertex2elements,
+                    std::size_t numAdjacencies, const elEntMap &bndEl2Ent)
+  {
+    std::set<int> types;
+    for(std::size_t i = 0; i < numAdjacencies; i++) {
+      MElement *el = vertex2elements.element(i);
+      if(types.insert(el->getTypeForMSH()).second) {
+        el->getFunctionSpace();
+        el->getJacobianFuncSpace();
+      }
+    }
+    for(elEntMap::const_iterator it = bndEl2Ent.begin(); it != bndEl2Ent.end();
+        ++it) {
+      MElement *el = it->first;
+      if(types.insert(el->getTypeForMSH()).second) {
+        el->getFunctionSpace();
+        el->getJacobianFuncSpace();
+        BasisFactory::getGradientBasis(el->getTypeForMSH(), FuncSpaceData(el));
+      }
+    }
+  }
+
+  // Adaptive strategy where the patches around all the bad elements are built
+  // up front and optimized concurrently: patches sharing a vertex (moved or
+  // fixed) conflict, and are greedily colored by decreasing badness of their
+  // bad element, each color giving a wave of independent patches. Patches
+  // that fail are enlarged and optimized again in the next adaptation step.
+  void optimizeConcurrent(const vertElVecMap &vertex2elements,
+                          const elEntMap &element2entity,
+                          const elElMap &el2BndEl, const elEntMap &bndEl2Ent,
+                          const elSet &badElts, MeshOptParameters &par)
+  {
+    int nbPatchSuccess[3] = {0, 0, 0}; // 0: fail, 1: partial fail, 2: success
+    std::vector<std::pair<double, double> > newObjFunctionRange;
+    std::vector<std::string> objFunctionNames;
+
+    par.success = 1;
+
+    const elEntMap &e2ePatch =
+      par.useGeomForPatches ? element2entity : elEntMap();
+    const elEntMap &e2eOpt = par.useGeomForOpt ? element2entity : elEntMap();
+
+    const flatVertex2Elements v2e(vertex2elements);
+    std::size_t numAdjacencies = 0;
+    for(vertElVecMap::const_iterator it = vertex2elements.begin();
+        it != vertex2elements.end(); ++it)
+      numAdjacencies += it->second.size();
+    prepareBases(v2e, numAdjacencies, bndEl2Ent);
+
+    // Sort bad elements, worst first
+    std::vector<std::pair<double, MElement *> > sorted;
+    for(elSet::const_iterator it = badElts.begin(); it != badElts.end();
+        ++it) {
+      GEntity *gEnt = 0;
+      elEntMap::const_iterator itEl2Ent = e2ePatch.find(*it);
+      if(itEl2Ent != e2ePatch.end()) gEnt = itEl2Ent->second;
+      sorted.push_back(std::make_pair(par.patchDef->elBadness(*it, gEnt), *it));
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), lessBadness());
+    std::vector<MElement *> pending(sorted.size());
+    for(std::size_t i = 0; i < sorted.size(); i++)
+      pending[i] = sorted[i].second;
+
+    if(par.verbose > 0)
+      Msg::Info("%d bad elements, optimizing patches concurrently...",
+                (int)pending.size());
+
+    int maxLayers = par.patchDef->maxLayers;
+    const int maxAdapt = std::max(1, par.patchDef->maxPatchAdapt);
+    for(int iAdapt = 0; iAdapt < maxAdapt && !pending.empty(); iAdapt++) {
+      const bool lastAdapt = (iAdapt == maxAdapt - 1);
+      const int nPatch = pending.size();
+
+      // Build patches
+      std::vector<elSet> patches(nPatch), bndElts(nPatch);
+      std::vector<vertSet> toFix(nPatch);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(int iPatch = 0; iPatch < nPatch; iPatch++) {
+        const double limDist = par.patchDef->maxDistance(pending[iPatch]);
+        patches[iPatch] =
+          getSurroundingPatchFlat(pending[iPatch], par.patchDef, limDist,
+                                  maxLayers, v2e, e2ePatch);
+        toFix[iPatch] = getAllBndVertices(patches[iPatch], vertex2elements);
+        if(!el2BndEl.empty())
+          getAdjacentBndElts(el2BndEl, bndEl2Ent, patches[iPatch],
+                             bndElts[iPatch], par);
+      }
+
+      // Patch -> vertex connectivity (moved and fixed vertices)
+      std::vector<std::size_t> patchRow(nPatch + 1, 0);
+      std::vector<MVertex *> patchVert;
+      for(int iPatch = 0; iPatch < nPatch; iPatch++) {
+        std::size_t first = patchVert.size();
+        patchVert.insert(patchVert.end(), toFix[iPatch].begin(),
+                         toFix[iPatch].end());
+        for(elSetIter it = patches[iPatch].begin();
+            it != patches[iPatch].end(); ++it)
+          for(std::size_t j = 0; j < (*it)->getNumVertices(); j++)
+            patchVert.push_back((*it)->getVertex(j));
+        std::sort(patchVert.begin() + first, patchVert.end());
+        patchVert.erase(std::unique(patchVert.begin() + first, patchVert.end()),
+                        patchVert.end());
+        patchRow[iPatch + 1] = patchVert.size();
+      }
+
+      // Number the vertices by pointer
+      std::vector<MVertex *> verts(patchVert);
+      std::sort(verts.begin(), verts.end());
+      verts.erase(std::unique(verts.begin(), verts.end()), verts.end());
+      std::vector<std::size_t> patchVertNum(patchVert.size());
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+      for(std::size_t k = 0; k < patchVert.size(); k++)
+        patchVertNum[k] =
+          std::lower_bound(verts.begin(), verts.end(), patchVert[k]) -
+          verts.begin();
+
+      // Greedy coloring of the conflict graph (patches sharing a vertex), in
+      // the order of the patches, through the colors already taken by the
+      // patches touching each vertex
+      std::vector<std::vector<int> > vertColors(verts.size());
+      std::vector<std::vector<int> > waves;
+      std::vector<char> taken;
+      for(int iPatch = 0; iPatch < nPatch; iPatch++) {
+        taken.assign(waves.size() + 1, 0);
+        for(std::size_t k = patchRow[iPatch]; k < patchRow[iPatch + 1]; k++) {
+          const std::vector<int> &c = vertColors[patchVertNum[k]];
+          for(std::size_t i = 0; i < c.size(); i++) taken[c[i]] = 1;
+        }
+        std::size_t c = 0;
+        while(taken[c]) c++;
+        if(c == waves.size()) waves.push_back(std::vector<int>());
+        waves[c].push_back(iPatch);
+        for(std::size_t k = patchRow[iPatch]; k < patchRow[iPatch + 1]; k++)
+          vertColors[patchVertNum[k]].push_back(c);
+      }
+
+      if(par.verbose > 0)
+        Msg::Info("Adaptation step %d: optimizing %d patches in %d waves",
+                  iAdapt, nPatch, (int)waves.size());
+
+      // Optimize independent patches concurrently, wave by wave
+      std::vector<int> success(nPatch, -1);
+      for(std::size_t iWave = 0; iWave < waves.size(); iWave++) {
+        const std::vector<int> &wave = waves[iWave];
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if(!par.nCurses)
+#endif
+        for(std::size_t k = 0; k < wave.size(); k++) {
+          const int iPatch = wave[k];
+
+          // The bad element may have been fixed by a previous wave
+          if(iWave > 0 && !isBadElement(pending[iPatch], element2entity,
+                                        el2BndEl, bndEl2Ent, par)) {
+            success[iPatch] = 1;
+            continue;
+          }
+
+          if(par.verbose > 1)
+            Msg::Info("Optimizing patch %i (adapt #%i) composed of %4d "
+                      "elements",
+                      iPatch, iAdapt, (int)patches[iPatch].size());
+          MeshOpt opt(e2eOpt, bndEl2Ent, patches[iPatch], toFix[iPatch],
+                      bndElts[iPatch], par);
+          if(opt.patch.nPC() == 0) {
+            Msg::Info("Patch %i (adapt #%i) has no degree of freedom, "
+                      "skipping",
+                      iPatch, iAdapt);
+            success[iPatch] = -1;
+          }
+          else
+            success[iPatch] = opt.optimize(par);
+
+          if((success[iPatch] > 0) || lastAdapt) {
+            opt.updateResults();
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+            {
+              if(newObjFunctionRange.size() == 0) {
+                newObjFunctionRange = opt.objFunction()->minMax();
+                objFunctionNames = opt.objFunction()->names();
+              }
+              else {
+                for(int i = 0; i < newObjFunctionRange.size(); i++) {
+                  newObjFunctionRange[i].first =
+                    std::min(newObjFunctionRange[i].first,
+                             opt.objFunction()->minMax()[i].first);
+                  newObjFunctionRange[i].second =
+                    std::max(newObjFunctionRange[i].second,
+                             opt.objFunction()->minMax()[i].second);
+                }
+              }
+            }
+            if(success[iPatch] >= 0) opt.patch.updateGEntityPositions();
+          }
+        }
+      }
+
+      // Enlarge the patches that failed for the next adaptation step
+      std::vector<MElement *> failed;
+      for(int iPatch = 0; iPatch < nPatch; iPatch++) {
+        if(success[iPatch] > 0 || lastAdapt) {
+          nbPatchSuccess[success[iPatch] + 1]++;
+          par.success = std::min(par.success, success[iPatch]);
+        }
+        else
+          failed.push_back(pending[iPatch]);
+      }
+      pending.swap(failed);
+      maxLayers *= par.patchDef->maxLayersAdaptFact;
+    }
+
+    if(par.verbose > 0)
+      Msg::Info("%d patches succeeded, %d partially failed, %d failed",
+                nbPatchSuccess[2], nbPatchSuccess[1], nbPatchSuccess[0]);
+    if(par.nCurses) {
+      displayMinMaxVal(nbPatchSuccess, objFunctionNames, newObjFunctionRange);
+      displayResultTable(nbPatchSuccess, badElts.size());
+    }
+  }
+
 } // namespace
 
 void MeshOptimizer(std::vector<GEntity *> &entities, MeshOptParameters &par)
@@ -787,6 +1121,9 @@ void MeshOptimizer(std::vector<GEntity *> &entities, MeshOptParameters &par)
   else if(par.patchDef->strategy == MeshOptPatchDef::STRAT_ONEBYONE)
     optimizeOneByOne(vertex2elements, element2entity, el2BndEl, bndEl2Ent,
                      badElts, par);
+  else if(par.patchDef->strategy == MeshOptPatchDef::STRAT_CONCURRENT)
+    optimizeConcurrent(vertex2elements, element2entity, el2BndEl, bndEl2Ent,
+                       badElts, par);
   else {
     if(par.nCurses) {
       mvcolor(2, true);
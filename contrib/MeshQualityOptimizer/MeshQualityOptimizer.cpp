@@ -65,6 +65,7 @@ QualPatchDefParameters::QualPatchDefParameters(const MeshQualOptParameters &p)
   _idealJacMin = p.minTargetIdealJac;
   _invCondNumMin = p.minTargetInvCondNum;
   strategy = (p.strategy == 1) ? MeshOptPatchDef::STRAT_ONEBYONE :
+             (p.strategy == 3) ? MeshOptPatchDef::STRAT_CONCURRENT :
                                  MeshOptPatchDef::STRAT_DISJOINT;
   minLayers = (p.dim == 3) ? 1 : 0;
   maxLayers = p.nbLayers;
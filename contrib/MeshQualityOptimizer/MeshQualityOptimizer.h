@@ -42,7 +42,8 @@ struct MeshQualOptParameters {
   bool onlyVisible; // If optimization applied to visible entities ONLY
   double distanceFactor; // Distance criterion for patch creation
   bool fixBndNodes; // If points can move on boundaries
-  int strategy; // 0 = connected blobs, 1 = adaptive one-by-one
+  int strategy; // 0 = connected blobs, 1 = adaptive one-by-one, 2 = connected
+                // blobs with weak merging, 3 = adaptive concurrent
   int maxPatchAdapt; // Max. nb. of patch adaptation iterations (if adaptive)
   int maxLayersAdaptFact; // Growth factor in number of layers for patch
                           // adaptation (if adaptive)